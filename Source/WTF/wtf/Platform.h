@@ -965,6 +965,11 @@
 #define WTF_USE_TEXTURE_MAPPER 1
 #endif
 
+/* Qt records composited layer contents into QPictures */
+#if PLATFORM(QT) && USE(ACCELERATED_COMPOSITING)
+#define WTF_USE_DISPLAY_LIST_RECORDING 1
+#endif
+
 #if USE(TEXTURE_MAPPER) && USE(3D_GRAPHICS) && !defined(WTF_USE_TEXTURE_MAPPER_GL)
 #define WTF_USE_TEXTURE_MAPPER_GL 1
 #endif
@@ -334,6 +334,7 @@ localizedStrings["Pseudo ::%s element"] = "Pseudo ::%s element";
 localizedStrings["Pseudo element"] = "Pseudo element";
 localizedStrings["URL fragment"] = "URL fragment";
 localizedStrings["Query String Parameters"] = "Query String Parameters";
+localizedStrings["Queueing"] = "Queueing";
 localizedStrings["RECORDS"] = "RECORDS";
 localizedStrings["RESULTS"] = "RESULTS";
 localizedStrings["RGB Colors"] = "RGB Colors";
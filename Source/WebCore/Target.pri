@@ -730,6 +730,7 @@ SOURCES += \
     html/parser/BackgroundHTMLInputStream.cpp \
     html/parser/BackgroundHTMLParser.cpp \
     html/parser/CSSPreloadScanner.cpp \
+    html/parser/CSSSubresourcePreloadScanner.cpp \
     html/parser/CompactHTMLToken.cpp \
     html/parser/HTMLConstructionSite.cpp \
     html/parser/HTMLDocumentParser.cpp \
@@ -1045,6 +1046,7 @@ SOURCES += \
     platform/graphics/transforms/TransformState.cpp \
     platform/graphics/transforms/TranslateTransformOperation.cpp \
     platform/graphics/WidthIterator.cpp \
+    platform/graphics/WordShapingCache.cpp \
     platform/image-decoders/ImageDecoder.cpp \
     platform/image-decoders/bmp/BMPImageDecoder.cpp \
     platform/image-decoders/bmp/BMPImageReader.cpp \
@@ -1083,6 +1085,7 @@ SOURCES += \
     platform/network/NetworkStateNotifier.cpp \
     platform/network/NetworkStorageSessionStub.cpp \
     platform/network/ParsedContentType.cpp \
+    platform/network/PreconnectQueue.cpp \
     platform/network/ProtectionSpace.cpp \
     platform/network/ProxyServer.cpp \
     platform/network/ResourceErrorBase.cpp \
@@ -1237,6 +1240,7 @@ SOURCES += \
     rendering/RenderWordBreak.cpp \
     rendering/RootInlineBox.cpp \
     rendering/ScrollBehavior.cpp \
+    rendering/SimpleLineLayout.cpp \
     rendering/shapes/PolygonShape.cpp \
     rendering/shapes/RectangleShape.cpp \
     rendering/shapes/Shape.cpp \
@@ -1905,6 +1909,7 @@ HEADERS += \
     html/ValidityState.h \
     html/parser/AtomicHTMLToken.h \
     html/parser/CSSPreloadScanner.h \
+    html/parser/CSSSubresourcePreloadScanner.h \
     html/parser/CompactHTMLToken.h \
     html/parser/HTMLConstructionSite.h \
     html/parser/HTMLDocumentParser.h \
@@ -2149,6 +2154,7 @@ HEADERS += \
     platform/graphics/cpu/arm/filters/FEGaussianBlurNEON.h \
     platform/graphics/cpu/arm/filters/FELightingNEON.h \
     platform/graphics/CrossfadeGeneratedImage.h \
+    platform/graphics/DisplayList.h \
     platform/graphics/filters/texmap/TextureMapperPlatformCompiledProgram.h \
     platform/graphics/filters/CustomFilterArrayParameter.h \
     platform/graphics/filters/CustomFilterColorParameter.h \
@@ -2264,7 +2270,7 @@ HEADERS += \
     platform/graphics/transforms/TransformState.h \
     platform/graphics/transforms/TranslateTransformOperation.h \
     platform/graphics/WidthIterator.h \
-    platform/graphics/WidthCache.h \
+    platform/graphics/WordShapingCache.h \
     platform/image-decoders/bmp/BMPImageDecoder.h \
     platform/image-decoders/bmp/BMPImageReader.h \
     platform/image-decoders/ico/ICOImageDecoder.h \
@@ -2315,6 +2321,7 @@ HEADERS += \
     platform/network/NetworkStateNotifier.h \
     platform/network/ParsedContentType.h \
     platform/network/PlatformCookieJar.h \
+    platform/network/PreconnectQueue.h \
     platform/network/ProtectionSpace.h \
     platform/network/ProxyServer.h \
     platform/network/qt/QtMIMETypeSniffer.h \
@@ -2501,6 +2508,7 @@ HEADERS += \
     rendering/RenderWordBreak.h \
     rendering/RootInlineBox.h \
     rendering/ScrollBehavior.h \
+    rendering/SimpleLineLayout.h \
     rendering/shapes/PolygonShape.h \
     rendering/shapes/RectangleShape.h \
     rendering/shapes/Shape.h \
@@ -2871,6 +2879,7 @@ SOURCES += \
     page/qt/EventHandlerQt.cpp \
     platform/graphics/qt/TransformationMatrixQt.cpp \
     platform/graphics/qt/ColorQt.cpp \
+    platform/graphics/qt/DisplayListQt.cpp \
     platform/graphics/qt/FontPlatformDataQt.cpp \
     platform/graphics/qt/FloatPointQt.cpp \
     platform/graphics/qt/FloatRectQt.cpp \
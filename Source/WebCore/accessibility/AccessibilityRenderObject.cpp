@@ -1171,7 +1171,7 @@ bool AccessibilityRenderObject::computeAccessibilityIsIgnored() const
         if (parent && (parent->ariaRoleAttribute() == MenuItemRole || parent->ariaRoleAttribute() == MenuButtonRole))
             return true;
         RenderText* renderText = toRenderText(m_renderer);
-        if (m_renderer->isBR() || !renderText->firstTextBox())
+        if (m_renderer->isBR() || (!renderText->firstTextBox() && !renderText->simpleLineLayout()))
             return true;
 
         // static text beneath TextControls is reported along with the text control text so it's ignored.
@@ -1234,8 +1234,10 @@ bool AccessibilityRenderObject::computeAccessibilityIsIgnored() const
     if (node && node->hasTagName(spanTag))
         return true;
     
-    if (m_renderer->isBlockFlow() && m_renderer->childrenInline() && !canSetFocusAttribute())
+    if (m_renderer->isBlockFlow() && m_renderer->childrenInline() && !canSetFocusAttribute()) {
+        toRenderBlock(m_renderer)->ensureLineBoxes();
         return !toRenderBlock(m_renderer)->firstLineBox() && !mouseButtonListener();
+    }
     
     // ignore images seemingly used as spacers
     if (isImage()) {
@@ -101,6 +101,8 @@ static gchar* textForRenderer(RenderObject* renderer)
             continue;
         }
 
+        if (renderText)
+            renderText->ensureLineBoxes();
         InlineTextBox* box = renderText ? renderText->firstTextBox() : 0;
         while (box) {
             // WebCore introduces line breaks in the text that do not reflect
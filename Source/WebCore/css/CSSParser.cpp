@@ -766,6 +766,10 @@ static inline bool isValidKeywordPropertyAndValue(CSSPropertyID propertyId, int
         if (valueID == CSSValueAuto || valueID == CSSValueAvoid)
             return true;
         break;
+    case CSSPropertyWebkitContain: // none | strict
+        if (valueID == CSSValueNone || valueID == CSSValueStrict)
+            return true;
+        break;
     case CSSPropertyPointerEvents:
         // none | visiblePainted | visibleFill | visibleStroke | visible |
         // painted | fill | stroke | auto | all | inherit
@@ -1119,6 +1123,7 @@ static inline bool isKeywordPropertyID(CSSPropertyID propertyId)
     case CSSPropertyWebkitColumnBreakBefore:
     case CSSPropertyWebkitColumnBreakInside:
     case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWebkitContain:
     case CSSPropertyWebkitAlignContent:
     case CSSPropertyWebkitAlignItems:
     case CSSPropertyWebkitAlignSelf:
@@ -1282,6 +1287,54 @@ static bool parseTranslateTransformValue(MutableStylePropertySet* properties, CS
     return true;
 }
 
+template <typename CharacterType>
+static inline bool isSimpleDeclarationList(const CharacterType* characters, unsigned length)
+{
+    // Anything that needs the tokenizer (comments, escapes, strings, functions, blocks, !important,
+    // non-ASCII identifiers) goes through the grammar.
+    for (unsigned i = 0; i < length; ++i) {
+        CharacterType c = characters[i];
+        if (!isASCII(c) || c == '/' || c == '\\' || c == '"' || c == '\'' || c == '(' || c == '!' || c == '{' || c == '}' || c == '@')
+            return false;
+    }
+    return true;
+}
+
+// Handles the common "name: value; name: value" form of style attributes without running the grammar,
+// as long as every value is accepted by one of the single value fast paths above. Returns false, possibly
+// leaving a partially filled declaration behind, when the full parser is needed.
+static bool parseSimpleDeclarationList(MutableStylePropertySet* declaration, const String& string, const CSSParserContext& context)
+{
+    Vector<String> declarations;
+    string.split(';', declarations);
+    for (size_t i = 0; i < declarations.size(); ++i) {
+        size_t colon = declarations[i].find(':');
+        if (colon == notFound) {
+            if (!declarations[i].stripWhiteSpace().isEmpty())
+                return false;
+            continue;
+        }
+        String value = declarations[i].substring(colon + 1).stripWhiteSpace();
+        if (value.isEmpty() || value.find(':') != notFound)
+            return false;
+
+        CSSPropertyID propertyID = cssPropertyID(declarations[i].left(colon).stripWhiteSpace());
+        if (propertyID == CSSPropertyInvalid || prefixingVariantForPropertyId(propertyID) != propertyID)
+            return false;
+
+        // Later declarations win, and keep their position like they would after filterProperties().
+        declaration->removeProperty(propertyID);
+        if (parseSimpleLengthValue(declaration, propertyID, value, false, context.mode))
+            continue;
+        if (parseColorValue(declaration, propertyID, value, false, context.mode))
+            continue;
+        if (parseKeywordValue(declaration, propertyID, value, false, context))
+            continue;
+        return false;
+    }
+    return true;
+}
+
 PassRefPtr<CSSValueList> CSSParser::parseFontFaceValue(const AtomicString& string)
 {
     if (string.isEmpty())
@@ -1433,6 +1486,12 @@ PassRefPtr<ImmutableStylePropertySet> CSSParser::parseInlineStyleDeclaration(con
 
 PassRefPtr<ImmutableStylePropertySet> CSSParser::parseDeclaration(const String& string, StyleSheetContents* contextStyleSheet)
 {
+    if (!string.isEmpty() && (string.is8Bit() ? isSimpleDeclarationList(string.characters8(), string.length()) : isSimpleDeclarationList(string.characters16(), string.length()))) {
+        RefPtr<MutableStylePropertySet> declaration = MutableStylePropertySet::create(m_context.mode);
+        if (parseSimpleDeclarationList(declaration.get(), string, m_context))
+            return declaration->immutableCopyIfNeeded();
+    }
+
     setStyleSheet(contextStyleSheet);
 
     setupParser("@-webkit-decls{", string, "} ");
@@ -3047,6 +3106,7 @@ bool CSSParser::parseValue(CSSPropertyID propId, bool important)
     case CSSPropertyWebkitColumnBreakBefore:
     case CSSPropertyWebkitColumnBreakInside:
     case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWebkitContain:
     case CSSPropertyWebkitAlignContent:
     case CSSPropertyWebkitAlignItems:
     case CSSPropertyWebkitAlignSelf:
@@ -11580,6 +11640,7 @@ bool CSSParser::isLoggingErrors()
 void CSSParser::logError(const String& message, int lineNumber)
 {
     // FIXME: <http://webkit.org/b/114313> CSS Parser ConsoleMessage errors should include column numbers
+    m_styleSheet->parserSetDidLogParseErrors();
     PageConsole* console = m_styleSheet->singleOwnerDocument()->page()->console();
     console->addMessage(CSSMessageSource, WarningMessageLevel, message, m_styleSheet->baseURL().string(), lineNumber + 1, 0);
 }
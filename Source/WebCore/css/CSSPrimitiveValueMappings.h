@@ -4320,6 +4320,35 @@ template<> inline CSSPrimitiveValue::operator ColumnProgression() const
     return NormalColumnProgression;
 }
 
+template<> inline CSSPrimitiveValue::CSSPrimitiveValue(EContain e)
+    : CSSValue(PrimitiveClass)
+{
+    m_primitiveUnitType = CSS_VALUE_ID;
+    switch (e) {
+    case ContainNone:
+        m_value.valueID = CSSValueNone;
+        break;
+    case ContainStrict:
+        m_value.valueID = CSSValueStrict;
+        break;
+    }
+}
+
+template<> inline CSSPrimitiveValue::operator EContain() const
+{
+    switch (m_value.valueID) {
+    case CSSValueNone:
+        return ContainNone;
+    case CSSValueStrict:
+        return ContainStrict;
+    default:
+        break;
+    }
+
+    ASSERT_NOT_REACHED();
+    return ContainNone;
+}
+
 template<> inline CSSPrimitiveValue::CSSPrimitiveValue(WrapFlow wrapFlow)
 : CSSValue(PrimitiveClass)
 {
@@ -90,6 +90,12 @@ PassRefPtr<CSSStyleSheet> CSSStyleSheet::createInline(Node* ownerNode, const KUR
     return adoptRef(new CSSStyleSheet(sheet.release(), ownerNode, true));
 }
 
+PassRefPtr<CSSStyleSheet> CSSStyleSheet::createInline(PassRefPtr<StyleSheetContents> sheet, Node* ownerNode)
+{
+    ASSERT(sheet->isCacheable());
+    return adoptRef(new CSSStyleSheet(sheet, ownerNode, true));
+}
+
 CSSStyleSheet::CSSStyleSheet(PassRefPtr<StyleSheetContents> contents, CSSImportRule* ownerRule)
     : m_contents(contents)
     , m_isInlineStylesheet(false)
@@ -167,6 +167,18 @@ void ElementRuleCollector::collectMatchingRules(const MatchRequest& matchRequest
             collectMatchingRulesForList(matchRequest.ruleSet->classRules(styledElement->classNames()[i].impl()), matchRequest, ruleRange);
     }
 
+    if (matchRequest.ruleSet->hasAttributeRules() && element->hasAttributes()) {
+        // Attributes in different namespaces can share a local name, so make sure each bucket is only collected once.
+        bool isHTMLElement = element->isHTMLElement();
+        Vector<AtomicStringImpl*, 8> collectedAttributeNames;
+        for (unsigned i = 0; i < element->attributeCount(); ++i) {
+            AtomicStringImpl* attributeName = element->attributeItem(i)->localName().impl();
+            if (collectedAttributeNames.contains(attributeName))
+                continue;
+            collectedAttributeNames.append(attributeName);
+            collectMatchingRulesForList(isHTMLElement ? matchRequest.ruleSet->htmlAttributeRules(attributeName) : matchRequest.ruleSet->attributeRules(attributeName), matchRequest, ruleRange);
+        }
+    }
     if (element->isLink())
         collectMatchingRulesForList(matchRequest.ruleSet->linkPseudoClassRules(), matchRequest, ruleRange);
     if (SelectorChecker::matchesFocusPseudoClass(element))
@@ -177,55 +177,87 @@ void RuleSet::addToRuleSet(AtomicStringImpl* key, AtomRuleMap& map, const RuleDa
     rules->append(ruleData);
 }
 
-bool RuleSet::findBestRuleSetAndAdd(const CSSSelector* component, RuleData& ruleData)
+bool RuleSet::findBestRuleSetAndAdd(const CSSSelector* rightmostSelector, RuleData& ruleData)
 {
-    if (component->m_match == CSSSelector::Id) {
-        addToRuleSet(component->value().impl(), m_idRules, ruleData);
+    // Look at every simple selector of the rightmost compound selector, not just the first one,
+    // so that e.g. "[data-state].item" and ":focus.item" are filed under the narrowest bucket.
+    const CSSSelector* idSelector = 0;
+    const CSSSelector* classSelector = 0;
+    const CSSSelector* linkSelector = 0;
+    const CSSSelector* focusSelector = 0;
+    const CSSSelector* attributeSelector = 0;
+    const CSSSelector* tagSelector = 0;
+    for (const CSSSelector* component = rightmostSelector; component; component = component->tagHistory()) {
+        if (component->isCustomPseudoElement()) {
+            addToRuleSet(component->value().impl(), m_shadowPseudoElementRules, ruleData);
+            return true;
+        }
+#if ENABLE(VIDEO_TRACK)
+        if (component->pseudoType() == CSSSelector::PseudoCue) {
+            m_cuePseudoRules.append(ruleData);
+            return true;
+        }
+#endif
+        if (component->m_match == CSSSelector::Id) {
+            if (!idSelector)
+                idSelector = component;
+        } else if (component->m_match == CSSSelector::Class) {
+            if (!classSelector)
+                classSelector = component;
+        } else if (SelectorChecker::isCommonPseudoClassSelector(component)) {
+            switch (component->pseudoType()) {
+            case CSSSelector::PseudoLink:
+            case CSSSelector::PseudoVisited:
+            case CSSSelector::PseudoAnyLink:
+                if (!linkSelector)
+                    linkSelector = component;
+                break;
+            case CSSSelector::PseudoFocus:
+                if (!focusSelector)
+                    focusSelector = component;
+                break;
+            default:
+                ASSERT_NOT_REACHED();
+            }
+        } else if (component->isAttributeSelector()) {
+            if (!attributeSelector)
+                attributeSelector = component;
+        } else if (component->m_match == CSSSelector::Tag) {
+            if (!tagSelector && component->tagQName().localName() != starAtom)
+                tagSelector = component;
+        }
+
+        if (component->relation() != CSSSelector::SubSelector)
+            break;
+    }
+
+    if (idSelector) {
+        addToRuleSet(idSelector->value().impl(), m_idRules, ruleData);
         return true;
     }
-    if (component->m_match == CSSSelector::Class) {
-        addToRuleSet(component->value().impl(), m_classRules, ruleData);
+    if (classSelector) {
+        addToRuleSet(classSelector->value().impl(), m_classRules, ruleData);
         return true;
     }
-    if (component->isCustomPseudoElement()) {
-        addToRuleSet(component->value().impl(), m_shadowPseudoElementRules, ruleData);
+    if (linkSelector) {
+        m_linkPseudoClassRules.append(ruleData);
         return true;
     }
-#if ENABLE(VIDEO_TRACK)
-    if (component->pseudoType() == CSSSelector::PseudoCue) {
-        m_cuePseudoRules.append(ruleData);
+    if (focusSelector) {
+        m_focusPseudoClassRules.append(ruleData);
         return true;
     }
-#endif
-    if (SelectorChecker::isCommonPseudoClassSelector(component)) {
-        switch (component->pseudoType()) {
-        case CSSSelector::PseudoLink:
-        case CSSSelector::PseudoVisited:
-        case CSSSelector::PseudoAnyLink:
-            m_linkPseudoClassRules.append(ruleData);
-            return true;
-        case CSSSelector::PseudoFocus:
-            m_focusPseudoClassRules.append(ruleData);
-            return true;
-        default:
-            ASSERT_NOT_REACHED();
-            return true;
-        }
+    if (attributeSelector) {
+        // Attribute names are matched case-insensitively on HTML elements and exactly on other elements.
+        // Filing the rule under both names lets ElementRuleCollector look buckets up with the attribute's
+        // own local name, without lowercasing it for every element it styles.
+        addToRuleSet(attributeSelector->attributeCanonicalLocalName().impl(), m_htmlAttributeRules, ruleData);
+        addToRuleSet(attributeSelector->attribute().localName().impl(), m_attributeRules, ruleData);
+        return true;
     }
-
-    if (component->m_match == CSSSelector::Tag) {
-        // If this is part of a subselector chain, recurse ahead to find a narrower set (ID/class/:pseudo)
-        if (component->relation() == CSSSelector::SubSelector) {
-            const CSSSelector* nextComponent = component->tagHistory();
-            if (nextComponent->m_match == CSSSelector::Class || nextComponent->m_match == CSSSelector::Id || SelectorChecker::isCommonPseudoClassSelector(nextComponent)) {
-                if (findBestRuleSetAndAdd(nextComponent, ruleData))
-                    return true;
-            }
-        }
-        if (component->tagQName().localName() != starAtom) {
-            addToRuleSet(component->tagQName().localName().impl(), m_tagRules, ruleData);
-            return true;
-        }
+    if (tagSelector) {
+        addToRuleSet(tagSelector->tagQName().localName().impl(), m_tagRules, ruleData);
+        return true;
     }
     return false;
 }
@@ -363,6 +395,8 @@ void RuleSet::shrinkToFit()
     shrinkMapVectorsToFit(m_idRules);
     shrinkMapVectorsToFit(m_classRules);
     shrinkMapVectorsToFit(m_tagRules);
+    shrinkMapVectorsToFit(m_htmlAttributeRules);
+    shrinkMapVectorsToFit(m_attributeRules);
     shrinkMapVectorsToFit(m_shadowPseudoElementRules);
     m_linkPseudoClassRules.shrinkToFit();
 #if ENABLE(VIDEO_TRACK)
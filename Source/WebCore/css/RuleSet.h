@@ -125,6 +125,10 @@ public:
     const Vector<RuleData>* idRules(AtomicStringImpl* key) const { return m_idRules.get(key); }
     const Vector<RuleData>* classRules(AtomicStringImpl* key) const { return m_classRules.get(key); }
     const Vector<RuleData>* tagRules(AtomicStringImpl* key) const { return m_tagRules.get(key); }
+    // Keyed on the lowercased attribute name for HTML elements and on the exact name for other elements.
+    const Vector<RuleData>* htmlAttributeRules(AtomicStringImpl* key) const { return m_htmlAttributeRules.get(key); }
+    const Vector<RuleData>* attributeRules(AtomicStringImpl* key) const { return m_attributeRules.get(key); }
+    bool hasAttributeRules() const { return !m_attributeRules.isEmpty(); }
     const Vector<RuleData>* shadowPseudoElementRules(AtomicStringImpl* key) const { return m_shadowPseudoElementRules.get(key); }
     const Vector<RuleData>* linkPseudoClassRules() const { return &m_linkPseudoClassRules; }
 #if ENABLE(VIDEO_TRACK)
@@ -144,6 +148,8 @@ public:
     AtomRuleMap m_idRules;
     AtomRuleMap m_classRules;
     AtomRuleMap m_tagRules;
+    AtomRuleMap m_htmlAttributeRules;
+    AtomRuleMap m_attributeRules;
     AtomRuleMap m_shadowPseudoElementRules;
     Vector<RuleData> m_linkPseudoClassRules;
 #if ENABLE(VIDEO_TRACK)
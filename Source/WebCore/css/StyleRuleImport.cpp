@@ -28,6 +28,7 @@
 #include "CachedResourceRequest.h"
 #include "CachedResourceRequestInitiators.h"
 #include "Document.h"
+#include "HTMLResourcePreloader.h"
 #include "SecurityOrigin.h"
 #include "StyleSheetContents.h"
 #include <wtf/StdLibExtras.h>
@@ -60,6 +61,16 @@ StyleRuleImport::~StyleRuleImport()
         m_cachedSheet->removeClient(&m_styleSheetClient);
 }
 
+void StyleRuleImport::preloadSubresources(PreloadRequestStream& requests)
+{
+    Document* document = m_parentStyleSheet ? m_parentStyleSheet->singleOwnerDocument() : 0;
+    // Preloads are only picked up until the document finishes parsing.
+    if (!document || !document->parsing())
+        return;
+    HTMLResourcePreloader preloader(document);
+    preloader.takeAndPreload(requests);
+}
+
 void StyleRuleImport::setCSSStyleSheet(const String& href, const KURL& baseURL, const String& charset, const CachedCSSStyleSheet* cachedStyleSheet)
 {
     if (m_styleSheet)
@@ -62,11 +62,16 @@ private:
         {
             m_ownerRule->setCSSStyleSheet(href, baseURL, charset, sheet);
         }
+        virtual void preloadSubresources(PreloadRequestStream& requests)
+        {
+            m_ownerRule->preloadSubresources(requests);
+        }
     private:
         StyleRuleImport* m_ownerRule;
     };
 
     void setCSSStyleSheet(const String& href, const KURL& baseURL, const String& charset, const CachedCSSStyleSheet*);
+    void preloadSubresources(PreloadRequestStream&);
     friend class ImportedStyleSheetClient;
 
     StyleRuleImport(const String& href, PassRefPtr<MediaQuerySet>);
@@ -65,6 +65,7 @@ StyleSheetContents::StyleSheetContents(StyleRuleImport* ownerRule, const String&
     , m_usesRemUnits(false)
     , m_isMutable(false)
     , m_isInMemoryCache(false)
+    , m_didLogParseErrors(false)
     , m_parserContext(context)
 {
 }
@@ -84,6 +85,7 @@ StyleSheetContents::StyleSheetContents(const StyleSheetContents& o)
     , m_usesRemUnits(o.m_usesRemUnits)
     , m_isMutable(false)
     , m_isInMemoryCache(false)
+    , m_didLogParseErrors(o.m_didLogParseErrors)
     , m_parserContext(o.m_parserContext)
 {
     ASSERT(o.isCacheable());
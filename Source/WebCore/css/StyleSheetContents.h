@@ -92,6 +92,8 @@ public:
     void parserAppendRule(PassRefPtr<StyleRuleBase>);
     void parserSetEncodingFromCharsetRule(const String& encoding); 
     void parserSetUsesRemUnits(bool b) { m_usesRemUnits = b; }
+    void parserSetDidLogParseErrors() { m_didLogParseErrors = true; }
+    bool didLogParseErrors() const { return m_didLogParseErrors; }
 
     void clearRules();
 
@@ -161,6 +163,7 @@ private:
     bool m_usesRemUnits : 1;
     bool m_isMutable : 1;
     bool m_isInMemoryCache : 1;
+    bool m_didLogParseErrors : 1;
     
     CSSParserContext m_parserContext;
 
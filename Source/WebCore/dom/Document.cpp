@@ -390,6 +390,8 @@ uint64_t Document::s_globalTreeVersion = 0;
 
 static const double timeBeforeThrowingAwayStyleResolverAfterLastUseInSeconds = 30;
 
+static const int timeToKeepSharedObjectPoolAliveAfterParsingFinishedInSeconds = 10;
+
 Document::Document(Frame* frame, const KURL& url, unsigned documentClasses)
     : ContainerNode(0, CreateDocument)
     , TreeScope(this)
@@ -634,6 +636,8 @@ void Document::dispose()
     m_documentElement = 0;
     m_contextFeatures = ContextFeatures::defaultSwitch();
     m_userActionElements.documentDidRemoveLastRef();
+    // Cached querySelectorAll() results hold on to elements.
+    m_selectorQueryCache.clear();
 #if ENABLE(FULLSCREEN_API)
     m_fullScreenElement = 0;
     m_fullScreenElementStack.clear();
@@ -1903,6 +1907,13 @@ void Document::updateLayout()
 // to instead suspend JavaScript execution.
 void Document::updateLayoutIgnorePendingStylesheets()
 {
+    updateLayoutIgnorePendingStylesheetsForNode(this);
+}
+
+void Document::updateLayoutIgnorePendingStylesheetsForNode(Node* node)
+{
+    ASSERT(node->document() == this);
+
     bool oldIgnore = m_ignorePendingStylesheets;
     
     if (!haveStylesheetsLoaded()) {
@@ -1926,6 +1937,12 @@ void Document::updateLayoutIgnorePendingStylesheets()
 
     updateLayout();
 
+    // Script asking for geometry must see the table rows it reads from laid out, not only those near the viewport.
+    if (renderView() && renderView()->hasTableSectionsWithDeferredRows() && node->renderer()) {
+        renderView()->setNeedsLayoutForDeferredTableRows(node->renderer());
+        updateLayout();
+    }
+
     m_ignorePendingStylesheets = oldIgnore;
 }
 
@@ -4429,7 +4446,6 @@ void Document::finishedParsing()
     // so that dynamically inserted content can also benefit from sharing optimizations.
     // Note that we don't refresh the timer on pool access since that could lead to huge caches being kept
     // alive indefinitely by something innocuous like JS setting .innerHTML repeatedly on a timer.
-    static const int timeToKeepSharedObjectPoolAliveAfterParsingFinishedInSeconds = 10;
     m_sharedObjectPoolClearTimer.startOneShot(timeToKeepSharedObjectPoolAliveAfterParsingFinishedInSeconds);
 
     // Parser should have picked up all preloads by now
@@ -4441,6 +4457,17 @@ void Document::sharedObjectPoolClearTimerFired(Timer<Document>*)
     m_sharedObjectPool.clear();
 }
 
+DocumentSharedObjectPool* Document::ensureSharedObjectPool()
+{
+    if (!m_sharedObjectPool) {
+        m_sharedObjectPool = DocumentSharedObjectPool::create();
+        // A pool created after parsing finished lives as long as the one kept after parsing.
+        if (!m_bParsing)
+            m_sharedObjectPoolClearTimer.startOneShot(timeToKeepSharedObjectPoolAliveAfterParsingFinishedInSeconds);
+    }
+    return m_sharedObjectPool.get();
+}
+
 void Document::didAccessStyleResolver()
 {
     m_styleResolverThrowawayTimer.restart();
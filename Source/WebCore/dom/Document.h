@@ -515,6 +515,9 @@ public:
     void updateStyleIfNeeded();
     void updateLayout();
     void updateLayoutIgnorePendingStylesheets();
+    // Of the table rows left unlaid out far from the viewport, only lays out those holding the node
+    // or inside it. For callers that read the geometry or text of a single node.
+    void updateLayoutIgnorePendingStylesheetsForNode(Node*);
     PassRefPtr<RenderStyle> styleForElementIgnoringPendingStylesheets(Element*);
     PassRefPtr<RenderStyle> styleForPage(int pageIndex);
 
@@ -1160,6 +1163,9 @@ public:
     ContextFeatures* contextFeatures() { return m_contextFeatures.get(); }
 
     DocumentSharedObjectPool* sharedObjectPool() { return m_sharedObjectPool.get(); }
+    // Creates the pool for parsers that run after the document has finished parsing, such as
+    // the fragment parser behind innerHTML.
+    DocumentSharedObjectPool* ensureSharedObjectPool();
 
     void didRemoveAllPendingStylesheet();
     void setNeedsNotifyRemoveAllPendingStylesheet() { m_needsNotifyRemoveAllPendingStylesheet = true; }
@@ -31,6 +31,7 @@
 #include "NodeTraversal.h"
 #include "Range.h"
 #include "RenderObject.h"
+#include "RenderText.h"
 #include "RenderedDocumentMarker.h"
 #include "TextIterator.h"
 #include <stdio.h>
@@ -51,6 +52,13 @@ DocumentMarkerController::~DocumentMarkerController()
 {
 }
 
+bool DocumentMarkerController::hasMarkers(Node* node)
+{
+    if (!possiblyHasMarkers(DocumentMarker::AllMarkers()))
+        return false;
+    return m_markers.contains(node);
+}
+
 void DocumentMarkerController::detach()
 {
     m_markers.clear();
@@ -178,8 +186,12 @@ void DocumentMarkerController::addMarker(Node* node, const DocumentMarker& newMa
     }
 
     // repaint the affected node
-    if (node->renderer())
-        node->renderer()->repaint();
+    if (RenderObject* renderer = node->renderer()) {
+        // Markers are painted by InlineTextBox, so the simple line layout cannot show them.
+        if (renderer->isText())
+            toRenderText(renderer)->ensureLineBoxes();
+        renderer->repaint();
+    }
 }
 
 // copies markers from srcNode to dstNode, applying the specified shift delta to the copies.  The shift is
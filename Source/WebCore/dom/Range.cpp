@@ -1894,7 +1894,7 @@ PassRefPtr<ClientRectList> Range::getClientRects() const
     if (!m_start.container())
         return ClientRectList::create();
 
-    m_ownerDocument->updateLayoutIgnorePendingStylesheets();
+    m_ownerDocument->updateLayoutIgnorePendingStylesheetsForNode(commonAncestorContainer(m_start.container(), m_end.container()));
 
     Vector<FloatQuad> quads;
     getBorderAndTextQuads(quads);
@@ -1954,7 +1954,7 @@ FloatRect Range::boundingRect() const
     if (!m_start.container())
         return FloatRect();
 
-    m_ownerDocument->updateLayoutIgnorePendingStylesheets();
+    m_ownerDocument->updateLayoutIgnorePendingStylesheetsForNode(commonAncestorContainer(m_start.container(), m_end.container()));
 
     Vector<FloatQuad> quads;
     getBorderAndTextQuads(quads);
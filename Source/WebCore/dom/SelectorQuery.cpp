@@ -150,6 +150,48 @@ ALWAYS_INLINE void SelectorDataList::executeFastPathForIdSelector(const Node* ro
         matchedElements.append(element);
 }
 
+// When a compound selector to the left of the rightmost one has an id that is unique in the tree scope,
+// every match has to be inside the element with that id (or inside its parent for sibling combinators),
+// so the traversal can start there instead of at the root node.
+static const Node* filterRootById(const Node* rootNode, const CSSSelector* firstSelector)
+{
+    if (!rootNode->inDocument())
+        return rootNode;
+    if (rootNode->document()->inQuirksMode())
+        return rootNode;
+
+    // Skip the rightmost compound selector, it has no id or the id fast path would have been taken.
+    const CSSSelector* selector = firstSelector;
+    while (selector->relation() == CSSSelector::SubSelector)
+        selector = selector->tagHistory();
+    CSSSelector::Relation relation = selector->relation();
+    selector = selector->tagHistory();
+
+    bool inAdjacentChain = relation == CSSSelector::DirectAdjacent || relation == CSSSelector::IndirectAdjacent;
+    for (; selector; selector = selector->tagHistory()) {
+        if (relation == CSSSelector::ShadowDescendant)
+            return rootNode;
+        if (selector->m_match == CSSSelector::Id) {
+            const AtomicString& idToMatch = selector->value();
+            if (!rootNode->treeScope()->containsMultipleElementsWithId(idToMatch)) {
+                const Node* searchRoot = rootNode->treeScope()->getElementById(idToMatch);
+                if (searchRoot && inAdjacentChain)
+                    searchRoot = searchRoot->parentNode();
+                if (searchRoot && (isTreeScopeRoot(rootNode) || searchRoot == rootNode || searchRoot->isDescendantOf(rootNode)))
+                    return searchRoot;
+            }
+        }
+        if (selector->relation() == CSSSelector::SubSelector)
+            continue;
+        relation = selector->relation();
+        if (relation == CSSSelector::DirectAdjacent || relation == CSSSelector::IndirectAdjacent)
+            inAdjacentChain = true;
+        else
+            inAdjacentChain = false;
+    }
+    return rootNode;
+}
+
 static bool isSingleTagNameSelector(const CSSSelector* selector)
 {
     return selector->isLastInTagHistory() && selector->m_match == CSSSelector::Tag;
@@ -240,7 +282,8 @@ ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const Node* rootN
 {
     ASSERT(m_selectors.size() == 1);
 
-    for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
+    const Node* searchRoot = filterRootById(rootNode, selectorData.selector);
+    for (Element* element = ElementTraversal::firstWithin(searchRoot); element; element = ElementTraversal::next(element, searchRoot)) {
         if (selectorMatches(selectorData, element, rootNode)) {
             matchedElements.append(element);
             if (firstMatchOnly)
@@ -283,12 +326,68 @@ ALWAYS_INLINE void SelectorDataList::execute(Node* rootNode, Vector<RefPtr<Node>
     executeSingleMultiSelectorData<firstMatchOnly>(rootNode, matchedElements);
 }
 
+static bool resultDependsOnlyOnDOMTree(const CSSSelectorList& selectorList)
+{
+    for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
+        for (const CSSSelector* component = selector; component; component = component->tagHistory()) {
+            if (component->m_match != CSSSelector::Tag && component->m_match != CSSSelector::Id && component->m_match != CSSSelector::Class)
+                return false;
+            if (component->relation() == CSSSelector::ShadowDescendant)
+                return false;
+        }
+    }
+    return true;
+}
+
 SelectorQuery::SelectorQuery(const CSSSelectorList& selectorList)
     : m_selectorList(selectorList)
+    , m_resultDependsOnlyOnDOMTree(resultDependsOnlyOnDOMTree(m_selectorList))
+    , m_cachedResultRootNode(0)
+    , m_cachedResultDOMTreeVersion(0)
 {
     m_selectors.initialize(m_selectorList);
 }
 
+bool SelectorQuery::canUseCachedResult(Node* rootNode) const
+{
+    if (!m_resultDependsOnlyOnDOMTree || !rootNode->inDocument())
+        return false;
+#if ENABLE(SVG)
+    // SMIL can animate the class attribute without going through Element::attributeChanged().
+    if (rootNode->document()->svgExtensions())
+        return false;
+#endif
+    return true;
+}
+
+PassRefPtr<NodeList> SelectorQuery::queryAll(Node* rootNode) const
+{
+    if (!canUseCachedResult(rootNode))
+        return m_selectors.queryAll(rootNode);
+
+    // Any insertion, removal or attribute change bumps the version. The root has to be in the document,
+    // so it cannot have been destroyed and replaced by another node at the same address while it matches.
+    uint64_t domTreeVersion = rootNode->document()->domTreeVersion();
+    if (m_cachedResultRootNode != rootNode || m_cachedResultDOMTreeVersion != domTreeVersion) {
+        RefPtr<NodeList> result = m_selectors.queryAll(rootNode);
+        unsigned length = result->length();
+        m_cachedResult.clear();
+        m_cachedResult.reserveCapacity(length);
+        for (unsigned i = 0; i < length; ++i)
+            m_cachedResult.uncheckedAppend(toElement(result->item(i)));
+        m_cachedResultRootNode = rootNode;
+        m_cachedResultDOMTreeVersion = domTreeVersion;
+        return result.release();
+    }
+
+    // Every call still returns a new NodeList, as the DOM requires.
+    Vector<RefPtr<Node> > nodes;
+    nodes.reserveInitialCapacity(m_cachedResult.size());
+    for (size_t i = 0; i < m_cachedResult.size(); ++i)
+        nodes.uncheckedAppend(m_cachedResult[i]);
+    return StaticNodeList::adopt(nodes);
+}
+
 SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, Document* document, ExceptionCode& ec)
 {
     HashMap<AtomicString, OwnPtr<SelectorQuery> >::iterator it = m_entries.find(selectors);
@@ -30,6 +30,7 @@
 #include "NodeList.h"
 #include <wtf/HashMap.h>
 #include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
 #include <wtf/Vector.h>
 #include <wtf/text/AtomicStringHash.h>
 
@@ -79,8 +80,19 @@ public:
     PassRefPtr<NodeList> queryAll(Node* rootNode) const;
     PassRefPtr<Element> queryFirst(Node* rootNode) const;
 private:
+    bool canUseCachedResult(Node* rootNode) const;
+
     SelectorDataList m_selectors;
     CSSSelectorList m_selectorList;
+
+    // Selectors that only depend on tag names, ids, classes and tree structure give the same result
+    // until the DOM tree version changes, so the last queryAll() result is kept around. The root is
+    // only compared, never dereferenced. It is not a RefPtr, as it is often the document that owns
+    // this query, which would then never be destroyed.
+    bool m_resultDependsOnlyOnDOMTree;
+    mutable const Node* m_cachedResultRootNode;
+    mutable uint64_t m_cachedResultDOMTreeVersion;
+    mutable Vector<RefPtr<Element> > m_cachedResult;
 };
 
 class SelectorQueryCache {
@@ -98,11 +110,6 @@ inline bool SelectorQuery::matches(Element* element) const
     return m_selectors.matches(element);
 }
 
-inline PassRefPtr<NodeList> SelectorQuery::queryAll(Node* rootNode) const
-{
-    return m_selectors.queryAll(rootNode);
-}
-
 inline PassRefPtr<Element> SelectorQuery::queryFirst(Node* rootNode) const
 {
     return m_selectors.queryFirst(rootNode);
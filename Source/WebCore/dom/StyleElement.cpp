@@ -30,7 +30,10 @@
 #include "MediaQueryEvaluator.h"
 #include "ScriptableDocumentParser.h"
 #include "StyleSheetContents.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringHash.h>
 #include <wtf/text/TextPosition.h>
 
 namespace WebCore {
@@ -47,6 +50,92 @@ static bool isCSS(Element* element, const AtomicString& type)
     return type.isEmpty() || (element->isHTMLElement() ? equalIgnoringCase(type, "text/css") : (type == "text/css"));
 }
 
+// Pages built from templates tend to repeat the same <style> blocks in every document and frame.
+// Parsed contents are shared between them as long as the parser context matches, the same way
+// CachedCSSStyleSheet shares the contents of linked style sheets. Entries are keyed on the start
+// line as well as the text, so that rules and parse errors keep the line numbers of the element.
+static const unsigned maximumInlineStyleSheetContentsCacheSize = 50;
+
+typedef std::pair<String, int> InlineStyleSheetKey;
+
+struct InlineStyleSheetCacheEntry {
+    RefPtr<StyleSheetContents> contents;
+    // Sheets created by the parser report parse errors to the console. Contents parsed for a
+    // script-created sheet were not checked for errors, so they are not shared with parser-created ones.
+    bool createdByParser;
+};
+
+typedef HashMap<InlineStyleSheetKey, InlineStyleSheetCacheEntry> InlineStyleSheetContentsCache;
+typedef ListHashSet<InlineStyleSheetKey> InlineStyleSheetUseOrder;
+
+static InlineStyleSheetContentsCache& inlineStyleSheetContentsCache()
+{
+    DEFINE_STATIC_LOCAL(InlineStyleSheetContentsCache, cache, ());
+    return cache;
+}
+
+// Least recently used first.
+static InlineStyleSheetUseOrder& inlineStyleSheetUseOrder()
+{
+    DEFINE_STATIC_LOCAL(InlineStyleSheetUseOrder, useOrder, ());
+    return useOrder;
+}
+
+static PassRefPtr<StyleSheetContents> restoreInlineStyleSheetContents(const InlineStyleSheetKey& key, const CSSParserContext& context, bool createdByParser)
+{
+    InlineStyleSheetContentsCache::iterator it = inlineStyleSheetContentsCache().find(key);
+    if (it == inlineStyleSheetContentsCache().end())
+        return 0;
+
+    RefPtr<StyleSheetContents> contents = it->value.contents;
+    ASSERT(contents->isCacheable());
+    ASSERT(contents->isInMemoryCache());
+
+    // Contexts must be identical so we know we would get the same exact result if we parsed again.
+    if (contents->parserContext() != context)
+        return 0;
+    if (createdByParser && !it->value.createdByParser)
+        return 0;
+
+    inlineStyleSheetUseOrder().appendOrMoveToLast(key);
+    return contents.release();
+}
+
+static void removeInlineStyleSheetContents(InlineStyleSheetContentsCache::iterator it)
+{
+    it->value.contents->removedFromMemoryCache();
+    inlineStyleSheetUseOrder().remove(it->key);
+    inlineStyleSheetContentsCache().remove(it);
+}
+
+static void saveInlineStyleSheetContents(const InlineStyleSheetKey& key, StyleSheetContents* contents, bool createdByParser)
+{
+    ASSERT(contents->isCacheable());
+
+    InlineStyleSheetContentsCache& cache = inlineStyleSheetContentsCache();
+    InlineStyleSheetContentsCache::iterator it = cache.find(key);
+    if (it != cache.end())
+        removeInlineStyleSheetContents(it);
+    else if (cache.size() >= maximumInlineStyleSheetContentsCacheSize)
+        removeInlineStyleSheetContents(cache.find(inlineStyleSheetUseOrder().first()));
+
+    contents->addedToMemoryCache();
+    InlineStyleSheetCacheEntry entry;
+    entry.contents = contents;
+    entry.createdByParser = createdByParser;
+    cache.add(key, entry);
+    inlineStyleSheetUseOrder().add(key);
+}
+
+void StyleElement::clearInlineStyleSheetContentsCache()
+{
+    InlineStyleSheetContentsCache& cache = inlineStyleSheetContentsCache();
+    for (InlineStyleSheetContentsCache::iterator it = cache.begin(); it != cache.end(); ++it)
+        it->value.contents->removedFromMemoryCache();
+    cache.clear();
+    inlineStyleSheetUseOrder().clear();
+}
+
 StyleElement::StyleElement(Document* document, bool createdByParser)
     : m_createdByParser(createdByParser)
     , m_loading(false)
@@ -171,6 +260,22 @@ void StyleElement::createSheet(Element* e, WTF::OrdinalNumber startLineNumber, c
             document->styleSheetCollection()->addPendingSheet();
             m_loading = true;
 
+            CSSParserContext parserContext(document, KURL(), document->inputEncoding());
+            RefPtr<StyleSheetContents> restoredContents = text.isEmpty() ? 0 : restoreInlineStyleSheetContents(InlineStyleSheetKey(text, startLineNumber.zeroBasedInt()), parserContext, m_createdByParser);
+            if (restoredContents) {
+                ASSERT(!restoredContents->isLoading());
+
+                m_sheet = CSSStyleSheet::createInline(restoredContents.release(), e);
+                m_sheet->setMediaQueries(mediaQueries.release());
+                m_sheet->setTitle(e->title());
+
+                m_loading = false;
+                // Shared contents have several clients, so they cannot report the load to a single owner node themselves.
+                if (e->sheetLoaded())
+                    e->notifyLoadedSheetAndAllCriticalSubresources(false);
+                return;
+            }
+
             m_sheet = CSSStyleSheet::createInline(e, KURL(), document->inputEncoding());
             m_sheet->setMediaQueries(mediaQueries.release());
             m_sheet->setTitle(e->title());
@@ -180,8 +285,15 @@ void StyleElement::createSheet(Element* e, WTF::OrdinalNumber startLineNumber, c
         }
     }
 
-    if (m_sheet)
-        m_sheet->contents()->checkLoaded();
+    if (!m_sheet)
+        return;
+
+    RefPtr<StyleSheetContents> contents = m_sheet->contents();
+    contents->checkLoaded();
+
+    // Restoring a sheet does not report its parse errors again, so sheets that had some are not shared.
+    if (!text.isEmpty() && contents->isCacheable() && !contents->isInMemoryCache() && !contents->didLogParseErrors())
+        saveInlineStyleSheetContents(InlineStyleSheetKey(text, startLineNumber.zeroBasedInt()), contents.get(), m_createdByParser);
 }
 
 bool StyleElement::isLoading() const
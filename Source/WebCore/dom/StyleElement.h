@@ -34,6 +34,9 @@ public:
     StyleElement(Document*, bool createdByParser);
     virtual ~StyleElement();
 
+    // Drops the parsed contents of inline style sheets kept for reuse, e.g. under memory pressure.
+    static void clearInlineStyleSheetContentsCache();
+
 protected:
     virtual const AtomicString& type() const = 0;
     virtual const AtomicString& media() const = 0;
@@ -518,6 +518,7 @@ bool TextIterator::handleTextNode()
         return true;
     }
 
+    renderer->ensureLineBoxes();
     if (renderer->firstTextBox())
         m_textBox = renderer->firstTextBox();
 
@@ -1253,6 +1254,7 @@ bool SimplifiedBackwardsTextIterator::handleTextNode()
     if (!renderer)
         return true;
 
+    renderer->ensureLineBoxes();
     String text = renderer->text();
     if (!renderer->firstTextBox() && text.length() > 0)
         return true;
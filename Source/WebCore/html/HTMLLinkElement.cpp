@@ -41,6 +41,7 @@
 #include "FrameView.h"
 #include "HTMLNames.h"
 #include "HTMLParserIdioms.h"
+#include "HTMLResourcePreloader.h"
 #include "MediaList.h"
 #include "MediaQueryEvaluator.h"
 #include "Page.h"
@@ -289,6 +290,15 @@ void HTMLLinkElement::finishParsingChildren()
     HTMLElement::finishParsingChildren();
 }
 
+void HTMLLinkElement::preloadSubresources(PreloadRequestStream& requests)
+{
+    // Preloads are only picked up until the document finishes parsing.
+    if (!inDocument() || !document()->parsing())
+        return;
+    HTMLResourcePreloader preloader(document());
+    preloader.takeAndPreload(requests);
+}
+
 void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL, const String& charset, const CachedCSSStyleSheet* cachedStyleSheet)
 {
     if (!inDocument()) {
@@ -39,6 +39,7 @@ LinkRelAttribute::LinkRelAttribute()
     , m_iconType(InvalidIcon)
     , m_isAlternate(false)
     , m_isDNSPrefetch(false)
+    , m_isPreconnect(false)
 #if ENABLE(LINK_PREFETCH)
     , m_isLinkPrefetch(false)
     , m_isLinkSubresource(false)
@@ -51,6 +52,7 @@ LinkRelAttribute::LinkRelAttribute(const String& rel)
     , m_iconType(InvalidIcon)
     , m_isAlternate(false)
     , m_isDNSPrefetch(false)
+    , m_isPreconnect(false)
 #if ENABLE(LINK_PREFETCH)
     , m_isLinkPrefetch(false)
     , m_isLinkSubresource(false)
@@ -68,6 +70,8 @@ LinkRelAttribute::LinkRelAttribute(const String& rel)
 #endif
     else if (equalIgnoringCase(rel, "dns-prefetch"))
         m_isDNSPrefetch = true;
+    else if (equalIgnoringCase(rel, "preconnect"))
+        m_isPreconnect = true;
     else if (equalIgnoringCase(rel, "alternate stylesheet") || equalIgnoringCase(rel, "stylesheet alternate")) {
         m_isStyleSheet = true;
         m_isAlternate = true;
@@ -85,6 +89,10 @@ LinkRelAttribute::LinkRelAttribute(const String& rel)
                 m_isAlternate = true;
             else if (equalIgnoringCase(*it, "icon"))
                 m_iconType = Favicon;
+            else if (equalIgnoringCase(*it, "dns-prefetch"))
+                m_isDNSPrefetch = true;
+            else if (equalIgnoringCase(*it, "preconnect"))
+                m_isPreconnect = true;
 #if ENABLE(TOUCH_ICON_LOADING)
             else if (equalIgnoringCase(*it, "apple-touch-icon"))
                 m_iconType = TouchIcon;
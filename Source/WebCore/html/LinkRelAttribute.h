@@ -42,6 +42,7 @@ public:
     IconType m_iconType;
     bool m_isAlternate;
     bool m_isDNSPrefetch;
+    bool m_isPreconnect;
 #if ENABLE(LINK_PREFETCH)
     bool m_isLinkPrefetch;
     bool m_isLinkSubresource;
@@ -82,10 +82,18 @@ public:
         return m_attributes;
     }
 
-    const UChar* characters() const
+    const LChar* characters8() const
     {
         ASSERT(m_type == HTMLToken::Character);
-        return m_externalCharacters;
+        ASSERT(m_isAll8BitData);
+        return m_externalCharacters8;
+    }
+
+    const UChar* characters16() const
+    {
+        ASSERT(m_type == HTMLToken::Character);
+        ASSERT(!m_isAll8BitData);
+        return m_externalCharacters16;
     }
 
     size_t charactersLength() const
@@ -146,9 +154,12 @@ public:
                 m_data = String(token.comment());
             break;
         case HTMLToken::Character:
-            m_externalCharacters = token.characters().data();
-            m_externalCharactersLength = token.characters().size();
             m_isAll8BitData = token.isAll8BitData();
+            if (m_isAll8BitData)
+                m_externalCharacters8 = token.characters8().data();
+            else
+                m_externalCharacters16 = token.characters16().data();
+            m_externalCharactersLength = token.charactersLength();
             break;
         }
     }
@@ -191,14 +202,15 @@ public:
             break;
         case HTMLToken::Character: {
             const String& string = token.data().asString();
-            m_externalCharacters = string.characters();
-            m_externalCharactersLength = string.length();
-            m_isAll8BitData = token.isAll8BitData();
-            // FIXME: We would like a stronger ASSERT here:
-            // ASSERT(string.is8Bit() == token.isAll8BitData());
-            // but currently that fires, likely due to bugs in HTMLTokenizer
-            // not setting isAll8BitData in all the times it could.
+            // Use the characters of the string directly. String::characters() would make a
+            // widened copy of an 8-bit string that lives as long as the string does.
             ASSERT(!token.isAll8BitData() || string.is8Bit());
+            m_isAll8BitData = string.is8Bit();
+            if (m_isAll8BitData)
+                m_externalCharacters8 = string.characters8();
+            else
+                m_externalCharacters16 = string.characters16();
+            m_externalCharactersLength = string.length();
             break;
         }
         }
@@ -208,7 +220,8 @@ public:
 
     explicit AtomicHTMLToken(HTMLToken::Type type)
         : m_type(type)
-        , m_externalCharacters(0)
+        , m_externalCharacters8(0)
+        , m_externalCharacters16(0)
         , m_externalCharactersLength(0)
         , m_isAll8BitData(false)
         , m_selfClosing(false)
@@ -218,7 +231,8 @@ public:
     AtomicHTMLToken(HTMLToken::Type type, const AtomicString& name, const Vector<Attribute>& attributes = Vector<Attribute>())
         : m_type(type)
         , m_name(name)
-        , m_externalCharacters(0)
+        , m_externalCharacters8(0)
+        , m_externalCharacters16(0)
         , m_externalCharactersLength(0)
         , m_isAll8BitData(false)
         , m_selfClosing(false)
@@ -251,7 +265,8 @@ private:
     //
     // FIXME: Add a mechanism for "internalizing" the characters when the
     //        HTMLToken is destructed.
-    const UChar* m_externalCharacters;
+    const LChar* m_externalCharacters8;
+    const UChar* m_externalCharacters16;
     size_t m_externalCharactersLength;
     bool m_isAll8BitData;
 
@@ -84,7 +84,10 @@ BackgroundHTMLParser::BackgroundHTMLParser(PassRefPtr<WeakReference<BackgroundHT
     , m_pendingTokens(adoptPtr(new CompactHTMLTokenStream))
     , m_xssAuditor(config->xssAuditor.release())
     , m_preloadScanner(config->preloadScanner.release())
+    , m_decoder(config->decoder.release())
 {
+    if (m_decoder)
+        m_lastReportedEncoding = m_decoder->encoding();
 }
 
 void BackgroundHTMLParser::append(const String& input)
@@ -94,6 +97,38 @@ void BackgroundHTMLParser::append(const String& input)
     pumpTokenizer();
 }
 
+void BackgroundHTMLParser::appendBytes(PassOwnPtr<Vector<char> > buffer)
+{
+    // The main thread only sends bytes to a parser that was created with a decoder.
+    ASSERT(m_decoder);
+    if (!m_decoder)
+        return;
+    appendDecodedBytes(m_decoder->decode(buffer->data(), buffer->size()));
+}
+
+void BackgroundHTMLParser::flush()
+{
+    if (!m_decoder)
+        return;
+    appendDecodedBytes(m_decoder->flush());
+}
+
+void BackgroundHTMLParser::appendDecodedBytes(const String& input)
+{
+    // The decoder can settle on a different encoding once it has seen a BOM or a <meta charset>.
+    // The document's own decoder lives on the main thread and has to learn about it.
+    if (m_decoder->encoding() != m_lastReportedEncoding) {
+        m_lastReportedEncoding = m_decoder->encoding();
+        // The auditor decoded the URL and the form data with the old encoding.
+        m_xssAuditor->setEncoding(m_lastReportedEncoding);
+        callOnMainThread(bind(&HTMLDocumentParser::didDetectEncodingOnBackgroundParser, m_parser, m_lastReportedEncoding, m_decoder->encodingSource()));
+    }
+
+    if (input.isEmpty())
+        return;
+    append(input);
+}
+
 void BackgroundHTMLParser::resumeFrom(PassOwnPtr<Checkpoint> checkpoint)
 {
     m_parser = checkpoint->parser;
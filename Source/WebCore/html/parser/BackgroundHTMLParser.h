@@ -36,6 +36,8 @@
 #include "HTMLToken.h"
 #include "HTMLTokenizer.h"
 #include "HTMLTreeBuilderSimulator.h"
+#include "TextEncoding.h"
+#include "TextResourceDecoder.h"
 #include "XSSAuditorDelegate.h"
 #include <wtf/PassOwnPtr.h>
 #include <wtf/WeakPtr.h>
@@ -53,6 +55,9 @@ public:
         WeakPtr<HTMLDocumentParser> parser;
         OwnPtr<XSSAuditor> xssAuditor;
         OwnPtr<TokenPreloadScanner> preloadScanner;
+        // Set when the parser receives undecoded bytes from the network. The decoder must not
+        // be referenced from the main thread.
+        RefPtr<TextResourceDecoder> decoder;
     };
 
     static void create(PassRefPtr<WeakReference<BackgroundHTMLParser> > reference, PassOwnPtr<Configuration> config)
@@ -72,6 +77,8 @@ public:
     };
 
     void append(const String&);
+    void appendBytes(PassOwnPtr<Vector<char> >);
+    void flush();
     void resumeFrom(PassOwnPtr<Checkpoint>);
     void startedChunkWithCheckpoint(HTMLInputCheckpoint);
     void finish();
@@ -83,6 +90,7 @@ private:
     BackgroundHTMLParser(PassRefPtr<WeakReference<BackgroundHTMLParser> >, PassOwnPtr<Configuration>);
 
     void markEndOfFile();
+    void appendDecodedBytes(const String&);
     void pumpTokenizer();
     void sendTokensToMainThread();
 
@@ -101,6 +109,9 @@ private:
 
     OwnPtr<XSSAuditor> m_xssAuditor;
     OwnPtr<TokenPreloadScanner> m_preloadScanner;
+
+    RefPtr<TextResourceDecoder> m_decoder;
+    TextEncoding m_lastReportedEncoding;
 };
 
 }
@@ -28,7 +28,7 @@
 #include "config.h"
 #include "CSSPreloadScanner.h"
 
-#include "HTMLIdentifier.h"
+#include "CompactHTMLToken.h"
 #include "HTMLParserIdioms.h"
 
 namespace WebCore {
@@ -59,15 +59,21 @@ void CSSPreloadScanner::scanCommon(const Char* begin, const Char* end, PreloadRe
     m_requests = 0;
 }
 
-void CSSPreloadScanner::scan(const HTMLToken::DataVector& data, PreloadRequestStream& requests)
+void CSSPreloadScanner::scan(const HTMLToken& token, PreloadRequestStream& requests)
 {
+    if (token.isAll8BitData()) {
+        const HTMLToken::LCharDataVector& data = token.characters8();
+        scanCommon(data.data(), data.data() + data.size(), requests);
+        return;
+    }
+    const HTMLToken::DataVector& data = token.characters16();
     scanCommon(data.data(), data.data() + data.size(), requests);
 }
 
 #if ENABLE(THREADED_HTML_PARSER)
-void CSSPreloadScanner::scan(const HTMLIdentifier& identifier, PreloadRequestStream& requests)
+void CSSPreloadScanner::scan(const CompactHTMLToken& token, PreloadRequestStream& requests)
 {
-    const StringImpl* data = identifier.asStringImpl();
+    const StringImpl* data = token.data().asStringImpl();
     if (data->is8Bit()) {
         const LChar* begin = data->characters8();
         scanCommon(begin, begin + data->length(), requests);
@@ -33,7 +33,7 @@
 
 namespace WebCore {
 
-class HTMLIdentifier;
+class CompactHTMLToken;
 
 class CSSPreloadScanner {
     WTF_MAKE_NONCOPYABLE(CSSPreloadScanner);
@@ -43,8 +43,9 @@ public:
 
     void reset();
 
-    void scan(const HTMLToken::DataVector&, PreloadRequestStream&);
-    void scan(const HTMLIdentifier&, PreloadRequestStream&);
+    // Scans the character data of a token.
+    void scan(const HTMLToken&, PreloadRequestStream&);
+    void scan(const CompactHTMLToken&, PreloadRequestStream&);
 
 private:
     enum State {
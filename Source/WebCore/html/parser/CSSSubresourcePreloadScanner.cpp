@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "CSSSubresourcePreloadScanner.h"
+
+#include "HTMLParserIdioms.h"
+#include "MediaList.h"
+#include "MediaQueryEvaluator.h"
+
+namespace WebCore {
+
+CSSSubresourcePreloadScanner::CSSSubresourcePreloadScanner(const KURL& sheetURL)
+    : m_sheetURL(sheetURL)
+    , m_state(RulePrelude)
+    , m_skipDepth(0)
+    , m_parenthesisDepth(0)
+    , m_quote(0)
+    , m_previousCharacter(0)
+    , m_escaped(false)
+    , m_inComment(false)
+    , m_sawBlock(false)
+    , m_requests(0)
+{
+}
+
+CSSSubresourcePreloadScanner::~CSSSubresourcePreloadScanner()
+{
+}
+
+void CSSSubresourcePreloadScanner::scan(const String& text, PreloadRequestStream& requests)
+{
+    if (text.isEmpty())
+        return;
+    m_requests = &requests;
+    if (text.is8Bit())
+        scanCharacters(text.characters8(), text.length());
+    else
+        scanCharacters(text.characters16(), text.length());
+    m_requests = 0;
+}
+
+template<typename CharacterType>
+void CSSSubresourcePreloadScanner::scanCharacters(const CharacterType* characters, unsigned length)
+{
+    for (unsigned i = 0; i < length; ++i)
+        tokenize(characters[i]);
+}
+
+Vector<UChar>* CSSSubresourcePreloadScanner::currentBuffer()
+{
+    switch (m_state) {
+    case RulePrelude:
+        return &m_prelude;
+    case DeclarationName:
+        return &m_declarationName;
+    case DeclarationValue:
+        return &m_declarationValue;
+    case SkippingBlock:
+        return 0;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+inline void CSSSubresourcePreloadScanner::tokenize(UChar c)
+{
+    if (m_inComment) {
+        if (m_previousCharacter == '*' && c == '/') {
+            m_inComment = false;
+            c = 0;
+        }
+        m_previousCharacter = c;
+        return;
+    }
+
+    Vector<UChar>* buffer = currentBuffer();
+
+    if (m_quote) {
+        if (buffer)
+            buffer->append(c);
+        if (m_escaped)
+            m_escaped = false;
+        else if (c == '\\')
+            m_escaped = true;
+        else if (c == m_quote)
+            m_quote = 0;
+        return;
+    }
+
+    if (m_previousCharacter == '/' && c == '*') {
+        // The slash was taken for content, take it back.
+        if (buffer && !buffer->isEmpty())
+            buffer->removeLast();
+        m_inComment = true;
+        m_previousCharacter = 0;
+        return;
+    }
+    m_previousCharacter = c;
+
+    if (m_escaped || c == '\\' || c == '"' || c == '\'' || c == '(' || c == ')' || m_parenthesisDepth) {
+        if (m_escaped)
+            m_escaped = false;
+        else if (c == '\\')
+            m_escaped = true;
+        else if (c == '"' || c == '\'')
+            m_quote = c;
+        else if (c == '(')
+            ++m_parenthesisDepth;
+        else if (c == ')' && m_parenthesisDepth)
+            --m_parenthesisDepth;
+        if (buffer)
+            buffer->append(c);
+        return;
+    }
+
+    switch (m_state) {
+    case RulePrelude:
+        if (c == '{')
+            endPrelude();
+        else if (c == ';')
+            endStatement();
+        else if (c == '}') {
+            // The end of a group rule like @media.
+            m_prelude.clear();
+        } else
+            m_prelude.append(c);
+        break;
+    case DeclarationName:
+        if (c == ':')
+            m_state = DeclarationValue;
+        else if (c == ';')
+            m_declarationName.clear();
+        else if (c == '}')
+            endBlock();
+        else if (!isHTMLSpace(c))
+            m_declarationName.append(c);
+        break;
+    case DeclarationValue:
+        if (c == ';') {
+            endDeclaration();
+            m_state = DeclarationName;
+        } else if (c == '}') {
+            endDeclaration();
+            endBlock();
+        } else
+            m_declarationValue.append(c);
+        break;
+    case SkippingBlock:
+        if (c == '{')
+            ++m_skipDepth;
+        else if (c == '}' && !--m_skipDepth)
+            m_state = RulePrelude;
+        break;
+    }
+}
+
+void CSSSubresourcePreloadScanner::skipBlock()
+{
+    m_state = SkippingBlock;
+    m_skipDepth = 1;
+}
+
+static bool mediaIsScreen(const String& mediaText)
+{
+    if (mediaText.isEmpty())
+        return true;
+    RefPtr<MediaQuerySet> mediaQueries = MediaQuerySet::create(mediaText);
+    // Like the HTML preload scanner, this only rules out media that can never apply to a screen.
+    MediaQueryEvaluator mediaQueryEvaluator("screen");
+    return mediaQueryEvaluator.eval(mediaQueries.get());
+}
+
+static bool isRootSelector(const String& selector)
+{
+    String simplified = selector.simplifyWhiteSpace();
+    simplified.replace(" > ", " ");
+    simplified.replace(">", " ");
+    return equalIgnoringCase(simplified, "html") || equalIgnoringCase(simplified, "body") || equalIgnoringCase(simplified, "html body");
+}
+
+// Every page has an html and a body element, so their backgrounds are the only images a sheet is
+// certain to need before its rules have been matched against the document.
+static bool selectorListMatchesRoot(const String& selectorList)
+{
+    Vector<String> selectors;
+    selectorList.split(',', selectors);
+    for (size_t i = 0; i < selectors.size(); ++i) {
+        if (isRootSelector(selectors[i]))
+            return true;
+    }
+    return false;
+}
+
+void CSSSubresourcePreloadScanner::endPrelude()
+{
+    String prelude = String(m_prelude).stripWhiteSpace();
+    m_prelude.clear();
+    m_sawBlock = true;
+
+    if (!prelude.startsWith('@')) {
+        if (!selectorListMatchesRoot(prelude)) {
+            skipBlock();
+            return;
+        }
+        m_state = DeclarationName;
+        return;
+    }
+
+    if (prelude.startsWith("@media", false) && mediaIsScreen(prelude.substring(6).stripWhiteSpace())) {
+        // Scan the nested rules. The closing brace is consumed in the prelude state.
+        return;
+    }
+    if (prelude.startsWith("@supports", false))
+        return;
+    // This includes @font-face: a font only loads once some text uses it.
+    skipBlock();
+}
+
+static void skipWhiteSpace(const String& value, unsigned& position)
+{
+    while (position < value.length() && isHTMLSpace(value[position]))
+        ++position;
+}
+
+static String takeQuotedString(const String& value, unsigned& position)
+{
+    ASSERT(value[position] == '"' || value[position] == '\'');
+    UChar quote = value[position];
+    size_t end = value.find(quote, position + 1);
+    if (end == notFound)
+        return String();
+    String string = value.substring(position + 1, end - position - 1);
+    position = end + 1;
+    return string;
+}
+
+// Returns the address of the next url() in the value at or after position, and moves position past it.
+static String takeNextURL(const String& value, unsigned& position)
+{
+    size_t start = value.find("url(", position, false);
+    if (start == notFound) {
+        position = value.length();
+        return String();
+    }
+    position = start + 4;
+    skipWhiteSpace(value, position);
+    if (position < value.length() && (value[position] == '"' || value[position] == '\'')) {
+        String url = takeQuotedString(value, position);
+        size_t end = value.find(')', position);
+        position = end == notFound ? value.length() : end + 1;
+        return url.stripWhiteSpace();
+    }
+    size_t end = value.find(')', position);
+    if (end == notFound) {
+        position = value.length();
+        return String();
+    }
+    String url = value.substring(position, end - position).stripWhiteSpace();
+    position = end + 1;
+    return url;
+}
+
+void CSSSubresourcePreloadScanner::endStatement()
+{
+    String prelude = String(m_prelude).stripWhiteSpace();
+    m_prelude.clear();
+
+    // @import rules are only valid before any other rule.
+    if (m_sawBlock || !prelude.startsWith("@import", false))
+        return;
+
+    unsigned position = 7;
+    skipWhiteSpace(prelude, position);
+    if (position >= prelude.length())
+        return;
+    String url;
+    if (prelude[position] == '"' || prelude[position] == '\'')
+        url = takeQuotedString(prelude, position).stripWhiteSpace();
+    else if (prelude.find("url(", position, false) == position)
+        url = takeNextURL(prelude, position);
+    if (url.isEmpty() || !mediaIsScreen(prelude.substring(position).stripWhiteSpace()))
+        return;
+    // The import is certain to load once this sheet has been parsed, so it keeps the priority of a style sheet.
+    emitURL(url, CachedResource::CSSStyleSheet, ResourceLoadPriorityUnresolved);
+}
+
+static bool isBackgroundProperty(const String& name)
+{
+    return equalIgnoringCase(name, "background") || equalIgnoringCase(name, "background-image");
+}
+
+void CSSSubresourcePreloadScanner::endDeclaration()
+{
+    String name(m_declarationName);
+    String value(m_declarationValue);
+    m_declarationName.clear();
+    m_declarationValue.clear();
+
+    if (!isBackgroundProperty(name))
+        return;
+    // Which image-set() candidate loads depends on the device scale factor of the page using the sheet.
+    if (value.find("image-set(", 0, false) != notFound)
+        return;
+    unsigned position = 0;
+    while (position < value.length()) {
+        String url = takeNextURL(value, position);
+        if (url.isNull())
+            break;
+        emitURL(url, CachedResource::ImageResource, ResourceLoadPriorityVeryLow);
+    }
+}
+
+void CSSSubresourcePreloadScanner::endBlock()
+{
+    m_declarationName.clear();
+    m_declarationValue.clear();
+    m_state = RulePrelude;
+}
+
+void CSSSubresourcePreloadScanner::emitURL(const String& url, CachedResource::Type type, ResourceLoadPriority priority)
+{
+    if (url.isEmpty() || url.startsWith('#') || url.startsWith("data:", false))
+        return;
+    OwnPtr<PreloadRequest> request = PreloadRequest::create("css", url, m_sheetURL, type);
+    request->setPriority(priority);
+    m_requests->append(request.release());
+}
+
+}
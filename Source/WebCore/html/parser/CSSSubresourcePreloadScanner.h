@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CSSSubresourcePreloadScanner_h
+#define CSSSubresourcePreloadScanner_h
+
+#include "HTMLResourcePreloader.h"
+#include "KURL.h"
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Scans the text of an external style sheet while it loads for the resources it is certain to need:
+// @import rules, and the background images of the html and body elements, which paint the canvas.
+// Anything else may never be used by the page, so it is left to the style resolver. The text can
+// arrive in arbitrary chunks.
+class CSSSubresourcePreloadScanner {
+    WTF_MAKE_NONCOPYABLE(CSSSubresourcePreloadScanner); WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit CSSSubresourcePreloadScanner(const KURL& sheetURL);
+    ~CSSSubresourcePreloadScanner();
+
+    void scan(const String& text, PreloadRequestStream&);
+
+private:
+    enum State {
+        RulePrelude,
+        DeclarationName,
+        DeclarationValue,
+        SkippingBlock,
+    };
+
+    template<typename CharacterType>
+    void scanCharacters(const CharacterType*, unsigned length);
+
+    inline void tokenize(UChar);
+    Vector<UChar>* currentBuffer();
+    void skipBlock();
+
+    void endPrelude();
+    void endStatement();
+    void endDeclaration();
+    void endBlock();
+
+    void emitURL(const String&, CachedResource::Type, ResourceLoadPriority);
+
+    KURL m_sheetURL;
+    State m_state;
+    unsigned m_skipDepth;
+    unsigned m_parenthesisDepth;
+    UChar m_quote;
+    UChar m_previousCharacter;
+    bool m_escaped;
+    bool m_inComment;
+    bool m_sawBlock;
+
+    Vector<UChar> m_prelude;
+    Vector<UChar> m_declarationName;
+    Vector<UChar> m_declarationValue;
+
+    // Only non-zero during scan()
+    PreloadRequestStream* m_requests;
+};
+
+}
+
+#endif
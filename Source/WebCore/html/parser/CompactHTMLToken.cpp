@@ -74,11 +74,16 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token, const TextPosition& t
         m_selfClosing = token->selfClosing();
         // Fall through!
     case HTMLToken::Comment:
-    case HTMLToken::Character: {
         m_isAll8BitData = token->isAll8BitData();
         m_data = HTMLIdentifier(token->data(), token->isAll8BitData() ? Force8Bit : Force16Bit);
         break;
-    }
+    case HTMLToken::Character:
+        m_isAll8BitData = token->isAll8BitData();
+        if (m_isAll8BitData)
+            m_data = HTMLIdentifier(token->characters8());
+        else
+            m_data = HTMLIdentifier(token->characters16(), Force16Bit);
+        break;
     default:
         ASSERT_NOT_REACHED();
         break;
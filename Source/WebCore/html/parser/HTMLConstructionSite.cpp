@@ -113,6 +113,8 @@ void HTMLConstructionSite::attachLater(ContainerNode* parent, PassRefPtr<Node> p
     ASSERT(scriptingContentIsAllowed(m_parserContentPolicy) || !prpChild.get()->isElementNode() || !toScriptElementIfPossible(toElement(prpChild.get())));
     ASSERT(pluginContentIsAllowed(m_parserContentPolicy) || !prpChild->isPluginElement());
 
+    flushPendingText();
+
     HTMLConstructionSiteTask task;
     task.parent = parent;
     task.child = prpChild;
@@ -170,6 +172,8 @@ HTMLConstructionSite::HTMLConstructionSite(DocumentFragment* fragment, ParserCon
     , m_inQuirksMode(fragment->document()->inQuirksMode())
 {
     ASSERT(m_document->isHTMLDocument() || m_document->isXHTMLDocument());
+    // Let elements created by innerHTML and friends share attribute data too.
+    m_document->ensureSharedObjectPool();
 }
 
 HTMLConstructionSite::~HTMLConstructionSite()
@@ -178,6 +182,7 @@ HTMLConstructionSite::~HTMLConstructionSite()
 
 void HTMLConstructionSite::detach()
 {
+    m_pendingText.discard();
     m_document = 0;
     m_attachmentRoot = 0;
 }
@@ -488,6 +493,29 @@ void HTMLConstructionSite::insertTextNode(const String& characters, WhitespaceMo
         task.parent = toHTMLTemplateElement(task.parent.get())->content();
 #endif
 
+    // Character tokens are often split, at the end of each chunk of network data for example.
+    // Collect their text so that it goes into the tree in one piece instead of being appended
+    // to the same text node over and over, which copies the node's data every time.
+    if (!m_pendingText.isEmpty() && (m_pendingText.parent != task.parent || m_pendingText.nextChild != task.nextChild))
+        flushPendingText();
+    m_pendingText.append(task.parent.release(), task.nextChild.release(), characters, whitespaceMode);
+}
+
+void HTMLConstructionSite::flushPendingText()
+{
+    if (m_pendingText.isEmpty())
+        return;
+
+    PendingText pendingText;
+    // Swap the pending text out in case inserting it re-enters the parser.
+    m_pendingText.swap(pendingText);
+
+    HTMLConstructionSiteTask task;
+    task.parent = pendingText.parent;
+    task.nextChild = pendingText.nextChild;
+    String characters = pendingText.stringBuilder.toString();
+    WhitespaceMode whitespaceMode = pendingText.whitespaceMode;
+
     // Strings composed entirely of whitespace are likely to be repeated.
     // Turn them into AtomicString so we share a single string for each.
     bool shouldUseAtomicString = whitespaceMode == AllWhitespace
@@ -658,6 +686,8 @@ bool HTMLConstructionSite::shouldFosterParent() const
 
 void HTMLConstructionSite::fosterParent(PassRefPtr<Node> node)
 {
+    flushPendingText();
+
     HTMLConstructionSiteTask task;
     findFosterSite(task);
     task.child = node;
@@ -34,6 +34,7 @@
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefPtr.h>
 #include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
 
 namespace WebCore {
 
@@ -93,6 +94,9 @@ public:
     void insertHTMLFormElement(AtomicHTMLToken*, bool isDemoted = false);
     void insertScriptElement(AtomicHTMLToken*);
     void insertTextNode(const String&, WhitespaceMode = WhitespaceUnknown);
+    // Text of consecutive insertTextNode() calls for the same position is buffered and
+    // inserted at once. This has to be called before anything else touches the tree.
+    void flushPendingText();
     void insertForeignElement(AtomicHTMLToken*, const AtomicString& namespaceURI);
 
     void insertHTMLHtmlStartTagBeforeHTML(AtomicHTMLToken*);
@@ -170,6 +174,53 @@ private:
     void mergeAttributesFromTokenIntoElement(AtomicHTMLToken*, Element*);
     void dispatchDocumentElementAvailableIfNeeded();
 
+    class PendingText {
+    public:
+        PendingText()
+            : whitespaceMode(WhitespaceUnknown)
+        {
+        }
+
+        void append(PassRefPtr<ContainerNode> newParent, PassRefPtr<Node> newNextChild, const String& newString, WhitespaceMode newWhitespaceMode)
+        {
+            ASSERT(!parent || parent == newParent);
+            parent = newParent;
+            ASSERT(!nextChild || nextChild == newNextChild);
+            nextChild = newNextChild;
+            if (stringBuilder.isEmpty())
+                whitespaceMode = newWhitespaceMode;
+            else if (whitespaceMode != newWhitespaceMode)
+                whitespaceMode = (whitespaceMode == NotAllWhitespace || newWhitespaceMode == NotAllWhitespace) ? NotAllWhitespace : WhitespaceUnknown;
+            stringBuilder.append(newString);
+        }
+
+        void discard()
+        {
+            PendingText discardedText;
+            swap(discardedText);
+        }
+
+        void swap(PendingText& other)
+        {
+            std::swap(whitespaceMode, other.whitespaceMode);
+            parent.swap(other.parent);
+            nextChild.swap(other.nextChild);
+            stringBuilder.swap(other.stringBuilder);
+        }
+
+        bool isEmpty()
+        {
+            // When the stringbuilder is empty, the parent and nextChild should be unset too.
+            ASSERT(!stringBuilder.isEmpty() || (!parent && !nextChild));
+            return stringBuilder.isEmpty();
+        }
+
+        RefPtr<ContainerNode> parent;
+        RefPtr<Node> nextChild;
+        StringBuilder stringBuilder;
+        WhitespaceMode whitespaceMode;
+    };
+
     Document* m_document;
     
     // This is the root ContainerNode to which the parser attaches all newly
@@ -183,6 +234,7 @@ private:
     mutable HTMLFormattingElementList m_activeFormattingElements;
 
     AttachmentQueue m_attachmentQueue;
+    PendingText m_pendingText;
 
     ParserContentPolicy m_parserContentPolicy;
     bool m_isParsingFragment;
@@ -32,6 +32,7 @@
 #include "ContentSecurityPolicy.h"
 #include "DocumentFragment.h"
 #include "DocumentLoader.h"
+#include "DocumentWriter.h"
 #include "Element.h"
 #include "Frame.h"
 #include "HTMLIdentifier.h"
@@ -93,6 +94,7 @@ HTMLDocumentParser::HTMLDocumentParser(HTMLDocument* document, bool reportErrors
     , m_isPinnedToMainThread(false)
     , m_endWasDelayed(false)
     , m_haveBackgroundParser(false)
+    , m_backgroundParserDecodesBytes(false)
     , m_pumpSessionNestingLevel(0)
 {
     ASSERT(shouldUseThreading() || (m_token && m_tokenizer));
@@ -113,6 +115,7 @@ HTMLDocumentParser::HTMLDocumentParser(DocumentFragment* fragment, Element* cont
     , m_isPinnedToMainThread(true)
     , m_endWasDelayed(false)
     , m_haveBackgroundParser(false)
+    , m_backgroundParserDecodesBytes(false)
     , m_pumpSessionNestingLevel(0)
 {
     ASSERT(!shouldUseThreading());
@@ -450,6 +453,8 @@ void HTMLDocumentParser::processParsedChunkFromBackgroundParser(PassOwnPtr<Parse
         ASSERT(!m_tokenizer);
         ASSERT(!m_token);
     }
+
+    m_treeBuilder->flush();
 }
 
 void HTMLDocumentParser::pumpPendingSpeculations()
@@ -552,6 +557,8 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
         ASSERT(token().isUninitialized());
     }
 
+    m_treeBuilder->flush();
+
     // Ensure we haven't been totally deref'ed after pumping. Any caller of this
     // function should be holding a RefPtr to this to ensure we weren't deleted.
     ASSERT(refCount() >= 1);
@@ -656,11 +663,12 @@ void HTMLDocumentParser::insert(const SegmentedString& source)
 
 #if ENABLE(THREADED_HTML_PARSER)
 
-void HTMLDocumentParser::startBackgroundParser()
+void HTMLDocumentParser::startBackgroundParser(PassRefPtr<TextResourceDecoder> decoder)
 {
     ASSERT(shouldUseThreading());
     ASSERT(!m_haveBackgroundParser);
     m_haveBackgroundParser = true;
+    m_backgroundParserDecodesBytes = decoder;
 
     HTMLIdentifier::init();
 
@@ -671,8 +679,11 @@ void HTMLDocumentParser::startBackgroundParser()
     config->options = m_options;
     config->parser = m_weakFactory.createWeakPtr();
     config->xssAuditor = adoptPtr(new XSSAuditor);
+    // When the parser thread decodes the bytes, it tells the auditor about the encoding it
+    // actually settles on. Until then the auditor uses the one the document's decoder starts with.
     config->xssAuditor->init(document(), &m_xssAuditorDelegate);
     config->preloadScanner = adoptPtr(new TokenPreloadScanner(document()->url().copy()));
+    config->decoder = decoder;
 
     ASSERT(config->xssAuditor->isSafeToSendToAnotherThread());
     ASSERT(config->preloadScanner->isSafeToSendToAnotherThread());
@@ -684,11 +695,62 @@ void HTMLDocumentParser::stopBackgroundParser()
     ASSERT(shouldUseThreading());
     ASSERT(m_haveBackgroundParser);
     m_haveBackgroundParser = false;
+    m_backgroundParserDecodesBytes = false;
 
     HTMLParserThread::shared()->postTask(bind(&BackgroundHTMLParser::stop, m_backgroundParser));
     m_weakFactory.revokeAll();
 }
 
+void HTMLDocumentParser::appendBytes(DocumentWriter* writer, const char* data, size_t length)
+{
+    // A background parser that was started for decoded input, for example by document.write(),
+    // has no decoder of its own. Keep decoding on the main thread for it.
+    if (!shouldUseThreading() || (m_haveBackgroundParser && !m_backgroundParserDecodesBytes)) {
+        DecodedDataDocumentParser::appendBytes(writer, data, length);
+        return;
+    }
+
+    if (!length || isStopped())
+        return;
+
+    // The bytes are decoded on the parser thread, by a copy of the document's decoder. The
+    // document's decoder itself only tracks the encoding the parser thread settles on.
+    TextResourceDecoder* decoder = writer->createDecoderIfNeeded();
+    if (!m_haveBackgroundParser)
+        startBackgroundParser(decoder->isolatedCopy());
+    writer->reportDataReceived();
+
+    OwnPtr<Vector<char> > buffer = adoptPtr(new Vector<char>(length));
+    memcpy(buffer->data(), data, length);
+    HTMLParserThread::shared()->postTask(bind(&BackgroundHTMLParser::appendBytes, m_backgroundParser, buffer.release()));
+}
+
+void HTMLDocumentParser::flush(DocumentWriter* writer)
+{
+    if (!m_backgroundParserDecodesBytes) {
+        DecodedDataDocumentParser::flush(writer);
+        return;
+    }
+
+    if (isStopped())
+        return;
+    HTMLParserThread::shared()->postTask(bind(&BackgroundHTMLParser::flush, m_backgroundParser));
+}
+
+void HTMLDocumentParser::didDetectEncodingOnBackgroundParser(const TextEncoding& encoding, TextResourceDecoder::EncodingSource source)
+{
+    if (isStopped())
+        return;
+    if (TextResourceDecoder* decoder = document()->decoder())
+        decoder->setEncoding(encoding, source);
+
+    // DocumentWriter::reportDataReceived() only looked at the encoding the decoder started with.
+    if (encoding.usesVisualOrdering() && !document()->visuallyOrdered()) {
+        document()->setVisuallyOrdered();
+        document()->setNeedsStyleRecalc();
+    }
+}
+
 #endif
 
 void HTMLDocumentParser::append(PassRefPtr<StringImpl> inputSource)
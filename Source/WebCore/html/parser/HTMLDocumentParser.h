@@ -40,6 +40,7 @@
 #include "HTMLTreeBuilderSimulator.h"
 #include "ScriptableDocumentParser.h"
 #include "SegmentedString.h"
+#include "TextResourceDecoder.h"
 #include "XSSAuditor.h"
 #include "XSSAuditorDelegate.h"
 #include <wtf/Deque.h>
@@ -96,6 +97,7 @@ public:
         TokenPreloadScannerCheckpoint preloadScannerCheckpoint;
     };
     void didReceiveParsedChunkFromBackgroundParser(PassOwnPtr<ParsedChunk>);
+    void didDetectEncodingOnBackgroundParser(const TextEncoding&, TextResourceDecoder::EncodingSource);
 #endif
 
 protected:
@@ -119,6 +121,8 @@ private:
     // DocumentParser
 #if ENABLE(THREADED_HTML_PARSER)
     virtual void pinToMainThread() OVERRIDE;
+    virtual void appendBytes(DocumentWriter*, const char* bytes, size_t length) OVERRIDE;
+    virtual void flush(DocumentWriter*) OVERRIDE;
 #endif
     virtual void detach() OVERRIDE;
     virtual bool hasInsertionPoint() OVERRIDE;
@@ -140,7 +144,7 @@ private:
     virtual void notifyFinished(CachedResource*);
 
 #if ENABLE(THREADED_HTML_PARSER)
-    void startBackgroundParser();
+    void startBackgroundParser(PassRefPtr<TextResourceDecoder> = 0);
     void stopBackgroundParser();
     void validateSpeculations(PassOwnPtr<ParsedChunk> lastChunk);
     void discardSpeculationsAndResumeFrom(PassOwnPtr<ParsedChunk> lastChunk, PassOwnPtr<HTMLToken>, PassOwnPtr<HTMLTokenizer>);
@@ -207,6 +211,7 @@ private:
     bool m_isPinnedToMainThread;
     bool m_endWasDelayed;
     bool m_haveBackgroundParser;
+    bool m_backgroundParserDecodesBytes;
     unsigned m_pumpSessionNestingLevel;
 };
 
@@ -58,7 +58,8 @@ bool HTMLIdentifier::hasIndex(const StringImpl* string)
 }
 #endif
 
-unsigned HTMLIdentifier::findIndex(const UChar* characters, unsigned length)
+template<typename CharacterType>
+unsigned HTMLIdentifier::findIndexInTable(const CharacterType* characters, unsigned length)
 {
     // We don't need to try hashing if we know the string is too long.
     if (length > maxNameLength)
@@ -80,6 +81,16 @@ unsigned HTMLIdentifier::findIndex(const UChar* characters, unsigned length)
     return it->value.first;
 }
 
+unsigned HTMLIdentifier::findIndex(const LChar* characters, unsigned length)
+{
+    return findIndexInTable(characters, length);
+}
+
+unsigned HTMLIdentifier::findIndex(const UChar* characters, unsigned length)
+{
+    return findIndexInTable(characters, length);
+}
+
 const unsigned kHTMLNamesIndexOffset = 0;
 const unsigned kHTMLAttrsIndexOffset = 1000;
 COMPILE_ASSERT(kHTMLAttrsIndexOffset > HTMLTagsCount, kHTMLAttrsIndexOffset_should_be_larger_than_HTMLTagsCount);
@@ -58,6 +58,15 @@ public:
             m_string = String(vector);
     }
 
+    template<size_t inlineCapacity>
+    explicit HTMLIdentifier(const Vector<LChar, inlineCapacity>& vector)
+        : m_index(findIndex(vector.data(), vector.size()))
+    {
+        if (m_index != invalidIndex)
+            return;
+        m_string = String(vector.data(), vector.size());
+    }
+
     // asString should only be used on the main thread.
     const String& asString() const;
     // asStringImpl() is safe to call from any thread.
@@ -74,7 +83,9 @@ public:
 private:
     static const unsigned invalidIndex = -1;
     static unsigned maxNameLength;
+    static unsigned findIndex(const LChar* characters, unsigned length);
     static unsigned findIndex(const UChar* characters, unsigned length);
+    template<typename CharacterType> static unsigned findIndexInTable(const CharacterType*, unsigned length);
     static void addNames(QualifiedName** names, unsigned namesCount, unsigned indexOffset);
 
     // FIXME: This could be a union.
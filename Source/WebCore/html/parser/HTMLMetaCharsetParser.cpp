@@ -122,17 +122,17 @@ TextEncoding HTMLMetaCharsetParser::encodingFromMetaAttributes(const AttributeLi
     String charset;
 
     for (AttributeList::const_iterator iter = attributes.begin(); iter != attributes.end(); ++iter) {
-        const AtomicString& attributeName = iter->first;
+        const String& attributeName = iter->first;
         const String& attributeValue = iter->second;
 
-        if (attributeName == http_equivAttr) {
+        if (threadSafeMatch(attributeName, http_equivAttr)) {
             if (equalIgnoringCase(attributeValue, "content-type"))
                 gotPragma = true;
         } else if (charset.isEmpty()) {
-            if (attributeName == charsetAttr) {
+            if (threadSafeMatch(attributeName, charsetAttr)) {
                 charset = attributeValue;
                 mode = Charset;
-            } else if (attributeName == contentAttr) {
+            } else if (threadSafeMatch(attributeName, contentAttr)) {
                 charset = extractCharset(attributeValue);
                 if (charset.length())
                     mode = Pragma;
@@ -148,6 +148,24 @@ TextEncoding HTMLMetaCharsetParser::encodingFromMetaAttributes(const AttributeLi
 
 static const int bytesToCheckUnconditionally = 1024; // That many input bytes will be checked for meta charset even if <head> section is over.
 
+// The threaded HTML parser decodes its input on the parser thread, where AtomicStrings are not
+// shared with the main thread. This is HTMLTokenizer::updateStateFor() using threadSafeMatch(),
+// for the options of m_tokenizer, which have scripting and plugins disabled.
+static void updateTokenizerStateFor(HTMLTokenizer* tokenizer, const String& tagName)
+{
+    if (threadSafeMatch(tagName, textareaTag) || threadSafeMatch(tagName, titleTag))
+        tokenizer->setState(HTMLTokenizer::RCDATAState);
+    else if (threadSafeMatch(tagName, plaintextTag))
+        tokenizer->setState(HTMLTokenizer::PLAINTEXTState);
+    else if (threadSafeMatch(tagName, scriptTag))
+        tokenizer->setState(HTMLTokenizer::ScriptDataState);
+    else if (threadSafeMatch(tagName, styleTag)
+        || threadSafeMatch(tagName, iframeTag)
+        || threadSafeMatch(tagName, xmpTag)
+        || threadSafeMatch(tagName, noframesTag))
+        tokenizer->setState(HTMLTokenizer::RAWTEXTState);
+}
+
 bool HTMLMetaCharsetParser::checkForMetaCharset(const char* data, size_t length)
 {
     if (m_doneChecking)
@@ -178,20 +196,20 @@ bool HTMLMetaCharsetParser::checkForMetaCharset(const char* data, size_t length)
     while (m_tokenizer->nextToken(m_input, m_token)) {
         bool end = m_token.type() == HTMLToken::EndTag;
         if (end || m_token.type() == HTMLToken::StartTag) {
-            AtomicString tagName(m_token.name());
+            String tagName = StringImpl::create8BitIfPossible(m_token.name());
             if (!end) {
-                m_tokenizer->updateStateFor(tagName);
-                if (tagName == metaTag && processMeta()) {
+                updateTokenizerStateFor(m_tokenizer.get(), tagName);
+                if (threadSafeMatch(tagName, metaTag) && processMeta()) {
                     m_doneChecking = true;
                     return true;
                 }
             }
 
-            if (tagName != scriptTag && tagName != noscriptTag
-                && tagName != styleTag && tagName != linkTag
-                && tagName != metaTag && tagName != objectTag
-                && tagName != titleTag && tagName != baseTag
-                && (end || tagName != htmlTag) && (end || tagName != headTag)) {
+            if (!threadSafeMatch(tagName, scriptTag) && !threadSafeMatch(tagName, noscriptTag)
+                && !threadSafeMatch(tagName, styleTag) && !threadSafeMatch(tagName, linkTag)
+                && !threadSafeMatch(tagName, metaTag) && !threadSafeMatch(tagName, objectTag)
+                && !threadSafeMatch(tagName, titleTag) && !threadSafeMatch(tagName, baseTag)
+                && (end || !threadSafeMatch(tagName, htmlTag)) && (end || !threadSafeMatch(tagName, headTag))) {
                 m_inHeadSection = false;
             }
         }
@@ -291,6 +291,11 @@ bool threadSafeMatch(const QualifiedName& a, const QualifiedName& b)
     return threadSafeEqual(a.localName().impl(), b.localName().impl());
 }
 
+bool threadSafeMatch(const String& localName, const QualifiedName& qName)
+{
+    return threadSafeEqual(localName.impl(), qName.localName().impl());
+}
+
 #if ENABLE(THREADED_HTML_PARSER)
 bool threadSafeMatch(const HTMLIdentifier& localName, const QualifiedName& qName)
 {
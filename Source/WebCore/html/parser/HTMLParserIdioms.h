@@ -93,6 +93,7 @@ inline bool isNotHTMLSpace(UChar character)
 }
 
 bool threadSafeMatch(const QualifiedName&, const QualifiedName&);
+bool threadSafeMatch(const String&, const QualifiedName&);
 #if ENABLE(THREADED_HTML_PARSER)
 bool threadSafeMatch(const HTMLIdentifier&, const QualifiedName&);
 inline bool threadSafeHTMLNamesMatch(const HTMLIdentifier& tagName, const QualifiedName& qName)
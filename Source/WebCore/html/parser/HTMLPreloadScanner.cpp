@@ -320,7 +320,7 @@ void TokenPreloadScanner::scanCommon(const Token& token, Vector<OwnPtr<PreloadRe
     case HTMLToken::Character: {
         if (!m_inStyle)
             return;
-        m_cssScanner.scan(token.data(), requests);
+        m_cssScanner.scan(token, requests);
         return;
     }
     case HTMLToken::EndTag: {
@@ -47,7 +47,7 @@ KURL PreloadRequest::completeURL(Document* document)
 CachedResourceRequest PreloadRequest::resourceRequest(Document* document)
 {
     ASSERT(isMainThread());
-    CachedResourceRequest request(ResourceRequest(completeURL(document)));
+    CachedResourceRequest request(ResourceRequest(completeURL(document)), m_priority);
     request.setInitiator(m_initiator);
 
     // FIXME: It's possible CORS should work for other request types?
@@ -56,6 +56,15 @@ CachedResourceRequest PreloadRequest::resourceRequest(Document* document)
     return request;
 }
 
+PassOwnPtr<PreloadRequest> PreloadRequest::copy() const
+{
+    OwnPtr<PreloadRequest> request = create(m_initiator, m_resourceURL, m_baseURL, m_resourceType);
+    request->m_charset = m_charset;
+    request->m_priority = m_priority;
+    request->m_crossOriginModeAllowsCookies = m_crossOriginModeAllowsCookies;
+    return request.release();
+}
+
 void HTMLResourcePreloader::takeAndPreload(PreloadRequestStream& r)
 {
     PreloadRequestStream requests;
@@ -28,6 +28,8 @@
 
 #include "CachedResource.h"
 #include "CachedResourceRequest.h"
+#include <wtf/PassOwnPtr.h>
+#include <wtf/WeakPtr.h>
 
 namespace WebCore {
 
@@ -38,6 +40,8 @@ public:
         return adoptPtr(new PreloadRequest(initiator, resourceURL, baseURL, resourceType));
     }
 
+    PassOwnPtr<PreloadRequest> copy() const;
+
     bool isSafeToSendToAnotherThread() const;
 
     CachedResourceRequest resourceRequest(Document*);
@@ -45,6 +49,8 @@ public:
     const String& charset() const { return m_charset; }
     void setCharset(const String& charset) { m_charset = charset.isolatedCopy(); }
     void setCrossOriginModeAllowsCookies(bool allowsCookies) { m_crossOriginModeAllowsCookies = allowsCookies; }
+    // Speculative requests can ask for a lower priority than the resource type would get.
+    void setPriority(ResourceLoadPriority priority) { m_priority = priority; }
     CachedResource::Type resourceType() const { return m_resourceType; }
 
 private:
@@ -53,6 +59,7 @@ private:
         , m_resourceURL(resourceURL.isolatedCopy())
         , m_baseURL(baseURL.copy())
         , m_resourceType(resourceType)
+        , m_priority(ResourceLoadPriorityUnresolved)
         , m_crossOriginModeAllowsCookies(false)
     {
     }
@@ -64,6 +71,7 @@ private:
     KURL m_baseURL;
     String m_charset;
     CachedResource::Type m_resourceType;
+    ResourceLoadPriority m_priority;
     bool m_crossOriginModeAllowsCookies;
 };
 
@@ -92,6 +92,7 @@ public:
 
     typedef Vector<Attribute, 10> AttributeList;
     typedef Vector<UChar, 256> DataVector;
+    typedef Vector<LChar, 256> LCharDataVector;
 
     HTMLToken() { clear(); }
 
@@ -102,6 +103,7 @@ public:
         m_range.end = 0;
         m_baseOffset = 0;
         m_data.clear();
+        m_data8.clear();
         m_orAllData = 0;
     }
 
@@ -130,7 +132,7 @@ public:
 
     const DataVector& data() const
     {
-        ASSERT(m_type == Character || m_type == Comment || m_type == StartTag || m_type == EndTag);
+        ASSERT(m_type == Comment || m_type == StartTag || m_type == EndTag);
         return m_data;
     }
 
@@ -337,6 +339,20 @@ public:
         m_currentAttribute->value.append(character);
     }
 
+    void appendToAttributeValue(const LChar* characters, unsigned length)
+    {
+        ASSERT(m_type == StartTag || m_type == EndTag);
+        ASSERT(m_currentAttribute->valueRange.start);
+        m_currentAttribute->value.append(characters, length);
+    }
+
+    void appendToAttributeValue(const UChar* characters, unsigned length)
+    {
+        ASSERT(m_type == StartTag || m_type == EndTag);
+        ASSERT(m_currentAttribute->valueRange.start);
+        m_currentAttribute->value.append(characters, length);
+    }
+
     void appendToAttributeValue(size_t i, const String& value)
     {
         ASSERT(!value.isEmpty());
@@ -376,21 +392,48 @@ public:
         m_type = Character;
     }
 
-    const DataVector& characters() const
+    // Character data is buffered as LChars for as long as every character fits, so that
+    // Latin-1 text is never widened. The first wider character moves what was buffered so
+    // far into the UChar buffer, and isAll8BitData() tells which of the two is in use.
+    const LCharDataVector& characters8() const
+    {
+        ASSERT(m_type == Character);
+        ASSERT(isAll8BitData());
+        return m_data8;
+    }
+
+    const DataVector& characters16() const
     {
         ASSERT(m_type == Character);
+        ASSERT(!isAll8BitData());
         return m_data;
     }
 
+    size_t charactersLength() const
+    {
+        ASSERT(m_type == Character);
+        return isAll8BitData() ? m_data8.size() : m_data.size();
+    }
+
     void appendToCharacter(char character)
     {
         ASSERT(m_type == Character);
-        m_data.append(character);
+        if (isAll8BitData())
+            m_data8.append(character);
+        else
+            m_data.append(character);
     }
 
     void appendToCharacter(UChar character)
     {
         ASSERT(m_type == Character);
+        if (isAll8BitData()) {
+            if (character <= 0xff) {
+                m_data8.append(static_cast<LChar>(character));
+                return;
+            }
+            widenCharacters();
+        }
         m_data.append(character);
         m_orAllData |= character;
     }
@@ -398,7 +441,36 @@ public:
     void appendToCharacter(const Vector<LChar, 32>& characters)
     {
         ASSERT(m_type == Character);
-        m_data.appendVector(characters);
+        if (isAll8BitData())
+            m_data8.appendVector(characters);
+        else
+            m_data.appendVector(characters);
+    }
+
+    void appendToCharacter(const LChar* characters, unsigned length)
+    {
+        ASSERT(m_type == Character);
+        if (isAll8BitData())
+            m_data8.append(characters, length);
+        else
+            m_data.append(characters, length);
+    }
+
+    void appendToCharacter(const UChar* characters, unsigned length)
+    {
+        ASSERT(m_type == Character);
+        UChar orCharacters = 0;
+        for (unsigned i = 0; i < length; ++i)
+            orCharacters |= characters[i];
+        if (isAll8BitData()) {
+            if (orCharacters <= 0xff) {
+                m_data8.append(characters, length);
+                return;
+            }
+            widenCharacters();
+        }
+        m_data.append(characters, length);
+        m_orAllData |= orCharacters;
     }
 
     /* Comment Tokens */
@@ -427,14 +499,23 @@ public:
     {
         ASSERT(m_type == Character);
         m_data.clear();
+        m_data8.clear();
         m_orAllData = 0;
     }
 
 private:
+    void widenCharacters()
+    {
+        ASSERT(m_data.isEmpty());
+        m_data.append(m_data8.data(), m_data8.size());
+        m_data8.clear();
+    }
+
     Type m_type;
     Attribute::Range m_range; // Always starts at zero.
     int m_baseOffset;
     DataVector m_data;
+    LCharDataVector m_data8;
     UChar m_orAllData;
 
     // For StartTag and EndTag
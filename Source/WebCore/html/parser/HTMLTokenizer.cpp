@@ -40,6 +40,10 @@
 #include <wtf/text/CString.h>
 #include <wtf/unicode/Unicode.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace WTF;
 
 namespace WebCore {
@@ -98,6 +102,58 @@ static inline bool isEndTagBufferingState(HTMLTokenizer::State state)
     }
 }
 
+static inline bool isOrdinaryRunCharacter(UChar character, LChar delimiter)
+{
+    return character != '&' && character != '\r' && character != '\n' && character != '\0' && character != delimiter;
+}
+
+// Returns the number of leading characters that the tokenizer would otherwise consume one
+// at a time without doing anything but appending them to the current token.
+static inline unsigned lengthOfOrdinaryRun(const LChar* characters, unsigned length, LChar delimiter)
+{
+    unsigned i = 0;
+#if defined(__SSE2__) && COMPILER(GCC)
+    const __m128i ampersand = _mm_set1_epi8('&');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i null = _mm_setzero_si128();
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, ampersand), _mm_cmpeq_epi8(block, delimiters)),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, carriageReturn), _mm_cmpeq_epi8(block, newline)), _mm_cmpeq_epi8(block, null)));
+        if (int mask = _mm_movemask_epi8(matches))
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while (i < length && isOrdinaryRunCharacter(characters[i], delimiter))
+        ++i;
+    return i;
+}
+
+static inline unsigned lengthOfOrdinaryRun(const UChar* characters, unsigned length, LChar delimiter)
+{
+    unsigned i = 0;
+#if defined(__SSE2__) && COMPILER(GCC)
+    const __m128i ampersand = _mm_set1_epi16('&');
+    const __m128i carriageReturn = _mm_set1_epi16('\r');
+    const __m128i newline = _mm_set1_epi16('\n');
+    const __m128i null = _mm_setzero_si128();
+    const __m128i delimiters = _mm_set1_epi16(delimiter);
+    for (; i + 8 <= length; i += 8) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(block, ampersand), _mm_cmpeq_epi16(block, delimiters)),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(block, carriageReturn), _mm_cmpeq_epi16(block, newline)), _mm_cmpeq_epi16(block, null)));
+        // Each matching UChar sets two adjacent bits of the mask.
+        if (int mask = _mm_movemask_epi8(matches))
+            return i + (__builtin_ctz(mask) >> 1);
+    }
+#endif
+    while (i < length && isOrdinaryRunCharacter(characters[i], delimiter))
+        ++i;
+    return i;
+}
+
 #define HTML_BEGIN_STATE(stateName) BEGIN_STATE(HTMLTokenizer, stateName)
 #define HTML_RECONSUME_IN(stateName) RECONSUME_IN(HTMLTokenizer, stateName)
 #define HTML_ADVANCE_TO(stateName) ADVANCE_TO(HTMLTokenizer, stateName)
@@ -175,6 +231,47 @@ inline bool HTMLTokenizer::processEntity(SegmentedString& source)
     return true;
 }
 
+void HTMLTokenizer::bufferCharacterRun(SegmentedString& source, UChar currentCharacter, LChar delimiter)
+{
+    // Pushed back characters come before the current substring, so it can't be scanned directly.
+    if (source.escaped() || source.hasPushedCharacters() || source.currentChar() != currentCharacter)
+        return;
+    unsigned length = source.lengthOfCharactersAfterCurrent();
+    if (!length)
+        return;
+    unsigned runLength;
+    if (source.currentSubstringIs8Bit()) {
+        const LChar* characters = source.charactersAfterCurrent8();
+        runLength = lengthOfOrdinaryRun(characters, length, delimiter);
+        m_token->appendToCharacter(characters, runLength);
+    } else {
+        const UChar* characters = source.charactersAfterCurrent16();
+        runLength = lengthOfOrdinaryRun(characters, length, delimiter);
+        m_token->appendToCharacter(characters, runLength);
+    }
+    source.advancePastNonNewlines(runLength);
+}
+
+void HTMLTokenizer::appendToAttributeValueRun(SegmentedString& source, UChar currentCharacter, LChar delimiter)
+{
+    if (source.escaped() || source.hasPushedCharacters() || source.currentChar() != currentCharacter)
+        return;
+    unsigned length = source.lengthOfCharactersAfterCurrent();
+    if (!length)
+        return;
+    unsigned runLength;
+    if (source.currentSubstringIs8Bit()) {
+        const LChar* characters = source.charactersAfterCurrent8();
+        runLength = lengthOfOrdinaryRun(characters, length, delimiter);
+        m_token->appendToAttributeValue(characters, runLength);
+    } else {
+        const UChar* characters = source.charactersAfterCurrent16();
+        runLength = lengthOfOrdinaryRun(characters, length, delimiter);
+        m_token->appendToAttributeValue(characters, runLength);
+    }
+    source.advancePastNonNewlines(runLength);
+}
+
 bool HTMLTokenizer::flushBufferedEndTag(SegmentedString& source)
 {
     ASSERT(m_token->type() == HTMLToken::Character || m_token->type() == HTMLToken::Uninitialized);
@@ -247,6 +344,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, cc, '<');
             HTML_ADVANCE_TO(DataState);
         }
     }
@@ -268,6 +366,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, cc, '<');
             HTML_ADVANCE_TO(RCDATAState);
         }
     }
@@ -287,6 +386,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, cc, '<');
             HTML_ADVANCE_TO(RAWTEXTState);
         }
     }
@@ -299,6 +399,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, cc, '<');
             HTML_ADVANCE_TO(ScriptDataState);
         }
     }
@@ -963,6 +1064,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             HTML_RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendToAttributeValueRun(source, cc, '"');
             HTML_ADVANCE_TO(AttributeValueDoubleQuotedState);
         }
     }
@@ -981,6 +1083,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             HTML_RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendToAttributeValueRun(source, cc, '\'');
             HTML_ADVANCE_TO(AttributeValueSingleQuotedState);
         }
     }
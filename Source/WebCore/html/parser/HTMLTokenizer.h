@@ -213,6 +213,12 @@ private:
         m_token->appendToCharacter(character);
     }
 
+    // The next two functions consume the run of ordinary characters that follows the current
+    // input character in one step, leaving the source on the last character of the run.
+    // A run ends before '&', '\r', '\n', '\0' or the given delimiter.
+    void bufferCharacterRun(SegmentedString&, UChar currentCharacter, LChar delimiter);
+    void appendToAttributeValueRun(SegmentedString&, UChar currentCharacter, LChar delimiter);
+
     inline bool emitAndResumeIn(SegmentedString& source, State state)
     {
         saveEndTagNameIfNeeded();
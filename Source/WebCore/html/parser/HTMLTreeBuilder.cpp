@@ -154,17 +154,19 @@ class HTMLTreeBuilder::ExternalCharacterTokenBuffer {
     WTF_MAKE_NONCOPYABLE(ExternalCharacterTokenBuffer);
 public:
     explicit ExternalCharacterTokenBuffer(AtomicHTMLToken* token)
-        : m_current(token->characters())
-        , m_end(m_current + token->charactersLength())
-        , m_isAll8BitData(token->isAll8BitData())
+        : m_characters8(token->isAll8BitData() ? token->characters8() : 0)
+        , m_characters16(token->isAll8BitData() ? 0 : token->characters16())
+        , m_current(0)
+        , m_end(token->charactersLength())
     {
         ASSERT(!isEmpty());
     }
 
     explicit ExternalCharacterTokenBuffer(const String& string)
-        : m_current(string.characters())
-        , m_end(m_current + string.length())
-        , m_isAll8BitData(string.length() && string.is8Bit())
+        : m_characters8(string.is8Bit() ? string.characters8() : 0)
+        , m_characters16(string.is8Bit() ? 0 : string.characters16())
+        , m_current(0)
+        , m_end(string.length())
     {
         ASSERT(!isEmpty());
     }
@@ -176,12 +178,12 @@ public:
 
     bool isEmpty() const { return m_current == m_end; }
 
-    bool isAll8BitData() const { return m_isAll8BitData; }
+    bool isAll8BitData() const { return !!m_characters8; }
 
     void skipAtMostOneLeadingNewline()
     {
         ASSERT(!isEmpty());
-        if (*m_current == '\n')
+        if (characterAt(m_current) == '\n')
             ++m_current;
     }
 
@@ -203,28 +205,26 @@ public:
     String takeRemaining()
     {
         ASSERT(!isEmpty());
-        const UChar* start = m_current;
+        unsigned start = m_current;
         m_current = m_end;
-        size_t length = m_current - start;
-
-        if (isAll8BitData())
-            return String::make8BitFrom16BitSource(start, length);
-
-        return String(start, length);
+        return substring(start, m_current - start);
     }
 
     void giveRemainingTo(StringBuilder& recipient)
     {
-        recipient.append(m_current, m_end - m_current);
+        if (isAll8BitData())
+            recipient.append(m_characters8 + m_current, m_end - m_current);
+        else
+            recipient.append(m_characters16 + m_current, m_end - m_current);
         m_current = m_end;
     }
 
     String takeRemainingWhitespace()
     {
         ASSERT(!isEmpty());
-        Vector<UChar> whitespace;
+        Vector<LChar> whitespace;
         do {
-            UChar cc = *m_current++;
+            UChar cc = characterAt(m_current++);
             if (isHTMLSpace(cc))
                 whitespace.append(cc);
         } while (m_current < m_end);
@@ -237,11 +237,23 @@ public:
     }
 
 private:
+    UChar characterAt(unsigned index) const
+    {
+        return isAll8BitData() ? m_characters8[index] : m_characters16[index];
+    }
+
+    String substring(unsigned start, unsigned length) const
+    {
+        if (isAll8BitData())
+            return String(m_characters8 + start, length);
+        return String(m_characters16 + start, length);
+    }
+
     template<bool characterPredicate(UChar)>
     void skipLeading()
     {
         ASSERT(!isEmpty());
-        while (characterPredicate(*m_current)) {
+        while (characterPredicate(characterAt(m_current))) {
             if (++m_current == m_end)
                 return;
         }
@@ -251,18 +263,17 @@ private:
     String takeLeading()
     {
         ASSERT(!isEmpty());
-        const UChar* start = m_current;
+        unsigned start = m_current;
         skipLeading<characterPredicate>();
         if (start == m_current)
             return String();
-        if (isAll8BitData())
-            return String::make8BitFrom16BitSource(start, m_current - start);
-        return String(start, m_current - start);
+        return substring(start, m_current - start);
     }
 
-    const UChar* m_current;
-    const UChar* m_end;
-    bool m_isAll8BitData;
+    const LChar* m_characters8;
+    const UChar* m_characters16;
+    unsigned m_current;
+    unsigned m_end;
 };
 
 
@@ -364,6 +375,10 @@ PassRefPtr<Element> HTMLTreeBuilder::takeScriptToProcess(TextPosition& scriptSta
 
 void HTMLTreeBuilder::constructTree(AtomicHTMLToken* token)
 {
+    // Only character tokens can add to the pending text; anything else may need to see it in the tree.
+    if (token->type() != HTMLToken::Character)
+        m_tree.flushPendingText();
+
     if (shouldProcessTokenInForeignContent(token))
         processTokenInForeignContent(token);
     else
@@ -2900,7 +2915,7 @@ void HTMLTreeBuilder::processTokenInForeignContent(AtomicHTMLToken* token)
         m_tree.insertComment(token);
         return;
     case HTMLToken::Character: {
-        String characters = String(token->characters(), token->charactersLength());
+        String characters = token->isAll8BitData() ? String(token->characters8(), token->charactersLength()) : String(token->characters16(), token->charactersLength());
         m_tree.insertTextNode(characters);
         if (m_framesetOk && !isAllWhitespaceOrReplacementCharacters(characters))
             m_framesetOk = false;
@@ -2914,6 +2929,8 @@ void HTMLTreeBuilder::processTokenInForeignContent(AtomicHTMLToken* token)
 
 void HTMLTreeBuilder::finished()
 {
+    m_tree.flushPendingText();
+
     if (isParsingFragment())
         return;
 
@@ -80,6 +80,8 @@ public:
     void detach();
 
     void constructTree(AtomicHTMLToken*);
+    // Inserts the text buffered from the last character tokens. Call before yielding.
+    void flush() { m_tree.flushPendingText(); }
 
     bool hasParserBlockingScript() const { return !!m_scriptToProcess; }
     // Must be called to take the parser-blocking script before calling the parser again.
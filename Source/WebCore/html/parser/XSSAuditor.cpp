@@ -229,9 +229,6 @@ void XSSAuditor::initForFragment()
 
 void XSSAuditor::init(Document* document, XSSAuditorDelegate* auditorDelegate)
 {
-    const size_t miniumLengthForSuffixTree = 512; // FIXME: Tune this parameter.
-    const int suffixTreeDepth = 5;
-
     ASSERT(isMainThread());
     if (m_state == Initialized)
         return;
@@ -245,8 +242,6 @@ void XSSAuditor::init(Document* document, XSSAuditorDelegate* auditorDelegate)
     if (!m_isEnabled)
         return;
 
-    m_documentURL = document->url().copy();
-
     // In theory, the Document could have detached from the Frame after the
     // XSSAuditor was constructed.
     if (!document->frame()) {
@@ -254,25 +249,23 @@ void XSSAuditor::init(Document* document, XSSAuditorDelegate* auditorDelegate)
         return;
     }
 
-    if (m_documentURL.isEmpty()) {
+    if (document->url().isEmpty()) {
         // The URL can be empty when opening a new browser window or calling window.open("").
         m_isEnabled = false;
         return;
     }
 
-    if (m_documentURL.protocolIsData()) {
+    if (document->url().protocolIsData()) {
         m_isEnabled = false;
         return;
     }
 
+    // setEncoding() relies on m_documentURL staying empty when the auditor is disabled above.
+    m_documentURL = document->url().copy();
+
     if (document->decoder())
         m_encoding = document->decoder()->encoding();
 
-    m_decodedURL = fullyDecodeString(m_documentURL.string(), m_encoding);
-    if (m_decodedURL.find(isRequiredForInjection) == notFound)
-        m_decodedURL = String();
-
-    String httpBodyAsString;
     if (DocumentLoader* documentLoader = document->frame()->loader()->documentLoader()) {
         DEFINE_STATIC_LOCAL(String, XSSProtectionHeader, (ASCIILiteral("X-XSS-Protection")));
         String headerValue = documentLoader->response().httpHeaderField(XSSProtectionHeader);
@@ -303,22 +296,48 @@ void XSSAuditor::init(Document* document, XSSAuditorDelegate* auditorDelegate)
         if (auditorDelegate)
             auditorDelegate->setReportURL(xssProtectionReportURL.copy());
         FormData* httpBody = documentLoader->originalRequest().httpBody();
-        if (httpBody && !httpBody->isEmpty()) {
-            httpBodyAsString = httpBody->flattenToString();
-            if (!httpBodyAsString.isEmpty()) {
-                m_decodedHTTPBody = fullyDecodeString(httpBodyAsString, m_encoding);
-                if (m_decodedHTTPBody.find(isRequiredForInjection) == notFound)
-                    m_decodedHTTPBody = String();
-                if (m_decodedHTTPBody.length() >= miniumLengthForSuffixTree)
-                    m_decodedHTTPBodySuffixTree = adoptPtr(new SuffixTree<ASCIICodebook>(m_decodedHTTPBody, suffixTreeDepth));
-            }
-        }
+        if (httpBody && !httpBody->isEmpty())
+            m_httpBody = httpBody->flattenToString();
     }
 
-    if (m_decodedURL.isEmpty() && m_decodedHTTPBody.isEmpty()) {
-        m_isEnabled = false;
+    decodeReflectedInput();
+}
+
+void XSSAuditor::setEncoding(const TextEncoding& encoding)
+{
+    ASSERT(m_state == Initialized);
+    if (!encoding.isValid() || encoding == m_encoding)
+        return;
+    m_encoding = encoding;
+
+    // The auditor was disabled by init() for reasons that don't depend on the encoding.
+    if (m_documentURL.isEmpty())
         return;
+
+    m_cachedDecodedSnippet = String();
+    decodeReflectedInput();
+}
+
+void XSSAuditor::decodeReflectedInput()
+{
+    const size_t miniumLengthForSuffixTree = 512; // FIXME: Tune this parameter.
+    const int suffixTreeDepth = 5;
+
+    m_decodedURL = fullyDecodeString(m_documentURL.string(), m_encoding);
+    if (m_decodedURL.find(isRequiredForInjection) == notFound)
+        m_decodedURL = String();
+
+    m_decodedHTTPBody = String();
+    m_decodedHTTPBodySuffixTree.clear();
+    if (!m_httpBody.isEmpty()) {
+        m_decodedHTTPBody = fullyDecodeString(m_httpBody, m_encoding);
+        if (m_decodedHTTPBody.find(isRequiredForInjection) == notFound)
+            m_decodedHTTPBody = String();
+        if (m_decodedHTTPBody.length() >= miniumLengthForSuffixTree)
+            m_decodedHTTPBodySuffixTree = adoptPtr(new SuffixTree<ASCIICodebook>(m_decodedHTTPBody, suffixTreeDepth));
     }
+
+    m_isEnabled = !m_decodedURL.isEmpty() || !m_decodedHTTPBody.isEmpty();
 }
 
 PassOwnPtr<XSSInfo> XSSAuditor::filterToken(const FilterTokenRequest& request)
@@ -728,6 +747,7 @@ bool XSSAuditor::isLikelySafeResource(const String& url)
 bool XSSAuditor::isSafeToSendToAnotherThread() const
 {
     return m_documentURL.isSafeToSendToAnotherThread()
+        && m_httpBody.isSafeToSendToAnotherThread()
         && m_decodedURL.isSafeToSendToAnotherThread()
         && m_decodedHTTPBody.isSafeToSendToAnotherThread()
         && m_cachedDecodedSnippet.isSafeToSendToAnotherThread();
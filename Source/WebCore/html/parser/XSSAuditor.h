@@ -60,6 +60,7 @@ public:
 
     void init(Document*, XSSAuditorDelegate*);
     void initForFragment();
+    void setEncoding(const TextEncoding&);
 
     PassOwnPtr<XSSInfo> filterToken(const FilterTokenRequest&);
     bool isSafeToSendToAnotherThread() const;
@@ -104,6 +105,8 @@ private:
     bool isContainedInRequest(const String&);
     bool isLikelySafeResource(const String& url);
 
+    void decodeReflectedInput();
+
     KURL m_documentURL;
     bool m_isEnabled;
 
@@ -111,6 +114,7 @@ private:
     bool m_didSendValidCSPHeader;
     bool m_didSendValidXSSProtectionHeader;
 
+    String m_httpBody;
     String m_decodedURL;
     String m_decodedHTTPBody;
     OwnPtr<SuffixTree<ASCIICodebook> > m_decodedHTTPBodySuffixTree;
@@ -86,16 +86,22 @@ WebInspector.RequestTimingView.createTimingTable = function(request)
     var tableElement = document.createElement("table");
     var rows = [];
 
+    // Rows are relative to requestTime, which is when the request left the loader's queue.
+    var queueingDelay = request.timing.queueingDelay || 0;
+
     function addRow(title, className, start, end)
     {
         var row = {};
         row.title = title;
         row.className = className;
-        row.start = start;
-        row.end = end;
+        row.start = start + queueingDelay;
+        row.end = end + queueingDelay;
         rows.push(row);
     }
 
+    if (queueingDelay)
+        addRow(WebInspector.UIString("Queueing"), "queueing", -queueingDelay, 0);
+
     if (request.timing.proxyStart !== -1)
         addRow(WebInspector.UIString("Proxy"), "proxy", request.timing.proxyStart, request.timing.proxyEnd);
 
@@ -126,7 +132,7 @@ WebInspector.RequestTimingView.createTimingTable = function(request)
     addRow(WebInspector.UIString("Receiving"), "receiving", (request.responseReceivedTime - request.timing.requestTime) * 1000, (request.endTime - request.timing.requestTime) * 1000);
 
     const chartWidth = 200;
-    var total = (request.endTime - request.timing.requestTime) * 1000;
+    var total = (request.endTime - request.timing.requestTime) * 1000 + queueingDelay;
     var scale = chartWidth / total;
 
     for (var i = 0; i < rows.length; ++i) {
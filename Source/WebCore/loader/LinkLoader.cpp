@@ -40,8 +40,10 @@
 #include "DNS.h"
 #include "Document.h"
 #include "Frame.h"
+#include "FrameLoader.h"
 #include "FrameView.h"
 #include "LinkRelAttribute.h"
+#include "PreconnectQueue.h"
 #include "Settings.h"
 #include "StyleResolver.h"
 
@@ -103,6 +105,12 @@ bool LinkLoader::loadLink(const LinkRelAttribute& relAttribute, const String& ty
             prefetchDNS(href.host());
     }
 
+    if (relAttribute.m_isPreconnect) {
+        Settings* settings = document->settings();
+        if (settings && settings->dnsPrefetchingEnabled() && href.isValid() && !href.isEmpty() && document->frame())
+            PreconnectQueue::shared().add(href, document->frame()->loader()->networkingContext(), PreconnectQueue::HintedConnection);
+    }
+
 #if ENABLE(LINK_PREFETCH)
     if ((relAttribute.m_isLinkPrefetch || relAttribute.m_isLinkSubresource) && href.isValid() && document->frame()) {
         if (!m_client->shouldLoadLink())
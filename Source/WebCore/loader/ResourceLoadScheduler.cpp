@@ -25,6 +25,7 @@
 #include "config.h"
 #include "ResourceLoadScheduler.h"
 
+#include "CachedResource.h"
 #include "Document.h"
 #include "DocumentLoader.h"
 #include "Frame.h"
@@ -35,9 +36,11 @@
 #include "Logging.h"
 #include "NetscapePlugInStreamLoader.h"
 #include "PlatformStrategies.h"
+#include "PreconnectQueue.h"
 #include "ResourceLoader.h"
 #include "ResourceRequest.h"
 #include "SubresourceLoader.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/MainThread.h>
 #include <wtf/TemporaryChange.h>
 #include <wtf/text/CString.h>
@@ -47,6 +50,13 @@ namespace WebCore {
 static const unsigned maxRequestsInFlightForNonHTTPProtocols = 20;
 // Match the parallel connection count used by the networking layer.
 static unsigned maxRequestsInFlightPerHost;
+// All HTTP hosts together get the connections of a few hosts, so that pages spreading their
+// resources over many hosts do not flood the network with low priority loads.
+static const unsigned connectionBudgetInHosts = 4;
+static unsigned maxHTTPRequestsInFlight;
+// Loads below ResourceLoadPriorityMedium, mostly images, leave this part of the budget free so
+// that render-blocking style sheets and scripts discovered later do not have to wait for them.
+static unsigned httpRequestsInFlightReservedForImportantLoads;
 
 ResourceLoadScheduler::HostInformation* ResourceLoadScheduler::hostForURL(const KURL& url, CreateHostPolicy createHostPolicy)
 {
@@ -88,11 +98,15 @@ ResourceLoadScheduler* resourceLoadScheduler()
 
 ResourceLoadScheduler::ResourceLoadScheduler()
     : m_nonHTTPProtocolHost(new HostInformation(String(), maxRequestsInFlightForNonHTTPProtocols))
+    , m_httpRequestsInFlight(0)
     , m_requestTimer(this, &ResourceLoadScheduler::requestTimerFired)
     , m_suspendPendingRequestsCount(0)
     , m_isSerialLoadingEnabled(false)
+    , m_isServingPendingRequests(false)
 {
     maxRequestsInFlightPerHost = initializeMaximumHTTPConnectionCountPerHost();
+    maxHTTPRequestsInFlight = maxRequestsInFlightPerHost * connectionBudgetInHosts;
+    httpRequestsInFlightReservedForImportantLoads = maxRequestsInFlightPerHost > 1 ? maxRequestsInFlightPerHost / 2 : 1;
 }
 
 ResourceLoadScheduler::~ResourceLoadScheduler()
@@ -131,6 +145,7 @@ void ResourceLoadScheduler::scheduleLoad(ResourceLoader* resourceLoader, Resourc
     HostInformation* host = hostForURL(resourceLoader->url(), CreateIfNotFound);    
     bool hadRequests = host->hasRequests();
     host->schedule(resourceLoader, priority);
+    resourceLoader->setScheduledTime(monotonicallyIncreasingTime());
 
     if (priority > ResourceLoadPriorityLow || !resourceLoader->url().protocolIsInHTTPFamily() || (priority == ResourceLoadPriorityLow && !hadRequests)) {
         // Try to request important resources immediately.
@@ -155,8 +170,25 @@ void ResourceLoadScheduler::remove(ResourceLoader* resourceLoader)
     ASSERT(resourceLoader);
 
     HostInformation* host = hostForURL(resourceLoader->url());
-    if (host)
-        host->remove(resourceLoader);
+    if (host && host->remove(resourceLoader) && host != m_nonHTTPProtocolHost) {
+        ASSERT(m_httpRequestsInFlight);
+        --m_httpRequestsInFlight;
+    }
+    scheduleServePendingRequests();
+}
+
+void ResourceLoadScheduler::reprioritize(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    ASSERT(priority != ResourceLoadPriorityUnresolved);
+
+    HostInformation* host = hostForURL(resourceLoader->url());
+    if (!host || !host->reprioritize(resourceLoader, priority))
+        return;
+
+    LOG(ResourceLoading, "ResourceLoadScheduler::reprioritize resource %p '%s' to %d", resourceLoader, resourceLoader->url().string().latin1().data(), priority);
+
+    // Priorities change during layout and scrolling, where starting a load right away could run
+    // loader callbacks at a bad time. The timer fires on the next turn of the run loop.
     scheduleServePendingRequests();
 }
 
@@ -170,7 +202,12 @@ void ResourceLoadScheduler::crossOriginRedirectReceived(ResourceLoader* resource
         return;
     
     newHost->addLoadInProgress(resourceLoader);
-    oldHost->remove(resourceLoader);
+    if (newHost != m_nonHTTPProtocolHost)
+        ++m_httpRequestsInFlight;
+    if (oldHost->remove(resourceLoader) && oldHost != m_nonHTTPProtocolHost) {
+        ASSERT(m_httpRequestsInFlight);
+        --m_httpRequestsInFlight;
+    }
 }
 
 void ResourceLoadScheduler::servePendingRequests(ResourceLoadPriority minimumPriority)
@@ -179,23 +216,43 @@ void ResourceLoadScheduler::servePendingRequests(ResourceLoadPriority minimumPri
     if (isSuspendingPendingRequests())
         return;
 
+    // Starting a load can run script that asks for pending requests to be served again. The hosts
+    // collected below must stay alive until this pass is done, so serve those requests afterwards.
+    if (m_isServingPendingRequests) {
+        scheduleServePendingRequests();
+        return;
+    }
+    TemporaryChange<bool> servingPendingRequests(m_isServingPendingRequests, true);
+
     m_requestTimer.stop();
     
     servePendingRequests(m_nonHTTPProtocolHost, minimumPriority);
 
-    Vector<HostInformation*> hostsToServe;
+    Vector<HostInformation*> hosts;
     m_hosts.checkConsistency();
     HostMap::iterator end = m_hosts.end();
     for (HostMap::iterator iter = m_hosts.begin(); iter != end; ++iter)
-        hostsToServe.append(iter->value);
+        hosts.append(iter->value);
 
-    int size = hostsToServe.size();
-    for (int i = 0; i < size; ++i) {
-        HostInformation* host = hostsToServe[i];
-        if (host->hasRequests())
-            servePendingRequests(host, minimumPriority);
+    Vector<HostInformation*> hostsToServe;
+    for (size_t i = 0; i < hosts.size(); ++i) {
+        if (hosts[i]->hasRequests())
+            hostsToServe.append(hosts[i]);
         else
-            delete m_hosts.take(host->name());
+            delete m_hosts.take(hosts[i]->name());
+    }
+
+    // Serve the most important requests of all hosts first, and take one request from each host in
+    // turn so that the connection budget is shared between hosts instead of going to the first one.
+    for (int priority = ResourceLoadPriorityHighest; priority >= minimumPriority; --priority) {
+        bool startedRequest = true;
+        while (startedRequest) {
+            startedRequest = false;
+            for (size_t i = 0; i < hostsToServe.size(); ++i) {
+                if (serveNextPendingRequest(hostsToServe[i], ResourceLoadPriority(priority)))
+                    startedRequest = true;
+            }
+        }
     }
 }
 
@@ -204,24 +261,69 @@ void ResourceLoadScheduler::servePendingRequests(HostInformation* host, Resource
     LOG(ResourceLoading, "ResourceLoadScheduler::servePendingRequests HostInformation.m_name='%s'", host->name().latin1().data());
 
     for (int priority = ResourceLoadPriorityHighest; priority >= minimumPriority; --priority) {
-        HostInformation::RequestQueue& requestsPending = host->requestsPending(ResourceLoadPriority(priority));
-
-        while (!requestsPending.isEmpty()) {
-            RefPtr<ResourceLoader> resourceLoader = requestsPending.first();
-
-            // For named hosts - which are only http(s) hosts - we should always enforce the connection limit.
-            // For non-named hosts - everything but http(s) - we should only enforce the limit if the document isn't done parsing 
-            // and we don't know all stylesheets yet.
-            Document* document = resourceLoader->frameLoader() ? resourceLoader->frameLoader()->frame()->document() : 0;
-            bool shouldLimitRequests = !host->name().isNull() || (document && (document->parsing() || !document->haveStylesheetsLoaded()));
-            if (shouldLimitRequests && host->limitRequests(ResourceLoadPriority(priority)))
-                return;
-
-            requestsPending.removeFirst();
-            host->addLoadInProgress(resourceLoader.get());
-            resourceLoader->start();
-        }
+        while (serveNextPendingRequest(host, ResourceLoadPriority(priority))) { }
+        if (!host->requestsPending(ResourceLoadPriority(priority)).isEmpty())
+            return;
+    }
+}
+
+bool ResourceLoadScheduler::serveNextPendingRequest(HostInformation* host, ResourceLoadPriority priority)
+{
+    HostInformation::RequestQueue& requestsPending = host->requestsPending(priority);
+    if (requestsPending.isEmpty())
+        return false;
+
+    RefPtr<ResourceLoader> resourceLoader = requestsPending.first();
+
+    // For named hosts - which are only http(s) hosts - we should always enforce the connection limit.
+    // For non-named hosts - everything but http(s) - we should only enforce the limit if the document isn't done parsing 
+    // and we don't know all stylesheets yet.
+    Document* document = resourceLoader->frameLoader() ? resourceLoader->frameLoader()->frame()->document() : 0;
+    bool shouldLimitRequests = !host->name().isNull() || (document && (document->parsing() || !document->haveStylesheetsLoaded()));
+    if (shouldLimitRequests && host->limitRequests(priority))
+        return false;
+
+    bool isHTTPHost = host != m_nonHTTPProtocolHost;
+    if (isHTTPHost && exceedsConnectionBudget(priority)) {
+        if (!host->hasLoadsInProgress())
+            preconnectForHeldBackLoad(resourceLoader.get());
+        return false;
     }
+
+    requestsPending.removeFirst();
+    host->addLoadInProgress(resourceLoader.get());
+    if (isHTTPHost)
+        ++m_httpRequestsInFlight;
+    resourceLoader->start();
+    return true;
+}
+
+bool ResourceLoadScheduler::exceedsConnectionBudget(ResourceLoadPriority priority) const
+{
+    if (m_isSerialLoadingEnabled)
+        return false;
+    unsigned budget = maxHTTPRequestsInFlight;
+    if (priority < ResourceLoadPriorityMedium)
+        budget -= httpRequestsInFlightReservedForImportantLoads;
+    return m_httpRequestsInFlight >= budget;
+}
+
+void ResourceLoadScheduler::preconnectForHeldBackLoad(ResourceLoader* resourceLoader)
+{
+    // Only resources the preload scanner found early are worth a speculative connection. The wait
+    // for the connection budget then hides the DNS lookup and handshakes to their host.
+    if (!resourceLoader->isSubresourceLoader())
+        return;
+    CachedResource* resource = static_cast<SubresourceLoader*>(resourceLoader)->cachedResource();
+    if (!resource || !resource->isPreloaded())
+        return;
+
+    FrameLoader* frameLoader = resourceLoader->frameLoader();
+    Document* document = frameLoader ? frameLoader->frame()->document() : 0;
+    if (!document || !document->isDNSPrefetchEnabled() || resourceLoader->url().host() == document->url().host())
+        return;
+
+    PreconnectQueue::shared().add(resourceLoader->url(), frameLoader->networkingContext(), PreconnectQueue::SpeculativeConnection);
 }
 
 void ResourceLoadScheduler::suspendPendingRequests()
@@ -276,11 +378,11 @@ void ResourceLoadScheduler::HostInformation::addLoadInProgress(ResourceLoader* r
     m_requestsLoading.add(resourceLoader);
 }
     
-void ResourceLoadScheduler::HostInformation::remove(ResourceLoader* resourceLoader)
+bool ResourceLoadScheduler::HostInformation::remove(ResourceLoader* resourceLoader)
 {
     if (m_requestsLoading.contains(resourceLoader)) {
         m_requestsLoading.remove(resourceLoader);
-        return;
+        return true;
     }
     
     for (int priority = ResourceLoadPriorityHighest; priority >= ResourceLoadPriorityLowest; --priority) {  
@@ -288,10 +390,29 @@ void ResourceLoadScheduler::HostInformation::remove(ResourceLoader* resourceLoad
         for (RequestQueue::iterator it = m_requestsPending[priority].begin(); it != end; ++it) {
             if (*it == resourceLoader) {
                 m_requestsPending[priority].remove(it);
-                return;
+                return false;
             }
         }
     }
+    return false;
+}
+
+bool ResourceLoadScheduler::HostInformation::reprioritize(ResourceLoader* resourceLoader, ResourceLoadPriority newPriority)
+{
+    for (int priority = ResourceLoadPriorityHighest; priority >= ResourceLoadPriorityLowest; --priority) {
+        if (priority == newPriority)
+            continue;
+        RequestQueue::iterator end = m_requestsPending[priority].end();
+        for (RequestQueue::iterator it = m_requestsPending[priority].begin(); it != end; ++it) {
+            if (*it == resourceLoader) {
+                RefPtr<ResourceLoader> protect(resourceLoader);
+                m_requestsPending[priority].remove(it);
+                m_requestsPending[newPriority].append(resourceLoader);
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 bool ResourceLoadScheduler::HostInformation::hasRequests() const
@@ -54,6 +54,8 @@ public:
     virtual PassRefPtr<NetscapePlugInStreamLoader> schedulePluginStreamLoad(Frame*, NetscapePlugInStreamLoaderClient*, const ResourceRequest&);
     virtual void remove(ResourceLoader*);
     virtual void crossOriginRedirectReceived(ResourceLoader*, const KURL& redirectURL);
+    // Moves a load that has not started yet to the queue for its new priority.
+    virtual void reprioritize(ResourceLoader*, ResourceLoadPriority);
     
     virtual void servePendingRequests(ResourceLoadPriority minimumPriority = ResourceLoadPriorityVeryLow);
     virtual void suspendPendingRequests();
@@ -74,6 +76,8 @@ private:
     void requestTimerFired(Timer<ResourceLoadScheduler>*);
 
     bool isSuspendingPendingRequests() const { return !!m_suspendPendingRequestsCount; }
+    bool exceedsConnectionBudget(ResourceLoadPriority) const;
+    void preconnectForHeldBackLoad(ResourceLoader*);
 
     class HostInformation {
         WTF_MAKE_NONCOPYABLE(HostInformation); WTF_MAKE_FAST_ALLOCATED;
@@ -84,8 +88,11 @@ private:
         const String& name() const { return m_name; }
         void schedule(ResourceLoader*, ResourceLoadPriority = ResourceLoadPriorityVeryLow);
         void addLoadInProgress(ResourceLoader*);
-        void remove(ResourceLoader*);
+        // Returns true if the load was in progress rather than pending.
+        bool remove(ResourceLoader*);
+        bool reprioritize(ResourceLoader*, ResourceLoadPriority);
         bool hasRequests() const;
+        bool hasLoadsInProgress() const { return !m_requestsLoading.isEmpty(); }
         bool limitRequests(ResourceLoadPriority) const;
 
         typedef Deque<RefPtr<ResourceLoader> > RequestQueue;
@@ -106,15 +113,20 @@ private:
     
     HostInformation* hostForURL(const KURL&, CreateHostPolicy = FindOnly);
     void servePendingRequests(HostInformation*, ResourceLoadPriority);
+    bool serveNextPendingRequest(HostInformation*, ResourceLoadPriority);
 
     typedef HashMap<String, HostInformation*, StringHash> HostMap;
     HostMap m_hosts;
     HostInformation* m_nonHTTPProtocolHost;
+
+    // HTTP loads in progress across all hosts, which share one connection budget.
+    unsigned m_httpRequestsInFlight;
         
     Timer<ResourceLoadScheduler> m_requestTimer;
 
     unsigned m_suspendPendingRequestsCount;
     bool m_isSerialLoadingEnabled;
+    bool m_isServingPendingRequests;
 };
 
 ResourceLoadScheduler* resourceLoadScheduler();
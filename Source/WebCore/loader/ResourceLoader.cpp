@@ -49,6 +49,7 @@
 #include "SecurityOrigin.h"
 #include "Settings.h"
 #include "SharedBuffer.h"
+#include <wtf/CurrentTime.h>
 
 namespace WebCore {
 
@@ -61,6 +62,8 @@ ResourceLoader::ResourceLoader(Frame* frame, ResourceLoaderOptions options)
     , m_cancellationStatus(NotCancelled)
     , m_defersLoading(frame->page()->defersLoading())
     , m_options(options)
+    , m_scheduledTime(0)
+    , m_queueingDelay(0)
 {
 }
 
@@ -156,6 +159,9 @@ void ResourceLoader::start()
         return;
     }
 
+    if (m_scheduledTime)
+        m_queueingDelay = monotonicallyIncreasingTime() - m_scheduledTime;
+
     if (!m_reachedTerminalState)
         m_handle = ResourceHandle::create(m_frame->loader()->networkingContext(), m_request, this, m_defersLoading, m_options.sniffContent == SniffContent);
 }
@@ -269,6 +275,9 @@ void ResourceLoader::didReceiveResponse(const ResourceResponse& r)
 
     m_response = r;
 
+    if (ResourceLoadTiming* timing = m_response.resourceLoadTiming())
+        timing->queueingDelay = static_cast<int>(m_queueingDelay * 1000);
+
     if (FormData* data = m_request.httpBody())
         data->removeGeneratedFilesIfNeeded();
         
@@ -377,7 +386,11 @@ void ResourceLoader::didChangePriority(ResourceLoadPriority loadPriority)
     if (handle()) {
         frameLoader()->client()->dispatchDidChangeResourcePriority(identifier(), loadPriority);
         handle()->didChangePriority(loadPriority);
+        return;
     }
+    // The request has not been sent yet, so it goes out with the new priority.
+    m_request.setPriority(loadPriority);
+    resourceLoadScheduler()->reprioritize(this, loadPriority);
 }
 
 void ResourceLoader::cancel()
@@ -148,10 +148,12 @@ public:
 protected:
     ResourceLoader(Frame*, ResourceLoaderOptions);
 
-    friend class ResourceLoadScheduler; // for access to start()
+    friend class ResourceLoadScheduler; // for access to start() and setScheduledTime()
     // start() actually sends the load to the network (unless the load is being
     // deferred) and should only be called by ResourceLoadScheduler or setDefersLoading().
     void start();
+    // Lets start() measure how long the load was queued for, see ResourceLoadTiming::queueingDelay.
+    void setScheduledTime(double scheduledTime) { m_scheduledTime = scheduledTime; }
 
     void didFinishLoadingOnePart(double finishTime);
     void cleanupForError(const ResourceError&);
@@ -193,6 +195,9 @@ private:
     bool m_defersLoading;
     ResourceRequest m_deferredRequest;
     ResourceLoaderOptions m_options;
+
+    double m_scheduledTime;
+    double m_queueingDelay;
 };
 
 inline const ResourceResponse& ResourceLoader::response() const
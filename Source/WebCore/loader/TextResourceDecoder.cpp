@@ -26,12 +26,14 @@
 #include "DOMImplementation.h"
 #include "HTMLMetaCharsetParser.h"
 #include "HTMLNames.h"
+#include "ResourceBuffer.h"
 #include "TextCodec.h"
 #include "TextEncoding.h"
 #include "TextEncodingDetector.h"
 #include "TextEncodingRegistry.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/StringExtras.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace WTF;
 
@@ -345,6 +347,20 @@ TextResourceDecoder::~TextResourceDecoder()
 {
 }
 
+PassRefPtr<TextResourceDecoder> TextResourceDecoder::isolatedCopy() const
+{
+    ASSERT(!m_checkedForBOM && m_buffer.isEmpty() && !m_codec);
+
+    RefPtr<TextResourceDecoder> decoder = adoptRef(new TextResourceDecoder(String(), m_encoding, m_usesEncodingDetector));
+    decoder->m_contentType = m_contentType;
+    decoder->m_encoding = m_encoding;
+    decoder->m_source = m_source;
+    // Encoding names are static strings, shared by all threads.
+    decoder->m_hintEncoding = m_hintEncoding;
+    decoder->m_useLenientXMLDecoding = m_useLenientXMLDecoding;
+    return decoder.release();
+}
+
 void TextResourceDecoder::setEncoding(const TextEncoding& encoding, EncodingSource source)
 {
     // In case the encoding didn't exist, we keep the old one (helps some sites specifying invalid encodings).
@@ -653,6 +669,25 @@ String TextResourceDecoder::decode(const char* data, size_t len)
     return result;
 }
 
+String TextResourceDecoder::decode(const ResourceBuffer& data, unsigned position)
+{
+    const char* segment;
+    unsigned length = data.getSomeData(segment, position);
+    if (!length)
+        return String();
+
+    // Most buffers are stored in one piece, which needs no builder.
+    if (position + length >= data.size())
+        return decode(segment, length);
+
+    StringBuilder builder;
+    do {
+        builder.append(decode(segment, length));
+        position += length;
+    } while ((length = data.getSomeData(segment, position)));
+    return builder.toString();
+}
+
 String TextResourceDecoder::flush()
 {
    // If we can not identify the encoding even after a document is completely
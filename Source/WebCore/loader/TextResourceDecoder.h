@@ -29,6 +29,7 @@
 namespace WebCore {
 
 class HTMLMetaCharsetParser;
+class ResourceBuffer;
 
 class TextResourceDecoder : public RefCounted<TextResourceDecoder> {
 public:
@@ -51,8 +52,16 @@ public:
 
     void setEncoding(const TextEncoding&, EncodingSource);
     const TextEncoding& encoding() const { return m_encoding; }
+    EncodingSource encodingSource() const { return m_source; }
+
+    // A decoder in the same configuration, which can be used on another thread. Only valid
+    // before anything was decoded.
+    PassRefPtr<TextResourceDecoder> isolatedCopy() const;
 
     String decode(const char* data, size_t length);
+    // Decodes the buffer from the given position on, one stored segment at a time, so the buffer
+    // does not have to be merged into a single block first.
+    String decode(const ResourceBuffer&, unsigned position = 0);
     String flush();
 
     void setHintEncoding(const TextResourceDecoder* hintDecoder)
@@ -28,6 +28,7 @@
 #include "CachedCSSStyleSheet.h"
 
 #include "CSSStyleSheet.h"
+#include "CSSSubresourcePreloadScanner.h"
 #include "CachedResourceClientWalker.h"
 #include "CachedStyleSheetClient.h"
 #include "HTTPParsers.h"
@@ -40,9 +41,16 @@
 
 namespace WebCore {
 
+// Text decoded while a sheet loads is kept, so that finishLoading() does not have to decode it again,
+// but only up to this length. Past it the text is dropped and decoded again in one go at the end, so a
+// large sheet does not hold its text twice, encoded and decoded, for the whole load.
+static const unsigned maximumIncrementallyDecodedTextLength = 256 * 1024;
+
 CachedCSSStyleSheet::CachedCSSStyleSheet(const ResourceRequest& resourceRequest, const String& charset)
     : CachedResource(resourceRequest, CSSStyleSheet)
     , m_decoder(TextResourceDecoder::create("text/css", charset))
+    , m_incrementallyDecodedLength(0)
+    , m_keepsIncrementallyDecodedText(true)
 {
     // Prefer text/css but accept any type (dell.com serves a stylesheet
     // as text/html; see <http://bugs.webkit.org/show_bug.cgi?id=11451>).
@@ -88,26 +96,108 @@ const String CachedCSSStyleSheet::sheetText(bool enforceMIMEType, bool* hasValid
         return m_decodedSheetText;
     
     // Don't cache the decoded text, regenerating is cheap and it can use quite a bit of memory
-    String sheetText = m_decoder->decode(m_data->data(), m_data->size());
+    String sheetText = m_decoder->decode(*m_data);
     sheetText.append(m_decoder->flush());
     return sheetText;
 }
 
+void CachedCSSStyleSheet::addDataBuffer(ResourceBuffer* data)
+{
+    ASSERT(dataBufferingPolicy() == BufferData);
+    if (m_data && m_data != data)
+        resetIncrementalDecoding();
+    m_data = data;
+    // Decode as bytes arrive so that the work is spread over the load instead of happening all at once when the sheet is applied.
+    preloadSubresources(decodeIncrementalData());
+}
+
+String CachedCSSStyleSheet::decodeIncrementalData()
+{
+    if (!m_data)
+        return String();
+    unsigned size = m_data->size();
+    if (size <= m_incrementallyDecodedLength)
+        return String();
+    String decodedText = m_decoder->decode(*m_data, m_incrementallyDecodedLength);
+    m_incrementallyDecodedLength = size;
+    if (m_keepsIncrementallyDecodedText && m_incrementallyDecodedText.length() + decodedText.length() > maximumIncrementallyDecodedTextLength) {
+        m_keepsIncrementallyDecodedText = false;
+        m_incrementallyDecodedText.clear();
+    }
+    if (m_keepsIncrementallyDecodedText)
+        m_incrementallyDecodedText.append(decodedText);
+    return decodedText;
+}
+
+void CachedCSSStyleSheet::preloadSubresources(const String& decodedText)
+{
+    if (decodedText.isEmpty())
+        return;
+    // The scanner has to see all of the text to keep track of where it is, even while nobody is waiting for the sheet.
+    if (!m_preloadScanner)
+        m_preloadScanner = adoptPtr(new CSSSubresourcePreloadScanner(m_response.url().isEmpty() ? m_resourceRequest.url() : m_response.url()));
+    PreloadRequestStream requests;
+    m_preloadScanner->scan(decodedText, requests);
+    if (requests.isEmpty())
+        return;
+
+    CachedResourceClientWalker<CachedStyleSheetClient> w(m_clients);
+    while (CachedStyleSheetClient* c = w.next()) {
+        PreloadRequestStream copies;
+        copies.reserveInitialCapacity(requests.size());
+        for (size_t i = 0; i < requests.size(); ++i)
+            copies.append(requests[i]->copy());
+        c->preloadSubresources(copies);
+    }
+}
+
+void CachedCSSStyleSheet::resetIncrementalDecoding()
+{
+    if (!m_incrementallyDecodedLength)
+        return;
+    // Flushing drops any partial character the decoder is holding on to.
+    m_decoder->flush();
+    m_preloadScanner.clear();
+    m_incrementallyDecodedText.clear();
+    m_incrementallyDecodedLength = 0;
+    m_keepsIncrementallyDecodedText = true;
+}
+
 void CachedCSSStyleSheet::finishLoading(ResourceBuffer* data)
 {
+    if (m_data != data)
+        resetIncrementalDecoding();
     m_data = data;
     setEncodedSize(m_data.get() ? m_data->size() : 0);
     // Decode the data to find out the encoding and keep the sheet text around during checkNotify()
     if (m_data) {
-        m_decodedSheetText = m_decoder->decode(m_data->data(), m_data->size());
-        m_decodedSheetText.append(m_decoder->flush());
+        decodeIncrementalData();
+        String flushedText = m_decoder->flush();
+        if (m_keepsIncrementallyDecodedText) {
+            m_incrementallyDecodedText.append(flushedText);
+            m_decodedSheetText = m_incrementallyDecodedText.toString();
+        } else {
+            m_decodedSheetText = m_decoder->decode(*m_data);
+            m_decodedSheetText.append(m_decoder->flush());
+        }
     }
+    m_incrementallyDecodedText.clear();
+    m_incrementallyDecodedLength = 0;
+    m_keepsIncrementallyDecodedText = true;
+    // The sheet is parsed now, which loads everything it refers to.
+    m_preloadScanner.clear();
     setLoading(false);
     checkNotify();
     // Clear the decoded text as it is unlikely to be needed immediately again and is cheap to regenerate.
     m_decodedSheetText = String();
 }
 
+void CachedCSSStyleSheet::error(CachedResource::Status status)
+{
+    resetIncrementalDecoding();
+    CachedResource::error(status);
+}
+
 void CachedCSSStyleSheet::checkNotify()
 {
     if (isLoading())
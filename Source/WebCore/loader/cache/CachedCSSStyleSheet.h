@@ -27,10 +27,13 @@
 #define CachedCSSStyleSheet_h
 
 #include "CachedResource.h"
+#include <wtf/OwnPtr.h>
 #include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
 
 namespace WebCore {
 
+    class CSSSubresourcePreloadScanner;
     class CachedResourceClient;
     class StyleSheetContents;
     class TextResourceDecoder;
@@ -55,15 +58,29 @@ namespace WebCore {
 
         virtual void setEncoding(const String&) OVERRIDE;
         virtual String encoding() const OVERRIDE;
+        virtual void addDataBuffer(ResourceBuffer*) OVERRIDE;
         virtual void finishLoading(ResourceBuffer*) OVERRIDE;
+        virtual void error(CachedResource::Status) OVERRIDE;
         virtual void destroyDecodedData() OVERRIDE;
 
+        String decodeIncrementalData();
+        void resetIncrementalDecoding();
+        void preloadSubresources(const String& decodedText);
+
     protected:
         virtual void checkNotify();
 
         RefPtr<TextResourceDecoder> m_decoder;
         String m_decodedSheetText;
 
+        // Text decoded so far while the sheet is still loading, covering the first m_incrementallyDecodedLength bytes of m_data.
+        StringBuilder m_incrementallyDecodedText;
+        unsigned m_incrementallyDecodedLength;
+        // False once the sheet has grown too large to keep its decoded text while it loads.
+        bool m_keepsIncrementallyDecodedText;
+        // Looks for the resources the sheet refers to in the incrementally decoded text.
+        OwnPtr<CSSSubresourcePreloadScanner> m_preloadScanner;
+
         RefPtr<StyleSheetContents> m_parsedStyleSheetCache;
     };
 
@@ -41,16 +41,21 @@ CachedRawResource::CachedRawResource(ResourceRequest& resourceRequest, Type type
 {
 }
 
-const char* CachedRawResource::calculateIncrementalDataChunk(ResourceBuffer* data, unsigned& incrementalDataLength)
+void CachedRawResource::notifyClientsOfIncrementalData(ResourceBuffer* data)
 {
-    incrementalDataLength = 0;
     if (!data)
-        return 0;
+        return;
+
+    unsigned position = encodedSize();
+    ASSERT(data->size() >= position);
+    setEncodedSize(data->size());
 
-    unsigned previousDataLength = encodedSize();
-    ASSERT(data->size() >= previousDataLength);
-    incrementalDataLength = data->size() - previousDataLength;
-    return data->data() + previousDataLength;
+    // Hand out the new bytes in the segments the buffer stores them in rather than merging it.
+    const char* segment;
+    while (unsigned length = data->getSomeData(segment, position)) {
+        notifyClientsDataWasReceived(segment, length);
+        position += length;
+    }
 }
 
 void CachedRawResource::addDataBuffer(ResourceBuffer* data)
@@ -58,12 +63,7 @@ void CachedRawResource::addDataBuffer(ResourceBuffer* data)
     CachedResourceHandle<CachedRawResource> protect(this);
     ASSERT(m_options.dataBufferingPolicy == BufferData);
     m_data = data;
-
-    unsigned incrementalDataLength;
-    const char* incrementalData = calculateIncrementalDataChunk(data, incrementalDataLength);
-    if (data)
-        setEncodedSize(data->size());
-    notifyClientsDataWasReceived(incrementalData, incrementalDataLength);
+    notifyClientsOfIncrementalData(data);
     if (m_options.dataBufferingPolicy == DoNotBufferData) {
         if (m_loader)
             m_loader->setDataBufferingPolicy(DoNotBufferData);
@@ -83,12 +83,7 @@ void CachedRawResource::finishLoading(ResourceBuffer* data)
     DataBufferingPolicy dataBufferingPolicy = m_options.dataBufferingPolicy;
     if (dataBufferingPolicy == BufferData) {
         m_data = data;
-
-        unsigned incrementalDataLength;
-        const char* incrementalData = calculateIncrementalDataChunk(data, incrementalDataLength);
-        if (data)
-            setEncodedSize(data->size());
-        notifyClientsDataWasReceived(incrementalData, incrementalDataLength);
+        notifyClientsOfIncrementalData(data);
     }
 
     CachedResource::finishLoading(data);
@@ -133,8 +128,16 @@ void CachedRawResource::didAddClient(CachedResourceClient* c)
         client->responseReceived(this, m_response);
     if (!hasClient(c))
         return;
-    if (m_data)
-        client->dataReceived(this, m_data->data(), m_data->size());
+    if (RefPtr<ResourceBuffer> data = m_data) {
+        const char* segment;
+        unsigned position = 0;
+        while (unsigned length = data->getSomeData(segment, position)) {
+            client->dataReceived(this, segment, length);
+            if (!hasClient(c))
+                return;
+            position += length;
+        }
+    }
     if (!hasClient(c))
        return;
     CachedResource::didAddClient(client);
@@ -64,7 +64,7 @@ private:
 
     virtual bool canReuse(const ResourceRequest&) const OVERRIDE;
 
-    const char* calculateIncrementalDataChunk(ResourceBuffer*, unsigned& incrementalDataLength);
+    void notifyClientsOfIncrementalData(ResourceBuffer*);
     void notifyClientsDataWasReceived(const char* data, unsigned length);
 
 #if USE(SOUP)
@@ -57,7 +57,7 @@ void CachedSVGDocument::finishLoading(ResourceBuffer* data)
 {
     if (data) {
         StringBuilder decodedText;
-        decodedText.append(m_decoder->decode(data->data(), data->size()));
+        decodedText.append(m_decoder->decode(*data));
         decodedText.append(m_decoder->flush());
         // We don't need to create a new frame because the new document belongs to the parent UseElement.
         m_document = SVGDocument::create(0, response().url());
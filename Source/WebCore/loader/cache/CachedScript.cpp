@@ -73,7 +73,7 @@ const String& CachedScript::script()
     ASSERT(!isPurgeable());
 
     if (!m_script && m_data) {
-        m_script = m_decoder->decode(m_data->data(), encodedSize());
+        m_script = m_decoder->decode(*m_data);
         m_script.append(m_decoder->flush());
         setDecodedSize(m_script.sizeInBytes());
     }
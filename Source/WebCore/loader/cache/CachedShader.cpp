@@ -52,7 +52,7 @@ const String& CachedShader::shaderString()
 {
     if (m_shaderString.isNull() && m_data) {
         StringBuilder builder;
-        builder.append(m_decoder->decode(m_data->data(), m_data->size()));
+        builder.append(m_decoder->decode(*m_data));
         builder.append(m_decoder->flush());
         m_shaderString = builder.toString();
     }
@@ -27,6 +27,7 @@
 #define CachedStyleSheetClient_h
 
 #include "CachedResourceClient.h"
+#include "HTMLResourcePreloader.h"
 #include <wtf/Forward.h>
 
 namespace WebCore {
@@ -41,6 +42,9 @@ public:
     virtual CachedResourceClientType resourceClientType() const { return expectedType(); }
     virtual void setCSSStyleSheet(const String& /* href */, const KURL& /* baseURL */, const String& /* charset */, const CachedCSSStyleSheet*) { }
     virtual void setXSLStyleSheet(const String& /* href */, const KURL& /* baseURL */, const String& /* sheet */) { }
+    // Called while a CSS style sheet loads with the resources its text refers to. The sheet can be
+    // shared by several documents, so every client gets its own copy of the requests.
+    virtual void preloadSubresources(PreloadRequestStream&) { }
 };
 
 } // namespace WebCore
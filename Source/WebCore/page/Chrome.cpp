@@ -31,6 +31,7 @@
 #include "FileList.h"
 #include "FloatRect.h"
 #include "Frame.h"
+#include "FrameLoader.h"
 #include "FrameTree.h"
 #include "Geolocation.h"
 #include "HTMLFormElement.h"
@@ -42,6 +43,7 @@
 #include "Page.h"
 #include "PageGroupLoadDeferrer.h"
 #include "PopupOpeningObserver.h"
+#include "PreconnectQueue.h"
 #include "RenderObject.h"
 #include "ResourceHandle.h"
 #include "SecurityOrigin.h"
@@ -389,8 +391,14 @@ void Chrome::mouseDidMoveOverElement(const HitTestResult& result, unsigned modif
 {
     if (result.innerNode()) {
         Document* document = result.innerNode()->document();
-        if (document && document->isDNSPrefetchEnabled())
-            prefetchDNS(result.absoluteLinkURL().host());
+        if (document && document->isDNSPrefetchEnabled()) {
+            // A hovered link is likely to be followed, so have a connection ready for it.
+            KURL linkURL = result.absoluteLinkURL();
+            if (linkURL.protocolIsInHTTPFamily() && document->frame())
+                PreconnectQueue::shared().add(linkURL, document->frame()->loader()->networkingContext(), PreconnectQueue::SpeculativeConnection);
+            else
+                prefetchDNS(linkURL.host());
+        }
     }
     m_client->mouseDidMoveOverElement(result, modifierFlags);
 
@@ -893,6 +893,20 @@ Color Frame::tiledBackingStoreBackgroundColor() const
         return Color();
     return m_view->baseBackgroundColor();
 }
+
+bool Frame::tiledBackingStoreRasterizesOnWorkerThreads() const
+{
+#if USE(DISPLAY_LIST_RECORDING)
+    return m_page && m_page->settings()->displayListRecordingEnabled();
+#else
+    return false;
+#endif
+}
+
+size_t Frame::tiledBackingStoreMemoryBudget() const
+{
+    return m_page ? m_page->settings()->tiledBackingStoreMemoryBudget() : 0;
+}
 #endif
 
 String Frame::layerTreeAsText(LayerTreeFlags flags) const
@@ -251,6 +251,8 @@ namespace WebCore {
         virtual IntRect tiledBackingStoreContentsRect();
         virtual IntRect tiledBackingStoreVisibleRect();
         virtual Color tiledBackingStoreBackgroundColor() const;
+        virtual bool tiledBackingStoreRasterizesOnWorkerThreads() const;
+        virtual size_t tiledBackingStoreMemoryBudget() const;
 
         OwnPtr<TiledBackingStore> m_tiledBackingStore;
 #endif
@@ -273,12 +273,15 @@ void FrameView::reset()
     m_borderY = 30;
     m_layoutTimer.stop();
     m_layoutRoot = 0;
+    m_additionalLayoutRoots.clear();
     m_delayedLayout = false;
     m_doFullRepaint = true;
     m_layoutSchedulingEnabled = true;
     m_layoutPhase = OutsideLayout;
     m_inSynchronousPostLayout = false;
     m_layoutCount = 0;
+    m_renderersLaidOutInLastLayout = 0;
+    m_layoutRootsInLastLayout = 0;
     m_nestedLayoutCount = 0;
     m_postLayoutTasksTimer.stop();
     m_firstLayout = true;
@@ -1088,6 +1091,47 @@ RenderObject* FrameView::layoutRoot(bool onlyDuringLayout) const
     return onlyDuringLayout && layoutPending() ? 0 : m_layoutRoot;
 }
 
+bool FrameView::isLayoutRoot(const RenderObject* object) const
+{
+    return object && (object == m_layoutRoot || m_additionalLayoutRoots.contains(object));
+}
+
+void FrameView::clearLayoutRoot(const RenderObject* object)
+{
+    if (object == m_layoutRoot) {
+        m_layoutRoot = 0;
+        if (!m_additionalLayoutRoots.isEmpty()) {
+            m_layoutRoot = m_additionalLayoutRoots.last();
+            m_additionalLayoutRoots.removeLast();
+        }
+        return;
+    }
+
+    size_t index = m_additionalLayoutRoots.find(object);
+    if (index != notFound)
+        m_additionalLayoutRoots.remove(index);
+}
+
+RenderObject* FrameView::layoutRootContaining(RenderObject* object) const
+{
+    for (RenderObject* r = object; r; r = r->container()) {
+        if (isLayoutRoot(r))
+            return r;
+    }
+    return 0;
+}
+
+void FrameView::convertSubtreeLayoutToFullLayout()
+{
+    ASSERT(m_layoutRoot);
+    m_layoutRoot->markContainingBlocksForLayout(false);
+    m_layoutRoot = 0;
+
+    for (size_t i = 0; i < m_additionalLayoutRoots.size(); ++i)
+        m_additionalLayoutRoots[i]->markContainingBlocksForLayout(false);
+    m_additionalLayoutRoots.clear();
+}
+
 static inline void collectFrameViewChildren(const FrameView* frameView, Vector<RefPtr<FrameView> >& frameViews)
 {
     const HashSet<RefPtr<Widget> >* viewChildren = frameView->children();
@@ -1174,10 +1218,8 @@ void FrameView::layout(bool allowSubtree)
 
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willLayout(m_frame.get());
 
-    if (!allowSubtree && m_layoutRoot) {
-        m_layoutRoot->markContainingBlocksForLayout(false);
-        m_layoutRoot = 0;
-    }
+    if (!allowSubtree && m_layoutRoot)
+        convertSubtreeLayoutToFullLayout();
 
     ASSERT(m_frame->view() == this);
 
@@ -1234,6 +1276,7 @@ void FrameView::layout(bool allowSubtree)
 
     FontCachePurgePreventer fontCachePurgePreventer;
     RenderLayer* layer;
+    Vector<RenderLayer*> additionalLayers;
     {
         TemporaryChange<bool> changeSchedulingEnabled(m_layoutSchedulingEnabled, false);
 
@@ -1319,6 +1362,8 @@ void FrameView::layout(bool allowSubtree)
 
         m_actionScheduler->pause();
 
+        unsigned renderersLaidOutBeforeLayout = RenderObject::renderersLaidOutCount();
+
         {
             bool disableLayoutState = false;
             if (subtree) {
@@ -1349,7 +1394,33 @@ void FrameView::layout(bool allowSubtree)
             if (subtree)
                 root->view()->popLayoutState(root);
         }
+
+        // The other roots are strictly contained and independent of |root|, so they are laid out in this
+        // same pass. Each becomes m_layoutRoot while it is laid out so it keeps its logical width.
+        Vector<RenderObject*> additionalRoots;
+        additionalRoots.swap(m_additionalLayoutRoots);
+        for (size_t i = 0; i < additionalRoots.size(); ++i) {
+            RenderObject* additionalRoot = additionalRoots[i];
+            if (!additionalRoot->needsLayout())
+                continue;
+
+            m_layoutRoot = additionalRoot;
+            RenderView* view = additionalRoot->view();
+            bool disableLayoutState = view->shouldDisableLayoutStateForSubtree(additionalRoot);
+            view->pushLayoutState(additionalRoot);
+            {
+                LayoutStateDisabler layoutStateDisabler(disableLayoutState ? view : 0);
+                beginDeferredRepaints();
+                additionalRoot->layout();
+                endDeferredRepaints();
+            }
+            view->popLayoutState(additionalRoot);
+            additionalLayers.append(additionalRoot->enclosingLayer());
+        }
         m_layoutRoot = 0;
+
+        m_renderersLaidOutInLastLayout = RenderObject::renderersLaidOutCount() - renderersLaidOutBeforeLayout;
+        m_layoutRootsInLastLayout = 1 + additionalLayers.size();
     } // Reset m_layoutSchedulingEnabled to its previous value.
 
     m_layoutPhase = InViewSizeAdjust;
@@ -1370,6 +1441,8 @@ void FrameView::layout(bool allowSubtree)
                                  // to work out most of the time, since first layouts and printing don't have you scrolled anywhere.
 
     layer->updateLayerPositionsAfterLayout(renderView()->layer(), updateLayerPositionFlags(layer, subtree, m_doFullRepaint));
+    for (size_t i = 0; i < additionalLayers.size(); ++i)
+        additionalLayers[i]->updateLayerPositionsAfterLayout(renderView()->layer(), updateLayerPositionFlags(additionalLayers[i], true, m_doFullRepaint));
 
     endDeferredRepaints();
 
@@ -2045,12 +2118,16 @@ void FrameView::scrollPositionChanged()
     frame()->eventHandler()->sendScrollEvent();
     frame()->eventHandler()->dispatchFakeMouseMoveEventSoon();
 
-#if USE(ACCELERATED_COMPOSITING)
     if (RenderView* renderView = this->renderView()) {
+        if (!isInLayout()) {
+            renderView->updateDeferredTableRowsNearViewport();
+            renderView->promoteLoadingImagesInViewport();
+        }
+#if USE(ACCELERATED_COMPOSITING)
         if (renderView->usesCompositing())
             renderView->compositor()->frameViewDidScroll();
-    }
 #endif
+    }
 }
 
 // FIXME: this function is misnamed; its primary purpose is to update RenderLayer positions.
@@ -2244,6 +2321,14 @@ void FrameView::visibleContentsResized()
     if (!frame()->view())
         return;
 
+    // A taller viewport can bring table rows whose layout was deferred into view.
+    if (RenderView* renderView = this->renderView()) {
+        if (!isInLayout()) {
+            renderView->updateDeferredTableRowsNearViewport();
+            renderView->promoteLoadingImagesInViewport();
+        }
+    }
+
     if (!useFixedLayout() && needsLayout())
         layout();
 
@@ -2446,10 +2531,8 @@ void FrameView::scheduleRelayout()
     // too many false assertions.  See <rdar://problem/7218118>.
     ASSERT(m_frame->view() == this);
 
-    if (m_layoutRoot) {
-        m_layoutRoot->markContainingBlocksForLayout(false);
-        m_layoutRoot = 0;
-    }
+    if (m_layoutRoot)
+        convertSubtreeLayoutToFullLayout();
     if (!m_layoutSchedulingEnabled)
         return;
     if (!needsLayout())
@@ -2499,26 +2582,54 @@ void FrameView::scheduleRelayoutOfSubtree(RenderObject* relayoutRoot)
     }
 
     if (layoutPending() || !m_layoutSchedulingEnabled) {
-        if (m_layoutRoot != relayoutRoot) {
-            if (isObjectAncestorContainerOf(m_layoutRoot, relayoutRoot)) {
-                // Keep the current root
-                relayoutRoot->markContainingBlocksForLayout(false, m_layoutRoot);
-                ASSERT(!m_layoutRoot->container() || !m_layoutRoot->container()->needsLayout());
-            } else if (m_layoutRoot && isObjectAncestorContainerOf(relayoutRoot, m_layoutRoot)) {
-                // Re-root at relayoutRoot
-                m_layoutRoot->markContainingBlocksForLayout(false, relayoutRoot);
-                m_layoutRoot = relayoutRoot;
-                ASSERT(!m_layoutRoot->container() || !m_layoutRoot->container()->needsLayout());
-                InspectorInstrumentation::didInvalidateLayout(m_frame.get());
-            } else {
-                // Just do a full relayout
-                if (m_layoutRoot)
-                    m_layoutRoot->markContainingBlocksForLayout(false);
-                m_layoutRoot = 0;
-                relayoutRoot->markContainingBlocksForLayout(false);
-                InspectorInstrumentation::didInvalidateLayout(m_frame.get());
+        if (RenderObject* enclosingRoot = layoutRootContaining(relayoutRoot)) {
+            // Keep the current root
+            if (enclosingRoot != relayoutRoot) {
+                relayoutRoot->markContainingBlocksForLayout(false, enclosingRoot);
+                ASSERT(!enclosingRoot->container() || !enclosingRoot->container()->needsLayout());
             }
+            return;
+        }
+
+        if (!m_layoutRoot) {
+            // A full relayout is already pending
+            relayoutRoot->markContainingBlocksForLayout(false);
+            InspectorInstrumentation::didInvalidateLayout(m_frame.get());
+            return;
+        }
+
+        // Re-root the current roots that relayoutRoot contains at relayoutRoot
+        Vector<RenderObject*> remainingRoots;
+        if (isObjectAncestorContainerOf(relayoutRoot, m_layoutRoot))
+            m_layoutRoot->markContainingBlocksForLayout(false, relayoutRoot);
+        else
+            remainingRoots.append(m_layoutRoot);
+        for (size_t i = 0; i < m_additionalLayoutRoots.size(); ++i) {
+            RenderObject* root = m_additionalLayoutRoots[i];
+            if (isObjectAncestorContainerOf(relayoutRoot, root))
+                root->markContainingBlocksForLayout(false, relayoutRoot);
+            else
+                remainingRoots.append(root);
         }
+
+        // Unrelated roots can only share a layout pass when all of them are strictly contained
+        bool rootsAreIndependent = relayoutRoot->hasLayoutContainment();
+        for (size_t i = 0; rootsAreIndependent && i < remainingRoots.size(); ++i)
+            rootsAreIndependent = remainingRoots[i]->hasLayoutContainment();
+
+        if (remainingRoots.isEmpty() || rootsAreIndependent) {
+            m_layoutRoot = relayoutRoot;
+            m_additionalLayoutRoots.swap(remainingRoots);
+            ASSERT(!m_layoutRoot->container() || !m_layoutRoot->container()->needsLayout());
+        } else {
+            // Just do a full relayout
+            for (size_t i = 0; i < remainingRoots.size(); ++i)
+                remainingRoots[i]->markContainingBlocksForLayout(false);
+            m_layoutRoot = 0;
+            m_additionalLayoutRoots.clear();
+            relayoutRoot->markContainingBlocksForLayout(false);
+        }
+        InspectorInstrumentation::didInvalidateLayout(m_frame.get());
     } else if (m_layoutSchedulingEnabled) {
         int delay = m_frame->document()->minimumLayoutDelay();
         m_layoutRoot = relayoutRoot;
@@ -2851,8 +2962,10 @@ void FrameView::performPostLayoutTasks()
     // with didLayout(LayoutMilestones).
     m_frame->loader()->client()->dispatchDidLayout();
 
-    if (RenderView* renderView = this->renderView())
+    if (RenderView* renderView = this->renderView()) {
         renderView->updateWidgetPositions();
+        renderView->promoteLoadingImagesInViewport();
+    }
     
     // layout() protects FrameView, but it still can get destroyed when updateWidgets()
     // is called through the post layout timer.
@@ -108,8 +108,11 @@ public:
     bool isInLayout() const { return m_layoutPhase == InLayout; }
 
     RenderObject* layoutRoot(bool onlyDuringLayout = false) const;
-    void clearLayoutRoot() { m_layoutRoot = 0; }
+    bool isLayoutRoot(const RenderObject*) const;
+    void clearLayoutRoot(const RenderObject*);
     int layoutCount() const { return m_layoutCount; }
+    unsigned renderersLaidOutInLastLayout() const { return m_renderersLaidOutInLastLayout; }
+    unsigned layoutRootsInLastLayout() const { return m_layoutRootsInLastLayout; }
 
     bool needsLayout() const;
     void setNeedsLayout();
@@ -484,6 +487,8 @@ private:
     void paintControlTints();
 
     void forceLayoutParentViewIfNeeded();
+    RenderObject* layoutRootContaining(RenderObject*) const;
+    void convertSubtreeLayoutToFullLayout();
     void performPostLayoutTasks();
     void autoSizeIfEnabled();
 
@@ -581,11 +586,16 @@ private:
     Timer<FrameView> m_layoutTimer;
     bool m_delayedLayout;
     RenderObject* m_layoutRoot;
+    // Strictly contained subtrees that are laid out in the same pass as m_layoutRoot. None of the
+    // roots contains another, so each one can be laid out on its own.
+    Vector<RenderObject*> m_additionalLayoutRoots;
 
     LayoutPhase m_layoutPhase;
     bool m_layoutSchedulingEnabled;
     bool m_inSynchronousPostLayout;
     int m_layoutCount;
+    unsigned m_renderersLaidOutInLastLayout;
+    unsigned m_layoutRootsInLastLayout;
     unsigned m_nestedLayoutCount;
     Timer<FrameView> m_postLayoutTasksTimer;
     bool m_firstLayoutCallbackPending;
@@ -59,6 +59,7 @@ AnimationControllerPrivate::AnimationControllerPrivate(Frame* frame)
     , m_animationsWaitingForStartTimeResponse()
     , m_waitingForAsyncStartNotification(false)
     , m_isSuspended(false)
+    , m_numberOfAnimatedElementsInLastUpdate(0)
 {
 }
 
@@ -88,7 +89,7 @@ bool AnimationControllerPrivate::clear(RenderObject* renderer)
 double AnimationControllerPrivate::updateAnimations(SetChanged callSetChanged/* = DoNotCallSetChanged*/)
 {
     double timeToNextService = -1;
-    bool calledSetChanged = false;
+    unsigned numberOfAnimatedElements = 0;
 
     RenderObjectAnimationMap::const_iterator animationsEnd = m_compositeAnimations.end();
     for (RenderObjectAnimationMap::const_iterator it = m_compositeAnimations.begin(); it != animationsEnd; ++it) {
@@ -102,7 +103,7 @@ double AnimationControllerPrivate::updateAnimations(SetChanged callSetChanged/*
                     Node* node = it->key->node();
                     ASSERT(!node || (node->document() && !node->document()->inPageCache()));
                     node->setNeedsStyleRecalc(SyntheticStyleChange);
-                    calledSetChanged = true;
+                    ++numberOfAnimatedElements;
                 }
                 else
                     break;
@@ -110,7 +111,13 @@ double AnimationControllerPrivate::updateAnimations(SetChanged callSetChanged/*
         }
     }
 
-    if (calledSetChanged)
+    if (callSetChanged == CallSetChanged) {
+        m_numberOfAnimatedElementsInLastUpdate = numberOfAnimatedElements;
+        LOG(Animations, "updateAnimations: %u animated elements in this update", numberOfAnimatedElements);
+    }
+
+    // All the elements are marked first so that a single style recalc picks up every animation of the frame.
+    if (numberOfAnimatedElements)
         m_frame->document()->updateStyleIfNeeded();
 
     return timeToNextService;
@@ -140,6 +147,12 @@ void AnimationControllerPrivate::updateAnimationTimer(SetChanged callSetChanged/
     if (!timeToNextService) {
         if (!m_animationTimer.isActive() || m_animationTimer.repeatInterval() == 0)
             m_animationTimer.startRepeating(cAnimationTimerDelay);
+#if ENABLE(REQUEST_ANIMATION_FRAME)
+        // Prefer updating on the next display refresh, together with requestAnimationFrame callbacks.
+        // The timer stays as a fallback for clients that never service animations.
+        if (FrameView* view = m_frame->view())
+            view->scheduleAnimation();
+#endif
         return;
     }
 
@@ -220,10 +233,12 @@ void AnimationControllerPrivate::addNodeChangeToDispatch(PassRefPtr<Node> node)
 #if ENABLE(REQUEST_ANIMATION_FRAME)
 void AnimationControllerPrivate::animationFrameCallbackFired()
 {
-    double timeToNextService = updateAnimations(CallSetChanged);
-
-    if (timeToNextService >= 0)
-        m_frame->document()->view()->scheduleAnimation();
+    // Same work as animationTimerFired(), driven by the display refresh tick that services all frames
+    // of the page at once. Restarting the timer pushes the fallback back as long as ticks keep coming.
+    setBeginAnimationUpdateTime(cBeginAnimationUpdateTimeNotSet);
+    m_animationTimer.stop();
+    updateAnimationTimer(CallSetChanged);
+    fireEventsAndUpdateStyle();
 }
 #endif
 
@@ -571,6 +586,11 @@ unsigned AnimationController::numberOfActiveAnimations(Document* document) const
     return m_data->numberOfActiveAnimations(document);
 }
 
+unsigned AnimationController::numberOfAnimatedElementsInLastUpdate() const
+{
+    return m_data->numberOfAnimatedElementsInLastUpdate();
+}
+
 bool AnimationController::pauseTransitionAtTime(RenderObject* renderer, const String& property, double t)
 {
     return m_data->pauseTransitionAtTime(renderer, property, t);
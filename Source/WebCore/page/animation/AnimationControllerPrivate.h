@@ -92,6 +92,7 @@ public:
     bool pauseAnimationAtTime(RenderObject*, const AtomicString& name, double t);
     bool pauseTransitionAtTime(RenderObject*, const String& property, double t);
     unsigned numberOfActiveAnimations(Document*) const;
+    unsigned numberOfAnimatedElementsInLastUpdate() const { return m_numberOfAnimatedElementsInLastUpdate; }
 
     PassRefPtr<RenderStyle> getAnimatedStyleForRenderer(RenderObject* renderer);
 
@@ -142,6 +143,7 @@ private:
     WaitingAnimationsSet m_animationsWaitingForStartTimeResponse;
     bool m_waitingForAsyncStartNotification;
     bool m_isSuspended;
+    unsigned m_numberOfAnimatedElementsInLastUpdate;
 };
 
 } // namespace WebCore
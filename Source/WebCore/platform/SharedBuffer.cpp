@@ -28,7 +28,9 @@
 #include "SharedBuffer.h"
 
 #include "PurgeableBuffer.h"
+#include <algorithm>
 #include <wtf/PassOwnPtr.h>
+#include <wtf/Threading.h>
 #include <wtf/unicode/UTF8.h>
 #include <wtf/unicode/Unicode.h>
 
@@ -39,6 +41,15 @@ namespace WebCore {
 static const unsigned segmentSize = 0x1000;
 static const unsigned segmentPositionMask = 0x0FFF;
 
+// Buffers are used off the main thread too, so the count is only updated under a lock.
+static Mutex& linearizedByteCountMutex()
+{
+    AtomicallyInitializedStatic(Mutex&, mutex = *new Mutex);
+    return mutex;
+}
+
+static unsigned long long s_linearizedByteCount;
+
 static inline unsigned segmentIndex(unsigned position)
 {
     return position / segmentSize;
@@ -59,19 +70,53 @@ static inline void freeSegment(char* p)
     fastFree(p);
 }
 
+// Holds bytes appended after a DataSegment, which have to stay behind it in order. It is allocated
+// with room for at least a full segment so that following small appends can be copied into it.
+class OwnedDataSegment : public SharedBuffer::DataSegment {
+public:
+    static PassRefPtr<OwnedDataSegment> create(const char* data, unsigned length) { return adoptRef(new OwnedDataSegment(data, length)); }
+
+    virtual const char* data() const OVERRIDE { return m_data.data(); }
+    virtual unsigned size() const OVERRIDE { return m_data.size(); }
+
+    unsigned freeSpace() const { return m_data.capacity() - m_data.size(); }
+
+    void append(const char* data, unsigned length)
+    {
+        // Growing past the capacity would move bytes getSomeData() may have handed out.
+        ASSERT(length <= freeSpace());
+        m_data.append(data, length);
+    }
+
+private:
+    OwnedDataSegment(const char* data, unsigned length)
+    {
+        m_data.reserveInitialCapacity(max(length, segmentSize));
+        m_data.append(data, length);
+    }
+
+    Vector<char> m_data;
+};
+
 SharedBuffer::SharedBuffer()
     : m_size(0)
+    , m_dataSegmentsSize(0)
+    , m_appendableDataSegment(0)
 {
 }
 
 SharedBuffer::SharedBuffer(size_t size)
     : m_size(size)
+    , m_dataSegmentsSize(0)
+    , m_appendableDataSegment(0)
     , m_buffer(size)
 {
 }
 
 SharedBuffer::SharedBuffer(const char* data, int size)
     : m_size(0)
+    , m_dataSegmentsSize(0)
+    , m_appendableDataSegment(0)
 {
     // FIXME: Use unsigned consistently, and check for invalid casts when calling into SharedBuffer from other code.
     if (size < 0)
@@ -82,6 +127,8 @@ SharedBuffer::SharedBuffer(const char* data, int size)
 
 SharedBuffer::SharedBuffer(const unsigned char* data, int size)
     : m_size(0)
+    , m_dataSegmentsSize(0)
+    , m_appendableDataSegment(0)
 {
     // FIXME: Use unsigned consistently, and check for invalid casts when calling into SharedBuffer from other code.
     if (size < 0)
@@ -135,6 +182,9 @@ void SharedBuffer::createPurgeableBuffer() const
         return;
 #endif
 
+    if (singleDataSegment())
+        return;
+
     m_purgeableBuffer = PurgeableBuffer::create(buffer().data(), m_size);
 }
 
@@ -147,6 +197,9 @@ const char* SharedBuffer::data() const
     if (const char* buffer = singleDataArrayBuffer())
         return buffer;
 #endif
+
+    if (const char* segment = singleDataSegment())
+        return segment;
     
     if (m_purgeableBuffer)
         return m_purgeableBuffer->data();
@@ -156,6 +209,12 @@ const char* SharedBuffer::data() const
 
 void SharedBuffer::append(SharedBuffer* data)
 {
+    if (data->hasOnlyDataSegments()) {
+        for (unsigned i = 0; i < data->m_dataSegments.size(); ++i)
+            append(data->m_dataSegments[i]);
+        return;
+    }
+
     const char* segment;
     size_t position = 0;
     while (size_t length = data->getSomeData(segment, position)) {
@@ -171,6 +230,20 @@ void SharedBuffer::append(const char* data, unsigned length)
         return;
 
     maybeTransferPlatformData();
+
+    if (!m_dataSegments.isEmpty()) {
+        // The last owned segment can only grow while no other buffer shares it.
+        if (m_appendableDataSegment && m_appendableDataSegment->hasOneRef() && length <= m_appendableDataSegment->freeSpace()) {
+            m_appendableDataSegment->append(data, length);
+            m_size += length;
+            m_dataSegmentsSize += length;
+            return;
+        }
+        RefPtr<OwnedDataSegment> segment = OwnedDataSegment::create(data, length);
+        append(segment);
+        m_appendableDataSegment = segment.get();
+        return;
+    }
     
     unsigned positionInSegment = offsetInSegment(m_size - m_buffer.size());
     m_size += length;
@@ -211,6 +284,51 @@ void SharedBuffer::append(const Vector<char>& data)
     append(data.data(), data.size());
 }
 
+void SharedBuffer::append(PassRefPtr<DataSegment> prpSegment)
+{
+    ASSERT(!m_purgeableBuffer);
+    RefPtr<DataSegment> segment = prpSegment;
+    if (!segment->size())
+        return;
+
+    maybeTransferPlatformData();
+#if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
+    ASSERT(m_dataArray.isEmpty());
+#endif
+
+    m_dataSegmentOffsets.append(m_dataSegmentsSize);
+    m_dataSegmentsSize += segment->size();
+    m_size += segment->size();
+    m_dataSegments.append(segment.release());
+    m_appendableDataSegment = 0;
+}
+
+bool SharedBuffer::hasOnlyDataSegments() const
+{
+    if (m_dataSegments.isEmpty() || !m_buffer.isEmpty() || !m_segments.isEmpty() || m_purgeableBuffer || hasPlatformData())
+        return false;
+#if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
+    if (!m_dataArray.isEmpty())
+        return false;
+#endif
+    return true;
+}
+
+const char* SharedBuffer::singleDataSegment() const
+{
+    if (m_dataSegments.size() != 1 || !hasOnlyDataSegments())
+        return 0;
+    return m_dataSegments[0]->data();
+}
+
+void SharedBuffer::clearDataSegments() const
+{
+    m_dataSegments.clear();
+    m_dataSegmentOffsets.clear();
+    m_dataSegmentsSize = 0;
+    m_appendableDataSegment = 0;
+}
+
 void SharedBuffer::clear()
 {
     clearPlatformData();
@@ -219,6 +337,7 @@ void SharedBuffer::clear()
         freeSegment(m_segments[i]);
 
     m_segments.clear();
+    clearDataSegments();
     m_size = 0;
 
     m_buffer.clear();
@@ -236,11 +355,19 @@ PassRefPtr<SharedBuffer> SharedBuffer::copy() const
         return clone;
     }
 
+    // Data segments are never written to, so the clone can share them.
+    unsigned segmentedSize = m_size - m_buffer.size() - m_dataSegmentsSize;
     clone->m_size = m_size;
-    clone->m_buffer.reserveCapacity(m_size);
+    clone->m_buffer.reserveCapacity(m_buffer.size() + segmentedSize);
     clone->m_buffer.append(m_buffer.data(), m_buffer.size());
-    for (unsigned i = 0; i < m_segments.size(); ++i)
-        clone->m_buffer.append(m_segments[i], segmentSize);
+    for (unsigned i = 0; i < m_segments.size(); ++i) {
+        unsigned bytesToCopy = min(segmentedSize, segmentSize);
+        clone->m_buffer.append(m_segments[i], bytesToCopy);
+        segmentedSize -= bytesToCopy;
+    }
+    clone->m_dataSegments = m_dataSegments;
+    clone->m_dataSegmentOffsets = m_dataSegmentOffsets;
+    clone->m_dataSegmentsSize = m_dataSegmentsSize;
     return clone;
 }
 
@@ -254,9 +381,13 @@ const Vector<char>& SharedBuffer::buffer() const
 {
     unsigned bufferSize = m_buffer.size();
     if (m_size > bufferSize) {
+        {
+            MutexLocker locker(linearizedByteCountMutex());
+            s_linearizedByteCount += m_size - bufferSize;
+        }
         m_buffer.resize(m_size);
         char* destination = m_buffer.data() + bufferSize;
-        unsigned bytesLeft = m_size - bufferSize;
+        unsigned bytesLeft = m_size - bufferSize - m_dataSegmentsSize;
         for (unsigned i = 0; i < m_segments.size(); ++i) {
             unsigned bytesToCopy = min(bytesLeft, segmentSize);
             memcpy(destination, m_segments[i], bytesToCopy);
@@ -265,6 +396,11 @@ const Vector<char>& SharedBuffer::buffer() const
             freeSegment(m_segments[i]);
         }
         m_segments.clear();
+        for (unsigned i = 0; i < m_dataSegments.size(); ++i) {
+            memcpy(destination, m_dataSegments[i]->data(), m_dataSegments[i]->size());
+            destination += m_dataSegments[i]->size();
+        }
+        clearDataSegments();
 #if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
         copyDataArrayAndClear(destination, bytesLeft);
 #endif
@@ -272,6 +408,12 @@ const Vector<char>& SharedBuffer::buffer() const
     return m_buffer;
 }
 
+unsigned long long SharedBuffer::linearizedByteCount()
+{
+    MutexLocker locker(linearizedByteCountMutex());
+    return s_linearizedByteCount;
+}
+
 unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) const
 {
     unsigned totalSize = size();
@@ -296,18 +438,26 @@ unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) con
     position -= consecutiveSize;
     unsigned segments = m_segments.size();
     unsigned maxSegmentedSize = segments * segmentSize;
-    unsigned segment = segmentIndex(position);
-    if (segment < segments) {
-        unsigned bytesLeft = totalSize - consecutiveSize;
-        unsigned segmentedSize = min(maxSegmentedSize, bytesLeft);
-
+    unsigned bytesLeft = totalSize - consecutiveSize - m_dataSegmentsSize;
+    unsigned segmentedSize = min(maxSegmentedSize, bytesLeft);
+    if (position < segmentedSize) {
+        unsigned segment = segmentIndex(position);
         unsigned positionInSegment = offsetInSegment(position);
         someData = m_segments[segment] + positionInSegment;
         return segment == segments - 1 ? segmentedSize - position : segmentSize - positionInSegment;
     }
+
+    position -= segmentedSize;
+    if (position < m_dataSegmentsSize) {
+        // The last segment whose start is at or before position holds it.
+        size_t index = upper_bound(m_dataSegmentOffsets.begin(), m_dataSegmentOffsets.end(), position) - m_dataSegmentOffsets.begin() - 1;
+        const DataSegment* segment = m_dataSegments[index].get();
+        unsigned positionInSegment = position - m_dataSegmentOffsets[index];
+        someData = segment->data() + positionInSegment;
+        return segment->size() - positionInSegment;
+    }
+    position -= m_dataSegmentsSize;
 #if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
-    ASSERT(maxSegmentedSize <= position);
-    position -= maxSegmentedSize;
     return copySomeDataFromDataArray(someData, position);
 #else
     ASSERT_NOT_REACHED();
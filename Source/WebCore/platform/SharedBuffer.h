@@ -29,7 +29,9 @@
 
 #include <wtf/Forward.h>
 #include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 
@@ -43,10 +45,20 @@ OBJC_CLASS NSData;
 
 namespace WebCore {
     
+class OwnedDataSegment;
 class PurgeableBuffer;
 
 class SharedBuffer : public RefCounted<SharedBuffer> {
 public:
+    // Memory owned by someone else, such as a shared memory region another process wrote
+    // response data into, that a SharedBuffer keeps as one of its segments instead of copying it.
+    class DataSegment : public RefCounted<DataSegment> {
+    public:
+        virtual ~DataSegment() { }
+        virtual const char* data() const = 0;
+        virtual unsigned size() const = 0;
+    };
+
     static PassRefPtr<SharedBuffer> create() { return adoptRef(new SharedBuffer); }
     static PassRefPtr<SharedBuffer> create(size_t size) { return adoptRef(new SharedBuffer(size)); }
     static PassRefPtr<SharedBuffer> create(const char* c, int i) { return adoptRef(new SharedBuffer(c, i)); }
@@ -84,6 +96,7 @@ public:
     void append(SharedBuffer*);
     void append(const char*, unsigned);
     void append(const Vector<char>&);
+    void append(PassRefPtr<DataSegment>);
 
     void clear();
     const char* platformData() const;
@@ -118,6 +131,10 @@ public:
 
     void tryReplaceContentsWithPlatformBuffer(SharedBuffer*);
 
+    // The number of bytes copied so far, in this process, to merge segmented buffers into a
+    // single block for data().
+    static unsigned long long linearizedByteCount();
+
 private:
     SharedBuffer();
     explicit SharedBuffer(size_t);
@@ -131,6 +148,10 @@ private:
     // memory, which can be a source of bugs.
     const Vector<char>& buffer() const;
 
+    bool hasOnlyDataSegments() const;
+    const char* singleDataSegment() const;
+    void clearDataSegments() const;
+
     void clearPlatformData();
     void maybeTransferPlatformData();
     bool hasPlatformData() const;
@@ -138,6 +159,12 @@ private:
     unsigned m_size;
     mutable Vector<char> m_buffer;
     mutable Vector<char*> m_segments;
+    mutable Vector<RefPtr<DataSegment> > m_dataSegments;
+    // Where each data segment starts, counted from the first one, so getSomeData() can binary search.
+    mutable Vector<unsigned> m_dataSegmentOffsets;
+    mutable unsigned m_dataSegmentsSize;
+    // The last data segment when it was created by this buffer to hold appended bytes.
+    mutable OwnedDataSegment* m_appendableDataSegment;
     mutable OwnPtr<PurgeableBuffer> m_purgeableBuffer;
 #if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
     mutable Vector<RetainPtr<CFDataRef> > m_dataArray;
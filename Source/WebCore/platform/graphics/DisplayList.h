@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayList_h
+#define DisplayList_h
+
+#if USE(DISPLAY_LIST_RECORDING)
+
+#include "IntRect.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+
+#if PLATFORM(QT)
+QT_BEGIN_NAMESPACE
+class QPainter;
+class QPicture;
+QT_END_NAMESPACE
+#endif
+
+namespace WebCore {
+
+#if PLATFORM(QT)
+class DisplayListRecordingDevice;
+#endif
+class GraphicsContext;
+
+// A recording of the drawing done into a GraphicsContext, which can be replayed any number of
+// times. Replaying reads through the recording, so a list may be replayed on one thread at a time
+// only: lists handed to a worker thread must not be replayed anywhere else until it is done.
+class DisplayList : public ThreadSafeRefCounted<DisplayList> {
+public:
+    static PassRefPtr<DisplayList> create(const IntRect& bounds) { return adoptRef(new DisplayList(bounds)); }
+    ~DisplayList();
+
+    // Drawing outside of the bounds is not recorded.
+    const IntRect& bounds() const { return m_bounds; }
+
+    // The returned context is valid until endRecording().
+    GraphicsContext* beginRecording();
+    void endRecording();
+
+    void replay(GraphicsContext&) const;
+
+    // False when the recording draws platform images that may only be used on the main thread,
+    // such as QPixmaps, or text on a platform that can only render fonts on the main thread.
+    // Such lists have to be replayed on the main thread.
+    bool canReplayOnWorkerThread() const { return m_canReplayOnWorkerThread; }
+
+    // How much memory the recording takes, used to keep each layer's recordings within a budget.
+    size_t sizeInBytes() const;
+
+private:
+    explicit DisplayList(const IntRect& bounds);
+
+    IntRect m_bounds;
+    bool m_canReplayOnWorkerThread;
+
+#if PLATFORM(QT)
+    OwnPtr<QPicture> m_picture;
+    OwnPtr<DisplayListRecordingDevice> m_recordingDevice;
+    OwnPtr<QPainter> m_recordingPainter;
+#endif
+    OwnPtr<GraphicsContext> m_recordingContext;
+};
+
+} // namespace WebCore
+
+#endif // USE(DISPLAY_LIST_RECORDING)
+
+#endif // DisplayList_h
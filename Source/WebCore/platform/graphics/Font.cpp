@@ -220,6 +220,22 @@ void pruneUnreferencedEntriesFromFontGlyphsCache()
         fontGlyphsCache().remove(toRemove[i]);
 }
 
+static FontGlyphs* findCachedFontGlyphsIgnoringSelectorVersion(const FontGlyphsCacheKey& key)
+{
+    FontGlyphsCache::iterator end = fontGlyphsCache().end();
+    for (FontGlyphsCache::iterator it = fontGlyphsCache().begin(); it != end; ++it) {
+        FontGlyphsCacheEntry* entry = it->value.get();
+        if (!entry || entry->key.fontSelectorVersion == key.fontSelectorVersion)
+            continue;
+        if (entry->key.fontSelectorId != key.fontSelectorId || entry->key.fontSelectorFlags != key.fontSelectorFlags)
+            continue;
+        if (entry->key.fontDescriptionCacheKey != key.fontDescriptionCacheKey || entry->key.families != key.families)
+            continue;
+        return entry->glyphs.get();
+    }
+    return 0;
+}
+
 static PassRefPtr<FontGlyphs> retrieveOrAddCachedFontGlyphs(const FontDescription& fontDescription, PassRefPtr<FontSelector> fontSelector)
 {
     FontGlyphsCacheKey key;
@@ -230,11 +246,19 @@ static PassRefPtr<FontGlyphs> retrieveOrAddCachedFontGlyphs(const FontDescriptio
     if (!addResult.isNewEntry && addResult.iterator->value->key == key)
         return addResult.iterator->value->glyphs;
 
+    // Fonts the selector does not resolve are not affected by web fonts loading, which bumps the selector
+    // version. Keep the words measured with them so that the relayout after a font load does not reshape them.
+    FontGlyphs* glyphsForPreviousSelectorVersion = 0;
+    if (fontSelector && !fontSelector->resolvesFamilyFor(fontDescription))
+        glyphsForPreviousSelectorVersion = findCachedFontGlyphsIgnoringSelectorVersion(key);
+
     OwnPtr<FontGlyphsCacheEntry>& newEntry = addResult.iterator->value;
     newEntry = adoptPtr(new FontGlyphsCacheEntry);
     newEntry->glyphs = FontGlyphs::create(fontSelector);
     newEntry->key = key;
     RefPtr<FontGlyphs> glyphs = newEntry->glyphs;
+    if (glyphsForPreviousSelectorVersion)
+        glyphs->shareWordShapingCache(*glyphsForPreviousSelectorVersion);
 
     static const unsigned unreferencedPruneInterval = 50;
     static const int maximumEntries = 400;
@@ -298,22 +322,36 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
 
     bool hasKerningOrLigatures = typesettingFeatures() & (Kerning | Ligatures);
     bool hasWordSpacingOrLetterSpacing = wordSpacing() || letterSpacing();
-    float* cacheEntry = m_glyphs->widthCache().add(run, std::numeric_limits<float>::quiet_NaN(), hasKerningOrLigatures, hasWordSpacingOrLetterSpacing, glyphOverflow);
-    if (cacheEntry && !std::isnan(*cacheEntry))
-        return *cacheEntry;
+    WordShapingCache& wordShapingCache = m_glyphs->wordShapingCache();
+    WordShapingCache::ShapedWord* cacheEntry = wordShapingCache.add(run, hasKerningOrLigatures || codePathToUse == Complex, hasWordSpacingOrLetterSpacing, glyphOverflow);
+    if (cacheEntry && !cacheEntry->isEmpty()) {
+        if (fallbackFonts) {
+            for (size_t i = 0; i < cacheEntry->fallbackFonts.size(); ++i)
+                fallbackFonts->add(cacheEntry->fallbackFonts[i].get());
+        }
+        return cacheEntry->width;
+    }
 
+    // A cached word needs the fallback fonts of this run alone, not those the caller collected so far.
     HashSet<const SimpleFontData*> localFallbackFonts;
-    if (!fallbackFonts)
-        fallbackFonts = &localFallbackFonts;
+    HashSet<const SimpleFontData*>* runFallbackFonts = (!fallbackFonts || cacheEntry) ? &localFallbackFonts : fallbackFonts;
 
     float result;
     if (codePathToUse == Complex)
-        result = floatWidthForComplexText(run, fallbackFonts, glyphOverflow);
+        result = floatWidthForComplexText(run, runFallbackFonts, glyphOverflow);
     else
-        result = floatWidthForSimpleText(run, fallbackFonts, glyphOverflow);
-
-    if (cacheEntry && fallbackFonts->isEmpty())
-        *cacheEntry = result;
+        result = floatWidthForSimpleText(run, runFallbackFonts, glyphOverflow);
+
+    if (cacheEntry) {
+        cacheEntry->width = result;
+        HashSet<const SimpleFontData*>::const_iterator end = localFallbackFonts.end();
+        for (HashSet<const SimpleFontData*>::const_iterator it = localFallbackFonts.begin(); it != end; ++it) {
+            cacheEntry->fallbackFonts.append(const_cast<SimpleFontData*>(*it));
+            if (fallbackFonts)
+                fallbackFonts->add(*it);
+        }
+        wordShapingCache.didShapeWord(*cacheEntry);
+    }
     return result;
 }
 
@@ -346,6 +384,12 @@ float Font::width(TextLayout&, unsigned, unsigned, HashSet<const SimpleFontData*
 }
 #endif
 
+#if !PLATFORM(QT)
+void Font::prepareLayouts(const Vector<RenderText*>&)
+{
+}
+#endif
+
 FloatRect Font::selectionRectForText(const TextRun& run, const FloatPoint& point, int h, int from, int to) const
 {
     to = (to == -1 ? run.length() : to);
@@ -113,6 +113,9 @@ public:
     PassOwnPtr<TextLayout> createLayout(RenderText*, float xPos, bool collapseWhiteSpace) const;
     static void deleteLayout(TextLayout*);
     static float width(TextLayout&, unsigned from, unsigned len, HashSet<const SimpleFontData*>* fallbackFonts = 0);
+    // Shapes the text of the given renderers ahead of line breaking, on worker threads where
+    // the platform allows it, so that layouts created afterwards find their measurements cached.
+    static void prepareLayouts(const Vector<RenderText*>&);
 
     int offsetForPosition(const TextRun&, float position, bool includePartialGlyphs) const;
     FloatRect selectionRectForText(const TextRun&, const FloatPoint&, int h, int from = 0, int to = -1) const;
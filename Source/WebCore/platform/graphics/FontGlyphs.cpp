@@ -41,6 +41,7 @@ FontGlyphs::FontGlyphs(PassRefPtr<FontSelector> fontSelector)
     : m_pageZero(0)
     , m_cachedPrimarySimpleFontData(0)
     , m_fontSelector(fontSelector)
+    , m_wordShapingCache(WordShapingCache::create())
     , m_fontSelectorVersion(m_fontSelector ? m_fontSelector->version() : 0)
     , m_familyIndex(0)
     , m_generation(fontCache()->generation())
@@ -54,6 +55,7 @@ FontGlyphs::FontGlyphs(const FontPlatformData& platformData)
     : m_pageZero(0)
     , m_cachedPrimarySimpleFontData(0)
     , m_fontSelector(0)
+    , m_wordShapingCache(WordShapingCache::create())
     , m_fontSelectorVersion(0)
     , m_familyIndex(cAllFamiliesScanned)
     , m_generation(fontCache()->generation())
@@ -23,7 +23,7 @@
 
 #include "FontSelector.h"
 #include "SimpleFontData.h"
-#include "WidthCache.h"
+#include "WordShapingCache.h"
 #include <wtf/Forward.h>
 #include <wtf/MainThread.h>
 
@@ -83,7 +83,9 @@ public:
     unsigned fontSelectorVersion() const { return m_fontSelectorVersion; }
     unsigned generation() const { return m_generation; }
 
-    WidthCache& widthCache() const { return m_widthCache; }
+    WordShapingCache& wordShapingCache() const { return *m_wordShapingCache; }
+    // Lets glyphs that are known to resolve to the same fonts share measurements.
+    void shareWordShapingCache(const FontGlyphs& other) { m_wordShapingCache = other.m_wordShapingCache; }
 
     const SimpleFontData* primarySimpleFontData(const FontDescription&) const;
     const FontData* primaryFontData(const FontDescription& description) const { return realizeFontDataAt(description, 0); }
@@ -100,7 +102,7 @@ private:
     mutable GlyphPageTreeNode* m_pageZero;
     mutable const SimpleFontData* m_cachedPrimarySimpleFontData;
     RefPtr<FontSelector> m_fontSelector;
-    mutable WidthCache m_widthCache;
+    RefPtr<WordShapingCache> m_wordShapingCache;
     unsigned m_fontSelectorVersion;
     mutable int m_familyIndex;
     unsigned short m_generation;
@@ -36,6 +36,7 @@
 #include "RotateTransformOperation.h"
 #include "TextStream.h"
 #include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuilder.h>
 #include <wtf/text/WTFString.h>
@@ -46,6 +47,14 @@
 
 namespace WebCore {
 
+#if USE(DISPLAY_LIST_RECORDING)
+static HashSet<GraphicsLayer*>& layersWithDisplayLists()
+{
+    DEFINE_STATIC_LOCAL(HashSet<GraphicsLayer*>, layers, ());
+    return layers;
+}
+#endif
+
 typedef HashMap<const GraphicsLayer*, Vector<FloatRect> > RepaintMap;
 static RepaintMap& repaintRectMap()
 {
@@ -97,6 +106,9 @@ GraphicsLayer::GraphicsLayer(GraphicsLayerClient* client)
     , m_replicaLayer(0)
     , m_replicatedLayer(0)
     , m_repaintCount(0)
+#if USE(DISPLAY_LIST_RECORDING)
+    , m_displayListsSizeInBytes(0)
+#endif
 {
 #ifndef NDEBUG
     if (m_client)
@@ -107,6 +119,7 @@ GraphicsLayer::GraphicsLayer(GraphicsLayerClient* client)
 GraphicsLayer::~GraphicsLayer()
 {
     resetTrackedRepaints();
+    invalidateDisplayLists();
     ASSERT(!m_parent); // willBeDestroyed should have been called already.
 }
 
@@ -301,6 +314,7 @@ void GraphicsLayer::setOffsetFromRenderer(const IntSize& offset, ShouldSetNeedsD
         return;
 
     m_offsetFromRenderer = offset;
+    invalidateDisplayLists();
 
     // If the compositing layer offset changes, we need to repaint.
     if (shouldSetNeedsDisplay == SetNeedsDisplay)
@@ -314,6 +328,31 @@ void GraphicsLayer::setBackgroundColor(const Color& color)
 
 void GraphicsLayer::paintGraphicsLayerContents(GraphicsContext& context, const IntRect& clip)
 {
+#if USE(DISPLAY_LIST_RECORDING)
+    if (m_client && m_client->shouldRecordDisplayList(this)) {
+        Vector<DisplayListCell> cells;
+        recordDisplayLists(clip, cells);
+        for (size_t i = 0; i < cells.size(); ++i) {
+            const DisplayListCell& cell = cells[i];
+            context.save();
+            context.clip(intersection(clip, cell.displayList->bounds()));
+            for (size_t j = 0; j < cell.patches.size(); ++j)
+                context.clipOut(cell.patches[j]->bounds());
+            cell.displayList->replay(context);
+            context.restore();
+
+            for (size_t j = 0; j < cell.patches.size(); ++j) {
+                context.save();
+                context.clip(intersection(clip, cell.patches[j]->bounds()));
+                cell.patches[j]->replay(context);
+                context.restore();
+            }
+        }
+        return;
+    }
+    invalidateDisplayLists();
+#endif
+
     if (m_client) {
         IntSize offset = offsetFromRenderer();
         context.translate(-offset);
@@ -325,6 +364,228 @@ void GraphicsLayer::paintGraphicsLayerContents(GraphicsContext& context, const I
     }
 }
 
+#if USE(DISPLAY_LIST_RECORDING)
+// Large enough that a cell holds a useful amount of content, small enough that a caret
+// blink or a small animated image does not throw away the recording of the whole layer.
+static const int displayListCellSize = 512;
+
+// Recordings keep every image and glyph run they draw alive, so a layer drops its least
+// recently painted cells once its recordings grow past this.
+static const size_t maximumDisplayListsSizeInBytesPerLayer = 4 * 1024 * 1024;
+
+// Invalidations covering more than this share of a cell, or coming once a cell has this many
+// patches, record the whole cell again: past that the patches cost more to draw than they save.
+static const int maximumDisplayListPatchAreaDivisor = 4;
+static const size_t maximumDisplayListPatchesPerCell = 8;
+
+static inline int displayListCellIndex(int coordinate)
+{
+    return coordinate >= 0 ? coordinate / displayListCellSize : (coordinate + 1) / displayListCellSize - 1;
+}
+
+static inline IntRect displayListCellRect(const IntPoint& cell)
+{
+    return IntRect(cell.x() * displayListCellSize, cell.y() * displayListCellSize, displayListCellSize, displayListCellSize);
+}
+
+static size_t displayListCellSizeInBytes(const GraphicsLayer::DisplayListCell& cell)
+{
+    size_t sizeInBytes = cell.displayList->sizeInBytes();
+    for (size_t i = 0; i < cell.patches.size(); ++i)
+        sizeInBytes += cell.patches[i]->sizeInBytes();
+    return sizeInBytes;
+}
+
+void GraphicsLayer::releaseAllDisplayLists()
+{
+    Vector<GraphicsLayer*> layers;
+    copyToVector(layersWithDisplayLists(), layers);
+    for (size_t i = 0; i < layers.size(); ++i)
+        layers[i]->invalidateDisplayLists();
+}
+
+size_t GraphicsLayer::displayListsSizeInBytes()
+{
+    size_t sizeInBytes = 0;
+    HashSet<GraphicsLayer*>::const_iterator end = layersWithDisplayLists().end();
+    for (HashSet<GraphicsLayer*>::const_iterator it = layersWithDisplayLists().begin(); it != end; ++it)
+        sizeInBytes += (*it)->m_displayListsSizeInBytes;
+    return sizeInBytes;
+}
+
+unsigned GraphicsLayer::displayListPatchCount()
+{
+    unsigned patchCount = 0;
+    HashSet<GraphicsLayer*>::const_iterator end = layersWithDisplayLists().end();
+    for (HashSet<GraphicsLayer*>::const_iterator it = layersWithDisplayLists().begin(); it != end; ++it) {
+        DisplayListMap::const_iterator cellsEnd = (*it)->m_displayLists.end();
+        for (DisplayListMap::const_iterator cell = (*it)->m_displayLists.begin(); cell != cellsEnd; ++cell)
+            patchCount += cell->value.patches.size();
+    }
+    return patchCount;
+}
+
+void GraphicsLayer::invalidateDisplayLists()
+{
+    if (m_displayLists.isEmpty())
+        return;
+
+    m_displayLists.clear();
+    m_displayListUseOrder.clear();
+    m_displayListsSizeInBytes = 0;
+    layersWithDisplayLists().remove(this);
+}
+
+void GraphicsLayer::removeDisplayList(const IntPoint& cell)
+{
+    DisplayListMap::iterator it = m_displayLists.find(cell);
+    if (it == m_displayLists.end())
+        return;
+
+    m_displayListsSizeInBytes -= displayListCellSizeInBytes(it->value);
+    m_displayLists.remove(it);
+    m_displayListUseOrder.remove(cell);
+    if (m_displayLists.isEmpty())
+        layersWithDisplayLists().remove(this);
+}
+
+PassRefPtr<DisplayList> GraphicsLayer::recordDisplayList(const IntRect& rect)
+{
+    RefPtr<DisplayList> displayList = DisplayList::create(rect);
+
+    IntSize offset = offsetFromRenderer();
+    GraphicsContext* recordingContext = displayList->beginRecording();
+    recordingContext->translate(-offset);
+    IntRect paintRect(rect);
+    paintRect.move(offset);
+    m_client->paintContents(this, *recordingContext, m_paintingPhase, paintRect);
+    displayList->endRecording();
+
+    m_displayListsSizeInBytes += displayList->sizeInBytes();
+    return displayList.release();
+}
+
+void GraphicsLayer::recordDisplayLists(const IntRect& rect, Vector<DisplayListCell>& cells)
+{
+    ASSERT(m_client);
+    if (rect.isEmpty())
+        return;
+
+    int lastColumn = displayListCellIndex(rect.maxX() - 1);
+    int lastRow = displayListCellIndex(rect.maxY() - 1);
+    for (int row = displayListCellIndex(rect.y()); row <= lastRow; ++row) {
+        for (int column = displayListCellIndex(rect.x()); column <= lastColumn; ++column) {
+            IntPoint cell(column, row);
+            DisplayListMap::AddResult result = m_displayLists.add(cell, DisplayListCell());
+            DisplayListCell& recordedCell = result.iterator->value;
+            if (!recordedCell.displayList) {
+                ASSERT(recordedCell.patches.isEmpty() && recordedCell.dirtyRects.isEmpty());
+                recordedCell.displayList = recordDisplayList(displayListCellRect(cell));
+                layersWithDisplayLists().add(this);
+            }
+            for (size_t i = 0; i < recordedCell.dirtyRects.size(); ++i)
+                recordedCell.patches.append(recordDisplayList(recordedCell.dirtyRects[i]));
+            recordedCell.dirtyRects.clear();
+
+            m_displayListUseOrder.appendOrMoveToLast(cell);
+            cells.append(recordedCell);
+        }
+    }
+
+    // The lists handed out above stay alive in cells even if they are evicted here.
+    while (m_displayListsSizeInBytes > maximumDisplayListsSizeInBytesPerLayer && !m_displayListUseOrder.isEmpty())
+        removeDisplayList(m_displayListUseOrder.first());
+}
+
+bool GraphicsLayer::addDisplayListDirtyRect(DisplayListCell& cell, const IntRect& cellRect, const IntRect& rect)
+{
+    IntRect dirtyRect = intersection(rect, cellRect);
+
+    // Patches and dirty rects that overlap the new one are folded into it and recorded again as one.
+    bool merged;
+    do {
+        merged = false;
+        for (size_t i = 0; i < cell.patches.size(); ++i) {
+            if (!dirtyRect.intersects(cell.patches[i]->bounds()))
+                continue;
+            dirtyRect.unite(cell.patches[i]->bounds());
+            m_displayListsSizeInBytes -= cell.patches[i]->sizeInBytes();
+            cell.patches.remove(i--);
+            merged = true;
+        }
+        for (size_t i = 0; i < cell.dirtyRects.size(); ++i) {
+            if (!dirtyRect.intersects(cell.dirtyRects[i]))
+                continue;
+            dirtyRect.unite(cell.dirtyRects[i]);
+            cell.dirtyRects.remove(i--);
+            merged = true;
+        }
+    } while (merged);
+
+    if (dirtyRect.width() * dirtyRect.height() > cellRect.width() * cellRect.height() / maximumDisplayListPatchAreaDivisor)
+        return false;
+    if (cell.patches.size() + cell.dirtyRects.size() >= maximumDisplayListPatchesPerCell)
+        return false;
+
+    cell.dirtyRects.append(dirtyRect);
+    return true;
+}
+
+void GraphicsLayer::invalidateDisplayListsInRect(const FloatRect& rect)
+{
+    if (m_displayLists.isEmpty())
+        return;
+
+    IntRect dirtyRect = enclosingIntRect(rect);
+    if (dirtyRect.isEmpty())
+        return;
+
+    // Dirty rects can be huge, so look at the recorded cells rather than at the dirty ones.
+    int firstColumn = displayListCellIndex(dirtyRect.x());
+    int firstRow = displayListCellIndex(dirtyRect.y());
+    int lastColumn = displayListCellIndex(dirtyRect.maxX() - 1);
+    int lastRow = displayListCellIndex(dirtyRect.maxY() - 1);
+    Vector<IntPoint> dirtyCells;
+    DisplayListMap::iterator end = m_displayLists.end();
+    for (DisplayListMap::iterator it = m_displayLists.begin(); it != end; ++it) {
+        const IntPoint& cell = it->key;
+        if (cell.x() < firstColumn || cell.x() > lastColumn || cell.y() < firstRow || cell.y() > lastRow)
+            continue;
+        if (!addDisplayListDirtyRect(it->value, displayListCellRect(cell), dirtyRect))
+            dirtyCells.append(cell);
+    }
+
+    for (size_t i = 0; i < dirtyCells.size(); ++i)
+        removeDisplayList(dirtyCells[i]);
+}
+
+void GraphicsLayer::invalidateDisplayListsOutsideRect(const IntRect& rect)
+{
+    if (m_displayLists.isEmpty())
+        return;
+
+    if (rect.isEmpty()) {
+        invalidateDisplayLists();
+        return;
+    }
+
+    int firstColumn = displayListCellIndex(rect.x());
+    int firstRow = displayListCellIndex(rect.y());
+    int lastColumn = displayListCellIndex(rect.maxX() - 1);
+    int lastRow = displayListCellIndex(rect.maxY() - 1);
+    Vector<IntPoint> offscreenCells;
+    DisplayListMap::const_iterator end = m_displayLists.end();
+    for (DisplayListMap::const_iterator it = m_displayLists.begin(); it != end; ++it) {
+        const IntPoint& cell = it->key;
+        if (cell.x() < firstColumn || cell.x() > lastColumn || cell.y() < firstRow || cell.y() > lastRow)
+            offscreenCells.append(cell);
+    }
+
+    for (size_t i = 0; i < offscreenCells.size(); ++i)
+        removeDisplayList(offscreenCells[i]);
+}
+#endif
+
 String GraphicsLayer::animationNameForTransition(AnimatedPropertyID property)
 {
     // | is not a valid identifier character in CSS, so this can never conflict with a keyframe identifier.
@@ -44,6 +44,14 @@
 #include "FilterOperations.h"
 #endif
 
+#if USE(DISPLAY_LIST_RECORDING)
+#include "DisplayList.h"
+#include "IntPointHash.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/RefPtr.h>
+#endif
+
 enum LayerTreeAsTextBehaviorFlags {
     LayerTreeAsTextBehaviorNormal = 0,
     LayerTreeAsTextDebug = 1 << 0, // Dump extra debugging info like layer addresses.
@@ -311,10 +319,20 @@ public:
     virtual void setMasksToBounds(bool b) { m_masksToBounds = b; }
     
     bool drawsContent() const { return m_drawsContent; }
-    virtual void setDrawsContent(bool b) { m_drawsContent = b; }
+    virtual void setDrawsContent(bool b)
+    {
+        m_drawsContent = b;
+        if (!b)
+            invalidateDisplayLists();
+    }
 
     bool contentsAreVisible() const { return m_contentsVisible; }
-    virtual void setContentsVisible(bool b) { m_contentsVisible = b; }
+    virtual void setContentsVisible(bool b)
+    {
+        m_contentsVisible = b;
+        if (!b)
+            invalidateDisplayLists();
+    }
 
     bool acceleratesDrawing() const { return m_acceleratesDrawing; }
     virtual void setAcceleratesDrawing(bool b) { m_acceleratesDrawing = b; }
@@ -344,7 +362,12 @@ public:
 
     // Some GraphicsLayers paint only the foreground or the background content
     GraphicsLayerPaintingPhase paintingPhase() const { return m_paintingPhase; }
-    void setPaintingPhase(GraphicsLayerPaintingPhase phase) { m_paintingPhase = phase; }
+    void setPaintingPhase(GraphicsLayerPaintingPhase phase)
+    {
+        if (phase != m_paintingPhase)
+            invalidateDisplayLists();
+        m_paintingPhase = phase;
+    }
 
     virtual void setNeedsDisplay() = 0;
     // mark the given rect (in layer coords) as needing dispay. Never goes deep.
@@ -391,6 +414,28 @@ public:
 
     // Callback from the underlying graphics system to draw layer contents.
     void paintGraphicsLayerContents(GraphicsContext&, const IntRect& clip);
+#if USE(DISPLAY_LIST_RECORDING)
+    // When the client asks for it, the layer contents are recorded into display lists that each
+    // cover a fixed size cell of the layer. Cells that were not invalidated since they were
+    // recorded are not painted again, and small invalidations only record the part of the cell
+    // that changed, as a patch drawn over the rest of the cell.
+    struct DisplayListCell {
+        RefPtr<DisplayList> displayList;
+        // Patches do not overlap each other, so each can be drawn with the others clipped out.
+        Vector<RefPtr<DisplayList> > patches;
+        // Parts of the cell to be recorded as patches the next time it is painted.
+        Vector<IntRect> dirtyRects;
+    };
+    // Returns the cells covering the given rect, in layer coords.
+    void recordDisplayLists(const IntRect&, Vector<DisplayListCell>&);
+
+    // Drops the recordings of every layer, for when memory runs low.
+    static void releaseAllDisplayLists();
+
+    // Totals over the recordings of every layer, for testing.
+    static size_t displayListsSizeInBytes();
+    static unsigned displayListPatchCount();
+#endif
     // Callback from the underlying graphics system when the layer has been displayed
     virtual void layerDidDisplay(PlatformLayer*) { }
     
@@ -487,6 +532,18 @@ protected:
     // Should be called from derived class destructors. Should call willBeDestroyed() on super.
     virtual void willBeDestroyed();
 
+    // Platform GraphicsLayer classes call these when the layer contents need to be painted again.
+#if USE(DISPLAY_LIST_RECORDING)
+    void invalidateDisplayLists();
+    void invalidateDisplayListsInRect(const FloatRect&);
+    // Platform layers call this when parts of the layer go off screen, so recordings are only kept where they may be painted.
+    void invalidateDisplayListsOutsideRect(const IntRect&);
+#else
+    void invalidateDisplayLists() { }
+    void invalidateDisplayListsInRect(const FloatRect&) { }
+    void invalidateDisplayListsOutsideRect(const IntRect&) { }
+#endif
+
 #if ENABLE(CSS_FILTERS)
     // This method is used by platform GraphicsLayer classes to clear the filters
     // when compositing is not done in hardware. It is not virtual, so the caller
@@ -573,6 +630,18 @@ protected:
     IntSize m_contentsTileSize;
 
     int m_repaintCount;
+
+#if USE(DISPLAY_LIST_RECORDING)
+    void removeDisplayList(const IntPoint& cell);
+    PassRefPtr<DisplayList> recordDisplayList(const IntRect&);
+    bool addDisplayListDirtyRect(DisplayListCell&, const IntRect& cellRect, const IntRect& dirtyRect);
+
+    typedef HashMap<IntPoint, DisplayListCell> DisplayListMap;
+    DisplayListMap m_displayLists;
+    // Recorded cells, least recently painted first.
+    ListHashSet<IntPoint> m_displayListUseOrder;
+    size_t m_displayListsSizeInBytes;
+#endif
 };
 
 
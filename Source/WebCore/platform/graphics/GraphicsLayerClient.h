@@ -90,6 +90,10 @@ public:
 
     virtual bool isTrackingRepaints() const { return false; }
 
+    // Whether the layer should record what it paints and replay the recording for later repaints
+    // of the same content.
+    virtual bool shouldRecordDisplayList(const GraphicsLayer*) const { return false; }
+
 #ifndef NDEBUG
     // RenderLayerBacking overrides this to verify that it is not
     // currently painting contents. An ASSERT fails, if it is.
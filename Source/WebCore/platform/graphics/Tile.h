@@ -41,6 +41,18 @@ public:
     virtual void invalidate(const IntRect&) = 0;
     virtual Vector<IntRect> updateBackBuffer() = 0;
     virtual void swapBackBufferToFront() = 0;
+
+    // Tiles that can be rasterized off the main thread update their back buffer in three steps
+    // instead of updateBackBuffer(). recordBackBufferUpdate() records the dirty content on the main
+    // thread, and returns false if the tile cannot be updated that way. rasterizeBackBuffer() can
+    // then run on any thread, and commitBackBufferUpdate() returns the updated rects on the main thread.
+    // Until then the main thread may still invalidate and paint the tile, from its front buffer.
+    virtual bool recordBackBufferUpdate() { return false; }
+    // False when there was nothing left to rasterize after recording, and the update can be
+    // committed right away.
+    virtual bool needsRasterization() const { return false; }
+    virtual void rasterizeBackBuffer() { }
+    virtual Vector<IntRect> commitBackBufferUpdate() { return Vector<IntRect>(); }
     virtual bool isReadyToPaint() const = 0;
     virtual void paint(GraphicsContext*, const IntRect&) = 0;
 
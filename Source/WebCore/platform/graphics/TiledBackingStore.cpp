@@ -23,12 +23,38 @@
 #if USE(TILED_BACKING_STORE)
 
 #include "GraphicsContext.h"
+#include "Logging.h"
 #include "TiledBackingStoreClient.h"
+#include <algorithm>
+#include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/MathExtras.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/Threading.h>
 
 namespace WebCore {
 
 static const int defaultTileDimension = 512;
 
+// When tiles are rasterized on worker threads, the tiles in the visible rect are always updated
+// together, but tiles outside of it are spread over several updates so that the visible ones
+// are not held back by them.
+static const unsigned maximumNonVisibleTilesPerUpdate = 8;
+
+// Scrolling that pauses for longer than this is no longer used to predict which tiles are needed.
+static const double scrollVelocityTimeout = 0.25;
+// Weight of the latest movement in the smoothed scroll velocity.
+static const float scrollVelocitySmoothing = 0.5f;
+// Slower scrolling than this, in pixels per second, is treated as no motion.
+static const float minimumScrollSpeed = 50;
+// How far ahead tiles are prefetched while scrolling: the distance covered in this many seconds,
+// but no more than this many viewports.
+static const double scrollPrefetchInterval = 0.5;
+static const float maximumScrollPrefetchViewports = 3;
+// At this speed and above, no tiles are prefetched across the direction of motion.
+static const float fastScrollSpeed = 4000;
+
 static IntPoint innerBottomRight(const IntRect& rect)
 {
     // Actually, the rect does not contain rect.maxX(). Refer to IntRect::contain.
@@ -38,27 +64,33 @@ static IntPoint innerBottomRight(const IntRect& rect)
 TiledBackingStore::TiledBackingStore(TiledBackingStoreClient* client, PassOwnPtr<TiledBackingStoreBackend> backend)
     : m_client(client)
     , m_backend(backend)
+    , m_lastUpdateStartTime(0)
     , m_tileBufferUpdateTimer(this, &TiledBackingStore::tileBufferUpdateTimerFired)
     , m_backingStoreUpdateTimer(this, &TiledBackingStore::backingStoreUpdateTimerFired)
     , m_tileSize(defaultTileDimension, defaultTileDimension)
     , m_coverAreaMultiplier(2.0f)
+    , m_lastScrollTime(0)
     , m_contentsScale(1.f)
     , m_pendingScale(0)
     , m_commitTileUpdatesOnIdleEventLoop(false)
     , m_contentsFrozen(false)
     , m_supportsAlpha(false)
     , m_pendingTileCreation(false)
+    , m_needsTileBufferUpdate(false)
 {
 }
 
 TiledBackingStore::~TiledBackingStore()
 {
+    // Waits for the worker threads, and drops what they rasterized.
+    m_tileRasterization.clear();
 }
 
 void TiledBackingStore::setTileSize(const IntSize& size)
 {
     m_tileSize = size;
     m_tiles.clear();
+    m_tileDirtyTimes.clear();
     startBackingStoreUpdateTimer();
 }
 
@@ -97,26 +129,144 @@ void TiledBackingStore::invalidate(const IntRect& contentsDirtyRect)
             // Pass the full rect to each tile as coveredDirtyRect might not
             // contain them completely and we don't want partial tile redraws.
             currentTile->invalidate(dirtyRect);
+            if (currentTile->isDirty())
+                m_tileDirtyTimes.add(currentTile->coordinate(), monotonicallyIncreasingTime());
         }
     }
 
     startTileBufferUpdateTimer();
 }
 
+struct TileUpdate {
+    TileUpdate(PassRefPtr<Tile> tile, double distance)
+        : tile(tile)
+        , distance(distance)
+    {
+    }
+
+    static bool isCloserToVisibleRect(const TileUpdate& a, const TileUpdate& b) { return a.distance < b.distance; }
+
+    RefPtr<Tile> tile;
+    double distance;
+};
+
+// Rasterizes the recorded updates of tiles on worker threads, while the main thread goes on. Each
+// worker takes every workerCount-th tile, so that all of them start with the tiles closest to the
+// visible rect, and the last worker to finish hands the tiles back to the main thread.
+class TiledBackingStore::TileRasterization {
+    WTF_MAKE_NONCOPYABLE(TileRasterization); WTF_MAKE_FAST_ALLOCATED;
+public:
+    TileRasterization(TiledBackingStore*, Vector<RefPtr<Tile> >& tiles);
+    ~TileRasterization();
+
+    TiledBackingStore* backingStore() const { return m_backingStore; }
+
+    // Blocks until the workers are done, and returns the rasterized tiles.
+    void finish(Vector<RefPtr<Tile> >& tiles);
+
+private:
+    struct Worker {
+        TileRasterization* rasterization;
+        size_t firstTile;
+        ThreadIdentifier thread;
+    };
+
+    static void workerThread(void*);
+    static void didFinishOnMainThread(void*);
+
+    void waitForWorkers();
+
+    TiledBackingStore* m_backingStore;
+    // Only the main thread touches the reference counts, the workers just use the tiles.
+    Vector<RefPtr<Tile> > m_tiles;
+    Vector<Worker> m_workers;
+    int m_unfinishedWorkerCount;
+};
+
+TiledBackingStore::TileRasterization::TileRasterization(TiledBackingStore* backingStore, Vector<RefPtr<Tile> >& tiles)
+    : m_backingStore(backingStore)
+{
+    ASSERT(!tiles.isEmpty());
+    m_tiles.swap(tiles);
+
+    size_t workerCount = std::min<size_t>(std::max(numberOfProcessorCores(), 1), m_tiles.size());
+    m_workers.resize(workerCount);
+    m_unfinishedWorkerCount = workerCount;
+    for (size_t n = 0; n < workerCount; ++n) {
+        m_workers[n].rasterization = this;
+        m_workers[n].firstTile = n;
+        m_workers[n].thread = createThread(&workerThread, &m_workers[n], "WebCore: TiledBackingStore");
+        if (!m_workers[n].thread)
+            workerThread(&m_workers[n]);
+    }
+}
+
+TiledBackingStore::TileRasterization::~TileRasterization()
+{
+    waitForWorkers();
+    // Tiles that were not handed back keep no recordings around.
+    for (size_t n = 0; n < m_tiles.size(); ++n)
+        m_tiles[n]->commitBackBufferUpdate();
+}
+
+void TiledBackingStore::TileRasterization::workerThread(void* context)
+{
+    Worker* worker = static_cast<Worker*>(context);
+    TileRasterization* rasterization = worker->rasterization;
+    size_t tileCount = rasterization->m_tiles.size();
+    size_t stride = rasterization->m_workers.size();
+    for (size_t n = worker->firstTile; n < tileCount; n += stride)
+        rasterization->m_tiles[n]->rasterizeBackBuffer();
+
+    if (!atomicDecrement(&rasterization->m_unfinishedWorkerCount))
+        callOnMainThread(&didFinishOnMainThread, rasterization);
+}
+
+void TiledBackingStore::TileRasterization::didFinishOnMainThread(void* context)
+{
+    static_cast<TileRasterization*>(context)->backingStore()->didFinishTileRasterization();
+}
+
+void TiledBackingStore::TileRasterization::waitForWorkers()
+{
+    for (size_t n = 0; n < m_workers.size(); ++n) {
+        if (!m_workers[n].thread)
+            continue;
+        waitForThreadCompletion(m_workers[n].thread);
+        m_workers[n].thread = 0;
+    }
+    cancelCallOnMainThread(&didFinishOnMainThread, this);
+}
+
+void TiledBackingStore::TileRasterization::finish(Vector<RefPtr<Tile> >& tiles)
+{
+    waitForWorkers();
+    tiles.swap(m_tiles);
+}
+
 void TiledBackingStore::updateTileBuffers()
 {
     if (m_contentsFrozen)
         return;
 
+    // A tile must not be recorded again while a worker thread may still be rasterizing it, so
+    // the update waits until the tiles on the worker threads are back.
+    if (m_tileRasterization) {
+        m_needsTileBufferUpdate = true;
+        return;
+    }
+
     m_client->tiledBackingStorePaintBegin();
 
+    double startTime = monotonicallyIncreasingTime();
+
     Vector<IntRect> paintedArea;
-    Vector<RefPtr<Tile> > dirtyTiles;
+    Vector<TileUpdate> dirtyTiles;
     TileMap::iterator end = m_tiles.end();
     for (TileMap::iterator it = m_tiles.begin(); it != end; ++it) {
         if (!it->value->isDirty())
             continue;
-        dirtyTiles.append(it->value);
+        dirtyTiles.append(TileUpdate(it->value, tileDistance(m_visibleRect, it->key)));
     }
 
     if (dirtyTiles.isEmpty()) {
@@ -124,19 +274,126 @@ void TiledBackingStore::updateTileBuffers()
         return;
     }
 
+    // Paint the tiles closest to the visible rect first.
+    std::stable_sort(dirtyTiles.begin(), dirtyTiles.end(), TileUpdate::isCloserToVisibleRect);
+
+    bool rasterizesOnWorkerThreads = m_client->tiledBackingStoreRasterizesOnWorkerThreads();
+    if (rasterizesOnWorkerThreads && m_commitTileUpdatesOnIdleEventLoop) {
+        unsigned visibleTileCount = 0;
+        while (visibleTileCount < dirtyTiles.size() && !dirtyTiles[visibleTileCount].distance)
+            ++visibleTileCount;
+        if (dirtyTiles.size() > visibleTileCount + maximumNonVisibleTilesPerUpdate) {
+            dirtyTiles.shrink(visibleTileCount + maximumNonVisibleTilesPerUpdate);
+            startTileBufferUpdateTimer();
+        }
+    }
+
+    m_lastUpdateStatistics = UpdateStatistics();
+    m_lastUpdateStartTime = startTime;
+
     // FIXME: In single threaded case, tile back buffers could be updated asynchronously 
     // one by one and then swapped to front in one go. This would minimize the time spent
     // blocking on tile updates.
+    Vector<RefPtr<Tile> > paintedTiles;
+    Vector<RefPtr<Tile> > tilesToRasterize;
     unsigned size = dirtyTiles.size();
     for (unsigned n = 0; n < size; ++n) {
-        Vector<IntRect> paintedRects = dirtyTiles[n]->updateBackBuffer();
-        paintedArea.appendVector(paintedRects);
-        dirtyTiles[n]->swapBackBufferToFront();
+        Tile* tile = dirtyTiles[n].tile.get();
+        if (rasterizesOnWorkerThreads && tile->recordBackBufferUpdate()) {
+            if (tile->needsRasterization()) {
+                tilesToRasterize.append(tile);
+                continue;
+            }
+            paintedArea.appendVector(tile->commitBackBufferUpdate());
+        } else
+            paintedArea.appendVector(tile->updateBackBuffer());
+        tile->swapBackBufferToFront();
+        paintedTiles.append(tile);
+    }
+    didPaintTiles(paintedTiles);
+
+    if (!tilesToRasterize.isEmpty()) {
+        m_tileRasterization = adoptPtr(new TileRasterization(this, tilesToRasterize));
+        // Clients that cannot be called back later get the rasterized tiles right away.
+        if (!m_commitTileUpdatesOnIdleEventLoop)
+            commitRasterizedTiles(paintedArea);
+    }
+
+    m_lastUpdateStatistics.mainThreadDuration = monotonicallyIncreasingTime() - startTime;
+    if (!m_tileRasterization) {
+        m_lastUpdateStatistics.updateDuration = m_lastUpdateStatistics.mainThreadDuration;
+        logUpdateStatistics();
     }
 
     m_client->tiledBackingStorePaintEnd(paintedArea);
 }
 
+void TiledBackingStore::didFinishTileRasterization()
+{
+    double startTime = monotonicallyIncreasingTime();
+
+    // The update that recorded these tiles has ended, so they are reported to the client on their own.
+    Vector<IntRect> paintedArea;
+    commitRasterizedTiles(paintedArea);
+    double now = monotonicallyIncreasingTime();
+    m_lastUpdateStatistics.mainThreadDuration += now - startTime;
+    m_lastUpdateStatistics.updateDuration = now - m_lastUpdateStartTime;
+    logUpdateStatistics();
+    m_client->tiledBackingStorePaintEnd(paintedArea);
+
+    if (m_needsTileBufferUpdate) {
+        m_needsTileBufferUpdate = false;
+        startTileBufferUpdateTimer();
+    }
+}
+
+void TiledBackingStore::commitRasterizedTiles(Vector<IntRect>& paintedArea)
+{
+    ASSERT(m_tileRasterization);
+    Vector<RefPtr<Tile> > tiles;
+    m_tileRasterization->finish(tiles);
+    m_tileRasterization.clear();
+
+    for (size_t n = 0; n < tiles.size(); ++n) {
+        paintedArea.appendVector(tiles[n]->commitBackBufferUpdate());
+        tiles[n]->swapBackBufferToFront();
+    }
+    didPaintTiles(tiles);
+    m_lastUpdateStatistics.workerThreadTileCount = tiles.size();
+}
+
+void TiledBackingStore::didPaintTiles(const Vector<RefPtr<Tile> >& tiles)
+{
+    if (tiles.isEmpty())
+        return;
+
+    double now = monotonicallyIncreasingTime();
+    double totalLatency = m_lastUpdateStatistics.averageTileLatency * m_lastUpdateStatistics.paintedTileCount;
+    for (size_t n = 0; n < tiles.size(); ++n) {
+        const Tile::Coordinate& coordinate = tiles[n]->coordinate();
+        TileDirtyTimeMap::iterator it = m_tileDirtyTimes.find(coordinate);
+        if (it == m_tileDirtyTimes.end())
+            continue;
+
+        double latency = now - it->value;
+        totalLatency += latency;
+        m_lastUpdateStatistics.maximumTileLatency = std::max(m_lastUpdateStatistics.maximumTileLatency, latency);
+        m_tileDirtyTimes.remove(it);
+        // Tiles invalidated again while they were rasterized on a worker thread are still dirty.
+        if (tiles[n]->isDirty())
+            m_tileDirtyTimes.add(coordinate, now);
+    }
+    m_lastUpdateStatistics.paintedTileCount += tiles.size();
+    m_lastUpdateStatistics.averageTileLatency = totalLatency / m_lastUpdateStatistics.paintedTileCount;
+}
+
+void TiledBackingStore::logUpdateStatistics() const
+{
+    LOG(Compositing, "TiledBackingStore %p painted %u tiles, %u on worker threads, in %.1fms, %.1fms of it on the main thread, tile latency %.1fms average, %.1fms maximum",
+        this, m_lastUpdateStatistics.paintedTileCount, m_lastUpdateStatistics.workerThreadTileCount, m_lastUpdateStatistics.updateDuration * 1000,
+        m_lastUpdateStatistics.mainThreadDuration * 1000, m_lastUpdateStatistics.averageTileLatency * 1000, m_lastUpdateStatistics.maximumTileLatency * 1000);
+}
+
 void TiledBackingStore::paint(GraphicsContext* context, const IntRect& rect)
 {
     context->save();
@@ -190,6 +447,7 @@ void TiledBackingStore::commitScaleChange()
     m_contentsScale = m_pendingScale;
     m_pendingScale = 0;
     m_tiles.clear();
+    m_tileDirtyTimes.clear();
     coverWithTilesIfNeeded();
 }
 
@@ -241,9 +499,11 @@ void TiledBackingStore::createTiles()
 
     // Update our backing store geometry.
     const IntRect previousRect = m_rect;
+    const IntRect previousVisibleRect = m_visibleRect;
     m_rect = mapFromContents(m_client->tiledBackingStoreContentsRect());
     m_trajectoryVector = m_pendingTrajectoryVector;
     m_visibleRect = visibleRect();
+    updateScrollVelocity(previousVisibleRect, m_visibleRect);
 
     if (m_rect.isEmpty()) {
         setCoverRect(IntRect());
@@ -316,8 +576,9 @@ void TiledBackingStore::createTiles()
         }
     }
 
-    // Now construct the tile(s) within the shortest distance.
-    unsigned tilesToCreateCount = tilesToCreate.size();
+    // Now construct the tile(s) within the shortest distance, as far as the memory budget allows.
+    unsigned tilesToCreateCount = tilesToCreate.isEmpty() ? 0 : makeRoomForTiles(tilesToCreate.size(), shortestDistance);
+    bool reachedMemoryBudget = tilesToCreateCount < tilesToCreate.size();
     for (unsigned n = 0; n < tilesToCreateCount; ++n) {
         Tile::Coordinate coordinate = tilesToCreate[n];
         setTile(coordinate, m_backend->createTile(this, coordinate));
@@ -328,8 +589,14 @@ void TiledBackingStore::createTiles()
     if (tilesToCreateCount || didResizeTiles)
         updateTileBuffers();
 
+    // Once scrolling stops the cover rect goes back to covering all directions, so check again
+    // when the measured velocity runs out.
+    if (m_scrollVelocity != FloatPoint::zero() && m_commitTileUpdatesOnIdleEventLoop && (!requiredTileCount || reachedMemoryBudget))
+        startBackingStoreUpdateTimer(scrollVelocityTimeout);
+
     // Re-call createTiles on a timer to cover the visible area with the newest shortest distance.
-    m_pendingTileCreation = requiredTileCount;
+    // Nothing more can be created once the budget is used up, until the visible rect moves.
+    m_pendingTileCreation = !reachedMemoryBudget && requiredTileCount;
     if (m_pendingTileCreation) {
         if (!m_commitTileUpdatesOnIdleEventLoop) {
             m_client->tiledBackingStoreHasPendingTileCreation();
@@ -341,6 +608,105 @@ void TiledBackingStore::createTiles()
     }
 }
 
+void TiledBackingStore::updateScrollVelocity(const IntRect& previousVisibleRect, const IntRect& visibleRect)
+{
+    double now = monotonicallyIncreasingTime();
+    double elapsed = now - m_lastScrollTime;
+
+    // A resized viewport or a scale change is not a scroll.
+    if (previousVisibleRect.isEmpty() || previousVisibleRect.size() != visibleRect.size() || elapsed > scrollVelocityTimeout) {
+        m_scrollVelocity = FloatPoint::zero();
+        m_lastScrollTime = now;
+        return;
+    }
+
+    // createTiles() is also called from a timer while the visible rect stays in place.
+    if (previousVisibleRect.location() == visibleRect.location() || elapsed <= 0)
+        return;
+
+    IntSize delta = visibleRect.location() - previousVisibleRect.location();
+    FloatPoint velocity(delta.width() / elapsed, delta.height() / elapsed);
+    m_scrollVelocity = FloatPoint(m_scrollVelocity.x() + (velocity.x() - m_scrollVelocity.x()) * scrollVelocitySmoothing,
+        m_scrollVelocity.y() + (velocity.y() - m_scrollVelocity.y()) * scrollVelocitySmoothing);
+    if (m_scrollVelocity.length() < minimumScrollSpeed)
+        m_scrollVelocity = FloatPoint::zero();
+    m_lastScrollTime = now;
+}
+
+FloatPoint TiledBackingStore::currentScrollVelocity() const
+{
+    if (monotonicallyIncreasingTime() - m_lastScrollTime > scrollVelocityTimeout)
+        return FloatPoint::zero();
+    return m_scrollVelocity;
+}
+
+unsigned TiledBackingStore::maximumTileCount() const
+{
+    size_t budget = m_client->tiledBackingStoreMemoryBudget();
+    if (!budget)
+        return std::numeric_limits<unsigned>::max();
+
+    size_t bytesPerTile = static_cast<size_t>(m_tileSize.width()) * m_tileSize.height() * 4;
+    return std::max<unsigned>(budget / bytesPerTile, 1);
+}
+
+double TiledBackingStore::tileEvictionPriority(const Tile::Coordinate& coordinate, const FloatPoint& scrollDirection) const
+{
+    double distance = tileDistance(m_visibleRect, coordinate);
+    if (scrollDirection == FloatPoint::zero())
+        return distance;
+
+    // How many tiles ahead of the center of the visible rect the tile is, in the direction of motion.
+    IntPoint viewCenter = m_visibleRect.location() + IntSize(m_visibleRect.width() / 2, m_visibleRect.height() / 2);
+    Tile::Coordinate centerCoordinate = tileCoordinateForPoint(viewCenter);
+    double ahead = (coordinate.x() - centerCoordinate.x()) * scrollDirection.x() + (coordinate.y() - centerCoordinate.y()) * scrollDirection.y();
+
+    // Tiles behind the motion go first.
+    return distance - ahead;
+}
+
+typedef std::pair<double, Tile::Coordinate> EvictionCandidate;
+
+static bool hasHigherEvictionPriority(const EvictionCandidate& a, const EvictionCandidate& b)
+{
+    return a.first > b.first;
+}
+
+unsigned TiledBackingStore::makeRoomForTiles(unsigned tileCount, double distance)
+{
+    unsigned maximumTileCount = this->maximumTileCount();
+    unsigned existingTileCount = m_tiles.size();
+    if (existingTileCount + tileCount <= maximumTileCount)
+        return tileCount;
+
+    FloatPoint scrollDirection = currentScrollVelocity();
+    scrollDirection.normalize();
+
+    // Never evict the visible tiles, nor tiles in the cover rect that are as close to the
+    // visible rect as the ones about to be created.
+    Vector<EvictionCandidate> candidates;
+    TileMap::iterator end = m_tiles.end();
+    for (TileMap::iterator it = m_tiles.begin(); it != end; ++it) {
+        double distanceFromVisibleRect = tileDistance(m_visibleRect, it->key);
+        if (!distanceFromVisibleRect)
+            continue;
+        if (distanceFromVisibleRect <= distance && it->value->rect().intersects(m_coverRect))
+            continue;
+        candidates.append(EvictionCandidate(tileEvictionPriority(it->key, scrollDirection), it->key));
+    }
+    std::sort(candidates.begin(), candidates.end(), hasHigherEvictionPriority);
+
+    unsigned evictCount = std::min<unsigned>(existingTileCount + tileCount - maximumTileCount, candidates.size());
+    for (unsigned n = 0; n < evictCount; ++n)
+        removeTile(candidates[n].second);
+    existingTileCount -= evictCount;
+
+    // The visible rect is always covered, even over budget.
+    if (!distance)
+        return tileCount;
+    return existingTileCount < maximumTileCount ? std::min(tileCount, maximumTileCount - existingTileCount) : 0;
+}
+
 void TiledBackingStore::adjustForContentsRect(IntRect& rect) const
 {
     IntRect bounds = m_rect;
@@ -412,6 +778,13 @@ void TiledBackingStore::computeCoverAndKeepRect(const IntRect& visibleRect, IntR
                            coverRect.height() * m_trajectoryVector.y() * trajectoryVectorMultiplier);
 
             coverRect.unite(visibleRect);
+        } else {
+            FloatPoint scrollVelocity = currentScrollVelocity();
+            if (scrollVelocity != FloatPoint::zero()) {
+                // Without a trajectory from the client, predict it from how fast the visible rect moves.
+                coverRect = coverRectForScrollVelocity(visibleRect, scrollVelocity);
+                keepRect.unite(coverRect);
+            }
         }
         ASSERT(keepRect.contains(coverRect));
     }
@@ -427,6 +800,31 @@ void TiledBackingStore::computeCoverAndKeepRect(const IntRect& visibleRect, IntR
     ASSERT(coverRect.isEmpty() || keepRect.contains(coverRect));
 }
 
+IntRect TiledBackingStore::coverRectForScrollVelocity(const IntRect& visibleRect, const FloatPoint& scrollVelocity) const
+{
+    float speed = scrollVelocity.length();
+    FloatPoint direction = scrollVelocity;
+    direction.normalize();
+
+    // Reach at least as far ahead as the static cover area does, and further the faster we scroll.
+    float staticInflationX = visibleRect.width() * (m_coverAreaMultiplier - 1) / 2;
+    float staticInflationY = visibleRect.height() * (m_coverAreaMultiplier - 1) / 2;
+    float reachX = std::max<float>(speed * scrollPrefetchInterval, 2 * staticInflationX) * direction.x();
+    float reachY = std::max<float>(speed * scrollPrefetchInterval, 2 * staticInflationY) * direction.y();
+    float maximumReachX = visibleRect.width() * maximumScrollPrefetchViewports;
+    float maximumReachY = visibleRect.height() * maximumScrollPrefetchViewports;
+
+    IntRect coverRect = visibleRect;
+    coverRect.move(clampTo<float>(reachX, -maximumReachX, maximumReachX), clampTo<float>(reachY, -maximumReachY, maximumReachY));
+    coverRect.unite(visibleRect);
+
+    // The faster we scroll, the less is covered across the direction of motion.
+    float crossFactor = 1 - std::min(speed / fastScrollSpeed, 1.f);
+    coverRect.inflateX(staticInflationX * crossFactor * (1 - fabs(direction.x())));
+    coverRect.inflateY(staticInflationY * crossFactor * (1 - fabs(direction.y())));
+    return coverRect;
+}
+
 bool TiledBackingStore::isBackingStoreUpdatesSuspended() const
 {
     return m_contentsFrozen;
@@ -494,11 +892,13 @@ PassRefPtr<Tile> TiledBackingStore::tileAt(const Tile::Coordinate& coordinate) c
 void TiledBackingStore::setTile(const Tile::Coordinate& coordinate, PassRefPtr<Tile> tile)
 {
     m_tiles.set(coordinate, tile);
+    m_tileDirtyTimes.set(coordinate, monotonicallyIncreasingTime());
 }
 
 void TiledBackingStore::removeTile(const Tile::Coordinate& coordinate)
 {
     m_tiles.remove(coordinate);
+    m_tileDirtyTimes.remove(coordinate);
 }
 
 IntRect TiledBackingStore::mapToContents(const IntRect& rect) const
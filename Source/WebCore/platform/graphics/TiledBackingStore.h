@@ -30,6 +30,7 @@
 #include "Timer.h"
 #include <wtf/Assertions.h>
 #include <wtf/HashMap.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/RefPtr.h>
 
 namespace WebCore {
@@ -75,11 +76,37 @@ public:
     double tileDistance(const IntRect& viewport, const Tile::Coordinate&) const;
 
     IntRect coverRect() const { return m_coverRect; }
+    unsigned tileCount() const { return m_tiles.size(); }
     bool visibleAreaIsCovered() const;
     void removeAllNonVisibleTiles();
 
     void setSupportsAlpha(bool);
 
+    struct UpdateStatistics {
+        UpdateStatistics()
+            : updateDuration(0)
+            , mainThreadDuration(0)
+            , paintedTileCount(0)
+            , workerThreadTileCount(0)
+            , averageTileLatency(0)
+            , maximumTileLatency(0)
+        {
+        }
+
+        // Time from the start of the last updateTileBuffers() call until all of its tiles were
+        // painted, in seconds. Tiles rasterized on worker threads are painted after the call returns.
+        double updateDuration;
+        // How much of that time the main thread was busy with the update.
+        double mainThreadDuration;
+        unsigned paintedTileCount;
+        unsigned workerThreadTileCount;
+        // How long the tiles painted by the last update waited since they were created or
+        // invalidated, in seconds.
+        double averageTileLatency;
+        double maximumTileLatency;
+    };
+    const UpdateStatistics& lastUpdateStatistics() const { return m_lastUpdateStatistics; }
+
 private:
     void startTileBufferUpdateTimer();
     void startBackingStoreUpdateTimer(double = 0);
@@ -89,6 +116,14 @@ private:
 
     void createTiles();
     void computeCoverAndKeepRect(const IntRect& visibleRect, IntRect& coverRect, IntRect& keepRect) const;
+    IntRect coverRectForScrollVelocity(const IntRect& visibleRect, const FloatPoint& scrollVelocity) const;
+
+    void updateScrollVelocity(const IntRect& previousVisibleRect, const IntRect& visibleRect);
+    FloatPoint currentScrollVelocity() const;
+
+    unsigned maximumTileCount() const;
+    double tileEvictionPriority(const Tile::Coordinate&, const FloatPoint& scrollDirection) const;
+    unsigned makeRoomForTiles(unsigned tileCount, double distance);
 
     bool isBackingStoreUpdatesSuspended() const;
     bool isTileBufferUpdatesSuspended() const;
@@ -105,6 +140,12 @@ private:
 
     IntRect visibleRect() const;
 
+    class TileRasterization;
+    void didFinishTileRasterization();
+    void commitRasterizedTiles(Vector<IntRect>& paintedArea);
+    void didPaintTiles(const Vector<RefPtr<Tile> >&);
+    void logUpdateStatistics() const;
+
     float coverageRatio(const IntRect&) const;
     void adjustForContentsRect(IntRect&) const;
 
@@ -117,6 +158,15 @@ private:
     typedef HashMap<Tile::Coordinate, RefPtr<Tile> > TileMap;
     TileMap m_tiles;
 
+    // When each dirty tile was created or first invalidated.
+    typedef HashMap<Tile::Coordinate, double> TileDirtyTimeMap;
+    TileDirtyTimeMap m_tileDirtyTimes;
+    UpdateStatistics m_lastUpdateStatistics;
+    double m_lastUpdateStartTime;
+
+    // Tiles being rasterized on worker threads. No other update starts until they are back.
+    OwnPtr<TileRasterization> m_tileRasterization;
+
     Timer<TiledBackingStore> m_tileBufferUpdateTimer;
     Timer<TiledBackingStore> m_backingStoreUpdateTimer;
 
@@ -127,6 +177,11 @@ private:
     FloatPoint m_pendingTrajectoryVector;
     IntRect m_visibleRect;
 
+    // Measured from the movement of the visible rect, in pixels per second. Only used when the
+    // client does not provide a trajectory vector.
+    FloatPoint m_scrollVelocity;
+    double m_lastScrollTime;
+
     IntRect m_coverRect;
     IntRect m_keepRect;
     IntRect m_rect;
@@ -138,6 +193,7 @@ private:
     bool m_contentsFrozen;
     bool m_supportsAlpha;
     bool m_pendingTileCreation;
+    bool m_needsTileBufferUpdate;
 
     friend class Tile;
 };
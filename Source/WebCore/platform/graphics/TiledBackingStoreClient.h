@@ -37,6 +37,9 @@ public:
     virtual IntRect tiledBackingStoreContentsRect() = 0;
     virtual IntRect tiledBackingStoreVisibleRect() = 0;
     virtual Color tiledBackingStoreBackgroundColor() const = 0;
+    virtual bool tiledBackingStoreRasterizesOnWorkerThreads() const { return false; }
+    // The number of bytes the tile buffers may use, or 0 for no limit.
+    virtual size_t tiledBackingStoreMemoryBudget() const { return 0; }
 };
 
 #else
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WordShapingCache.h"
+
+#include "SimpleFontData.h"
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+unsigned WordShapingCache::s_hitCount = 0;
+unsigned WordShapingCache::s_missCount = 0;
+
+static HashSet<WordShapingCache*>& liveCaches()
+{
+    DEFINE_STATIC_LOCAL(HashSet<WordShapingCache*>, caches, ());
+    return caches;
+}
+
+static unsigned runFlags(const TextRun& run)
+{
+    return static_cast<unsigned>(run.rtl())
+        | static_cast<unsigned>(run.directionalOverride()) << 1
+        | static_cast<unsigned>(run.characterScanForCodePath()) << 2
+        | static_cast<unsigned>(run.applyRunRounding()) << 3
+        | static_cast<unsigned>(run.applyWordRounding()) << 4;
+}
+
+// Looks words up straight from the run, so that only new entries allocate a String.
+struct WordShapingCache::RunTranslator {
+    static unsigned hash(const TextRun& run)
+    {
+        unsigned textHash = run.is8Bit() ? StringHasher::computeHashAndMaskTop8Bits(run.characters8(), run.length()) : StringHasher::computeHashAndMaskTop8Bits(run.characters16(), run.length());
+        return WTF::pairIntHash(textHash, runFlags(run));
+    }
+
+    static bool equal(const Key& key, const TextRun& run)
+    {
+        if (key.flags != runFlags(run) || key.text.length() != static_cast<unsigned>(run.length()))
+            return false;
+        if (run.is8Bit())
+            return WTF::equal(key.text.impl(), run.characters8(), run.length());
+        return WTF::equal(key.text.impl(), run.characters16(), run.length());
+    }
+
+    static void translate(Key& key, const TextRun& run, unsigned)
+    {
+        String text = run.is8Bit() ? String(run.characters8(), run.length()) : String(run.characters16(), run.length());
+        key = Key(text, runFlags(run));
+    }
+};
+
+WordShapingCache::WordShapingCache()
+    : m_interval(s_maxInterval)
+    , m_countdown(m_interval)
+    , m_memoryUsage(0)
+{
+    liveCaches().add(this);
+}
+
+WordShapingCache::~WordShapingCache()
+{
+    liveCaches().remove(this);
+}
+
+WordShapingCache::ShapedWord* WordShapingCache::addSlowCase(const TextRun& run)
+{
+    Map::AddResult addResult = m_map.add<RunTranslator>(run, ShapedWord());
+    ShapedWord* value = &addResult.iterator->value;
+
+    // Cache hit: ramp up by sampling the next few words.
+    if (!addResult.isNewEntry && !value->isEmpty()) {
+        ++s_hitCount;
+        m_interval = s_minInterval;
+        return value;
+    }
+
+    // Cache miss: ramp down by increasing our sampling interval.
+    ++s_missCount;
+    if (m_interval < s_maxInterval)
+        ++m_interval;
+    m_countdown = m_interval;
+
+    if (addResult.isNewEntry)
+        m_memoryUsage += sizeof(Map::ValueType) + run.length() * (run.is8Bit() ? sizeof(LChar) : sizeof(UChar));
+    if (m_memoryUsage < s_maxMemoryUsage)
+        return value;
+
+    // No need to be fancy: we're just trying to avoid pathological growth.
+    clear();
+    return 0;
+}
+
+void WordShapingCache::didShapeWord(const ShapedWord& word)
+{
+    m_memoryUsage += word.fallbackFonts.size() * sizeof(RefPtr<SimpleFontData>);
+    if (m_memoryUsage >= s_maxMemoryUsage)
+        clear();
+}
+
+PassRefPtr<WordShapingCache::ShapedRun> WordShapingCache::shapedRun(const String& text, unsigned flags) const
+{
+    ShapedRunMap::const_iterator it = m_shapedRuns.find(Key(text, flags));
+    return it == m_shapedRuns.end() ? 0 : it->value;
+}
+
+bool WordShapingCache::containsShapedRun(const String& text, unsigned flags) const
+{
+    return m_shapedRuns.contains(Key(text, flags));
+}
+
+void WordShapingCache::addShapedRun(const String& text, unsigned flags, PassRefPtr<ShapedRun> prpShapedRun)
+{
+    RefPtr<ShapedRun> shapedRun = prpShapedRun;
+    size_t memoryUsage = sizeof(ShapedRunMap::ValueType) + text.length() * (text.is8Bit() ? sizeof(LChar) : sizeof(UChar)) + shapedRun->memoryUsage();
+    if (memoryUsage >= s_maxMemoryUsage)
+        return;
+    if (m_memoryUsage + memoryUsage >= s_maxMemoryUsage)
+        clear();
+    if (m_shapedRuns.add(Key(text, flags), shapedRun).isNewEntry)
+        m_memoryUsage += memoryUsage;
+}
+
+void WordShapingCache::clear()
+{
+    m_map.clear();
+    m_shapedRuns.clear();
+    m_memoryUsage = 0;
+}
+
+void WordShapingCache::clearAll()
+{
+    HashSet<WordShapingCache*>::iterator end = liveCaches().end();
+    for (HashSet<WordShapingCache*>::iterator it = liveCaches().begin(); it != end; ++it)
+        (*it)->clear();
+}
+
+} // namespace WebCore
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef WordShapingCache_h
+#define WordShapingCache_h
+
+#include "TextRun.h"
+#include <wtf/Forward.h>
+#include <wtf/HashFunctions.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/MathExtras.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+#include <wtf/StringHasher.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+#include <limits>
+
+namespace WebCore {
+
+class SimpleFontData;
+struct GlyphOverflow;
+
+// Remembers the measured width of words, together with the fallback fonts used to shape them, for
+// both the simple and the complex text paths. The cache outlives layouts: words measured again after
+// a resize, or after a web font loads for some other family, are found here instead of being shaped
+// again. Ports that shape whole runs ahead of line breaking keep the results here as well. Each cache
+// holds a bounded amount of memory and all caches are emptied on memory pressure.
+class WordShapingCache : public RefCounted<WordShapingCache> {
+public:
+    struct ShapedWord {
+        ShapedWord()
+            : width(std::numeric_limits<float>::quiet_NaN())
+        {
+        }
+
+        bool isEmpty() const { return std::isnan(width); }
+
+        float width;
+        Vector<RefPtr<SimpleFontData> > fallbackFonts;
+    };
+
+    // Cursor positions of a whole text run, for ports that shape runs ahead of line breaking.
+    // Offsets that were not recorded hold NaN.
+    class ShapedRun : public RefCounted<ShapedRun> {
+    public:
+        static PassRefPtr<ShapedRun> create(Vector<float>& cursorPositions) { return adoptRef(new ShapedRun(cursorPositions)); }
+
+        bool cursorToX(unsigned offset, float& x) const
+        {
+            if (offset >= m_cursorPositions.size() || std::isnan(m_cursorPositions[offset]))
+                return false;
+            x = m_cursorPositions[offset];
+            return true;
+        }
+
+        size_t memoryUsage() const { return sizeof(ShapedRun) + m_cursorPositions.size() * sizeof(float); }
+
+    private:
+        explicit ShapedRun(Vector<float>& cursorPositions)
+        {
+            m_cursorPositions.swap(cursorPositions);
+        }
+
+        Vector<float> m_cursorPositions;
+    };
+
+    static PassRefPtr<WordShapingCache> create() { return adoptRef(new WordShapingCache); }
+    ~WordShapingCache();
+
+    ShapedWord* add(const TextRun& run, bool isExpensiveToShape, bool hasWordSpacingOrLetterSpacing, GlyphOverflow* glyphOverflow)
+    {
+        // The cache is not really profitable unless we're doing expensive glyph transformations.
+        if (!isExpensiveToShape)
+            return 0;
+        // Word spacing and letter spacing can change the width of a word.
+        if (hasWordSpacingOrLetterSpacing)
+            return 0;
+        // Since this is just a width cache, we don't have enough information to satisfy glyph queries.
+        if (glyphOverflow)
+            return 0;
+        // If we allow tabs and a tab occurs inside a word, the width of the word varies based on its position on the line.
+        if (run.allowTabs())
+            return 0;
+        // Expansion is distributed over the whole run being laid out, not over single words.
+        if (run.expansion())
+            return 0;
+        if (!run.length() || static_cast<unsigned>(run.length()) > s_maxWordLength)
+            return 0;
+
+        if (m_countdown > 0) {
+            --m_countdown;
+            return 0;
+        }
+
+        return addSlowCase(run);
+    }
+
+    // Called once a word returned by add() has been measured.
+    void didShapeWord(const ShapedWord&);
+
+    // Runs are keyed by their text and by port specific flags describing how they are shaped. They
+    // share the memory budget of the words.
+    PassRefPtr<ShapedRun> shapedRun(const String& text, unsigned flags) const;
+    bool containsShapedRun(const String& text, unsigned flags) const;
+    void addShapedRun(const String& text, unsigned flags, PassRefPtr<ShapedRun>);
+
+    void clear();
+
+    static void clearAll();
+
+    // Totals over all caches, for testing.
+    static unsigned hitCount() { return s_hitCount; }
+    static unsigned missCount() { return s_missCount; }
+
+private:
+    WordShapingCache();
+
+    ShapedWord* addSlowCase(const TextRun&);
+
+    // Words are keyed by their characters and by the run flags that change how they are shaped.
+    struct Key {
+        Key()
+            : flags(0)
+        {
+        }
+
+        Key(const String& text, unsigned flags)
+            : text(text)
+            , flags(flags)
+        {
+        }
+
+        Key(WTF::HashTableDeletedValueType)
+            : text(WTF::HashTableDeletedValue)
+            , flags(0)
+        {
+        }
+
+        bool isHashTableDeletedValue() const { return text.isHashTableDeletedValue(); }
+
+        String text;
+        unsigned flags;
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return WTF::pairIntHash(key.text.impl()->hash(), key.flags); }
+        static bool equal(const Key& a, const Key& b) { return a.flags == b.flags && a.text == b.text; }
+        static const bool safeToCompareToEmptyOrDeleted = false;
+    };
+
+    struct KeyHashTraits : WTF::SimpleClassHashTraits<Key> {
+        static const int minimumTableSize = 16;
+    };
+
+    struct RunTranslator;
+
+    typedef HashMap<Key, ShapedWord, KeyHash, KeyHashTraits> Map;
+    typedef HashMap<Key, RefPtr<ShapedRun>, KeyHash, KeyHashTraits> ShapedRunMap;
+
+    static const int s_minInterval = -3; // A cache hit pays for about 3 cache misses.
+    static const int s_maxInterval = 20; // Sampling at this interval has almost no overhead.
+    static const unsigned s_maxWordLength = 64; // Longer runs are rarely measured twice.
+    static const size_t s_maxMemoryUsage = 512 * 1024; // Per cache, to guard against pathological growth.
+
+    static unsigned s_hitCount;
+    static unsigned s_missCount;
+
+    int m_interval;
+    int m_countdown;
+    size_t m_memoryUsage;
+    Map m_map;
+    ShapedRunMap m_shapedRuns;
+};
+
+} // namespace WebCore
+
+#endif // WordShapingCache_h
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayList.h"
+
+#if USE(DISPLAY_LIST_RECORDING)
+
+#include "GraphicsContext.h"
+
+#include <QFontDatabase>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QPicture>
+
+namespace WebCore {
+
+// Records into a QPicture through a painter of its own, so that the use of QPixmaps and text is
+// seen while recording instead of by playing the picture back afterwards. Images decode to
+// QPixmaps, which may only be painted on the GUI thread, and some platforms can only render
+// text there.
+class DisplayListRecordingDevice : public QPaintDevice {
+public:
+    explicit DisplayListRecordingDevice(QPicture* picture)
+        : m_engine(picture)
+    {
+    }
+
+    bool usesPixmaps() const { return m_engine.usesPixmaps(); }
+    bool usesText() const { return m_engine.usesText(); }
+
+    virtual QPaintEngine* paintEngine() const { return &m_engine; }
+
+protected:
+    virtual int metric(PaintDeviceMetric metric) const
+    {
+        const QPicture* picture = m_engine.picture();
+        switch (metric) {
+        case PdmWidth:
+            return picture->width();
+        case PdmHeight:
+            return picture->height();
+        case PdmWidthMM:
+            return picture->widthMM();
+        case PdmHeightMM:
+            return picture->heightMM();
+        case PdmNumColors:
+            return picture->colorCount();
+        case PdmDepth:
+            return picture->depth();
+        case PdmDpiX:
+            return picture->logicalDpiX();
+        case PdmDpiY:
+            return picture->logicalDpiY();
+        case PdmPhysicalDpiX:
+            return picture->physicalDpiX();
+        case PdmPhysicalDpiY:
+            return picture->physicalDpiY();
+        default:
+            return QPaintDevice::metric(metric);
+        }
+    }
+
+private:
+    // Hands every state change and drawing command on to a painter on the picture.
+    class Engine : public QPaintEngine {
+    public:
+        explicit Engine(QPicture* picture)
+            : QPaintEngine(QPaintEngine::AllFeatures)
+            , m_picture(picture)
+            , m_usesPixmaps(false)
+            , m_usesText(false)
+        {
+        }
+
+        const QPicture* picture() const { return m_picture; }
+        bool usesPixmaps() const { return m_usesPixmaps; }
+        bool usesText() const { return m_usesText; }
+
+        virtual bool begin(QPaintDevice*) { return m_painter.begin(m_picture); }
+        virtual bool end() { return m_painter.end(); }
+        virtual Type type() const { return QPaintEngine::User; }
+
+        virtual void updateState(const QPaintEngineState& state)
+        {
+            QPaintEngine::DirtyFlags flags = state.state();
+            // Texture brushes, used for image patterns, keep their texture as a QPixmap.
+            if (flags & DirtyPen) {
+                m_usesPixmaps |= state.pen().brush().style() == Qt::TexturePattern;
+                m_painter.setPen(state.pen());
+            }
+            if (flags & DirtyBrush) {
+                m_usesPixmaps |= state.brush().style() == Qt::TexturePattern;
+                m_painter.setBrush(state.brush());
+            }
+            if (flags & DirtyBrushOrigin)
+                m_painter.setBrushOrigin(state.brushOrigin());
+            if (flags & DirtyFont)
+                m_painter.setFont(state.font());
+            if (flags & DirtyBackground) {
+                m_usesPixmaps |= state.backgroundBrush().style() == Qt::TexturePattern;
+                m_painter.setBackground(state.backgroundBrush());
+            }
+            if (flags & DirtyBackgroundMode)
+                m_painter.setBackgroundMode(state.backgroundMode());
+            if (flags & DirtyTransform)
+                m_painter.setTransform(state.transform());
+            if (flags & DirtyClipEnabled)
+                m_painter.setClipping(state.isClipEnabled());
+            if (flags & DirtyClipRegion)
+                m_painter.setClipRegion(state.clipRegion(), state.clipOperation());
+            if (flags & DirtyClipPath)
+                m_painter.setClipPath(state.clipPath(), state.clipOperation());
+            if (flags & DirtyHints) {
+                m_painter.setRenderHints(m_painter.renderHints() & ~state.renderHints(), false);
+                m_painter.setRenderHints(state.renderHints(), true);
+            }
+            if (flags & DirtyCompositionMode)
+                m_painter.setCompositionMode(state.compositionMode());
+            if (flags & DirtyOpacity)
+                m_painter.setOpacity(state.opacity());
+        }
+
+        virtual void drawRects(const QRect* rects, int count) { m_painter.drawRects(rects, count); }
+        virtual void drawRects(const QRectF* rects, int count) { m_painter.drawRects(rects, count); }
+        virtual void drawLines(const QLine* lines, int count) { m_painter.drawLines(lines, count); }
+        virtual void drawLines(const QLineF* lines, int count) { m_painter.drawLines(lines, count); }
+        virtual void drawEllipse(const QRect& rect) { m_painter.drawEllipse(rect); }
+        virtual void drawEllipse(const QRectF& rect) { m_painter.drawEllipse(rect); }
+        virtual void drawPath(const QPainterPath& path) { m_painter.drawPath(path); }
+        virtual void drawPoints(const QPoint* points, int count) { m_painter.drawPoints(points, count); }
+        virtual void drawPoints(const QPointF* points, int count) { m_painter.drawPoints(points, count); }
+        virtual void drawPolygon(const QPoint* points, int count, PolygonDrawMode mode) { drawPolygonInMode(points, count, mode); }
+        virtual void drawPolygon(const QPointF* points, int count, PolygonDrawMode mode) { drawPolygonInMode(points, count, mode); }
+
+        virtual void drawTextItem(const QPointF& point, const QTextItem& textItem)
+        {
+            m_usesText = true;
+            m_painter.drawTextItem(point, textItem);
+        }
+
+        virtual void drawImage(const QRectF& rect, const QImage& image, const QRectF& sourceRect, Qt::ImageConversionFlags flags)
+        {
+            m_painter.drawImage(rect, image, sourceRect, flags);
+        }
+
+        virtual void drawPixmap(const QRectF& rect, const QPixmap& pixmap, const QRectF& sourceRect)
+        {
+            m_usesPixmaps = true;
+            m_painter.drawPixmap(rect, pixmap, sourceRect);
+        }
+
+        virtual void drawTiledPixmap(const QRectF& rect, const QPixmap& pixmap, const QPointF& offset)
+        {
+            m_usesPixmaps = true;
+            m_painter.drawTiledPixmap(rect, pixmap, offset);
+        }
+
+    private:
+        template<typename PointType>
+        void drawPolygonInMode(const PointType* points, int count, PolygonDrawMode mode)
+        {
+            switch (mode) {
+            case PolylineMode:
+                m_painter.drawPolyline(points, count);
+                return;
+            case ConvexMode:
+                m_painter.drawConvexPolygon(points, count);
+                return;
+            case OddEvenMode:
+                m_painter.drawPolygon(points, count, Qt::OddEvenFill);
+                return;
+            case WindingMode:
+                m_painter.drawPolygon(points, count, Qt::WindingFill);
+                return;
+            }
+        }
+
+        QPicture* m_picture;
+        QPainter m_painter;
+        bool m_usesPixmaps;
+        bool m_usesText;
+    };
+
+    mutable Engine m_engine;
+};
+
+DisplayList::DisplayList(const IntRect& bounds)
+    : m_bounds(bounds)
+    , m_canReplayOnWorkerThread(true)
+    , m_picture(adoptPtr(new QPicture))
+{
+}
+
+DisplayList::~DisplayList()
+{
+    ASSERT(!m_recordingContext);
+}
+
+GraphicsContext* DisplayList::beginRecording()
+{
+    ASSERT(!m_recordingContext);
+
+    // QPicture serializes the QPainter calls into a compact byte stream. Setting the bounding
+    // rect up front keeps QPicture from growing it for every recorded command.
+    m_picture->setBoundingRect(m_bounds);
+    m_recordingDevice = adoptPtr(new DisplayListRecordingDevice(m_picture.get()));
+    m_recordingPainter = adoptPtr(new QPainter(m_recordingDevice.get()));
+    m_recordingContext = adoptPtr(new GraphicsContext(m_recordingPainter.get()));
+    m_recordingContext->clip(m_bounds);
+    return m_recordingContext.get();
+}
+
+void DisplayList::endRecording()
+{
+    ASSERT(m_recordingContext);
+
+    m_recordingContext.clear();
+    m_recordingPainter->end();
+    m_recordingPainter.clear();
+    m_canReplayOnWorkerThread = !m_recordingDevice->usesPixmaps()
+        && (!m_recordingDevice->usesText() || QFontDatabase::supportsThreadedFontRendering());
+    m_recordingDevice.clear();
+}
+
+void DisplayList::replay(GraphicsContext& context) const
+{
+    ASSERT(!m_recordingContext);
+
+    QPainter* painter = context.platformContext();
+    painter->save();
+    m_picture->play(painter);
+    painter->restore();
+}
+
+size_t DisplayList::sizeInBytes() const
+{
+    return m_picture->size();
+}
+
+} // namespace WebCore
+
+#endif // USE(DISPLAY_LIST_RECORDING)
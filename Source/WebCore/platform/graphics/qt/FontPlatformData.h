@@ -41,12 +41,14 @@ public:
         : size(0)
         , bold(false)
         , oblique(false)
+        , isResolvedFromFont(false)
         , isDeletedValue(false)
     { }
     FontPlatformDataPrivate(const float size, const bool bold, const bool oblique)
         : size(size)
         , bold(bold)
         , oblique(oblique)
+        , isResolvedFromFont(false)
         , isDeletedValue(false)
     {
 // This is necessary for SVG Fonts, which are only supported when using QRawFont.
@@ -63,17 +65,21 @@ public:
         , size(rawFont.pixelSize())
         , bold(rawFont.weight() >= QFont::Bold)
         , oblique(false)
+        , isResolvedFromFont(false)
         , isDeletedValue(false)
     { }
 
     FontPlatformDataPrivate(WTF::HashTableDeletedValueType)
-        : isDeletedValue(true)
+        : isResolvedFromFont(false)
+        , isDeletedValue(true)
     { }
 
     QRawFont rawFont;
+    QFont font;
     float size;
     bool bold : 1;
     bool oblique : 1;
+    bool isResolvedFromFont : 1;
     bool isDeletedValue : 1;
 };
 
@@ -107,6 +113,15 @@ public:
         return m_data->rawFont;
     }
 
+    // QRawFont may only be used on the thread that resolved it. When the raw font was
+    // resolved from a QFont, other threads can resolve the same font engine from font().
+    bool isResolvedFromFont() const { return m_data && m_data->isResolvedFromFont; }
+    QFont font() const
+    {
+        Q_ASSERT(isResolvedFromFont());
+        return m_data->font;
+    }
+
     float size() const
     {
         Q_ASSERT(!isHashTableDeletedValue());
@@ -125,6 +125,8 @@ FontPlatformData::FontPlatformData(const FontDescription& description, const Ato
     // otherwise.
     m_data->size = (!requestedSize) ? requestedSize : font.pixelSize();
     m_data->rawFont = QRawFont::fromFont(font, QFontDatabase::Any);
+    m_data->font = font;
+    m_data->isResolvedFromFont = true;
 }
 
 FontPlatformData::FontPlatformData(const FontPlatformData& other, float size)
@@ -35,16 +35,23 @@
 #include "RenderText.h"
 #include "ShadowBlur.h"
 #include "TextRun.h"
+#include "WordShapingCache.h"
+#include <wtf/HashSet.h>
+#include <wtf/MathExtras.h>
+#include <wtf/ParallelJobs.h>
 
 #include <QBrush>
+#include <QFontDatabase>
 #include <QPainter>
 #include <QPainterPath>
 #include <QPen>
 #include <QPointF>
+#include <QTextBoundaryFinder>
 #include <QTextLayout>
 #include <qalgorithms.h>
 
 #include <limits.h>
+#include <limits>
 
 namespace WebCore {
 
@@ -59,24 +66,34 @@ static const QString fromRawDataWithoutRef(const String& string, int start = 0,
     return QString::fromRawData(reinterpret_cast<const QChar*>(string.characters() + start), len);
 }
 
-static QTextLine setupLayout(QTextLayout* layout, const TextRun& style, bool shouldSetDirection)
+static int layoutFlags(const TextRun& style, bool shouldSetDirection)
 {
     int flags = 0;
     if (shouldSetDirection || style.directionalOverride())
         flags |= style.rtl() ? Qt::TextForceRightToLeft : Qt::TextForceLeftToRight;
     if (style.expansion())
         flags |= Qt::TextJustificationForced;
+    return flags;
+}
+
+static QTextLine setupLayout(QTextLayout* layout, int flags, float expansion)
+{
     layout->setCacheEnabled(true);
     layout->setFlags(flags);
     layout->beginLayout();
     QTextLine line = layout->createLine();
     line.setLineWidth(INT_MAX/256);
-    if (style.expansion())
-        line.setLineWidth(line.naturalTextWidth() + style.expansion());
+    if (expansion)
+        line.setLineWidth(line.naturalTextWidth() + expansion);
     layout->endLayout();
     return line;
 }
 
+static QTextLine setupLayout(QTextLayout* layout, const TextRun& style, bool shouldSetDirection)
+{
+    return setupLayout(layout, layoutFlags(style, shouldSetDirection), style.expansion());
+}
+
 static QPen fillPenForContext(GraphicsContext* ctx)
 {
     if (ctx->fillGradient()) {
@@ -173,6 +190,40 @@ static void drawQtGlyphRun(GraphicsContext* context, const QGlyphRun& qtGlyphRun
     }
 }
 
+static QList<QTextLayout::FormatRange> additionalFormats(const Font& font, const TextRun& run)
+{
+    QTextLayout::FormatRange range;
+    // WebCore expects word-spacing to be ignored on leading spaces contrary to what Qt does.
+    // To avoid word-spacing on any leading spaces, we exclude them from FormatRange which
+    // word-spacing along with other options would be applied to. This is safe since the other
+    // formatting options does not affect spaces.
+    unsigned length = run.length();
+    for (range.start = 0; range.start < length && Font::treatAsSpace(run[range.start]); ++range.start) { }
+    range.length = length - range.start;
+
+    if (font.wordSpacing() && !run.spacingDisabled())
+        range.format.setFontWordSpacing(font.wordSpacing());
+    if (font.letterSpacing() && !run.spacingDisabled())
+        range.format.setFontLetterSpacing(font.letterSpacing());
+    if (font.typesettingFeatures() & Kerning)
+        range.format.setFontKerning(true);
+    if (font.isSmallCaps())
+        range.format.setFontCapitalization(QFont::SmallCaps);
+
+    if (!range.format.propertyCount() || !range.length)
+        return QList<QTextLayout::FormatRange>();
+    return QList<QTextLayout::FormatRange>() << range;
+}
+
+// Only fonts resolved from a QFont can be shaped off the main thread. Word and letter spacing are not
+// part of the font the cache belongs to, so runs using them are not cached, as for words.
+static bool canCacheShapedRun(const Font& font, const TextRun& run)
+{
+    if (!font.primaryFont()->platformData().isResolvedFromFont())
+        return false;
+    return run.spacingDisabled() || (!font.wordSpacing() && !font.letterSpacing());
+}
+
 class TextLayout {
 public:
     static bool isNeeded(RenderText* text, const Font& font)
@@ -181,6 +232,16 @@ public:
         return font.codePath(run) == Font::Complex;
     }
 
+    static TextRun constructTextRun(RenderText* text, const Font& font, float xPos)
+    {
+        TextRun run = RenderBlock::constructTextRun(text, font, text, text->style());
+        run.setCharactersLength(text->textLength());
+        ASSERT(run.charactersLength() >= run.length());
+
+        run.setXPos(xPos);
+        return run;
+    }
+
     TextLayout(RenderText* text, const Font& font, float xPos)
     {
         const TextRun run(constructTextRun(text, font, xPos));
@@ -189,32 +250,37 @@ public:
         m_layout.setText(string);
         m_layout.setRawFont(font.rawFont());
         font.initFormatForTextLayout(&m_layout, run);
-        m_line = setupLayout(&m_layout, run, false);
+        m_flags = layoutFlags(run, false);
+
+        if (canCacheShapedRun(font, run))
+            m_shapedRun = font.glyphs()->wordShapingCache().shapedRun(sanitized, m_flags);
+        // The cached positions only cover the offsets line breaking usually asks for. The
+        // layout is shaped here on the first offset they miss.
+        if (!m_shapedRun)
+            m_line = setupLayout(&m_layout, m_flags, 0);
     }
 
     float width(unsigned from, unsigned len, HashSet<const SimpleFontData*>* fallbackFonts)
     {
         Q_UNUSED(fallbackFonts);
-        float x1 = m_line.cursorToX(from);
-        float x2 = m_line.cursorToX(from + len);
+        float x1;
+        float x2;
+        if (!m_shapedRun || !m_shapedRun->cursorToX(from, x1) || !m_shapedRun->cursorToX(from + len, x2)) {
+            if (!m_line.isValid())
+                m_line = setupLayout(&m_layout, m_flags, 0);
+            x1 = m_line.cursorToX(from);
+            x2 = m_line.cursorToX(from + len);
+        }
         float width = qAbs(x2 - x1);
 
         return width;
     }
 
 private:
-    static TextRun constructTextRun(RenderText* text, const Font& font, float xPos)
-    {
-        TextRun run = RenderBlock::constructTextRun(text, font, text, text->style());
-        run.setCharactersLength(text->textLength());
-        ASSERT(run.charactersLength() >= run.length());
-
-        run.setXPos(xPos);
-        return run;
-    }
-
     QTextLayout m_layout;
     QTextLine m_line;
+    int m_flags;
+    RefPtr<WordShapingCache::ShapedRun> m_shapedRun;
 };
 
 PassOwnPtr<TextLayout> Font::createLayout(RenderText* text, float xPos, bool collapseWhiteSpace) const
@@ -234,6 +300,126 @@ float Font::width(TextLayout& layout, unsigned from, unsigned len, HashSet<const
     return layout.width(from, len, fallbackFonts);
 }
 
+// Everything a worker thread needs to shape one text run. WebCore fonts, strings and
+// renderers stay on the main thread; workers only see Qt's reentrant value types and
+// resolve their own QRawFont, since raw fonts are bound to the thread that made them.
+// The cache and the text a job is stored under are only used once the workers are done.
+struct ShapingJob {
+    WordShapingCache* cache;
+    String sanitizedText;
+    QString text;
+    QString fontDescription;
+    QFont::StyleStrategy styleStrategy;
+    QList<QTextLayout::FormatRange> formats;
+    int flags;
+    Vector<float> cursorPositions;
+};
+
+struct ShapingParameters {
+    ShapingJob* jobs;
+    size_t jobCount;
+};
+
+// Empirical number of characters below which shaping is not worth a thread.
+static const unsigned minimalShapingLengthPerThread = 4096;
+
+static void shapeText(ShapingJob& job)
+{
+    QFont font;
+    font.fromString(job.fontDescription);
+    font.setStyleStrategy(job.styleStrategy);
+
+    QTextLayout layout(job.text);
+    layout.setRawFont(QRawFont::fromFont(font, QFontDatabase::Any));
+    if (!job.formats.isEmpty())
+        layout.setAdditionalFormats(job.formats);
+    QTextLine line = setupLayout(&layout, job.flags, 0);
+
+    int length = job.text.length();
+    job.cursorPositions.fill(std::numeric_limits<float>::quiet_NaN(), length + 1);
+    job.cursorPositions[0] = line.cursorToX(0);
+    job.cursorPositions[length] = line.cursorToX(length);
+    for (int i = 0; i < length; ++i) {
+        if (job.text.at(i) != QLatin1Char(' '))
+            continue;
+        job.cursorPositions[i] = line.cursorToX(i);
+        job.cursorPositions[i + 1] = line.cursorToX(i + 1);
+    }
+    QTextBoundaryFinder finder(QTextBoundaryFinder::Line, job.text);
+    for (int offset = finder.toNextBoundary(); offset > 0 && offset < length; offset = finder.toNextBoundary()) {
+        if (std::isnan(job.cursorPositions[offset]))
+            job.cursorPositions[offset] = line.cursorToX(offset);
+    }
+}
+
+static void shapeTextWorker(ShapingParameters* parameters)
+{
+    for (size_t i = 0; i < parameters->jobCount; ++i)
+        shapeText(parameters->jobs[i]);
+}
+
+void Font::prepareLayouts(const Vector<RenderText*>& texts)
+{
+    Vector<ShapingJob> jobs;
+    HashSet<std::pair<WordShapingCache*, std::pair<String, int> > > queuedRuns;
+    unsigned totalLength = 0;
+    for (size_t i = 0; i < texts.size(); ++i) {
+        RenderText* text = texts[i];
+        if (!text->textLength() || !text->style()->collapseWhiteSpace())
+            continue;
+        const Font& font = text->style()->font();
+        if (!TextLayout::isNeeded(text, font))
+            continue;
+
+        const TextRun run(TextLayout::constructTextRun(text, font, 0));
+        if (!canCacheShapedRun(font, run))
+            continue;
+        ShapingJob job;
+        job.cache = &font.glyphs()->wordShapingCache();
+        job.sanitizedText = Font::normalizeSpaces(run.characters16(), run.length());
+        job.flags = layoutFlags(run, false);
+        if (job.cache->containsShapedRun(job.sanitizedText, job.flags) || !queuedRuns.add(std::make_pair(job.cache, std::make_pair(job.sanitizedText, job.flags))).isNewEntry)
+            continue;
+        QFont qtFont = font.primaryFont()->platformData().font();
+        job.text = QString(job.sanitizedText);
+        job.fontDescription = qtFont.toString();
+        job.styleStrategy = qtFont.styleStrategy();
+        job.formats = additionalFormats(font, run);
+        totalLength += job.sanitizedText.length();
+        jobs.append(job);
+    }
+    if (jobs.isEmpty())
+        return;
+
+    // Workers resolve their own fonts and shape with them, which the font database has to support.
+    bool shapedInParallel = false;
+    int optimalThreadNumber = std::min<int>(totalLength / minimalShapingLengthPerThread, jobs.size());
+    if (optimalThreadNumber > 1 && QFontDatabase::supportsThreadedFontRendering()) {
+        WTF::ParallelJobs<ShapingParameters> parallelJobs(&shapeTextWorker, optimalThreadNumber);
+        int numOfThreads = parallelJobs.numberOfJobs();
+        if (numOfThreads > 1) {
+            const size_t jobSize = jobs.size() / numOfThreads;
+            const size_t jobsWithExtra = jobs.size() % numOfThreads;
+            size_t currentJob = 0;
+            for (int thread = numOfThreads - 1; thread >= 0; --thread) {
+                ShapingParameters& parameters = parallelJobs.parameter(thread);
+                parameters.jobs = jobs.data() + currentJob;
+                parameters.jobCount = static_cast<size_t>(thread) < jobsWithExtra ? jobSize + 1 : jobSize;
+                currentJob += parameters.jobCount;
+            }
+            parallelJobs.execute();
+            shapedInParallel = true;
+        }
+    }
+    if (!shapedInParallel) {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            shapeText(jobs[i]);
+    }
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+        jobs[i].cache->addShapedRun(jobs[i].sanitizedText, jobs[i].flags, WordShapingCache::ShapedRun::create(jobs[i].cursorPositions));
+}
+
 void Font::drawComplexText(GraphicsContext* ctx, const TextRun& run, const FloatPoint& point, int from, int to) const
 {
     String sanitized = Font::normalizeSpaces(run.characters16(), run.length());
@@ -305,26 +491,9 @@ FloatRect Font::selectionRectForComplexText(const TextRun& run, const FloatPoint
 
 void Font::initFormatForTextLayout(QTextLayout* layout, const TextRun& run) const
 {
-    QTextLayout::FormatRange range;
-    // WebCore expects word-spacing to be ignored on leading spaces contrary to what Qt does.
-    // To avoid word-spacing on any leading spaces, we exclude them from FormatRange which
-    // word-spacing along with other options would be applied to. This is safe since the other
-    // formatting options does not affect spaces.
-    unsigned length = run.length();
-    for (range.start = 0; range.start < length && treatAsSpace(run[range.start]); ++range.start) { }
-    range.length = length - range.start;
-
-    if (m_wordSpacing && !run.spacingDisabled())
-        range.format.setFontWordSpacing(m_wordSpacing);
-    if (m_letterSpacing && !run.spacingDisabled())
-        range.format.setFontLetterSpacing(m_letterSpacing);
-    if (typesettingFeatures() & Kerning)
-        range.format.setFontKerning(true);
-    if (isSmallCaps())
-        range.format.setFontCapitalization(QFont::SmallCaps);
-
-    if (range.format.propertyCount() && range.length)
-        layout->setAdditionalFormats(QList<QTextLayout::FormatRange>() << range);
+    QList<QTextLayout::FormatRange> formats = additionalFormats(*this, run);
+    if (!formats.isEmpty())
+        layout->setAdditionalFormats(formats);
 }
 
 bool Font::canReturnFallbackFontsForComplexText()
@@ -29,12 +29,47 @@
 #include "config.h"
 #include "ImageDecoderQt.h"
 
-#include <QtCore/QBuffer>
 #include <QtCore/QByteArray>
 #include <QtGui/QImageReader>
+#include <algorithm>
 
 namespace WebCore {
 
+// Lets QImageReader read the encoded image straight out of the segments of a SharedBuffer,
+// which a QBuffer could only do after the SharedBuffer was merged into one block.
+class SharedBufferIODevice : public QIODevice {
+public:
+    explicit SharedBufferIODevice(PassRefPtr<SharedBuffer> buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    virtual bool isSequential() const OVERRIDE { return false; }
+    virtual qint64 size() const OVERRIDE { return m_buffer->size(); }
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) OVERRIDE
+    {
+        qint64 position = pos();
+        qint64 bytesRead = 0;
+        const char* segment;
+        while (bytesRead < maxSize) {
+            unsigned length = m_buffer->getSomeData(segment, position + bytesRead);
+            if (!length)
+                break;
+            qint64 bytesToCopy = std::min<qint64>(length, maxSize - bytesRead);
+            memcpy(data + bytesRead, segment, bytesToCopy);
+            bytesRead += bytesToCopy;
+        }
+        return bytesRead;
+    }
+
+    virtual qint64 writeData(const char*, qint64) OVERRIDE { return -1; }
+
+private:
+    RefPtr<SharedBuffer> m_buffer;
+};
+
 ImageDecoderQt::ImageDecoderQt(ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : ImageDecoder(alphaOption, gammaAndColorProfileOption)
     , m_repetitionCount(cAnimationNone)
@@ -62,9 +97,7 @@ void ImageDecoderQt::setData(SharedBuffer* data, bool allDataReceived)
     ASSERT(!m_reader);
 
     // Attempt to load the data
-    QByteArray imageData = QByteArray::fromRawData(m_data->data(), m_data->size());
-    m_buffer = adoptPtr(new QBuffer);
-    m_buffer->setData(imageData);
+    m_buffer = adoptPtr(new SharedBufferIODevice(m_data));
     m_buffer->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
     m_reader = adoptPtr(new QImageReader(m_buffer.get(), m_format));
 
@@ -28,8 +28,8 @@
 #define ImageDecoderQt_h
 
 #include "ImageDecoder.h"
-#include <QtCore/QBuffer>
 #include <QtCore/QHash>
+#include <QtCore/QIODevice>
 #include <QtCore/QList>
 #include <QtGui/QImageReader>
 #include <QtGui/QPixmap>
@@ -68,7 +68,7 @@ private:
 
 private:
     QByteArray m_format;
-    OwnPtr<QBuffer> m_buffer;
+    OwnPtr<QIODevice> m_buffer;
     OwnPtr<QImageReader> m_reader;
     mutable int m_repetitionCount;
 };
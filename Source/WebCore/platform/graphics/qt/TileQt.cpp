@@ -22,11 +22,14 @@
 
 #if USE(TILED_BACKING_STORE)
 
+#include "DisplayList.h"
 #include "GraphicsContext.h"
 #include "TiledBackingStore.h"
 #include "TiledBackingStoreClient.h"
+#include <QImage>
 #include <QObject>
 #include <QPainter>
+#include <QPixmap>
 #include <QRegion>
 
 namespace WebCore {
@@ -54,6 +57,67 @@ static QPixmap& checkeredPixmap()
     return *pixmap;
 }
     
+TileQt::Buffer::Buffer(const IntSize& size, bool isImage)
+{
+    if (isImage)
+        m_image = adoptPtr(new QImage(size.width(), size.height(), QImage::Format_ARGB32_Premultiplied));
+    else
+        m_pixmap = adoptPtr(new QPixmap(size.width(), size.height()));
+}
+
+TileQt::Buffer::~Buffer()
+{
+}
+
+TileQt::Buffer* TileQt::Buffer::copyAsImage() const
+{
+    Buffer* copy = new Buffer;
+    // QImage shares its data until it is painted on, so the copy is only made on the thread that
+    // paints into it.
+    if (m_image)
+        copy->m_image = adoptPtr(new QImage(*m_image));
+    else
+        copy->m_image = adoptPtr(new QImage(m_pixmap->toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied)));
+    return copy;
+}
+
+void TileQt::Buffer::convert(bool toImage)
+{
+    if (toImage == isImage())
+        return;
+
+    if (toImage) {
+        m_image = adoptPtr(new QImage(m_pixmap->toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied)));
+        m_pixmap.clear();
+    } else {
+        m_pixmap = adoptPtr(new QPixmap(QPixmap::fromImage(*m_image)));
+        m_image.clear();
+    }
+}
+
+QPaintDevice* TileQt::Buffer::paintDevice() const
+{
+    if (m_image)
+        return m_image.get();
+    return m_pixmap.get();
+}
+
+void TileQt::Buffer::fill(const QColor& color)
+{
+    if (m_image)
+        m_image->fill(color);
+    else
+        m_pixmap->fill(color);
+}
+
+void TileQt::Buffer::draw(QPainter* painter, const QRect& target, const QRect& source) const
+{
+    if (m_image)
+        painter->drawImage(target, *m_image, source);
+    else
+        painter->drawPixmap(target, *m_pixmap, source);
+}
+
 TileQt::TileQt(TiledBackingStore* backingStore, const Coordinate& tileCoordinate)
     : m_backingStore(backingStore)
     , m_coordinate(tileCoordinate)
@@ -66,6 +130,10 @@ TileQt::TileQt(TiledBackingStore* backingStore, const Coordinate& tileCoordinate
 
 TileQt::~TileQt()
 {
+#if USE(DISPLAY_LIST_RECORDING)
+    ASSERT(m_recordedUpdates.isEmpty());
+    ASSERT(m_recordedRects.isEmpty());
+#endif
     delete m_buffer;
     delete m_backBuffer;
     delete m_dirtyRegion;
@@ -90,27 +158,37 @@ void TileQt::invalidate(const IntRect& dirtyRect)
     *m_dirtyRegion += tileDirtyRect;
 }
     
+void TileQt::prepareBackBuffer(bool isImage)
+{
+    if (m_backBuffer) {
+        m_backBuffer->convert(isImage);
+        return;
+    }
+
+    if (!m_buffer) {
+        m_backBuffer = new Buffer(m_backingStore->tileSize(), isImage);
+        m_backBuffer->fill(QColor(m_backingStore->client()->tiledBackingStoreBackgroundColor()));
+    } else {
+        // Currently all buffers are updated synchronously at the same time so there is no real need
+        // to have separate back and front buffers. Just use the existing buffer.
+        m_backBuffer = m_buffer;
+        m_buffer = 0;
+        // The worker thread setting can change while tiles exist.
+        m_backBuffer->convert(isImage);
+    }
+}
+
 Vector<IntRect> TileQt::updateBackBuffer()
 {
     if (m_buffer && !isDirty())
         return Vector<IntRect>();
 
-    if (!m_backBuffer) {
-        if (!m_buffer) {
-            m_backBuffer = new QPixmap(m_backingStore->tileSize().width(), m_backingStore->tileSize().height());
-            m_backBuffer->fill(m_backingStore->client()->tiledBackingStoreBackgroundColor());
-        } else {
-            // Currently all buffers are updated synchronously at the same time so there is no real need
-            // to have separate back and front buffers. Just use the existing buffer.
-            m_backBuffer = m_buffer;
-            m_buffer = 0;
-        }
-    }
+    prepareBackBuffer(m_backingStore->client()->tiledBackingStoreRasterizesOnWorkerThreads());
 
     QVector<QRect> dirtyRects = m_dirtyRegion->rects();
     *m_dirtyRegion = QRegion();
     
-    QPainter painter(m_backBuffer);
+    QPainter painter(m_backBuffer->paintDevice());
     GraphicsContext context(&painter);
     context.translate(-m_rect.x(), -m_rect.y());
 
@@ -129,6 +207,83 @@ Vector<IntRect> TileQt::updateBackBuffer()
     return updatedRects;
 }
 
+#if USE(DISPLAY_LIST_RECORDING)
+void TileQt::prepareBackBufferCopy()
+{
+    if (m_backBuffer || !m_buffer) {
+        prepareBackBuffer(true);
+        return;
+    }
+    // The front buffer stays in place, so that the tile can still be painted while a worker
+    // thread rasterizes the back buffer.
+    m_backBuffer = m_buffer->copyAsImage();
+}
+
+bool TileQt::recordBackBufferUpdate()
+{
+    ASSERT(m_recordedUpdates.isEmpty());
+    if (m_buffer && !isDirty())
+        return true;
+
+    QVector<QRect> dirtyRects = m_dirtyRegion->rects();
+    *m_dirtyRegion = QRegion();
+
+    bool canRasterizeOnWorkerThread = true;
+    int size = dirtyRects.size();
+    for (int n = 0; n < size; ++n) {
+        IntRect rect = dirtyRects[n];
+        RefPtr<DisplayList> displayList = DisplayList::create(rect);
+        GraphicsContext* context = displayList->beginRecording();
+        context->scale(FloatSize(m_backingStore->contentsScale(), m_backingStore->contentsScale()));
+        m_backingStore->client()->tiledBackingStorePaint(context, m_backingStore->mapToContents(rect));
+        displayList->endRecording();
+        canRasterizeOnWorkerThread &= displayList->canReplayOnWorkerThread();
+        m_recordedRects.append(rect);
+        m_recordedUpdates.append(displayList.release());
+    }
+
+    if (m_recordedUpdates.isEmpty())
+        return true;
+
+    // Allocate the back buffer here so that the worker threads only have to paint into it.
+    prepareBackBufferCopy();
+
+    // Recordings that draw pixmaps are replayed right away, on the main thread. The tile still
+    // goes through the worker pass, which finds nothing left to rasterize.
+    if (!canRasterizeOnWorkerThread) {
+        rasterizeBackBuffer();
+        m_recordedUpdates.clear();
+    }
+    return true;
+}
+
+void TileQt::rasterizeBackBuffer()
+{
+    if (m_recordedUpdates.isEmpty())
+        return;
+
+    QPainter painter(m_backBuffer->paintDevice());
+    GraphicsContext context(&painter);
+    context.translate(-m_rect.x(), -m_rect.y());
+
+    size_t size = m_recordedUpdates.size();
+    for (size_t n = 0; n < size; ++n) {
+        context.save();
+        context.clip(FloatRect(m_recordedUpdates[n]->bounds()));
+        m_recordedUpdates[n]->replay(context);
+        context.restore();
+    }
+}
+
+Vector<IntRect> TileQt::commitBackBufferUpdate()
+{
+    m_recordedUpdates.clear();
+    Vector<IntRect> updatedRects;
+    updatedRects.swap(m_recordedRects);
+    return updatedRects;
+}
+#endif
+
 void TileQt::swapBackBufferToFront()
 {
     if (!m_backBuffer)
@@ -149,13 +304,14 @@ void TileQt::paint(GraphicsContext* context, const IntRect& rect)
                    target.width(),
                    target.height());
     
-    context->platformContext()->drawPixmap(target, *m_buffer, source);
+    m_buffer->draw(context->platformContext(), target, source);
 }
     
 void TileQt::resize(const IntSize& newSize)
 {
     IntRect oldRect = m_rect;
-    m_rect = IntRect(m_rect.location(), newSize);
+    // Only the size changes, a worker thread rasterizing the tile may be reading the location.
+    m_rect.setSize(newSize);
     if (m_rect.maxX() > oldRect.maxX())
         invalidate(IntRect(oldRect.maxX(), oldRect.y(), m_rect.maxX() - oldRect.maxX(), m_rect.height()));
     if (m_rect.maxY() > oldRect.maxY())
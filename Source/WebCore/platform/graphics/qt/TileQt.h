@@ -25,16 +25,24 @@
 #include "IntPoint.h"
 #include "IntRect.h"
 #include "Tile.h"
+#include <wtf/OwnPtr.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
 
 QT_BEGIN_NAMESPACE
+class QColor;
+class QImage;
+class QPainter;
+class QPaintDevice;
 class QPixmap;
+class QRect;
 class QRegion;
 QT_END_NAMESPACE
 
 namespace WebCore {
 
+class DisplayList;
 class TiledBackingStore;
 
 class TileQt : public Tile {
@@ -48,6 +56,12 @@ public:
     void invalidate(const IntRect&);
     Vector<IntRect> updateBackBuffer();
     void swapBackBufferToFront();
+#if USE(DISPLAY_LIST_RECORDING)
+    bool recordBackBufferUpdate();
+    bool needsRasterization() const { return !m_recordedUpdates.isEmpty(); }
+    void rasterizeBackBuffer();
+    Vector<IntRect> commitBackBufferUpdate();
+#endif
     bool isReadyToPaint() const;
     void paint(GraphicsContext*, const IntRect&);
 
@@ -58,13 +72,48 @@ public:
 private:
     TileQt(TiledBackingStore*, const Coordinate&);
 
+    // QPixmap can only be painted on the GUI thread, so a tile's buffers are images while the
+    // backing store rasterizes on worker threads, and pixmaps otherwise.
+    class Buffer {
+    public:
+        Buffer(const IntSize&, bool isImage);
+        ~Buffer();
+
+        // An image buffer with the same content, which may be painted on another thread.
+        Buffer* copyAsImage() const;
+
+        bool isImage() const { return m_image; }
+        void convert(bool toImage);
+
+        QPaintDevice* paintDevice() const;
+        void fill(const QColor&);
+        void draw(QPainter*, const QRect& target, const QRect& source) const;
+
+    private:
+        Buffer() { }
+
+        OwnPtr<QImage> m_image;
+        OwnPtr<QPixmap> m_pixmap;
+    };
+
+    void prepareBackBuffer(bool isImage);
+#if USE(DISPLAY_LIST_RECORDING)
+    void prepareBackBufferCopy();
+#endif
+
     TiledBackingStore* m_backingStore;
     Coordinate m_coordinate;
     IntRect m_rect;
 
-    QPixmap* m_buffer;
-    QPixmap* m_backBuffer;
+    Buffer* m_buffer;
+    Buffer* m_backBuffer;
     QRegion* m_dirtyRegion;
+
+#if USE(DISPLAY_LIST_RECORDING)
+    // Recordings waiting to be rasterized on a worker thread.
+    Vector<RefPtr<DisplayList> > m_recordedUpdates;
+    Vector<IntRect> m_recordedRects;
+#endif
 };
 
 }
@@ -119,6 +119,7 @@ void GraphicsLayerTextureMapper::willBeDestroyed()
 */
 void GraphicsLayerTextureMapper::setNeedsDisplay()
 {
+    invalidateDisplayLists();
     if (!drawsContent())
         return;
 
@@ -139,6 +140,7 @@ void GraphicsLayerTextureMapper::setContentsNeedsDisplay()
 */
 void GraphicsLayerTextureMapper::setNeedsDisplayInRect(const FloatRect& rect)
 {
+    invalidateDisplayListsInRect(rect);
     if (!drawsContent())
         return;
 
@@ -534,6 +534,7 @@ void CoordinatedGraphicsLayer::setNeedsDisplay()
 
 void CoordinatedGraphicsLayer::setNeedsDisplayInRect(const FloatRect& rect)
 {
+    invalidateDisplayListsInRect(rect);
     if (m_mainBackingStore)
         m_mainBackingStore->invalidate(IntRect(rect));
 
@@ -1016,6 +1017,7 @@ void CoordinatedGraphicsLayer::updateContentBuffers()
     if (!shouldHaveBackingStore()) {
         m_mainBackingStore.clear();
         m_previousBackingStore.clear();
+        invalidateDisplayLists();
         return;
     }
 
@@ -1032,6 +1034,8 @@ void CoordinatedGraphicsLayer::updateContentBuffers()
     if (m_pendingVisibleRectAdjustment) {
         m_pendingVisibleRectAdjustment = false;
         m_mainBackingStore->coverWithTilesIfNeeded();
+        // Parts of the layer that lost their tiles are off screen, so their recordings would only take up memory.
+        invalidateDisplayListsOutsideRect(m_mainBackingStore->mapToContents(m_mainBackingStore->coverRect()));
     }
 
     m_mainBackingStore->updateTileBuffers();
@@ -1048,6 +1052,7 @@ void CoordinatedGraphicsLayer::purgeBackingStores()
     TemporaryChange<bool> updateModeProtector(m_isPurging, true);
     m_mainBackingStore.clear();
     m_previousBackingStore.clear();
+    invalidateDisplayLists();
 
     releaseImageBackingIfNeeded();
 
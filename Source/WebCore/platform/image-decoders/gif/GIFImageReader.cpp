@@ -311,10 +311,29 @@ bool GIFLZWContext::doLZW(const unsigned char* block, size_t bytesInBlock)
     return true;
 }
 
+const unsigned char* consecutiveData(const WebCore::SharedBuffer& data, size_t position, size_t length, Vector<unsigned char>& buffer)
+{
+    const char* segment;
+    unsigned segmentLength = data.getSomeData(segment, position);
+    if (segmentLength >= length)
+        return reinterpret_cast<const unsigned char*>(segment);
+
+    buffer.resize(length);
+    size_t bytesCopied = 0;
+    while (bytesCopied < length && segmentLength) {
+        size_t bytesToCopy = std::min<size_t>(segmentLength, length - bytesCopied);
+        memcpy(buffer.data() + bytesCopied, segment, bytesToCopy);
+        bytesCopied += bytesToCopy;
+        segmentLength = data.getSomeData(segment, position + bytesCopied);
+    }
+    ASSERT(bytesCopied == length);
+    return buffer.data();
+}
+
 // Perform decoding for this frame. frameDecoded will be true if the entire frame is decoded.
 // Returns false if a decoding error occurred. This is a fatal error and causes the GIFImageReader to set the "decode failed" flag.
 // Otherwise, either not enough data is available to decode further than before, or the new data has been decoded successfully; returns true in this case.
-bool GIFFrameContext::decode(const unsigned char* data, size_t length, WebCore::GIFImageDecoder* client, bool* frameDecoded)
+bool GIFFrameContext::decode(const WebCore::SharedBuffer& data, WebCore::GIFImageDecoder* client, bool* frameDecoded)
 {
     *frameDecoded = false;
     if (!m_lzwContext) {
@@ -332,12 +351,13 @@ bool GIFFrameContext::decode(const unsigned char* data, size_t length, WebCore::
     }
 
     // Some bad GIFs have extra blocks beyond the last row, which we don't want to decode.
+    Vector<unsigned char> blockBuffer;
     while (m_currentLzwBlock < m_lzwBlocks.size() && m_lzwContext->hasRemainingRows()) {
         size_t blockPosition = m_lzwBlocks[m_currentLzwBlock].blockPosition;
         size_t blockSize = m_lzwBlocks[m_currentLzwBlock].blockSize;
-        if (blockPosition + blockSize > length)
+        if (blockPosition + blockSize > data.size())
             return false;
-        if (!m_lzwContext->doLZW(data + blockPosition, blockSize))
+        if (!m_lzwContext->doLZW(consecutiveData(data, blockPosition, blockSize, blockBuffer), blockSize))
             return false;
         ++m_currentLzwBlock;
     }
@@ -368,7 +388,7 @@ bool GIFImageReader::decode(GIFImageDecoder::GIFQuery query, unsigned haltAtFram
         bool frameDecoded = false;
         GIFFrameContext* currentFrame = m_frames[m_currentDecodingFrame].get();
 
-        if (!currentFrame->decode(data(0), m_data->size(), m_client, &frameDecoded))
+        if (!currentFrame->decode(*m_data, m_client, &frameDecoded))
             return false;
 
         // We need more data to continue decoding.
@@ -404,7 +424,8 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
     // point to the next component. len will be decremented accordingly.
     while (len >= m_bytesToConsume) {
         const size_t currentComponentPosition = dataPosition;
-        const unsigned char* currentComponent = data(dataPosition);
+        // LZW blocks are only recorded here and read when the frame is decoded.
+        const unsigned char* currentComponent = m_state == GIFLZW ? 0 : data(dataPosition, m_bytesToConsume);
 
         // Mark the current component as consumed. Note that currentComponent will remain pointed at this
         // component until the next loop iteration.
@@ -456,7 +477,6 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
             if ((currentComponent[4] & 0x80) && m_globalColormapSize > 0) { /* global map */
                 // Get the global colormap
                 const size_t globalColormapBytes = 3 * m_globalColormapSize;
-                m_globalColormapPosition = dataPosition;
 
                 if (len < globalColormapBytes) {
                     // Wait until we have enough bytes to consume the entire colormap at once.
@@ -464,6 +484,9 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
                     break;
                 }
 
+                Vector<unsigned char> colormapBuffer;
+                m_globalColormap.clear();
+                m_globalColormap.append(consecutiveData(*m_data, dataPosition, globalColormapBytes, colormapBuffer), globalColormapBytes);
                 m_isGlobalColormapDefined = true;
                 dataPosition += globalColormapBytes;
                 len -= globalColormapBytes;
@@ -478,6 +501,8 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
         }
 
         case GIFGlobalColormap: {
+            m_globalColormap.clear();
+            m_globalColormap.append(currentComponent, m_bytesToConsume);
             m_isGlobalColormapDefined = true;
             GETN(1, GIFImageStart);
             break;
@@ -714,7 +739,6 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
                 const size_t localColormapBytes = 3 * numColors;
 
                 // Switch to the new local palette after it loads
-                currentFrame->localColormapPosition = dataPosition;
                 currentFrame->localColormapSize = numColors;
 
                 if (len < localColormapBytes) {
@@ -723,6 +747,9 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
                     break;
                 }
 
+                Vector<unsigned char> colormapBuffer;
+                currentFrame->localColormap.clear();
+                currentFrame->localColormap.append(consecutiveData(*m_data, dataPosition, localColormapBytes, colormapBuffer), localColormapBytes);
                 currentFrame->isLocalColormapDefined = true;
                 dataPosition += localColormapBytes;
                 len -= localColormapBytes;
@@ -736,6 +763,8 @@ bool GIFImageReader::parse(size_t dataPosition, size_t len, bool parseSizeOnly)
 
         case GIFImageColormap: {
             ASSERT(!m_frames.isEmpty());
+            m_frames.last()->localColormap.clear();
+            m_frames.last()->localColormap.append(currentComponent, m_bytesToConsume);
             m_frames.last()->isLocalColormapDefined = true;
             GETN(1, GIFLZWStart);
             break;
@@ -79,6 +79,10 @@ enum GIFState {
 
 struct GIFFrameContext;
 
+// Returns length consecutive bytes of data starting at position. They are read in place when they lie in
+// one segment of the buffer and copied into buffer otherwise, so that the data never has to be merged.
+const unsigned char* consecutiveData(const WebCore::SharedBuffer& data, size_t position, size_t length, Vector<unsigned char>& buffer);
+
 // LZW decoder state machine.
 class GIFLZWContext {
     WTF_MAKE_FAST_ALLOCATED;
@@ -158,7 +162,7 @@ public:
     unsigned height;
     int tpixel; // Index of transparent pixel.
     WebCore::ImageFrame::FrameDisposalMethod disposalMethod; // Restore to background, leave in place, etc.
-    size_t localColormapPosition; // Per-image colormap.
+    Vector<unsigned char> localColormap; // Per-image colormap.
     int localColormapSize; // Size of local colormap array.
     int datasize;
     
@@ -177,7 +181,6 @@ public:
         , height(0)
         , tpixel(0)
         , disposalMethod(WebCore::ImageFrame::DisposeNotSpecified)
-        , localColormapPosition(0)
         , localColormapSize(0)
         , datasize(0)
         , isLocalColormapDefined(false)
@@ -201,7 +204,7 @@ public:
         m_lzwBlocks.append(GIFLZWBlock(position, size));
     }
 
-    bool decode(const unsigned char* data, size_t length, WebCore::GIFImageDecoder* client, bool* frameDecoded);
+    bool decode(const WebCore::SharedBuffer& data, WebCore::GIFImageDecoder* client, bool* frameDecoded);
 
     bool isComplete() const { return m_isComplete; }
     void setComplete() { m_isComplete = true; }
@@ -236,7 +239,6 @@ public:
         , m_screenWidth(0)
         , m_screenHeight(0)
         , m_isGlobalColormapDefined(false)
-        , m_globalColormapPosition(0)
         , m_globalColormapSize(0)
         , m_loopCount(cLoopCountNotSeen)
         , m_currentDecodingFrame(0)
@@ -266,7 +268,7 @@ public:
 
     const unsigned char* globalColormap() const
     {
-        return m_isGlobalColormapDefined ? data(m_globalColormapPosition) : 0;
+        return m_isGlobalColormapDefined ? m_globalColormap.data() : 0;
     }
     int globalColormapSize() const
     {
@@ -275,7 +277,7 @@ public:
 
     const unsigned char* localColormap(const GIFFrameContext* frame) const
     {
-        return frame->isLocalColormapDefined ? data(frame->localColormapPosition) : 0;
+        return frame->isLocalColormapDefined ? frame->localColormap.data() : 0;
     }
     int localColormapSize(const GIFFrameContext* frame) const
     {
@@ -293,9 +295,9 @@ private:
     bool parse(size_t dataPosition, size_t len, bool parseSizeOnly);
     void setRemainingBytes(size_t);
 
-    const unsigned char* data(size_t dataPosition) const
+    const unsigned char* data(size_t dataPosition, size_t length)
     {
-        return reinterpret_cast<const unsigned char*>(m_data->data()) + dataPosition;
+        return consecutiveData(*m_data, dataPosition, length, m_componentBuffer);
     }
 
     void addFrameIfNecessary();
@@ -317,7 +319,7 @@ private:
     unsigned m_screenWidth; // Logical screen width & height.
     unsigned m_screenHeight;
     bool m_isGlobalColormapDefined;
-    size_t m_globalColormapPosition; // (3* MAX_COLORS in size) Default colormap if local not supplied, 3 bytes for each color.
+    Vector<unsigned char> m_globalColormap; // (3* MAX_COLORS in size) Default colormap if local not supplied, 3 bytes for each color.
     int m_globalColormapSize; // Size of global colormap array.
     int m_loopCount; // Netscape specific extension block to control the number of animation loops a GIF renders.
     
@@ -325,6 +327,7 @@ private:
     size_t m_currentDecodingFrame;
 
     RefPtr<WebCore::SharedBuffer> m_data;
+    Vector<unsigned char> m_componentBuffer; // Holds a component that spans several segments of m_data.
     bool m_parseCompleted;
 };
 
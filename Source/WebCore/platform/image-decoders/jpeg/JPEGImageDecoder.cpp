@@ -236,8 +236,11 @@ class JPEGImageReader {
 public:
     JPEGImageReader(JPEGImageDecoder* decoder)
         : m_decoder(decoder)
-        , m_bufferLength(0)
-        , m_bytesToSkip(0)
+        , m_data(0)
+        , m_nextReadPosition(0)
+        , m_restartPosition(0)
+        , m_lastSetByte(0)
+        , m_needsRestart(false)
         , m_state(JPEG_HEADER)
         , m_samples(0)
 #if USE(QCMSLIB)
@@ -303,29 +306,65 @@ public:
 
     void skipBytes(long numBytes)
     {
-        decoder_source_mgr* src = (decoder_source_mgr*)m_info.src;
-        long bytesToSkip = std::min(numBytes, (long)src->pub.bytes_in_buffer);
-        src->pub.bytes_in_buffer -= (size_t)bytesToSkip;
-        src->pub.next_input_byte += bytesToSkip;
+        if (numBytes <= 0)
+            return;
+
+        size_t bytesToSkip = static_cast<size_t>(numBytes);
+        if (bytesToSkip < m_info.src->bytes_in_buffer) {
+            m_info.src->bytes_in_buffer -= bytesToSkip;
+            m_info.src->next_input_byte += bytesToSkip;
+        } else {
+            // The skipped bytes run past this segment, possibly past the data received so far.
+            m_nextReadPosition += bytesToSkip - m_info.src->bytes_in_buffer;
+            m_info.src->bytes_in_buffer = 0;
+            m_info.src->next_input_byte = 0;
+        }
 
-        m_bytesToSkip = std::max(numBytes - bytesToSkip, static_cast<long>(0));
+        // libjpeg only skips whole markers, so this is a position it can resume from.
+        m_restartPosition = m_nextReadPosition - m_info.src->bytes_in_buffer;
+        m_lastSetByte = m_info.src->next_input_byte;
     }
 
-    bool decode(const SharedBuffer& data, bool onlySize)
+    // libjpeg reads one segment of the data at a time. When it runs out of data in the middle of a marker or
+    // an MCU it suspends, and expects to be handed the same bytes again, from the last position it reached
+    // between markers or MCUs, once more data has arrived. That position is the restart position: libjpeg
+    // moves next_input_byte only when it gets there, so a next_input_byte that differs from what was set
+    // last means it did.
+    bool fillBuffer()
     {
-        m_decodingSizeOnly = onlySize;
-
-        unsigned newByteCount = data.size() - m_bufferLength;
-        unsigned readOffset = m_bufferLength - m_info.src->bytes_in_buffer;
+        if (m_needsRestart) {
+            m_needsRestart = false;
+            m_nextReadPosition = m_restartPosition;
+        } else
+            updateRestartPosition();
+
+        const char* segment;
+        unsigned length = m_data->getSomeData(segment, m_nextReadPosition);
+        if (!length) {
+            m_needsRestart = true;
+            clearBuffer();
+            return false;
+        }
 
-        m_info.src->bytes_in_buffer += newByteCount;
-        m_info.src->next_input_byte = (JOCTET*)(data.data()) + readOffset;
+        m_nextReadPosition += length;
+        m_info.src->bytes_in_buffer = length;
+        m_info.src->next_input_byte = reinterpret_cast<const JOCTET*>(segment);
+        m_lastSetByte = m_info.src->next_input_byte;
+        return true;
+    }
 
-        // If we still have bytes to skip, try to skip those now.
-        if (m_bytesToSkip)
-            skipBytes(m_bytesToSkip);
+    bool decode(const SharedBuffer& data, bool onlySize)
+    {
+        m_decodingSizeOnly = onlySize;
 
-        m_bufferLength = data.size();
+        // Segments may have moved since the last call, when more data was appended, so the buffer is read
+        // again from the same position instead of being kept.
+        m_data = &data;
+        if (!m_needsRestart) {
+            updateRestartPosition();
+            m_nextReadPosition -= m_info.src->bytes_in_buffer;
+            clearBuffer();
+        }
 
         // We need to do the setjmp here. Otherwise bad things will happen
         if (setjmp(m_err.setjmp_buffer))
@@ -407,9 +446,7 @@ public:
             m_samples = (*m_info.mem->alloc_sarray)((j_common_ptr) &m_info, JPOOL_IMAGE, m_info.output_width * 4, 1);
 
             if (m_decodingSizeOnly) {
-                // We can stop here. Reduce our buffer length and available data.
-                m_bufferLength -= m_info.src->bytes_in_buffer;
-                m_info.src->bytes_in_buffer = 0;
+                // We can stop here. The next call reads on from where the header ended.
                 return true;
             }
         // FALL THROUGH
@@ -534,9 +571,26 @@ public:
 #endif
 
 private:
+    void updateRestartPosition()
+    {
+        if (m_lastSetByte != m_info.src->next_input_byte)
+            m_restartPosition = m_nextReadPosition - m_info.src->bytes_in_buffer;
+    }
+
+    void clearBuffer()
+    {
+        // Makes libjpeg call fill_input_buffer() for more data.
+        m_info.src->bytes_in_buffer = 0;
+        m_info.src->next_input_byte = 0;
+        m_lastSetByte = 0;
+    }
+
     JPEGImageDecoder* m_decoder;
-    unsigned m_bufferLength;
-    int m_bytesToSkip;
+    const SharedBuffer* m_data;
+    unsigned m_nextReadPosition; // Position in m_data right after the segment libjpeg is reading.
+    unsigned m_restartPosition;
+    const JOCTET* m_lastSetByte;
+    bool m_needsRestart;
     bool m_decodingSizeOnly;
 
     jpeg_decompress_struct m_info;
@@ -568,12 +622,11 @@ void skip_input_data(j_decompress_ptr jd, long num_bytes)
     src->decoder->skipBytes(num_bytes);
 }
 
-boolean fill_input_buffer(j_decompress_ptr)
+boolean fill_input_buffer(j_decompress_ptr jd)
 {
-    // Our decode step always sets things up properly, so if this method is ever
-    // called, then we have hit the end of the buffer.  A return value of false
-    // indicates that we have no data to supply yet.
-    return false;
+    // A return value of false indicates that we have no data to supply yet.
+    decoder_source_mgr *src = (decoder_source_mgr *)jd->src;
+    return src->decoder->fillBuffer();
 }
 
 void term_source(j_decompress_ptr jd)
@@ -34,6 +34,8 @@
 #import <WebCore/LayerPool.h>
 #import <WebCore/ScrollingThread.h>
 #import <WebCore/StorageThread.h>
+#import <WebCore/StyleElement.h>
+#import <WebCore/WordShapingCache.h>
 #import <WebCore/WorkerThread.h>
 #import <wtf/CurrentTime.h>
 #import <wtf/FastMalloc.h>
@@ -159,6 +161,10 @@ void MemoryPressureHandler::releaseMemory(bool)
 
     fontCache()->purgeInactiveFontData();
 
+    WordShapingCache::clearAll();
+
+    StyleElement::clearInlineStyleSheetContentsCache();
+
     memoryCache()->pruneToPercentage(0);
 
     LayerPool::sharedPool()->drain();
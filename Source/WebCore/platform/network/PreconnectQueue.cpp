@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PreconnectQueue.h"
+
+#include "DNS.h"
+#include "NetworkingContext.h"
+#include "ResourceHandle.h"
+#include <wtf/CurrentTime.h>
+
+namespace WebCore {
+
+// At most this many speculative connections are opened in any window of this many seconds, so that
+// a page with links to many sites does not open sockets to all of them.
+static const unsigned maxConnectionsPerWindow = 6;
+static const double connectionWindowInSeconds = 10;
+
+// Servers typically keep an idle connection open for a while, so an origin is not connected to
+// again this soon.
+static const double reconnectDelayInSeconds = 30;
+
+// Guessed origins found after the queue is full are dropped. They come from further down the page
+// than the ones already queued. A hinted origin takes the place of the last guessed one instead.
+static const size_t maxPendingConnections = 16;
+
+static String originKey(const KURL& url)
+{
+    unsigned short port = url.hasPort() ? url.port() : url.protocolIs("https") ? 443 : 80;
+    return url.protocol().lower() + "://" + url.host().lower() + ':' + String::number(port);
+}
+
+PreconnectQueue::PreconnectQueue()
+{
+}
+
+PreconnectQueue::~PreconnectQueue()
+{
+}
+
+bool PreconnectQueue::openConnection(const KURL& url, NetworkingContext* context)
+{
+    return context && context->isValid() && ResourceHandle::preconnect(context, url);
+}
+
+void PreconnectQueue::prefetchHostName(const String& host)
+{
+    prefetchDNS(host);
+}
+
+double PreconnectQueue::monotonicTime() const
+{
+    return monotonicallyIncreasingTime();
+}
+
+void PreconnectQueue::add(const KURL& url, NetworkingContext* context, ConnectionKind kind)
+{
+    if (!url.protocolIsInHTTPFamily() || url.host().isEmpty())
+        return;
+
+    String origin = originKey(url);
+    HashMap<String, ConnectionKind>::iterator pendingOrigin = m_pendingOrigins.find(origin);
+    if (pendingOrigin != m_pendingOrigins.end()) {
+        if (kind == SpeculativeConnection || pendingOrigin->value == HintedConnection)
+            return;
+        // The page now asks for an origin that was only guessed at, so move it up.
+        removePendingConnection(m_pendingSpeculativeConnections, origin);
+        m_pendingOrigins.remove(pendingOrigin);
+    }
+
+    double now = monotonicTime();
+    forgetExpiredConnections(now);
+    if (m_lastConnectionTimes.contains(origin))
+        return;
+
+    // Connect right away when nothing as important is waiting, which matters when the mouse is over a link.
+    bool isFirstInLine = m_pendingHintedConnections.isEmpty() && (kind == HintedConnection || m_pendingSpeculativeConnections.isEmpty());
+    if (isFirstInLine && hasConnectionBudget(now)) {
+        connect(url, context, now);
+        return;
+    }
+
+    if (pendingConnectionCount() >= maxPendingConnections) {
+        if (kind == SpeculativeConnection || m_pendingSpeculativeConnections.isEmpty())
+            return;
+        // Make room by dropping the guess that was found last.
+        m_pendingOrigins.remove(originKey(m_pendingSpeculativeConnections.last().url));
+        m_pendingSpeculativeConnections.removeLast();
+    }
+
+    PendingConnection pending;
+    pending.url = url;
+    pending.context = context;
+    if (kind == HintedConnection)
+        m_pendingHintedConnections.append(pending);
+    else
+        m_pendingSpeculativeConnections.append(pending);
+    m_pendingOrigins.add(origin, kind);
+    if (!isActive())
+        startTimer(now);
+}
+
+void PreconnectQueue::removePendingConnection(PendingConnectionQueue& queue, const String& origin)
+{
+    for (PendingConnectionQueue::iterator it = queue.begin(); it != queue.end(); ++it) {
+        if (originKey(it->url) == origin) {
+            queue.remove(it);
+            return;
+        }
+    }
+}
+
+void PreconnectQueue::startTimer(double now)
+{
+    startOneShot(hasConnectionBudget(now) ? 0 : m_recentConnectionTimes.first() + connectionWindowInSeconds - now);
+}
+
+bool PreconnectQueue::hasConnectionBudget(double now)
+{
+    while (!m_recentConnectionTimes.isEmpty() && now - m_recentConnectionTimes.first() >= connectionWindowInSeconds)
+        m_recentConnectionTimes.removeFirst();
+    return m_recentConnectionTimes.size() < maxConnectionsPerWindow;
+}
+
+void PreconnectQueue::connect(const KURL& url, NetworkingContext* context, double now)
+{
+    String origin = originKey(url);
+    m_lastConnectionTimes.set(origin, now);
+
+    if (!openConnection(url, context)) {
+        // The host name lookup is cheap enough not to count against the budget.
+        prefetchHostName(url.host());
+        return;
+    }
+    m_recentConnectionTimes.append(now);
+}
+
+void PreconnectQueue::fired()
+{
+    double now = monotonicTime();
+    while (pendingConnectionCount() && hasConnectionBudget(now)) {
+        PendingConnectionQueue& queue = m_pendingHintedConnections.isEmpty() ? m_pendingSpeculativeConnections : m_pendingHintedConnections;
+        PendingConnection pending = queue.takeFirst();
+        m_pendingOrigins.remove(originKey(pending.url));
+        connect(pending.url, pending.context.get(), now);
+    }
+
+    if (pendingConnectionCount())
+        startTimer(now);
+
+    forgetExpiredConnections(now);
+}
+
+// Forgets origins that are allowed to be connected to again. Connections opened straight from add()
+// never go through the timer, so both prune.
+void PreconnectQueue::forgetExpiredConnections(double now)
+{
+    Vector<String> expiredOrigins;
+    for (HashMap<String, double>::iterator it = m_lastConnectionTimes.begin(); it != m_lastConnectionTimes.end(); ++it) {
+        if (now - it->value >= reconnectDelayInSeconds)
+            expiredOrigins.append(it->key);
+    }
+    for (size_t i = 0; i < expiredOrigins.size(); ++i)
+        m_lastConnectionTimes.remove(expiredOrigins[i]);
+}
+
+} // namespace WebCore
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PreconnectQueue_h
+#define PreconnectQueue_h
+
+#include "KURL.h"
+#include "Timer.h"
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/RefPtr.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+class NetworkingContext;
+
+// Opens connections to origins the page is likely to load from soon: <link rel=preconnect>, hosts
+// of preloads the load scheduler is holding back, and hovered links. Connections go through the
+// networking stack of the page, so its next request to the origin finds an idle connection with
+// DNS, TCP and TLS done.
+// Only a few speculative connections are opened per time window, and none to an origin that was
+// connected to recently. Connections the page asked for go ahead of the ones WebKit guesses at.
+// Where the platform cannot open a connection ahead of a request, the host name is prefetched
+// instead.
+class PreconnectQueue : public TimerBase {
+public:
+    enum ConnectionKind {
+        // Asked for by the page with <link rel=preconnect>.
+        HintedConnection,
+        // Guessed from scanned subresources and hovered links.
+        SpeculativeConnection
+    };
+
+    static PreconnectQueue& shared()
+    {
+        DEFINE_STATIC_LOCAL(PreconnectQueue, queue, ());
+        return queue;
+    }
+
+    void add(const KURL&, NetworkingContext*, ConnectionKind);
+
+protected:
+    PreconnectQueue();
+    virtual ~PreconnectQueue();
+
+    // Tests override these to see what the queue does and to control time.
+    virtual bool openConnection(const KURL&, NetworkingContext*);
+    virtual void prefetchHostName(const String& host);
+    virtual double monotonicTime() const;
+
+    virtual void fired() OVERRIDE;
+
+private:
+    bool hasConnectionBudget(double now);
+    void forgetExpiredConnections(double now);
+    void connect(const KURL&, NetworkingContext*, double now);
+    void startTimer(double now);
+
+    struct PendingConnection {
+        KURL url;
+        RefPtr<NetworkingContext> context;
+    };
+    typedef Deque<PendingConnection> PendingConnectionQueue;
+
+    static void removePendingConnection(PendingConnectionQueue&, const String& origin);
+    size_t pendingConnectionCount() const { return m_pendingHintedConnections.size() + m_pendingSpeculativeConnections.size(); }
+
+    PendingConnectionQueue m_pendingHintedConnections;
+    PendingConnectionQueue m_pendingSpeculativeConnections;
+    HashMap<String, ConnectionKind> m_pendingOrigins;
+    HashMap<String, double> m_lastConnectionTimes;
+    Deque<double> m_recentConnectionTimes;
+};
+
+} // namespace WebCore
+
+#endif // PreconnectQueue_h
@@ -244,4 +244,12 @@ void ResourceHandle::didChangePriority(ResourceLoadPriority)
     // Optionally implemented by platform.
 }
 
+#if !PLATFORM(QT)
+bool ResourceHandle::preconnect(NetworkingContext*, const KURL&)
+{
+    // Optionally implemented by platform.
+    return false;
+}
+#endif
+
 } // namespace WebCore
@@ -102,6 +102,9 @@ class ResourceHandle : public RefCounted<ResourceHandle>
 public:
     static PassRefPtr<ResourceHandle> create(NetworkingContext*, const ResourceRequest&, ResourceHandleClient*, bool defersLoading, bool shouldContentSniff);
     static void loadResourceSynchronously(NetworkingContext*, const ResourceRequest&, StoredCredentials, ResourceError&, ResourceResponse&, Vector<char>& data);
+    // Opens a connection to the origin of the URL ahead of a request. Returns false if the platform
+    // cannot do that, in which case callers may want to prefetch the host name instead.
+    static bool preconnect(NetworkingContext*, const KURL&);
 
     virtual ~ResourceHandle();
 
@@ -56,6 +56,7 @@ public:
         timing->receiveHeadersEnd = receiveHeadersEnd;
         timing->sslStart = sslStart;
         timing->sslEnd = sslEnd;
+        timing->queueingDelay = queueingDelay;
         return timing.release();
     }
 
@@ -72,7 +73,8 @@ public:
             && sendEnd == other.sendEnd
             && receiveHeadersEnd == other.receiveHeadersEnd
             && sslStart == other.sslStart
-            && sslEnd == other.sslEnd;
+            && sslEnd == other.sslEnd
+            && queueingDelay == other.queueingDelay;
     }
 
     bool operator!=(const ResourceLoadTiming& other) const
@@ -99,6 +101,7 @@ public:
     int receiveHeadersEnd;
     int sslStart;
     int sslEnd;
+    int queueingDelay; // Milliseconds the load waited in the ResourceLoadScheduler before it was handed to the port.
 
 private:
     ResourceLoadTiming()
@@ -114,6 +117,7 @@ private:
         , receiveHeadersEnd(0)
         , sslStart(-1)
         , sslEnd(-1)
+        , queueingDelay(0)
     {
     }
 };
@@ -28,6 +28,7 @@
 #include "ResourceHandle.h"
 #include "ResourceHandleClient.h"
 #include "ResourceHandleInternal.h"
+#include "ResourceLoadTiming.h"
 #include "ResourceRequest.h"
 #include "ResourceResponse.h"
 #include <QDateTime>
@@ -37,6 +38,7 @@
 #include <QNetworkCookie>
 #include <QNetworkReply>
 
+#include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
 #include <QCoreApplication>
@@ -451,6 +453,7 @@ QNetworkReplyHandler::QNetworkReplyHandler(ResourceHandle* handle, LoadType load
     : QObject(0)
     , m_resourceHandle(handle)
     , m_loadType(loadType)
+    , m_requestTime(0)
     , m_redirectionTries(gMaxRedirections)
     , m_queue(this, deferred)
 {
@@ -621,6 +624,12 @@ void QNetworkReplyHandler::sendResponseIfNeeded()
             }
         }
 
+        // QNetworkReply does not tell how long the connection and the request took, only when the headers arrived.
+        RefPtr<ResourceLoadTiming> timing = ResourceLoadTiming::create();
+        timing->requestTime = m_requestTime;
+        timing->receiveHeadersEnd = static_cast<int>((monotonicallyIncreasingTime() - m_requestTime) * 1000);
+        response.setResourceLoadTiming(timing.release());
+
         response.setHTTPStatusCode(statusCode);
         response.setHTTPStatusText(m_replyWrapper->reply()->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray().constData());
 
@@ -806,6 +815,7 @@ void QNetworkReplyHandler::start()
     if (!d || !d->m_context)
         return;
 
+    m_requestTime = monotonicallyIncreasingTime();
     QNetworkReply* reply = sendNetworkRequest(d->m_context->networkAccessManager(), d->m_firstRequest);
     if (!reply)
         return;
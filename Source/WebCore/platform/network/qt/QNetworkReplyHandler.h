@@ -159,6 +159,7 @@ private:
     QNetworkAccessManager::Operation m_method;
     QNetworkRequest m_request;
     QBasicTimer m_timeoutTimer;
+    double m_requestTime;
 
     // defer state holding
     int m_redirectionTries;
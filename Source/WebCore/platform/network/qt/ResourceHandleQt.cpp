@@ -143,6 +143,38 @@ void ResourceHandle::platformLoadResourceSynchronously(NetworkingContext* contex
     d->m_job->setLoadingDeferred(false);
 }
 
+bool ResourceHandle::preconnect(NetworkingContext* context, const KURL& url)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
+    if (!context || !context->isValid())
+        return false;
+
+    QNetworkAccessManager* manager = context->networkAccessManager();
+    if (!manager)
+        return false;
+
+    // The connection is opened through the same manager as the page's requests, so it ends up in the
+    // pool the next request to this origin is served from.
+    if (url.protocolIs("https")) {
+#ifndef QT_NO_SSL
+        manager->connectToHostEncrypted(url.host(), url.hasPort() ? url.port() : 443);
+        return true;
+#else
+        return false;
+#endif
+    }
+    if (url.protocolIs("http")) {
+        manager->connectToHost(url.host(), url.hasPort() ? url.port() : 80);
+        return true;
+    }
+    return false;
+#else
+    UNUSED_PARAM(context);
+    UNUSED_PARAM(url);
+    return false;
+#endif
+}
+
 void ResourceHandle::platformSetDefersLoading(bool defers)
 {
     if (!d->m_job)
@@ -144,6 +144,23 @@ QNetworkRequest ResourceRequest::toNetworkRequest(NetworkingContext *context) co
     if (!allowCookies())
         request.setAttribute(QNetworkRequest::AuthenticationReuseAttribute, QNetworkRequest::Manual);
 
+    switch (priority()) {
+    case ResourceLoadPriorityVeryHigh:
+    case ResourceLoadPriorityHigh:
+        request.setPriority(QNetworkRequest::HighPriority);
+        break;
+    case ResourceLoadPriorityLow:
+    case ResourceLoadPriorityVeryLow:
+        request.setPriority(QNetworkRequest::LowPriority);
+        // The per host limit above counts on pipelined requests. Only pipeline the loads nothing
+        // waits for, so that style sheets and scripts never queue behind a large image.
+        if ((httpMethod() == "GET" || httpMethod() == "HEAD") && !httpBody())
+            request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+        break;
+    default:
+        break;
+    }
+
     return request;
 }
 
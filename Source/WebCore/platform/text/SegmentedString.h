@@ -58,7 +58,7 @@ public:
 
     void clear() { m_length = 0; m_data.string16Ptr = 0; m_is8Bit = false;}
     
-    bool is8Bit() { return m_is8Bit; }
+    bool is8Bit() const { return m_is8Bit; }
     
     bool excludeLineNumbers() const { return !m_doNotExcludeLineNumbers; }
     bool doNotExcludeLineNumbers() const { return m_doNotExcludeLineNumbers; }
@@ -271,6 +271,51 @@ public:
         advance();
     }
 
+    // Characters pushed back with push() are read before the current substring.
+    bool hasPushedCharacters() const { return m_pushedChar1; }
+
+    // The characters that follow currentChar() in the current substring. These let the
+    // tokenizer scan a long run of ordinary characters without advancing one at a time.
+    // Only meaningful when nothing has been pushed back.
+    unsigned lengthOfCharactersAfterCurrent() const
+    {
+        ASSERT(!m_pushedChar1);
+        return m_currentString.m_length > 1 ? m_currentString.m_length - 1 : 0;
+    }
+
+    bool currentSubstringIs8Bit() const { return m_currentString.is8Bit(); }
+
+    const LChar* charactersAfterCurrent8() const
+    {
+        ASSERT(m_currentString.is8Bit());
+        return m_currentString.m_data.string8Ptr + 1;
+    }
+
+    const UChar* charactersAfterCurrent16() const
+    {
+        ASSERT(!m_currentString.is8Bit());
+        return m_currentString.m_data.string16Ptr + 1;
+    }
+
+    // Advances past |count| characters of the current substring, none of which may be a
+    // newline. At least one character of the substring must be left afterwards.
+    void advancePastNonNewlines(unsigned count)
+    {
+        ASSERT(!m_pushedChar1);
+        ASSERT(count < static_cast<unsigned>(m_currentString.m_length));
+        if (!count)
+            return;
+        m_currentString.m_length -= count;
+        if (m_currentString.is8Bit())
+            m_currentString.m_data.string8Ptr += count;
+        else
+            m_currentString.m_data.string16Ptr += count;
+        m_currentChar = m_currentString.getCurrentChar();
+        ASSERT(m_currentChar != '\n');
+        if (m_currentString.m_length == 1)
+            updateSlowCaseFunctionPointers();
+    }
+
     void advancePastNewlineAndUpdateLineNumber()
     {
         ASSERT(currentChar() == '\n');
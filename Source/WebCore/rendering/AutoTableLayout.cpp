@@ -59,10 +59,10 @@ void AutoTableLayout::recalcColumn(unsigned effCol)
             RenderTableSection* section = toRenderTableSection(child);
             unsigned numRows = section->numRows();
             for (unsigned i = 0; i < numRows; i++) {
-                RenderTableSection::CellStruct current = section->cellAt(i, effCol);
+                const RenderTableSection::CellStruct& current = section->cellAt(i, effCol);
                 RenderTableCell* cell = current.primaryCell();
                 
-                if (current.inColSpan || !cell)
+                if (current.inColSpan() || !cell)
                     continue;
 
                 bool cellHasContent = cell->children()->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding();
@@ -1000,6 +1000,8 @@ void RenderBlock::deleteLineBoxTree()
         }
     }
     m_lineBoxes.deleteLineBoxTree(renderArena());
+    if (m_rareData)
+        m_rareData->m_simpleLineLayout.clear();
 
     if (AXObjectCache* cache = document()->existingAXObjectCache())
         cache->recomputeIsIgnored(this);
@@ -1351,7 +1353,7 @@ bool RenderBlock::isSelfCollapsingBlock() const
         // If the block has inline children, see if we generated any line boxes.  If we have any
         // line boxes, then we can't be self-collapsing, since we have content.
         if (childrenInline())
-            return !firstLineBox();
+            return !firstLineBox() && !simpleLineLayout();
         
         // Whether or not we collapse is dependent on whether all our normal flow children
         // are also self-collapsing.
@@ -3173,9 +3175,12 @@ void RenderBlock::paintContents(PaintInfo& paintInfo, const LayoutPoint& paintOf
     if (document()->didLayoutWithPendingStylesheets() && !isRenderView())
         return;
 
-    if (childrenInline())
-        m_lineBoxes.paint(this, paintInfo, paintOffset);
-    else {
+    if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            SimpleLineLayout::paintFlow(this, *simpleLineLayout, paintInfo, paintOffset);
+        else
+            m_lineBoxes.paint(this, paintInfo, paintOffset);
+    } else {
         PaintPhase newPhase = (paintInfo.phase == PaintPhaseChildOutlines) ? PaintPhaseOutline : paintInfo.phase;
         newPhase = (newPhase == PaintPhaseChildBlockBackgrounds) ? PaintPhaseChildBlockBackground : newPhase;
 
@@ -5249,6 +5254,8 @@ void RenderBlock::adjustForColumnRect(LayoutSize& offset, const LayoutPoint& loc
 bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, HitTestAction hitTestAction)
 {
     if (childrenInline() && !isTable()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            return hitTestAction == HitTestForeground && SimpleLineLayout::hitTestFlow(this, *simpleLineLayout, request, result, locationInContainer, accumulatedOffset);
         // We have to hit-test our line boxes.
         if (m_lineBoxes.hitTest(this, request, result, locationInContainer, accumulatedOffset, hitTestAction))
             return true;
@@ -5329,6 +5336,8 @@ VisiblePosition RenderBlock::positionForPointWithInlineChildren(const LayoutPoin
 {
     ASSERT(childrenInline());
 
+    ensureLineBoxes();
+
     if (!firstRootBox())
         return createVisiblePosition(0, DOWNSTREAM);
 
@@ -5919,7 +5928,11 @@ void RenderBlock::adjustForColumns(LayoutSize& offset, const LayoutPoint& point)
 
 void RenderBlock::computeIntrinsicLogicalWidths(LayoutUnit& minLogicalWidth, LayoutUnit& maxLogicalWidth) const
 {
-    if (childrenInline()) {
+    if (hasLayoutContainment()) {
+        // The contents of a strictly contained block never contribute to its size.
+        minLogicalWidth = 0;
+        maxLogicalWidth = 0;
+    } else if (childrenInline()) {
         // FIXME: Remove this const_cast.
         const_cast<RenderBlock*>(this)->computeInlinePreferredLogicalWidths(minLogicalWidth, maxLogicalWidth);
     } else
@@ -6560,9 +6573,9 @@ int RenderBlock::baselinePosition(FontBaseline baselineType, bool firstLine, Lin
         // (the content inside them moves).  This matches WinIE as well, which just bottom-aligns them.
         // We also give up on finding a baseline if we have a vertical scrollbar, or if we are scrolled
         // vertically (e.g., an overflow:hidden block that has had scrollTop moved) or if the baseline is outside
-        // of our content box.
+        // of our content box. Strictly contained blocks don't let their contents move the line they sit on.
         bool ignoreBaseline = (layer() && (layer()->marquee() || (direction == HorizontalLine ? (layer()->verticalScrollbar() || layer()->scrollYOffset() != 0)
-            : (layer()->horizontalScrollbar() || layer()->scrollXOffset() != 0)))) || (isWritingModeRoot() && !isRubyRun());
+            : (layer()->horizontalScrollbar() || layer()->scrollXOffset() != 0)))) || (isWritingModeRoot() && !isRubyRun()) || hasLayoutContainment();
         
         int baselinePos = ignoreBaseline ? -1 : inlineBlockBaseline(direction);
         
@@ -6583,6 +6596,8 @@ int RenderBlock::firstLineBoxBaseline() const
         return -1;
 
     if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            return SimpleLineLayout::computeFlowFirstLineBaseline(this, *simpleLineLayout);
         if (firstLineBox())
             return firstLineBox()->logicalTop() + style(true)->fontMetrics().ascent(firstRootBox()->baselineType());
         else
@@ -6612,6 +6627,8 @@ int RenderBlock::lastLineBoxBaseline(LineDirectionMode lineDirection) const
         return -1;
 
     if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            return SimpleLineLayout::computeFlowLastLineBaseline(this, *simpleLineLayout);
         if (!firstLineBox() && hasLineIfEmpty()) {
             const FontMetrics& fontMetrics = firstLineStyle()->fontMetrics();
             return fontMetrics.ascent()
@@ -6953,6 +6970,7 @@ RootInlineBox* RenderBlock::lineAtIndex(int i) const
         return 0;
 
     if (childrenInline()) {
+        const_cast<RenderBlock*>(this)->ensureLineBoxes();
         for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox())
             if (!i--)
                 return box;
@@ -6973,7 +6991,10 @@ int RenderBlock::lineCount(const RootInlineBox* stopRootInlineBox, bool* found)
     int count = 0;
 
     if (style()->visibility() == VISIBLE) {
-        if (childrenInline())
+        if (childrenInline()) {
+            // A simple line layout has no root boxes, so it cannot contain stopRootInlineBox.
+            if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+                return simpleLineLayout->lineCount();
             for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox()) {
                 count++;
                 if (box == stopRootInlineBox) {
@@ -6982,7 +7003,7 @@ int RenderBlock::lineCount(const RootInlineBox* stopRootInlineBox, bool* found)
                     break;
                 }
             }
-        else
+        } else
             for (RenderObject* obj = firstChild(); obj; obj = obj->nextSibling())
                 if (shouldCheckLines(obj)) {
                     bool recursiveFound = false;
@@ -7009,6 +7030,13 @@ void RenderBlock::adjustForBorderFit(LayoutUnit x, LayoutUnit& left, LayoutUnit&
     // for either overflow or translations via relative positioning.
     if (style()->visibility() == VISIBLE) {
         if (childrenInline()) {
+            if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout()) {
+                const Vector<SimpleLineLayout::Run>& runs = simpleLineLayout->runs();
+                for (size_t i = 0; i < runs.size(); ++i) {
+                    left = min(left, x + static_cast<LayoutUnit>(runs[i].left));
+                    right = max(right, x + static_cast<LayoutUnit>(ceilf(runs[i].right)));
+                }
+            }
             for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox()) {
                 if (box->firstChild())
                     left = min(left, x + static_cast<LayoutUnit>(box->firstChild()->x()));
@@ -7355,6 +7383,16 @@ void RenderBlock::addFocusRingRects(Vector<IntRect>& rects, const LayoutPoint& a
         rects.append(pixelSnappedIntRect(additionalOffset, size()));
 
     if (!hasOverflowClip() && !hasControlClip()) {
+        // Focus rings are collected while painting, which must not build line boxes.
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout()) {
+            Vector<LayoutRect> lineRects = SimpleLineLayout::collectFlowLineRects(*simpleLineLayout);
+            for (size_t i = 0; i < lineRects.size(); ++i) {
+                LayoutRect rect = lineRects[i];
+                rect.moveBy(additionalOffset);
+                if (!rect.isEmpty())
+                    rects.append(pixelSnappedIntRect(rect));
+            }
+        }
         for (RootInlineBox* curr = firstRootBox(); curr; curr = curr->nextRootBox()) {
             LayoutUnit top = max<LayoutUnit>(curr->lineTop(), curr->top());
             LayoutUnit bottom = min<LayoutUnit>(curr->lineBottom(), curr->top() + curr->height());
@@ -29,6 +29,7 @@
 #include "RenderBox.h"
 #include "RenderLineBoxList.h"
 #include "RootInlineBox.h"
+#include "SimpleLineLayout.h"
 #include "TextBreakIterator.h"
 #include "TextRun.h"
 #include <wtf/OwnPtr.h>
@@ -114,6 +115,12 @@ public:
 
     void deleteLineBoxTree();
 
+    // Blocks laid out with SimpleLineLayout have no line boxes. Code that needs to walk
+    // the inline box tree must call ensureLineBoxes() first, which lays the block out
+    // again with line boxes. They last until the block's next layout.
+    const SimpleLineLayout::Layout* simpleLineLayout() const { return m_rareData ? m_rareData->m_simpleLineLayout.get() : 0; }
+    void ensureLineBoxes();
+
     virtual void addChild(RenderObject* newChild, RenderObject* beforeChild = 0);
     virtual void removeChild(RenderObject*);
 
@@ -643,6 +650,7 @@ private:
 
     void layoutBlockChildren(bool relayoutChildren, LayoutUnit& maxFloatLogicalBottom);
     void layoutInlineChildren(bool relayoutChildren, LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom);
+    void layoutSimpleLines(LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom);
     BidiRun* handleTrailingSpaces(BidiRunList<BidiRun>&, BidiContext*);
 
     void insertIntoTrackedRendererMaps(RenderBox* descendant, TrackedDescendantsMap*&, TrackedContainerMap*&);
@@ -1287,6 +1295,7 @@ public:
             , m_shouldBreakAtLineToAvoidWidow(false)
             , m_discardMarginBefore(false)
             , m_discardMarginAfter(false)
+            , m_forceLineBoxes(false)
         { 
         }
 
@@ -1317,9 +1326,11 @@ public:
 #if ENABLE(CSS_SHAPES)
         OwnPtr<ShapeInsideInfo> m_shapeInsideInfo;
 #endif
+        OwnPtr<SimpleLineLayout::Layout> m_simpleLineLayout;
         bool m_shouldBreakAtLineToAvoidWidow : 1;
         bool m_discardMarginBefore : 1;
         bool m_discardMarginAfter : 1;
+        bool m_forceLineBoxes : 1;
      };
 
 protected:
@@ -24,6 +24,7 @@
 #include "config.h"
 
 #include "BidiResolver.h"
+#include "FrameView.h"
 #include "Hyphenation.h"
 #include "InlineIterator.h"
 #include "InlineTextBox.h"
@@ -39,6 +40,7 @@
 #include "RenderRubyRun.h"
 #include "RenderView.h"
 #include "Settings.h"
+#include "SimpleLineLayout.h"
 #include "TrailingFloatsRootInlineBox.h"
 #include "VerticalPositionCache.h"
 #include "break_lines.h"
@@ -2107,8 +2109,65 @@ void RenderBlock::repaintDirtyFloats(Vector<FloatWithRect>& floats)
     }
 }
 
+void RenderBlock::layoutSimpleLines(LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
+{
+    // Whatever the old lines covered has to be repainted along with the new ones.
+    repaintLogicalTop = borderAndPaddingBefore();
+    repaintLogicalBottom = repaintLogicalTop;
+    if (const SimpleLineLayout::Layout* oldSimpleLineLayout = simpleLineLayout())
+        repaintLogicalBottom = borderAndPaddingBefore() + oldSimpleLineLayout->height();
+    else if (lastRootBox()) {
+        repaintLogicalTop = min(repaintLogicalTop, firstRootBox()->logicalTopVisualOverflow());
+        repaintLogicalBottom = lastRootBox()->logicalBottomVisualOverflow();
+    }
+
+    RenderText* textRenderer = toRenderText(firstChild());
+    lineBoxes()->deleteLineBoxes(renderArena());
+    textRenderer->dirtyLineBoxes(true);
+    textRenderer->setNeedsLayout(false);
+
+    OwnPtr<SimpleLineLayout::Layout> simpleLineLayout = SimpleLineLayout::Layout::create(this);
+    setLogicalHeight(borderAndPaddingBefore() + simpleLineLayout->height() + borderAndPaddingAfter() + scrollbarLogicalHeight());
+    repaintLogicalBottom = max(repaintLogicalBottom, borderAndPaddingBefore() + simpleLineLayout->height());
+
+    if (!m_rareData)
+        m_rareData = adoptPtr(new RenderBlockRareData(this));
+    m_rareData->m_simpleLineLayout = simpleLineLayout.release();
+}
+
+void RenderBlock::ensureLineBoxes()
+{
+    if (!m_rareData || !m_rareData->m_simpleLineLayout || m_beingDestroyed || documentBeingDestroyed())
+        return;
+    // Lay the block out again with line boxes. This only applies to the next layout of the block,
+    // the one after it goes back to simple lines if they can still be used.
+    m_rareData->m_forceLineBoxes = true;
+    setNeedsLayout(true);
+
+    // The layout has to go through the frame view so that it runs with the right layout state.
+    // It is left pending when it cannot run now: during layout or painting, or when it would have
+    // to recalculate style first, which could destroy renderers the caller is holding on to.
+    FrameView* frameView = view()->frameView();
+    if (!frameView || frameView->isInLayout() || frameView->isPainting())
+        return;
+    Document* document = this->document();
+    if (document->needsStyleRecalc() || document->childNeedsStyleRecalc())
+        return;
+    frameView->layout();
+}
+
 void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
 {
+    bool forceLineBoxes = m_rareData && m_rareData->m_forceLineBoxes;
+    if (m_rareData)
+        m_rareData->m_forceLineBoxes = false;
+    if (!forceLineBoxes && SimpleLineLayout::canUseFor(this)) {
+        layoutSimpleLines(repaintLogicalTop, repaintLogicalBottom);
+        return;
+    }
+    if (m_rareData)
+        m_rareData->m_simpleLineLayout.clear();
+
     setLogicalHeight(borderAndPaddingBefore());
     
     // Lay out our hypothetical grid line as though it occurs at the top of the block.
@@ -2147,6 +2206,7 @@ void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repain
         // elements at the same time.
         bool hasInlineChild = false;
         Vector<RenderBox*> replacedChildren;
+        Vector<RenderText*> dirtyTextChildren;
         for (InlineWalker walker(this); !walker.atEnd(); walker.advance()) {
             RenderObject* o = walker.current();
             if (!hasInlineChild && o->isInline())
@@ -2177,8 +2237,11 @@ void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repain
             } else if (o->isText() || (o->isRenderInline() && !walker.atEndOfInline())) {
                 if (!o->isText())
                     toRenderInline(o)->updateAlwaysCreateLineBoxes(layoutState.isFullLayout());
-                if (layoutState.isFullLayout() || o->selfNeedsLayout())
+                if (layoutState.isFullLayout() || o->selfNeedsLayout()) {
                     dirtyLineBoxesForRenderer(o, layoutState.isFullLayout());
+                    if (o->isText())
+                        dirtyTextChildren.append(toRenderText(o));
+                }
                 o->setNeedsLayout(false);
             }
         }
@@ -2186,6 +2249,10 @@ void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repain
         for (size_t i = 0; i < replacedChildren.size(); i++)
              replacedChildren[i]->layoutIfNeeded();
 
+        // Shape the text that is about to be broken into lines up front, so that line breaking
+        // measures from cached results instead of shaping each text run as it reaches it.
+        Font::prepareLayouts(dirtyTextChildren);
+
         layoutRunsAndFloats(layoutState, hasInlineChild);
     }
 
@@ -3544,6 +3611,11 @@ InlineIterator RenderBlock::LineBreaker::nextSegmentBreak(InlineBidiResolver& re
 
 void RenderBlock::addOverflowFromInlineChildren()
 {
+    if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout()) {
+        SimpleLineLayout::collectFlowOverflow(this, *simpleLineLayout);
+        return;
+    }
+
     LayoutUnit endPadding = hasOverflowClip() ? paddingEnd() : LayoutUnit();
     // FIXME: Need to find another way to do this, since scrollbars could show when we don't want them to.
     if (hasOverflowClip() && !endPadding && node() && node()->isRootEditableElement() && style()->isLeftToRightDirection())
@@ -76,6 +76,14 @@ static OverrideSizeMap* gOverrideWidthMap = 0;
 static OverrideSizeMap* gOverrideContainingBlockLogicalHeightMap = 0;
 static OverrideSizeMap* gOverrideContainingBlockLogicalWidthMap = 0;
 
+// Used by flexible boxes and grid elements to avoid laying out their items again just to measure them.
+struct CachedIntrinsicLogicalHeight {
+    LayoutUnit availableLogicalWidth;
+    LayoutUnit logicalHeight;
+};
+typedef WTF::HashMap<const RenderBox*, CachedIntrinsicLogicalHeight> IntrinsicLogicalHeightMap;
+static IntrinsicLogicalHeightMap* gIntrinsicLogicalHeightMap = 0;
+
 
 // Size of border belt for autoscroll. When mouse pointer in border belt,
 // autoscroll is started.
@@ -158,6 +166,7 @@ void RenderBox::willBeDestroyed()
 {
     clearOverrideSize();
     clearContainingBlockOverrideSize();
+    clearCachedIntrinsicLogicalHeight();
 
     RenderBlock::removePercentHeightDescendantIfNeeded(this);
 
@@ -357,9 +366,10 @@ void RenderBox::updateFromStyle()
     setFloating(!isOutOfFlowPositioned() && styleToUse->isFloating());
 
     // We also handle <body> and <html>, whose overflow applies to the viewport.
-    if (styleToUse->overflowX() != OVISIBLE && !isRootObject && isRenderBlock()) {
+    // Strict containment clips as well, so that nothing inside the box can reach outside of it.
+    if ((styleToUse->overflowX() != OVISIBLE || styleToUse->hasStrictContainment()) && !isRootObject && isRenderBlock()) {
         bool boxHasOverflowClip = true;
-        if (isBody()) {
+        if (isBody() && styleToUse->overflowX() != OVISIBLE) {
             // Overflow on the body can propagate to the viewport under the following conditions.
             // (1) The root element is <html>.
             // (2) We are the primary <body> (can be checked by looking at document.body).
@@ -979,6 +989,38 @@ void RenderBox::clearOverrideContainingBlockContentLogicalHeight()
         gOverrideContainingBlockLogicalHeightMap->remove(this);
 }
 
+bool RenderBox::cachedIntrinsicLogicalHeight(LayoutUnit availableLogicalWidth, LayoutUnit& logicalHeight) const
+{
+    // Anything that can change the measured height, from our own style to a descendant's text,
+    // marks us as needing layout.
+    if (!gIntrinsicLogicalHeightMap || needsLayout())
+        return false;
+
+    IntrinsicLogicalHeightMap::const_iterator it = gIntrinsicLogicalHeightMap->find(this);
+    if (it == gIntrinsicLogicalHeightMap->end() || it->value.availableLogicalWidth != availableLogicalWidth)
+        return false;
+
+    logicalHeight = it->value.logicalHeight;
+    return true;
+}
+
+void RenderBox::setCachedIntrinsicLogicalHeight(LayoutUnit availableLogicalWidth, LayoutUnit logicalHeight)
+{
+    if (!gIntrinsicLogicalHeightMap)
+        gIntrinsicLogicalHeightMap = new IntrinsicLogicalHeightMap;
+
+    CachedIntrinsicLogicalHeight cachedHeight;
+    cachedHeight.availableLogicalWidth = availableLogicalWidth;
+    cachedHeight.logicalHeight = logicalHeight;
+    gIntrinsicLogicalHeightMap->set(this, cachedHeight);
+}
+
+void RenderBox::clearCachedIntrinsicLogicalHeight()
+{
+    if (gIntrinsicLogicalHeightMap)
+        gIntrinsicLogicalHeightMap->remove(this);
+}
+
 LayoutUnit RenderBox::adjustBorderBoxLogicalWidthForBoxSizing(LayoutUnit width) const
 {
     LayoutUnit bordersPlusPadding = borderAndPaddingLogicalWidth();
@@ -2465,6 +2507,10 @@ static bool shouldFlipBeforeAfterMargins(const RenderStyle* containingBlockStyle
 
 void RenderBox::updateLogicalHeight()
 {
+    // A strictly contained box sizes as if it were empty.
+    if (hasLayoutContainment())
+        setLogicalHeight(borderAndPaddingLogicalHeight() + scrollbarLogicalHeight());
+
     LogicalExtentComputedValues computedValues;
     computeLogicalHeight(logicalHeight(), logicalTop(), computedValues);
 
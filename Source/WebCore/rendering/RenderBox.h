@@ -319,6 +319,13 @@ public:
     void clearContainingBlockOverrideSize();
     void clearOverrideContainingBlockContentLogicalHeight();
 
+    // Flexbox and grid containers lay out their children just to measure how tall they want to be.
+    // The measured height is remembered here, and is only valid while the box does not need layout,
+    // for the same available logical width. The box's parent always measures it the same way.
+    bool cachedIntrinsicLogicalHeight(LayoutUnit availableLogicalWidth, LayoutUnit& logicalHeight) const;
+    void setCachedIntrinsicLogicalHeight(LayoutUnit availableLogicalWidth, LayoutUnit logicalHeight);
+    void clearCachedIntrinsicLogicalHeight();
+
     virtual LayoutSize offsetFromContainer(RenderObject*, const LayoutPoint&, bool* offsetDependsOnPoint = 0) const;
     
     LayoutUnit adjustBorderBoxLogicalWidthForBoxSizing(LayoutUnit width) const;
@@ -351,6 +351,11 @@ void RenderFlexibleBox::layoutBlock(bool relayoutChildren, LayoutUnit)
 
     dirtyForLayoutFromPercentageHeightDescendants();
 
+    if (relayoutChildren) {
+        for (RenderBox* child = firstChildBox(); child; child = child->nextSiblingBox())
+            child->clearCachedIntrinsicLogicalHeight();
+    }
+
     Vector<LineContext> lineContexts;
     OrderHashSet orderValues;
     computeMainAxisPreferredSizes(orderValues);
@@ -749,12 +754,20 @@ LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox*
 
     Length flexBasis = flexBasisForChild(child);
     if (flexBasis.isAuto() || (flexBasis.isFixed() && !flexBasis.value() && hasInfiniteLineLength)) {
+        LayoutUnit mainAxisExtent;
         if (hasOrthogonalFlow(child)) {
-            if (hasOverrideSize)
-                child->setChildNeedsLayout(true, MarkOnlyThis);
-            child->layoutIfNeeded();
-        }
-        LayoutUnit mainAxisExtent = hasOrthogonalFlow(child) ? child->logicalHeight() : child->maxPreferredLogicalWidth();
+            // Laying the child out again to measure it would also measure its own flex items again,
+            // which is exponential in the depth of nested flexboxes.
+            LayoutUnit availableLogicalWidth = crossAxisContentExtent();
+            if (!child->cachedIntrinsicLogicalHeight(availableLogicalWidth, mainAxisExtent)) {
+                if (hasOverrideSize)
+                    child->setChildNeedsLayout(true, MarkOnlyThis);
+                child->layoutIfNeeded();
+                mainAxisExtent = child->logicalHeight();
+                child->setCachedIntrinsicLogicalHeight(availableLogicalWidth, mainAxisExtent);
+            }
+        } else
+            mainAxisExtent = child->maxPreferredLogicalWidth();
         ASSERT(mainAxisExtent - mainAxisBorderAndPaddingExtentForChild(child) >= 0);
         return mainAxisExtent - mainAxisBorderAndPaddingExtentForChild(child);
     }
@@ -363,18 +363,25 @@ size_t RenderGrid::maximumIndexInDirection(TrackSizingDirection direction) const
 
 LayoutUnit RenderGrid::logicalContentHeightForChild(RenderBox* child, Vector<GridTrack>& columnTracks)
 {
-    // FIXME: We shouldn't force a layout every time this function is called but
-    // 1) Return computeLogicalHeight's value if it's available. Unfortunately computeLogicalHeight
+    // The min-content and max-content heights of a child are the same layout, and both are asked
+    // for every time the row tracks are sized, so only lay the child out again when it or the
+    // breadth of its column tracks changed.
+    // FIXME: Return computeLogicalHeight's value if it's available. Unfortunately computeLogicalHeight
     // doesn't return if the logical height is available so would need to be changed.
-    // 2) Relayout if the column track's used breadth changed OR the logical height is unavailable.
+    LayoutUnit overrideContainingBlockContentLogicalWidth = gridAreaBreadthForChild(child, ForColumns, columnTracks);
+    LayoutUnit logicalHeight;
+    if (child->cachedIntrinsicLogicalHeight(overrideContainingBlockContentLogicalWidth, logicalHeight))
+        return logicalHeight;
+
     if (!child->needsLayout())
         child->setNeedsLayout(true, MarkOnlyThis);
 
-    child->setOverrideContainingBlockContentLogicalWidth(gridAreaBreadthForChild(child, ForColumns, columnTracks));
+    child->setOverrideContainingBlockContentLogicalWidth(overrideContainingBlockContentLogicalWidth);
     // If |child| has a percentage logical height, we shouldn't let it override its intrinsic height, which is
     // what we are interested in here. Thus we need to set the override logical height to -1 (no possible resolution).
     child->setOverrideContainingBlockContentLogicalHeight(-1);
     child->layout();
+    child->setCachedIntrinsicLogicalHeight(overrideContainingBlockContentLogicalWidth, child->logicalHeight());
     return child->logicalHeight();
 }
 
@@ -670,8 +677,9 @@ void RenderGrid::layoutGridItems()
         LayoutUnit oldOverrideContainingBlockContentLogicalWidth = child->hasOverrideContainingBlockLogicalWidth() ? child->overrideContainingBlockContentLogicalWidth() : LayoutUnit();
         LayoutUnit oldOverrideContainingBlockContentLogicalHeight = child->hasOverrideContainingBlockLogicalHeight() ? child->overrideContainingBlockContentLogicalHeight() : LayoutUnit();
 
-        // FIXME: For children in a content sized track, we clear the overrideContainingBlockContentLogicalHeight
-        // in minContentForChild / maxContentForChild which means that we will always relayout the child.
+        // FIXME: For children in a content sized track that had to be measured again, we clear the
+        // overrideContainingBlockContentLogicalHeight in minContentForChild / maxContentForChild which
+        // means that we will relayout the child.
         LayoutUnit overrideContainingBlockContentLogicalWidth = gridAreaBreadthForChild(child, ForColumns, columnTracks);
         LayoutUnit overrideContainingBlockContentLogicalHeight = gridAreaBreadthForChild(child, ForRows, rowTracks);
         if (oldOverrideContainingBlockContentLogicalWidth != overrideContainingBlockContentLogicalWidth || oldOverrideContainingBlockContentLogicalHeight != overrideContainingBlockContentLogicalHeight)
@@ -572,6 +572,18 @@ void RenderImage::layout()
     IntSize containerSize(contentWidth(), contentHeight());
     if (!containerSize.isEmpty())
         m_imageResource->setContainerSizeForRenderer(containerSize);
+
+    // Once it has a position, FrameView raises the load priority of the image if it is in view.
+    CachedImage* cachedImage = m_imageResource->cachedImage();
+    if (cachedImage && cachedImage->isLoading() && cachedImage->loadPriority() < ResourceLoadPriorityMedium)
+        view()->addLoadingImage(this);
+}
+
+void RenderImage::willBeDestroyed()
+{
+    if (RenderView* v = view())
+        v->removeLoadingImage(this);
+    RenderReplaced::willBeDestroyed();
 }
 
 void RenderImage::computeIntrinsicRatioInformation(FloatSize& intrinsicSize, double& intrinsicRatio, bool& isPercentageIntrinsicSize) const
@@ -74,6 +74,7 @@ protected:
     virtual void paintIntoRect(GraphicsContext*, const LayoutRect&);
     virtual void paint(PaintInfo&, const LayoutPoint&);
     virtual void layout();
+    virtual void willBeDestroyed() OVERRIDE;
 
     virtual void intrinsicSizeChanged()
     {
@@ -84,6 +84,9 @@
 #include "RenderSVGResourceClipper.h"
 #include "RenderScrollbar.h"
 #include "RenderScrollbarPart.h"
+#include "RenderTableCell.h"
+#include "RenderTableRow.h"
+#include "RenderTableSection.h"
 #include "RenderTheme.h"
 #include "RenderTreeAsText.h"
 #include "RenderView.h"
@@ -182,6 +185,7 @@ RenderLayer::RenderLayer(RenderLayerModelObject* renderer)
 #endif
     , m_containsDirtyOverlayScrollbars(false)
     , m_updatingMarqueePosition(false)
+    , m_isInDeferredTableRow(false)
 #if !ASSERT_DISABLED
     , m_layerListMutationAllowed(true)
 #endif
@@ -197,6 +201,7 @@ RenderLayer::RenderLayer(RenderLayerModelObject* renderer)
     , m_next(0)
     , m_first(0)
     , m_last(0)
+    , m_deferredTableRowsVersion(0)
     , m_staticInlinePosition(0)
     , m_staticBlockPosition(0)
     , m_reflection(0)
@@ -1753,6 +1758,10 @@ void RenderLayer::addChild(RenderLayer* child, RenderLayer* beforeChild)
 
     child->setParent(this);
 
+    // Whether a layer is in a deferred table row depends on its ancestors.
+    if (RenderView* view = renderer()->view())
+        view->deferredTableRowsChanged();
+
     if (child->isNormalFlowOnly())
         dirtyNormalFlowList();
 
@@ -2221,6 +2230,8 @@ void RenderLayer::scrollTo(int x, int y)
             view->frameView()->updateAnnotatedRegions();
 #endif
             view->updateWidgetPositions();
+            view->updateDeferredTableRowsNearViewport();
+            view->promoteLoadingImagesInViewport();
         }
 
         if (!m_updatingMarqueePosition) {
@@ -3603,6 +3614,27 @@ static bool paintForFixedRootBackground(const RenderLayer* layer, RenderLayer::P
 }
 #endif
 
+// Cells of rows that RenderTableSection has not laid out yet still need layout, so neither they
+// nor anything inside them may be painted or hit tested. Every paint and hit test asks each layer,
+// so the answer is kept until RenderView reports that the deferred rows changed.
+bool RenderLayer::isInDeferredTableRow() const
+{
+    RenderView* view = renderer()->view();
+    if (!view->hasTableSectionsWithDeferredRows())
+        return false;
+    if (m_deferredTableRowsVersion == view->deferredTableRowsVersion())
+        return m_isInDeferredTableRow;
+
+    RenderTableRow* row = 0;
+    if (renderer()->isTableCell())
+        row = toRenderTableCell(renderer())->row();
+    else if (renderer()->isTableRow())
+        row = toRenderTableRow(renderer());
+    m_isInDeferredTableRow = (row && row->section() && row->section()->rowLayoutIsDeferred(row)) || (m_parent && m_parent->isInDeferredTableRow());
+    m_deferredTableRowsVersion = view->deferredTableRowsVersion();
+    return m_isInDeferredTableRow;
+}
+
 void RenderLayer::paintLayer(GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
 {
 #if USE(ACCELERATED_COMPOSITING)
@@ -3630,6 +3662,9 @@ void RenderLayer::paintLayer(GraphicsContext* context, const LayerPaintingInfo&
     if (!isSelfPaintingLayer() && !hasSelfPaintingLayerDescendant())
         return;
 
+    if (isInDeferredTableRow())
+        return;
+
     if (shouldSuppressPaintingLayer(this))
         return;
     
@@ -4558,6 +4593,9 @@ RenderLayer* RenderLayer::hitTestLayer(RenderLayer* rootLayer, RenderLayer* cont
     if (!isSelfPaintingLayer() && !hasSelfPaintingLayerDescendant())
         return 0;
 
+    if (isInDeferredTableRow())
+        return 0;
+
     // The natural thing would be to keep HitTestingTransformState on the stack, but it's big, so we heap-allocate.
 
     // Apply a transform if we have one.
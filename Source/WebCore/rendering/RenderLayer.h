@@ -948,6 +948,8 @@ private:
     GraphicsContext* applyFilters(FilterEffectRendererHelper*, GraphicsContext* originalContext, LayerPaintingInfo&, LayerFragments&);
 #endif
 
+    bool isInDeferredTableRow() const;
+
     void paintLayer(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerContentsAndReflection(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerByApplyingTransform(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags, const LayoutPoint& translationOffset = LayoutPoint());
@@ -1199,6 +1201,8 @@ protected:
     bool m_containsDirtyOverlayScrollbars : 1;
     bool m_updatingMarqueePosition : 1;
 
+    mutable bool m_isInDeferredTableRow : 1;
+
 #if !ASSERT_DISABLED
     bool m_layerListMutationAllowed : 1;
 #endif
@@ -1219,6 +1223,9 @@ protected:
     RenderLayer* m_first;
     RenderLayer* m_last;
 
+    // The RenderView::deferredTableRowsVersion() m_isInDeferredTableRow was computed for.
+    mutable unsigned m_deferredTableRowsVersion;
+
     LayoutRect m_repaintRect; // Cached repaint rects. Used by layout.
     LayoutRect m_outlineBox;
 
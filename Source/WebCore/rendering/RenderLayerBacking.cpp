@@ -2087,6 +2087,12 @@ bool RenderLayerBacking::isTrackingRepaints() const
     return client ? client->isTrackingRepaints() : false;
 }
 
+bool RenderLayerBacking::shouldRecordDisplayList(const GraphicsLayer*) const
+{
+    Frame* frame = renderer()->frame();
+    return frame && frame->settings() && frame->settings()->displayListRecordingEnabled();
+}
+
 #ifndef NDEBUG
 void RenderLayerBacking::verifyNotPainting()
 {
@@ -170,6 +170,7 @@ public:
     virtual bool getCurrentTransform(const GraphicsLayer*, TransformationMatrix&) const OVERRIDE;
 
     virtual bool isTrackingRepaints() const OVERRIDE;
+    virtual bool shouldRecordDisplayList(const GraphicsLayer*) const OVERRIDE;
 
 #ifndef NDEBUG
     virtual void verifyNotPainting();
@@ -41,6 +41,7 @@
 #include "HTMLNames.h"
 #include "HitTestResult.h"
 #include "InspectorInstrumentation.h"
+#include "IntPointHash.h"
 #include "Logging.h"
 #include "NodeList.h"
 #include "Page.h"
@@ -142,33 +143,128 @@ public:
     RenderGeometryMap& geometryMap() { return m_geometryMap; }
 
 private:
-    struct RectList {
-        Vector<IntRect> rects;
-        IntRect boundingRect;
-        
+    // Overlap tests against a few rects just scan them. Past gridThreshold rects, they are also
+    // bucketed into a grid so that a test only looks at the rects near the tested bounds; pages
+    // with thousands of positioned layers would otherwise make the overlap testing quadratic.
+    class RectList {
+    public:
         void append(const IntRect& rect)
         {
-            rects.append(rect);
-            boundingRect.unite(rect);
+            if (rect.isEmpty())
+                return;
+            m_rects.append(rect);
+            m_boundingRect.unite(rect);
+
+            if (m_rects.size() == gridThreshold)
+                buildGrid();
+            else if (m_rects.size() > gridThreshold)
+                addToGrid(m_rects.size() - 1);
         }
 
         void append(const RectList& rectList)
         {
-            rects.appendVector(rectList.rects);
-            boundingRect.unite(rectList.boundingRect);
+            if (rectList.m_rects.size() < gridThreshold || m_rects.size() + rectList.m_rects.size() < gridThreshold) {
+                for (size_t i = 0; i < rectList.m_rects.size(); ++i)
+                    append(rectList.m_rects[i]);
+                return;
+            }
+            size_t oldSize = m_rects.size();
+            m_rects.appendVector(rectList.m_rects);
+            m_boundingRect.unite(rectList.m_boundingRect);
+            if (oldSize < gridThreshold)
+                buildGrid();
+            else {
+                for (size_t i = oldSize; i < m_rects.size(); ++i)
+                    addToGrid(i);
+            }
         }
-        
+
         bool intersects(const IntRect& rect) const
         {
-            if (!rects.size() || !boundingRect.intersects(rect))
+            if (!m_rects.size() || !m_boundingRect.intersects(rect))
                 return false;
 
-            for (unsigned i = 0; i < rects.size(); i++) {
+            if (m_rects.size() < gridThreshold)
+                return intersectsAny(m_rects, rect);
+
+            IntRect cells = cellsCoveredBy(intersection(rect, m_boundingRect));
+            if (static_cast<uint64_t>(cells.width()) * cells.height() > m_rects.size())
+                return intersectsAny(m_rects, rect);
+
+            for (size_t i = 0; i < m_largeRects.size(); ++i) {
+                if (m_rects[m_largeRects[i]].intersects(rect))
+                    return true;
+            }
+            for (int y = cells.y(); y < cells.maxY(); ++y) {
+                for (int x = cells.x(); x < cells.maxX(); ++x) {
+                    Grid::const_iterator cell = m_grid.find(IntPoint(x, y));
+                    if (cell == m_grid.end())
+                        continue;
+                    const Vector<unsigned>& indices = cell->value;
+                    for (size_t i = 0; i < indices.size(); ++i) {
+                        if (m_rects[indices[i]].intersects(rect))
+                            return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        typedef HashMap<IntPoint, Vector<unsigned> > Grid;
+
+        static const size_t gridThreshold = 32;
+        static const int gridCellSize = 256;
+        // Rects covering more cells than this are tested on every query instead.
+        static const unsigned maxCellsPerRect = 64;
+
+        static bool intersectsAny(const Vector<IntRect>& rects, const IntRect& rect)
+        {
+            for (size_t i = 0; i < rects.size(); ++i) {
                 if (rects[i].intersects(rect))
                     return true;
             }
             return false;
         }
+
+        static int cellIndex(int coordinate)
+        {
+            return coordinate >= 0 ? coordinate / gridCellSize : (coordinate + 1) / gridCellSize - 1;
+        }
+
+        static IntRect cellsCoveredBy(const IntRect& rect)
+        {
+            ASSERT(!rect.isEmpty());
+            int minX = cellIndex(rect.x());
+            int minY = cellIndex(rect.y());
+            return IntRect(minX, minY, cellIndex(rect.maxX() - 1) - minX + 1, cellIndex(rect.maxY() - 1) - minY + 1);
+        }
+
+        void buildGrid()
+        {
+            m_grid.clear();
+            m_largeRects.clear();
+            for (size_t i = 0; i < m_rects.size(); ++i)
+                addToGrid(i);
+        }
+
+        void addToGrid(size_t index)
+        {
+            IntRect cells = cellsCoveredBy(m_rects[index]);
+            if (static_cast<uint64_t>(cells.width()) * cells.height() > maxCellsPerRect) {
+                m_largeRects.append(index);
+                return;
+            }
+            for (int y = cells.y(); y < cells.maxY(); ++y) {
+                for (int x = cells.x(); x < cells.maxX(); ++x)
+                    m_grid.add(IntPoint(x, y), Vector<unsigned>()).iterator->value.append(index);
+            }
+        }
+
+        Vector<IntRect> m_rects;
+        IntRect m_boundingRect;
+        Grid m_grid;
+        Vector<unsigned> m_largeRects;
     };
 
     Vector<RectList> m_overlapStack;
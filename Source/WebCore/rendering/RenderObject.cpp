@@ -145,6 +145,9 @@ static bool shouldRepaintFixedBackgroundsOnScroll(FrameView* frameView)
 bool RenderObject::s_affectsParentBlock = false;
 bool RenderObject::s_noLongerAffectsParentBlock = false;
 
+bool RenderObject::s_countsRenderersLaidOut = false;
+unsigned RenderObject::s_renderersLaidOutCount = 0;
+
 RenderObjectAncestorLineboxDirtySet* RenderObject::s_ancestorLineboxDirtySet = 0;
 
 void* RenderObject::operator new(size_t sz, RenderArena* renderArena)
@@ -670,6 +673,13 @@ static inline bool objectIsRelayoutBoundary(const RenderObject* object)
     if (!object->hasOverflowClip())
         return false;
 
+    // Strictly contained boxes size themselves without looking at their contents, so any width
+    // or height will do. Tables, flexboxes and grids still size their children themselves.
+    if (object->style()->hasStrictContainment()) {
+        RenderObject* parent = object->parent();
+        return !object->isTablePart() && parent && !parent->isFlexibleBoxIncludingDeprecated() && !parent->isRenderGrid();
+    }
+
     if (object->style()->width().isIntrinsicOrAuto() || object->style()->height().isIntrinsicOrAuto() || object->style()->height().isPercent())
         return false;
 
@@ -773,6 +783,9 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
             // A positioned object has no effect on the min/max width of its containing block ever.
             // We can optimize this case and not go up any further.
             break;
+        if (o->hasLayoutContainment())
+            // Nor does anything inside a strictly contained box.
+            break;
         o = container;
     }
 }
@@ -2420,12 +2433,12 @@ inline void RenderObject::clearLayoutRootIfNeeded() const
 {
     if (!documentBeingDestroyed() && frame()) {
         if (FrameView* view = frame()->view()) {
-            if (view->layoutRoot() == this) {
+            if (view->isLayoutRoot(this)) {
                 ASSERT_NOT_REACHED();
                 // This indicates a failure to layout the child, which is why
                 // the layout root is still set to |this|. Make sure to clear it
                 // since we are getting destroyed.
-                view->clearLayoutRoot();
+                view->clearLayoutRoot(this);
             }
         }
     }
@@ -577,6 +577,11 @@ public:
     }
 
     bool selfNeedsLayout() const { return m_bitfields.needsLayout(); }
+
+    // Running total of renderers whose layout has completed, only kept once testing code turns counting on.
+    // FrameView samples it around a layout pass.
+    static void setCountsRenderersLaidOut(bool counts) { s_countsRenderersLaidOut = counts; }
+    static unsigned renderersLaidOutCount() { return s_renderersLaidOutCount; }
     bool needsPositionedMovementLayout() const { return m_bitfields.needsPositionedMovementLayout(); }
     bool needsPositionedMovementLayoutOnly() const
     {
@@ -595,6 +600,8 @@ public:
     bool hasClip() const { return isOutOfFlowPositioned() && style()->hasClip(); }
     bool hasOverflowClip() const { return m_bitfields.hasOverflowClip(); }
     bool hasClipOrOverflowClip() const { return hasClip() || hasOverflowClip(); }
+    // Strict containment only takes effect on boxes that clip their overflow, see RenderBox::updateFromStyle().
+    bool hasLayoutContainment() const { return hasOverflowClip() && style()->hasStrictContainment(); }
 
     bool hasTransform() const { return m_bitfields.hasTransform(); }
     bool hasMask() const { return style() && style()->hasMask(); }
@@ -1162,6 +1169,9 @@ private:
     // Store state between styleWillChange and styleDidChange
     static bool s_affectsParentBlock;
     static bool s_noLongerAffectsParentBlock;
+
+    static bool s_countsRenderersLaidOut;
+    static unsigned s_renderersLaidOutCount;
 };
 
 inline bool RenderObject::documentBeingDestroyed() const
@@ -1196,6 +1206,9 @@ inline bool RenderObject::isBeforeOrAfterContent() const
 
 inline void RenderObject::setNeedsLayout(bool needsLayout, MarkingBehavior markParents)
 {
+    if (UNLIKELY(s_countsRenderersLaidOut) && !needsLayout && this->needsLayout())
+        ++s_renderersLaidOutCount;
+
     bool alreadyNeededLayout = m_bitfields.needsLayout();
     m_bitfields.setNeedsLayout(needsLayout);
     if (needsLayout) {
@@ -94,12 +94,16 @@ public:
     {
         // FIXME: This function does too much work, and is very hot during table layout!
         int adjustedLogicalHeight = pixelSnappedLogicalHeight() - (intrinsicPaddingBefore() + intrinsicPaddingAfter());
-        int styleLogicalHeight = valueForLength(style()->logicalHeight(), 0, view());
-        // In strict mode, box-sizing: content-box do the right thing and actually add in the border and padding.
-        // Call computedCSSPadding* directly to avoid including implicitPadding.
-        if (!document()->inQuirksMode() && style()->boxSizing() != BORDER_BOX)
-            styleLogicalHeight += (computedCSSPaddingBefore() + computedCSSPaddingAfter()).floor() + borderBefore() + borderAfter();
-        return max(styleLogicalHeight, adjustedLogicalHeight);
+        return max(styleLogicalHeightForRowSizing(), adjustedLogicalHeight);
+    }
+
+    // A strictly contained cell is as tall as its borders, padding and scrollbar, whatever its
+    // contents, so its row can be sized without laying it out.
+    int logicalHeightForRowSizingWithoutLayout() const
+    {
+        ASSERT(hasLayoutContainment());
+        int adjustedLogicalHeight = roundToInt(borderAndPaddingLogicalHeight() + scrollbarLogicalHeight()) - (intrinsicPaddingBefore() + intrinsicPaddingAfter());
+        return max(styleLogicalHeightForRowSizing(), adjustedLogicalHeight);
     }
 
 
@@ -217,6 +221,16 @@ protected:
     virtual void computePreferredLogicalWidths();
 
 private:
+    int styleLogicalHeightForRowSizing() const
+    {
+        int styleLogicalHeight = valueForLength(style()->logicalHeight(), 0, view());
+        // In strict mode, box-sizing: content-box do the right thing and actually add in the border and padding.
+        // Call computedCSSPadding* directly to avoid including implicitPadding.
+        if (!document()->inQuirksMode() && style()->boxSizing() != BORDER_BOX)
+            styleLogicalHeight += (computedCSSPaddingBefore() + computedCSSPaddingAfter()).floor() + borderBefore() + borderAfter();
+        return styleLogicalHeight;
+    }
+
     virtual const char* renderName() const { return (isAnonymous() || isPseudoElement()) ? "RenderTableCell (anonymous)" : "RenderTableCell"; }
 
     virtual bool isTableCell() const { return true; }
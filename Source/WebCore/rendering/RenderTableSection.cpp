@@ -26,6 +26,7 @@
 #include "config.h"
 #include "RenderTableSection.h"
 #include "Document.h"
+#include "FrameView.h"
 #include "HitTestResult.h"
 #include "HTMLNames.h"
 #include "PaintInfo.h"
@@ -48,6 +49,54 @@ using namespace HTMLNames;
 static unsigned gMinTableSizeToUseFastPaintPathWithOverflowingCell = 75 * 75;
 static float gMaxAllowedOverflowingCellRatioForFastPaintPath = 0.1f;
 
+// Below this many rows, laying out every row is cheap enough that we never defer any of them.
+static const unsigned gMinRowCountToDeferRowLayout = 200;
+
+RenderTableSection::CellStruct::CellStruct(const CellStruct& other)
+    : m_bits(other.m_bits)
+{
+    if (other.hasCellVector())
+        m_bits = reinterpret_cast<uintptr_t>(new CellVector(*other.cellVector())) | (other.m_bits & FlagMask);
+}
+
+RenderTableSection::CellStruct::~CellStruct()
+{
+    if (hasCellVector())
+        delete cellVector();
+}
+
+RenderTableSection::CellStruct& RenderTableSection::CellStruct::operator=(const CellStruct& other)
+{
+    CellStruct copy(other);
+    std::swap(m_bits, copy.m_bits);
+    return *this;
+}
+
+void RenderTableSection::CellStruct::appendCell(RenderTableCell* cell)
+{
+    ASSERT(cell);
+    ASSERT(!(reinterpret_cast<uintptr_t>(cell) & FlagMask));
+
+    uintptr_t inColSpanFlag = m_bits & InColSpanFlag;
+    if (!hasCells()) {
+        m_bits = reinterpret_cast<uintptr_t>(cell) | inColSpanFlag;
+        return;
+    }
+
+    if (!hasCellVector()) {
+        CellVector* cells = new CellVector;
+        cells->append(singleCell());
+        m_bits = reinterpret_cast<uintptr_t>(cells) | CellVectorFlag | inColSpanFlag;
+    }
+    cellVector()->append(cell);
+}
+
+void RenderTableSection::CellStruct::appendCells(const CellStruct& other)
+{
+    for (unsigned i = 0; i < other.cellCount(); ++i)
+        appendCell(other.cell(i));
+}
+
 static inline void setRowLogicalHeightToRowStyleLogicalHeightIfNotRelative(RenderTableSection::RowStruct& row)
 {
     ASSERT(row.rowRenderer);
@@ -94,6 +143,8 @@ RenderTableSection::RenderTableSection(Element* element)
     , m_outerBorderAfter(0)
     , m_needsCellRecalc(false)
     , m_hasMultipleCellLevels(false)
+    , m_hasDeferredRows(false)
+    , m_needsLayoutForDeferredRows(false)
 {
     // init RenderObject attributes
     setInline(false); // our object is not Inline
@@ -121,6 +172,14 @@ void RenderTableSection::willBeRemovedFromTree()
     // Preventively invalidate our cells as we may be re-inserted into
     // a new table which would require us to rebuild our structure.
     setNeedsCellRecalc();
+
+    setHasDeferredRows(false);
+}
+
+void RenderTableSection::willBeDestroyed()
+{
+    setHasDeferredRows(false);
+    RenderBox::willBeDestroyed();
 }
 
 void RenderTableSection::addChild(RenderObject* child, RenderObject* beforeChild)
@@ -216,7 +275,7 @@ void RenderTableSection::addCell(RenderTableCell* cell, RenderTableRow* row)
     // <TR><TD>1 <TD rowspan="2">2 <TD>3 <TD>4
     // <TR><TD colspan="2">5
     // </TABLE>
-    while (m_cCol < nCols && (cellAt(insertionRow, m_cCol).hasCells() || cellAt(insertionRow, m_cCol).inColSpan))
+    while (m_cCol < nCols && (cellAt(insertionRow, m_cCol).hasCells() || cellAt(insertionRow, m_cCol).inColSpan()))
         m_cCol++;
 
     updateLogicalHeightForCell(m_grid[insertionRow], cell);
@@ -241,12 +300,12 @@ void RenderTableSection::addCell(RenderTableCell* cell, RenderTableRow* row)
         for (unsigned r = 0; r < rSpan; r++) {
             CellStruct& c = cellAt(insertionRow + r, m_cCol);
             ASSERT(cell);
-            c.cells.append(cell);
+            c.appendCell(cell);
             // If cells overlap then we take the slow path for painting.
-            if (c.cells.size() > 1)
+            if (c.cellCount() > 1)
                 m_hasMultipleCellLevels = true;
             if (inColSpan)
-                c.inColSpan = true;
+                c.setInColSpan(true);
         }
         m_cCol++;
         cSpan -= currentSpan;
@@ -287,9 +346,9 @@ int RenderTableSection::calcRowLogicalHeight()
 
         for (unsigned c = 0; c < totalCols; c++) {
             CellStruct& current = cellAt(r, c);
-            for (unsigned i = 0; i < current.cells.size(); i++) {
-                cell = current.cells[i];
-                if (current.inColSpan && cell->rowSpan() == 1)
+            for (unsigned i = 0; i < current.cellCount(); i++) {
+                cell = current.cell(i);
+                if (current.inColSpan() && cell->rowSpan() == 1)
                     continue;
 
                 // FIXME: We are always adding the height of a rowspan to the last rows which doesn't match
@@ -298,19 +357,19 @@ int RenderTableSection::calcRowLogicalHeight()
                     // We will apply the height of the rowspan to the current row if next row is not valid.
                     if ((r + 1) < totalRows) {
                         unsigned col = 0;
-                        CellStruct nextRowCell = cellAt(r + 1, col);
+                        const CellStruct* nextRowCell = &cellAt(r + 1, col);
 
                         // We are trying to find that next row is valid or not.
-                        while (nextRowCell.cells.size() && nextRowCell.cells[0]->rowSpan() > 1 && nextRowCell.cells[0]->rowIndex() < (r + 1)) {
+                        while (nextRowCell->hasCells() && nextRowCell->cell(0)->rowSpan() > 1 && nextRowCell->cell(0)->rowIndex() < (r + 1)) {
                             col++;
                             if (col < totalCols)
-                                nextRowCell = cellAt(r + 1, col);
+                                nextRowCell = &cellAt(r + 1, col);
                             else
                                 break;
                         }
 
                         // We are adding the height of the rowspan to the current row if next row is not valid.
-                        if (col < totalCols && nextRowCell.cells.size())
+                        if (col < totalCols && nextRowCell->hasCells())
                             continue;
                     }
                 }
@@ -318,7 +377,7 @@ int RenderTableSection::calcRowLogicalHeight()
                 // For row spanning cells, |r| is the last row in the span.
                 unsigned cellStartRow = cell->rowIndex();
 
-                if (cell->hasOverrideHeight()) {
+                if (cell->hasOverrideHeight() && !m_grid[r].layoutDeferred) {
                     if (!statePusher.didPush()) {
                         // Technically, we should also push state for the row, but since
                         // rows don't push a coordinate transform, that's not necessary.
@@ -330,7 +389,7 @@ int RenderTableSection::calcRowLogicalHeight()
                     cell->layoutIfNeeded();
                 }
 
-                int cellLogicalHeight = cell->logicalHeightForRowSizing();
+                int cellLogicalHeight = m_grid[r].layoutDeferred ? cell->logicalHeightForRowSizingWithoutLayout() : cell->logicalHeightForRowSizing();
                 m_rowPos[r + 1] = max(m_rowPos[r + 1], m_rowPos[cellStartRow] + cellLogicalHeight);
 
                 // Find out the baseline. The baseline is set on the first row in a rowspan.
@@ -379,6 +438,17 @@ void RenderTableSection::layout()
 
     const Vector<int>& columnPos = table()->columnPositions();
 
+    // Rows far from the viewport whose height does not depend on their contents are not laid out
+    // until scrolling brings them close, see RenderView::updateDeferredTableRowsNearViewport().
+    bool canDeferRows = !m_needsLayoutForDeferredRows && canDeferRowLayout();
+    m_needsLayoutForDeferredRows = false;
+    int windowTop = 0;
+    int windowBottom = 0;
+    if (canDeferRows)
+        computeRowLayoutWindow(roundToInt(view()->layoutState()->m_paintOffset.height()), windowTop, windowBottom);
+    int rowLogicalTop = table()->vBorderSpacing();
+    bool hasDeferredRows = false;
+
     for (unsigned r = 0; r < m_grid.size(); ++r) {
         Row& row = m_grid[r].row;
         unsigned cols = row.size();
@@ -387,7 +457,7 @@ void RenderTableSection::layout()
         for (unsigned startColumn = 0; startColumn < cols; ++startColumn) {
             CellStruct& current = row[startColumn];
             RenderTableCell* cell = current.primaryCell();
-            if (!cell || current.inColSpan)
+            if (!cell || current.inColSpan())
                 continue;
 
             unsigned endCol = startColumn;
@@ -401,14 +471,168 @@ void RenderTableSection::layout()
             cell->setCellLogicalWidth(tableLayoutLogicalWidth);
         }
 
-        if (RenderTableRow* rowRenderer = m_grid[r].rowRenderer)
-            rowRenderer->layoutIfNeeded();
+        bool layoutRequested = m_grid[r].layoutRequested;
+        m_grid[r].layoutDeferred = false;
+        m_grid[r].layoutRequested = false;
+        RenderTableRow* rowRenderer = m_grid[r].rowRenderer;
+        if (!rowRenderer)
+            continue;
+
+        if (canDeferRows && !layoutRequested && rowRenderer->needsLayout() && rowLayoutCanBeDeferred(r)) {
+            m_grid[r].layoutDeferred = true;
+            int rowLogicalHeight = rowLogicalHeightForLayoutWindow(r);
+            if (rowLogicalTop + rowLogicalHeight <= windowTop || rowLogicalTop >= windowBottom) {
+                rowLogicalTop += rowLogicalHeight;
+                hasDeferredRows = true;
+                continue;
+            }
+            m_grid[r].layoutDeferred = false;
+        }
+
+        rowRenderer->layoutIfNeeded();
+        if (canDeferRows)
+            rowLogicalTop += rowLogicalHeightForLayoutWindow(r);
     }
 
+    if (hasDeferredRows || m_hasDeferredRows)
+        view()->deferredTableRowsChanged();
+    setHasDeferredRows(hasDeferredRows);
+
     statePusher.pop();
     setNeedsLayout(false);
 }
 
+bool RenderTableSection::canDeferRowLayout() const
+{
+    RenderView* renderView = view();
+    if (!renderView->frameView() || renderView->printing() || !renderView->layoutStateEnabled() || renderView->layoutState()->isPaginated())
+        return false;
+
+    if (m_grid.size() < gMinRowCountToDeferRowLayout || m_hasMultipleCellLevels || !isHorizontalWritingMode() || hasTransform())
+        return false;
+
+    // Fixed table layout sizes the columns without looking at the cells, so nothing else in
+    // the table depends on how a deferred row is laid out.
+    RenderTable* table = this->table();
+    return table->style()->tableLayout() == TFIXED && !table->style()->logicalWidth().isAuto() && !table->collapseBorders();
+}
+
+bool RenderTableSection::rowLayoutCanBeDeferred(unsigned rowIndex) const
+{
+    // The row height must be known without laying out the cells, so every cell must be strictly
+    // contained, must not span rows and must not align to the row's baseline.
+    const Row& row = m_grid[rowIndex].row;
+    for (unsigned c = 0; c < row.size(); ++c) {
+        const CellStruct& current = row[c];
+        RenderTableCell* cell = current.primaryCell();
+        if (!cell || current.inColSpan())
+            continue;
+        if (cell->rowSpan() != 1 || !cell->hasLayoutContainment() || cell->isBaselineAligned())
+            return false;
+    }
+    return true;
+}
+
+int RenderTableSection::rowLogicalHeightForLayoutWindow(unsigned rowIndex) const
+{
+    // A cheap version of what calcRowLogicalHeight() computes, ignoring row spans and baselines.
+    // It only decides which rows are close enough to the viewport to be laid out.
+    const RowStruct& rowStruct = m_grid[rowIndex];
+    int logicalHeight = minimumValueForLength(rowStruct.logicalHeight, 0, view()).round();
+    for (unsigned c = 0; c < rowStruct.row.size(); ++c) {
+        const CellStruct& current = rowStruct.row[c];
+        RenderTableCell* cell = current.primaryCell();
+        if (!cell || current.inColSpan() || cell->rowSpan() != 1)
+            continue;
+        logicalHeight = max(logicalHeight, rowStruct.layoutDeferred ? cell->logicalHeightForRowSizingWithoutLayout() : cell->logicalHeightForRowSizing());
+    }
+    return logicalHeight + table()->vBorderSpacing();
+}
+
+void RenderTableSection::computeRowLayoutWindow(int logicalTopInView, int& windowTop, int& windowBottom) const
+{
+    // Keep a viewport's worth of rows laid out on either side of the visible ones, so that
+    // scrolling rarely exposes a row before it has been laid out.
+    IntRect visibleRect = view()->frameView()->visibleContentRect();
+    windowTop = visibleRect.y() - visibleRect.height() - logicalTopInView;
+    windowBottom = visibleRect.maxY() + visibleRect.height() - logicalTopInView;
+}
+
+bool RenderTableSection::hasDeferredRowsNearViewport() const
+{
+    if (!m_hasDeferredRows || !view()->frameView())
+        return false;
+
+    int windowTop;
+    int windowBottom;
+    computeRowLayoutWindow(roundToInt(localToAbsolute().y()), windowTop, windowBottom);
+
+    CellSpan rows = spannedRows(LayoutRect(0, windowTop, logicalWidth(), windowBottom - windowTop));
+    for (unsigned r = rows.start(); r < rows.end(); ++r) {
+        if (m_grid[r].layoutDeferred)
+            return true;
+    }
+    return false;
+}
+
+bool RenderTableSection::rowLayoutIsDeferred(const RenderTableRow* row) const
+{
+    if (!m_hasDeferredRows || m_needsCellRecalc || !row->rowIndexWasSet())
+        return false;
+    unsigned rowIndex = row->rowIndex();
+    return rowIndex < m_grid.size() && m_grid[rowIndex].layoutDeferred;
+}
+
+unsigned RenderTableSection::deferredRowCount() const
+{
+    if (!m_hasDeferredRows)
+        return 0;
+
+    unsigned count = 0;
+    for (unsigned r = 0; r < m_grid.size(); ++r) {
+        if (m_grid[r].layoutDeferred)
+            ++count;
+    }
+    return count;
+}
+
+void RenderTableSection::setNeedsLayoutForDeferredRows()
+{
+    if (!m_hasDeferredRows)
+        return;
+    m_needsLayoutForDeferredRows = true;
+    setNeedsLayout(true);
+}
+
+void RenderTableSection::setNeedsLayoutForDeferredRowContaining(RenderObject* descendant)
+{
+    RenderObject* child = descendant;
+    while (child && child->parent() != this)
+        child = child->parent();
+    if (!child || !child->isTableRow())
+        return;
+
+    RenderTableRow* row = toRenderTableRow(child);
+    if (!rowLayoutIsDeferred(row))
+        return;
+    m_grid[row->rowIndex()].layoutRequested = true;
+    setNeedsLayout(true);
+}
+
+void RenderTableSection::setHasDeferredRows(bool hasDeferredRows)
+{
+    if (m_hasDeferredRows == hasDeferredRows)
+        return;
+
+    m_hasDeferredRows = hasDeferredRows;
+    if (hasDeferredRows)
+        view()->addTableSectionWithDeferredRows(this);
+    else if (RenderView* renderView = view()) {
+        // The view is already gone when the renderers of a document being torn down are destroyed.
+        renderView->removeTableSectionWithDeferredRows(this);
+    }
+}
+
 void RenderTableSection::distributeExtraLogicalHeightToPercentRows(int& extraLogicalHeight, int totalPercent)
 {
     if (!totalPercent)
@@ -537,9 +761,15 @@ void RenderTableSection::layoutRows()
             CellStruct& cs = cellAt(r, c);
             RenderTableCell* cell = cs.primaryCell();
 
-            if (!cell || cs.inColSpan)
+            if (!cell || cs.inColSpan())
                 continue;
 
+            if (m_grid[r].layoutDeferred) {
+                // The cell will be sized and aligned when its row is laid out.
+                setLogicalPositionForCell(cell, c);
+                continue;
+            }
+
             int rowIndex = cell->rowIndex();
             int rHeight = m_rowPos[rowIndex + cell->rowSpan()] - m_rowPos[rowIndex] - vspacing;
 
@@ -642,9 +872,9 @@ void RenderTableSection::layoutRows()
             for (unsigned rowIndex = r + 1; rowIndex <= totalRows; rowIndex++)
                 m_rowPos[rowIndex] += rowHeightIncreaseForPagination;
             for (unsigned c = 0; c < nEffCols; ++c) {
-                Vector<RenderTableCell*, 1>& cells = cellAt(r, c).cells;
-                for (size_t i = 0; i < cells.size(); ++i)
-                    cells[i]->setLogicalHeight(cells[i]->logicalHeight() + rowHeightIncreaseForPagination);
+                const CellStruct& current = cellAt(r, c);
+                for (unsigned i = 0; i < current.cellCount(); ++i)
+                    current.cell(i)->setLogicalHeight(current.cell(i)->logicalHeight() + rowHeightIncreaseForPagination);
             }
         }
     }
@@ -677,10 +907,12 @@ void RenderTableSection::computeOverflowFromCells(unsigned totalRows, unsigned n
 #endif
     // Now that our height has been determined, add in overflow from cells.
     for (unsigned r = 0; r < totalRows; r++) {
+        if (m_grid[r].layoutDeferred)
+            continue;
         for (unsigned c = 0; c < nEffCols; c++) {
             CellStruct& cs = cellAt(r, c);
             RenderTableCell* cell = cs.primaryCell();
-            if (!cell || cs.inColSpan)
+            if (!cell || cs.inColSpan())
                 continue;
             if (r < totalRows - 1 && cell == primaryCellAt(r + 1, c))
                 continue;
@@ -726,7 +958,7 @@ int RenderTableSection::calcOuterBorderBefore() const
     bool allHidden = true;
     for (unsigned c = 0; c < totalCols; c++) {
         const CellStruct& current = cellAt(0, c);
-        if (current.inColSpan || !current.hasCells())
+        if (current.inColSpan() || !current.hasCells())
             continue;
         const BorderValue& cb = current.primaryCell()->style()->borderBefore(); // FIXME: Make this work with perpendicular and flipped cells.
         // FIXME: Don't repeat for the same col group
@@ -777,7 +1009,7 @@ int RenderTableSection::calcOuterBorderAfter() const
     bool allHidden = true;
     for (unsigned c = 0; c < totalCols; c++) {
         const CellStruct& current = cellAt(m_grid.size() - 1, c);
-        if (current.inColSpan || !current.hasCells())
+        if (current.inColSpan() || !current.hasCells())
             continue;
         const BorderValue& cb = current.primaryCell()->style()->borderAfter(); // FIXME: Make this work with perpendicular and flipped cells.
         // FIXME: Don't repeat for the same col group
@@ -1136,6 +1368,8 @@ void RenderTableSection::paintObject(PaintInfo& paintInfo, const LayoutPoint& pa
             } else {
                 // Draw the dirty cells in the order that they appear.
                 for (unsigned r = dirtiedRows.start(); r < dirtiedRows.end(); r++) {
+                    if (m_grid[r].layoutDeferred)
+                        continue;
                     RenderTableRow* row = m_grid[r].rowRenderer;
                     if (row && !row->hasSelfPaintingLayer())
                         row->paintOutlineForRowIfNeeded(paintInfo, paintOffset);
@@ -1163,6 +1397,8 @@ void RenderTableSection::paintObject(PaintInfo& paintInfo, const LayoutPoint& pa
             HashSet<RenderTableCell*> spanningCells;
 
             for (unsigned r = dirtiedRows.start(); r < dirtiedRows.end(); r++) {
+                if (m_grid[r].layoutDeferred)
+                    continue;
                 RenderTableRow* row = m_grid[r].rowRenderer;
                 if (row && !row->hasSelfPaintingLayer())
                     row->paintOutlineForRowIfNeeded(paintInfo, paintOffset);
@@ -1170,16 +1406,17 @@ void RenderTableSection::paintObject(PaintInfo& paintInfo, const LayoutPoint& pa
                     CellStruct& current = cellAt(r, c);
                     if (!current.hasCells())
                         continue;
-                    for (unsigned i = 0; i < current.cells.size(); ++i) {
-                        if (m_overflowingCells.contains(current.cells[i]))
+                    for (unsigned i = 0; i < current.cellCount(); ++i) {
+                        RenderTableCell* cell = current.cell(i);
+                        if (m_overflowingCells.contains(cell))
                             continue;
 
-                        if (current.cells[i]->rowSpan() > 1 || current.cells[i]->colSpan() > 1) {
-                            if (!spanningCells.add(current.cells[i]).isNewEntry)
+                        if (cell->rowSpan() > 1 || cell->colSpan() > 1) {
+                            if (!spanningCells.add(cell).isNewEntry)
                                 continue;
                         }
 
-                        cells.append(current.cells[i]);
+                        cells.append(cell);
                     }
                 }
             }
@@ -1277,7 +1514,7 @@ unsigned RenderTableSection::numColumns() const
     for (unsigned r = 0; r < m_grid.size(); ++r) {
         for (unsigned c = result; c < table()->numEffCols(); ++c) {
             const CellStruct& cell = cellAt(r, c);
-            if (cell.hasCells() || cell.inColSpan)
+            if (cell.hasCells() || cell.inColSpan())
                 result = c;
         }
     }
@@ -1327,17 +1564,12 @@ void RenderTableSection::splitColumn(unsigned pos, unsigned first)
         Row& r = m_grid[row].row;
         r.insert(pos + 1, CellStruct());
         if (r[pos].hasCells()) {
-            r[pos + 1].cells.appendVector(r[pos].cells);
+            r[pos + 1].appendCells(r[pos]);
             RenderTableCell* cell = r[pos].primaryCell();
             ASSERT(cell);
-            ASSERT(cell->colSpan() >= (r[pos].inColSpan ? 1u : 0));
-            unsigned colleft = cell->colSpan() - r[pos].inColSpan;
-            if (first > colleft)
-              r[pos + 1].inColSpan = 0;
-            else
-              r[pos + 1].inColSpan = first + r[pos].inColSpan;
-        } else {
-            r[pos + 1].inColSpan = 0;
+            ASSERT(cell->colSpan() >= (r[pos].inColSpan() ? 1u : 0));
+            unsigned colleft = cell->colSpan() - r[pos].inColSpan();
+            r[pos + 1].setInColSpan(first <= colleft && first + r[pos].inColSpan());
         }
     }
 }
@@ -1384,6 +1616,8 @@ bool RenderTableSection::nodeAtPoint(const HitTestRequest& request, HitTestResul
 
     // Now iterate over the spanned rows and columns.
     for (unsigned hitRow = rowSpan.start(); hitRow < rowSpan.end(); ++hitRow) {
+        if (m_grid[hitRow].layoutDeferred)
+            continue;
         for (unsigned hitColumn = columnSpan.start(); hitColumn < columnSpan.end(); ++hitColumn) {
             CellStruct& current = cellAt(hitRow, hitColumn);
 
@@ -1391,9 +1625,9 @@ bool RenderTableSection::nodeAtPoint(const HitTestRequest& request, HitTestResul
             if (!current.hasCells())
                 continue;
 
-            for (unsigned i = current.cells.size() ; i; ) {
+            for (unsigned i = current.cellCount() ; i; ) {
                 --i;
-                RenderTableCell* cell = current.cells[i];
+                RenderTableCell* cell = current.cell(i);
                 LayoutPoint cellPoint = flipForWritingModeForChild(cell, adjustedLocation);
                 if (static_cast<RenderObject*>(cell)->nodeAtPoint(request, result, locationInContainer, cellPoint, action)) {
                     updateHitTestResult(result, locationInContainer.point() - toLayoutSize(cellPoint));
@@ -83,26 +83,54 @@ public:
 
     RenderTable* table() const { return toRenderTable(parent()); }
 
-    struct CellStruct {
-        Vector<RenderTableCell*, 1> cells; 
-        bool inColSpan; // true for columns after the first in a colspan
-
+    // One slot of the grid. Almost every slot is covered by a single cell, so a slot is one word:
+    // the cell pointer, with the inColSpan flag in its low bit. Only slots where cells overlap
+    // point to a separately allocated vector instead.
+    class CellStruct {
+    public:
         CellStruct()
-            : inColSpan(false)
+            : m_bits(0)
         {
         }
 
-        RenderTableCell* primaryCell()
+        CellStruct(const CellStruct&);
+        ~CellStruct();
+        CellStruct& operator=(const CellStruct&);
+
+        unsigned cellCount() const { return hasCellVector() ? cellVector()->size() : hasCells(); }
+        RenderTableCell* cell(unsigned index) const
         {
-            return hasCells() ? cells[cells.size() - 1] : 0;
+            ASSERT_WITH_SECURITY_IMPLICATION(index < cellCount());
+            return hasCellVector() ? cellVector()->at(index) : singleCell();
         }
 
-        const RenderTableCell* primaryCell() const
+        void appendCell(RenderTableCell*);
+        void appendCells(const CellStruct&);
+
+        RenderTableCell* primaryCell() const
         {
-            return hasCells() ? cells[cells.size() - 1] : 0;
+            return hasCells() ? cell(cellCount() - 1) : 0;
         }
 
-        bool hasCells() const { return cells.size() > 0; }
+        bool hasCells() const { return m_bits & ~FlagMask; }
+
+        // True for columns after the first in a colspan.
+        bool inColSpan() const { return m_bits & InColSpanFlag; }
+        void setInColSpan(bool inColSpan) { m_bits = inColSpan ? (m_bits | InColSpanFlag) : (m_bits & ~InColSpanFlag); }
+
+    private:
+        typedef Vector<RenderTableCell*, 2> CellVector;
+        enum {
+            InColSpanFlag = 1 << 0,
+            CellVectorFlag = 1 << 1,
+            FlagMask = InColSpanFlag | CellVectorFlag
+        };
+
+        bool hasCellVector() const { return m_bits & CellVectorFlag; }
+        RenderTableCell* singleCell() const { return reinterpret_cast<RenderTableCell*>(m_bits & ~FlagMask); }
+        CellVector* cellVector() const { return reinterpret_cast<CellVector*>(m_bits & ~FlagMask); }
+
+        uintptr_t m_bits;
     };
 
     typedef Vector<CellStruct> Row;
@@ -111,6 +139,8 @@ public:
         RowStruct()
             : rowRenderer(0)
             , baseline()
+            , layoutDeferred(false)
+            , layoutRequested(false)
         {
         }
 
@@ -118,6 +148,10 @@ public:
         RenderTableRow* rowRenderer;
         LayoutUnit baseline;
         Length logicalHeight;
+        // The row was left unlaid out because it was far from the viewport, see layout().
+        bool layoutDeferred;
+        // The next layout lays the row out even if it is far from the viewport.
+        bool layoutRequested;
     };
 
     const BorderValue& borderAdjoiningTableStart() const
@@ -144,11 +178,7 @@ public:
 
     CellStruct& cellAt(unsigned row,  unsigned col) { return m_grid[row].row[col]; }
     const CellStruct& cellAt(unsigned row, unsigned col) const { return m_grid[row].row[col]; }
-    RenderTableCell* primaryCellAt(unsigned row, unsigned col)
-    {
-        CellStruct& c = m_grid[row].row[col];
-        return c.primaryCell();
-    }
+    RenderTableCell* primaryCellAt(unsigned row, unsigned col) const { return m_grid[row].row[col].primaryCell(); }
 
     RenderTableRow* rowRendererAt(unsigned row) const { return m_grid[row].rowRenderer; }
 
@@ -198,6 +228,15 @@ public:
     
     virtual void paint(PaintInfo&, const LayoutPoint&) OVERRIDE;
 
+    bool hasDeferredRows() const { return m_hasDeferredRows; }
+    bool hasDeferredRowsNearViewport() const;
+    bool rowLayoutIsDeferred(const RenderTableRow*) const;
+    unsigned deferredRowCount() const;
+    // The next layout lays out every row, wherever it is.
+    void setNeedsLayoutForDeferredRows();
+    // The next layout lays out the row holding the renderer, if that row is deferred.
+    void setNeedsLayoutForDeferredRowContaining(RenderObject*);
+
 protected:
     virtual void styleDidChange(StyleDifference, const RenderStyle* oldStyle);
 
@@ -210,6 +249,7 @@ private:
     virtual bool isTableSection() const { return true; }
 
     virtual void willBeRemovedFromTree() OVERRIDE;
+    virtual void willBeDestroyed() OVERRIDE;
 
     virtual void layout();
 
@@ -222,6 +262,12 @@ private:
 
     void ensureRows(unsigned);
 
+    bool canDeferRowLayout() const;
+    bool rowLayoutCanBeDeferred(unsigned row) const;
+    int rowLogicalHeightForLayoutWindow(unsigned row) const;
+    void computeRowLayoutWindow(int logicalTopInView, int& windowTop, int& windowBottom) const;
+    void setHasDeferredRows(bool);
+
     void distributeExtraLogicalHeightToPercentRows(int& extraLogicalHeight, int totalPercent);
     void distributeExtraLogicalHeightToAutoRows(int& extraLogicalHeight, unsigned autoRowsCount);
     void distributeRemainingExtraLogicalHeight(int& extraLogicalHeight);
@@ -269,6 +315,9 @@ private:
 
     bool m_hasMultipleCellLevels;
 
+    bool m_hasDeferredRows;
+    bool m_needsLayoutForDeferredRows;
+
     // This map holds the collapsed border values for cells with collapsed borders.
     // It is held at RenderTableSection level to spare memory consumption by table cells.
     HashMap<pair<const RenderTableCell*, int>, CollapsedBorderValue > m_cellsCollapsedBorders;
@@ -291,4 +340,11 @@ void toRenderTableSection(const RenderTableSection*);
 
 } // namespace WebCore
 
+namespace WTF {
+
+// A CellStruct is a tagged pointer that is null when empty, so it can be zero-initialized and moved with memcpy.
+template<> struct VectorTraits<WebCore::RenderTableSection::CellStruct> : SimpleClassVectorTraits { };
+
+} // namespace WTF
+
 #endif // RenderTableSection_h
@@ -223,13 +223,13 @@ void RenderText::styleDidChange(StyleDifference diff, const RenderStyle* oldStyl
 void RenderText::removeAndDestroyTextBoxes()
 {
     if (!documentBeingDestroyed()) {
-        if (firstTextBox()) {
+        if (m_firstTextBox) {
             if (isBR()) {
-                RootInlineBox* next = firstTextBox()->root()->nextRootBox();
+                RootInlineBox* next = m_firstTextBox->root()->nextRootBox();
                 if (next)
                     next->markDirty();
             }
-            for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
+            for (InlineTextBox* box = m_firstTextBox; box; box = box->nextTextBox())
                 box->remove();
         } else if (parent())
             parent()->dirtyLinesFromChangedChild(this);
@@ -297,12 +297,26 @@ void RenderText::removeTextBox(InlineTextBox* box)
     checkConsistency();
 }
 
+const SimpleLineLayout::Layout* RenderText::simpleLineLayout() const
+{
+    RenderObject* parent = this->parent();
+    if (!parent || !parent->isRenderBlock() || parent->firstChild() != this || parent->lastChild() != this)
+        return 0;
+    return toRenderBlock(parent)->simpleLineLayout();
+}
+
+void RenderText::ensureLineBoxes()
+{
+    if (simpleLineLayout())
+        toRenderBlock(parent())->ensureLineBoxes();
+}
+
 void RenderText::deleteTextBoxes()
 {
-    if (firstTextBox()) {
+    if (m_firstTextBox) {
         RenderArena* arena = renderArena();
         InlineTextBox* next;
-        for (InlineTextBox* curr = firstTextBox(); curr; curr = next) {
+        for (InlineTextBox* curr = m_firstTextBox; curr; curr = next) {
             next = curr->nextTextBox();
             curr->destroy(arena);
         }
@@ -318,6 +332,12 @@ PassRefPtr<StringImpl> RenderText::originalText() const
 
 void RenderText::absoluteRects(Vector<IntRect>& rects, const LayoutPoint& accumulatedOffset) const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        Vector<FloatRect> runRects = SimpleLineLayout::collectTextRunRects(toRenderBlock(parent()), *layout);
+        for (size_t i = 0; i < runRects.size(); ++i)
+            rects.append(enclosingIntRect(FloatRect(accumulatedOffset + runRects[i].location(), runRects[i].size())));
+        return;
+    }
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
         rects.append(enclosingIntRect(FloatRect(accumulatedOffset + box->topLeft(), box->size())));
 }
@@ -354,7 +374,9 @@ void RenderText::absoluteRectsForRange(Vector<IntRect>& rects, unsigned start, u
     ASSERT(start <= INT_MAX);
     start = min(start, static_cast<unsigned>(INT_MAX));
     end = min(end, static_cast<unsigned>(INT_MAX));
-    
+
+    ensureLineBoxes();
+
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         // Note: box->end() returns the index of the last character, not the index past it
         if (start <= box->start() && box->end() < end) {
@@ -405,6 +427,14 @@ static IntRect ellipsisRectForBox(InlineTextBox* box, unsigned startPos, unsigne
     
 void RenderText::absoluteQuads(Vector<FloatQuad>& quads, bool* wasFixed, ClippingOption option) const
 {
+    // Blocks are only laid out with SimpleLineLayout when nothing is truncated.
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        Vector<FloatRect> runRects = SimpleLineLayout::collectTextRunRects(toRenderBlock(parent()), *layout);
+        for (size_t i = 0; i < runRects.size(); ++i)
+            quads.append(localToAbsoluteQuad(runRects[i], 0, wasFixed));
+        return;
+    }
+
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         FloatRect boundaries = box->calculateBoundaries();
 
@@ -437,7 +467,9 @@ void RenderText::absoluteQuadsForRange(Vector<FloatQuad>& quads, unsigned start,
     ASSERT(start <= INT_MAX);
     start = min(start, static_cast<unsigned>(INT_MAX));
     end = min(end, static_cast<unsigned>(INT_MAX));
-    
+
+    ensureLineBoxes();
+
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         // Note: box->end() returns the index of the last character, not the index past it
         if (start <= box->start() && box->end() < end) {
@@ -612,6 +644,8 @@ static VisiblePosition createVisiblePositionAfterAdjustingOffsetForBiDi(const In
 
 VisiblePosition RenderText::positionForPoint(const LayoutPoint& point)
 {
+    ensureLineBoxes();
+
     if (!firstTextBox() || textLength() == 0)
         return createVisiblePosition(0, DOWNSTREAM);
 
@@ -1216,16 +1250,26 @@ FloatPoint RenderText::firstRunOrigin() const
 
 float RenderText::firstRunX() const
 {
+    const SimpleLineLayout::Layout* layout = simpleLineLayout();
+    if (layout && !layout->runs().isEmpty())
+        return SimpleLineLayout::collectTextRunRects(toRenderBlock(parent()), *layout).first().x();
     return m_firstTextBox ? m_firstTextBox->x() : 0;
 }
 
 float RenderText::firstRunY() const
 {
+    const SimpleLineLayout::Layout* layout = simpleLineLayout();
+    if (layout && !layout->runs().isEmpty())
+        return SimpleLineLayout::collectTextRunRects(toRenderBlock(parent()), *layout).first().y();
     return m_firstTextBox ? m_firstTextBox->y() : 0;
 }
     
 void RenderText::setSelectionState(SelectionState state)
 {
+    // Selections are painted by the text boxes.
+    if (state != SelectionNone)
+        ensureLineBoxes();
+
     RenderObject::setSelectionState(state);
 
     if (canUpdateSelectionOnRootLineBoxes()) {
@@ -1279,7 +1323,7 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
     bool dirtiedLines = false;
 
     // Dirty all text boxes that include characters in between offset and offset+len.
-    for (InlineTextBox* curr = firstTextBox(); curr; curr = curr->nextTextBox()) {
+    for (InlineTextBox* curr = m_firstTextBox; curr; curr = curr->nextTextBox()) {
         // FIXME: This shouldn't rely on the end of a dirty line box. See https://bugs.webkit.org/show_bug.cgi?id=97264
         // Text run is entirely before the affected range.
         if (curr->end() < offset)
@@ -1322,9 +1366,9 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
         RootInlineBox* prev = firstRootBox->prevRootBox();
         if (prev)
             firstRootBox = prev;
-    } else if (lastTextBox()) {
+    } else if (m_lastTextBox) {
         ASSERT(!lastRootBox);
-        firstRootBox = lastTextBox()->root();
+        firstRootBox = m_lastTextBox->root();
         firstRootBox->markDirty();
         dirtiedLines = true;
     }
@@ -1334,7 +1378,7 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
     }
 
     // If the text node is empty, dirty the line where new text will be inserted.
-    if (!firstTextBox() && parent()) {
+    if (!m_firstTextBox && parent()) {
         parent()->dirtyLinesFromChangedChild(this);
         dirtiedLines = true;
     }
@@ -1486,7 +1530,7 @@ void RenderText::dirtyLineBoxes(bool fullLayout)
     if (fullLayout)
         deleteTextBoxes();
     else if (!m_linesDirty) {
-        for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
+        for (InlineTextBox* box = m_firstTextBox; box; box = box->nextTextBox())
             box->dirtyLineBoxes();
     }
     m_linesDirty = false;
@@ -1582,6 +1626,9 @@ float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos,
 
 IntRect RenderText::linesBoundingBox() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return SimpleLineLayout::computeTextBoundingBox(toRenderBlock(parent()), *layout);
+
     IntRect result;
     
     ASSERT(!firstTextBox() == !lastTextBox());  // Either both are null or both exist.
@@ -1610,6 +1657,10 @@ IntRect RenderText::linesBoundingBox() const
 
 LayoutRect RenderText::linesVisualOverflowBoundingBox() const
 {
+    // Text without shadows or decorations has no visual overflow outside its text boxes.
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return SimpleLineLayout::computeTextBoundingBox(toRenderBlock(parent()), *layout);
+
     if (!firstTextBox())
         return LayoutRect();
 
@@ -1695,6 +1746,8 @@ LayoutRect RenderText::selectionRectForRepaint(const RenderLayerModelObject* rep
 
 int RenderText::caretMinOffset() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return SimpleLineLayout::findCaretMinimumOffset(*layout);
     InlineTextBox* box = firstTextBox();
     if (!box)
         return 0;
@@ -1706,6 +1759,8 @@ int RenderText::caretMinOffset() const
 
 int RenderText::caretMaxOffset() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return SimpleLineLayout::findCaretMaximumOffset(*layout);
     InlineTextBox* box = lastTextBox();
     if (!lastTextBox())
         return textLength();
@@ -1718,6 +1773,8 @@ int RenderText::caretMaxOffset() const
 
 unsigned RenderText::renderedTextLength() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return SimpleLineLayout::computeTextRenderedLength(*layout);
     int l = 0;
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
         l += box->len();
@@ -31,6 +31,10 @@ namespace WebCore {
 
 class InlineTextBox;
 
+namespace SimpleLineLayout {
+class Layout;
+}
+
 class RenderText : public RenderObject {
 public:
     RenderText(Node*, PassRefPtr<StringImpl>);
@@ -113,6 +117,11 @@ public:
     InlineTextBox* firstTextBox() const { return m_firstTextBox; }
     InlineTextBox* lastTextBox() const { return m_lastTextBox; }
 
+    // The containing block may have been laid out with SimpleLineLayout, which creates no text boxes.
+    // Code that walks the text boxes outside of layout and painting must call ensureLineBoxes() first.
+    const SimpleLineLayout::Layout* simpleLineLayout() const;
+    void ensureLineBoxes();
+
     virtual int caretMinOffset() const;
     virtual int caretMaxOffset() const;
     virtual unsigned renderedTextLength() const;
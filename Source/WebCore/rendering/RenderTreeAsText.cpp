@@ -248,7 +248,7 @@ void RenderTreeAsText::writeRenderObject(TextStream& ts, const RenderObject& o,
         const RenderText& text = *toRenderText(&o);
         IntRect linesBox = text.linesBoundingBox();
         r = IntRect(text.firstRunX(), text.firstRunY(), linesBox.width(), linesBox.height());
-        if (adjustForTableCells && !text.firstTextBox())
+        if (adjustForTableCells && !text.firstTextBox() && !text.simpleLineLayout())
             adjustForTableCells = false;
     } else if (o.isRenderInline()) {
         // FIXME: Would be better not to just dump 0, 0 as the x and y here.
@@ -564,6 +564,10 @@ void write(TextStream& ts, const RenderObject& o, int indent, RenderAsTextBehavi
     }
 #endif
 
+    // The dump lists text runs, so blocks using the simple line layout have to build their line boxes first.
+    if (o.isText())
+        const_cast<RenderText*>(toRenderText(&o))->ensureLineBoxes();
+
     writeIndent(ts, indent);
 
     RenderTreeAsText::writeRenderObject(ts, o, behavior);
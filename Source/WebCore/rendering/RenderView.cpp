@@ -34,11 +34,14 @@
 #include "HTMLIFrameElement.h"
 #include "HitTestResult.h"
 #include "Page.h"
+#include "CachedImage.h"
 #include "RenderGeometryMap.h"
+#include "RenderImage.h"
 #include "RenderLayer.h"
 #include "RenderLayerBacking.h"
 #include "RenderNamedFlowThread.h"
 #include "RenderSelectionInfo.h"
+#include "RenderTableSection.h"
 #include "RenderWidget.h"
 #include "RenderWidgetProtector.h"
 #include "StyleInheritedData.h"
@@ -63,6 +66,7 @@ RenderView::RenderView(Document* document)
     , m_selectionStartPos(-1)
     , m_selectionEndPos(-1)
     , m_maximalOutlineSize(0)
+    , m_deferredTableRowsVersion(1)
     , m_pageLogicalHeight(0)
     , m_pageLogicalHeightChanged(false)
     , m_layoutState(0)
@@ -951,6 +955,97 @@ void RenderView::removeWidget(RenderWidget* o)
     m_widgets.remove(o);
 }
 
+void RenderView::addTableSectionWithDeferredRows(RenderTableSection* section)
+{
+    m_tableSectionsWithDeferredRows.add(section);
+    deferredTableRowsChanged();
+}
+
+void RenderView::removeTableSectionWithDeferredRows(RenderTableSection* section)
+{
+    m_tableSectionsWithDeferredRows.remove(section);
+    deferredTableRowsChanged();
+}
+
+void RenderView::updateDeferredTableRowsNearViewport()
+{
+    if (m_tableSectionsWithDeferredRows.isEmpty())
+        return;
+
+    Vector<RenderTableSection*> sectionsToLayout;
+    HashSet<RenderTableSection*>::const_iterator end = m_tableSectionsWithDeferredRows.end();
+    for (HashSet<RenderTableSection*>::const_iterator it = m_tableSectionsWithDeferredRows.begin(); it != end; ++it) {
+        RenderTableSection* section = *it;
+        if (!section->needsLayout() && section->hasDeferredRowsNearViewport())
+            sectionsToLayout.append(section);
+    }
+
+    // Marking a section schedules a layout, which lays out the rows that are now close to the viewport.
+    for (size_t i = 0; i < sectionsToLayout.size(); ++i)
+        sectionsToLayout[i]->setNeedsLayout(true);
+}
+
+unsigned RenderView::deferredTableRowCount() const
+{
+    unsigned count = 0;
+    HashSet<RenderTableSection*>::const_iterator end = m_tableSectionsWithDeferredRows.end();
+    for (HashSet<RenderTableSection*>::const_iterator it = m_tableSectionsWithDeferredRows.begin(); it != end; ++it)
+        count += (*it)->deferredRowCount();
+    return count;
+}
+
+void RenderView::setNeedsLayoutForDeferredTableRows(RenderObject* renderer)
+{
+    Vector<RenderTableSection*> sections;
+    copyToVector(m_tableSectionsWithDeferredRows, sections);
+    for (size_t i = 0; i < sections.size(); ++i) {
+        RenderTableSection* section = sections[i];
+        if (section->isDescendantOf(renderer))
+            section->setNeedsLayoutForDeferredRows();
+        else if (renderer->isDescendantOf(section))
+            section->setNeedsLayoutForDeferredRowContaining(renderer);
+    }
+}
+
+void RenderView::addLoadingImage(RenderImage* image)
+{
+    m_loadingImages.add(image);
+}
+
+void RenderView::removeLoadingImage(RenderImage* image)
+{
+    m_loadingImages.remove(image);
+}
+
+void RenderView::promoteLoadingImagesInViewport()
+{
+    if (m_loadingImages.isEmpty() || !m_frameView)
+        return;
+
+    IntRect visibleRect = m_frameView->visibleContentRect();
+    Vector<RenderImage*> imagesToRemove;
+    Vector<CachedImage*> imagesToPromote;
+    HashSet<RenderImage*>::const_iterator end = m_loadingImages.end();
+    for (HashSet<RenderImage*>::const_iterator it = m_loadingImages.begin(); it != end; ++it) {
+        RenderImage* image = *it;
+        CachedImage* cachedImage = image->cachedImage();
+        if (!cachedImage || !cachedImage->isLoading() || cachedImage->loadPriority() >= ResourceLoadPriorityMedium) {
+            imagesToRemove.append(image);
+            continue;
+        }
+        if (!image->needsLayout() && image->absoluteBoundingBoxRect().intersects(visibleRect)) {
+            imagesToRemove.append(image);
+            imagesToPromote.append(cachedImage);
+        }
+    }
+
+    for (size_t i = 0; i < imagesToRemove.size(); ++i)
+        m_loadingImages.remove(imagesToRemove[i]);
+    // The scheduler starts the promoted loads from a timer, so this is safe during layout and scrolling.
+    for (size_t i = 0; i < imagesToPromote.size(); ++i)
+        imagesToPromote[i]->setLoadPriority(ResourceLoadPriorityMedium);
+}
+
 void RenderView::notifyWidgets(WidgetNotification notification)
 {
     Vector<RenderWidget*> renderWidgets;
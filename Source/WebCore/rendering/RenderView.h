@@ -31,7 +31,9 @@
 namespace WebCore {
 
 class FlowThreadController;
+class RenderImage;
 class RenderQuote;
+class RenderTableSection;
 class RenderWidget;
 
 #if USE(ACCELERATED_COMPOSITING)
@@ -115,6 +117,25 @@ public:
     
     void notifyWidgets(WidgetNotification);
 
+    // Large table sections leave rows far from the viewport unlaid out until scrolling or resizing
+    // brings them close, or until script asks for geometry.
+    void addTableSectionWithDeferredRows(RenderTableSection*);
+    void removeTableSectionWithDeferredRows(RenderTableSection*);
+    bool hasTableSectionsWithDeferredRows() const { return !m_tableSectionsWithDeferredRows.isEmpty(); }
+    void updateDeferredTableRowsNearViewport();
+    unsigned deferredTableRowCount() const;
+    // Makes the next layout lay out the deferred rows that hold the renderer or lie inside it.
+    void setNeedsLayoutForDeferredTableRows(RenderObject*);
+    // Changes whenever the set of deferred rows may have changed, so callers can cache what they derive from it.
+    unsigned deferredTableRowsVersion() const { return m_deferredTableRowsVersion; }
+    void deferredTableRowsChanged() { ++m_deferredTableRowsVersion; }
+
+    // Images that are still loading at a low priority. Those that come into the viewport are
+    // raised to a higher load priority, so they load ahead of the images that are off screen.
+    void addLoadingImage(RenderImage*);
+    void removeLoadingImage(RenderImage*);
+    void promoteLoadingImagesInViewport();
+
     // layoutDelta is used transiently during layout to store how far an object has moved from its
     // last layout location, in order to repaint correctly.
     // If we're doing a full repaint m_layoutState will be 0, but in that case layoutDelta doesn't matter.
@@ -324,6 +345,10 @@ protected:
     typedef HashSet<RenderWidget*> RenderWidgetSet;
     RenderWidgetSet m_widgets;
 
+    HashSet<RenderTableSection*> m_tableSectionsWithDeferredRows;
+    unsigned m_deferredTableRowsVersion;
+    HashSet<RenderImage*> m_loadingImages;
+
 private:
     bool shouldUsePrintingLayout() const;
 
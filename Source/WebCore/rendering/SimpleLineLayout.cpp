@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SimpleLineLayout.h"
+
+#include "AXObjectCache.h"
+#include "Document.h"
+#include "DocumentMarkerController.h"
+#include "DocumentStyleSheetCollection.h"
+#include "Font.h"
+#include "Frame.h"
+#include "GraphicsContext.h"
+#include "HitTestLocation.h"
+#include "HitTestRequest.h"
+#include "HitTestResult.h"
+#include "InlineTextBox.h"
+#include "LayoutState.h"
+#include "Page.h"
+#include "PaintInfo.h"
+#include "RenderBlock.h"
+#include "RenderStyle.h"
+#include "RenderText.h"
+#include "RenderView.h"
+#include "TextBreakIterator.h"
+#include "break_lines.h"
+#include <wtf/unicode/CharacterNames.h>
+
+namespace WebCore {
+namespace SimpleLineLayout {
+
+static inline bool isWhitespace(UChar character)
+{
+    // Matches the characters the full line layout collapses when white-space is 'normal'.
+    return character == ' ' || character == '\t' || character == '\n';
+}
+
+static bool canUseForText(const RenderText* textRenderer, const Font& font)
+{
+    if (!textRenderer->canUseSimpleFontCodePath())
+        return false;
+
+    unsigned length = textRenderer->textLength();
+    for (unsigned i = 0; i < length; ++i) {
+        UChar character = textRenderer->characterAt(i);
+        if (isWhitespace(character))
+            continue;
+        if (character == softHyphen)
+            return false;
+        if (U16_IS_SURROGATE(character))
+            return false;
+        // Anything that would make the bidi resolver produce more than one run.
+        if (character >= 0x0590) {
+            WTF::Unicode::Direction direction = WTF::Unicode::direction(character);
+            if (direction == WTF::Unicode::RightToLeft || direction == WTF::Unicode::RightToLeftArabic
+                || direction == WTF::Unicode::RightToLeftEmbedding || direction == WTF::Unicode::RightToLeftOverride
+                || direction == WTF::Unicode::LeftToRightEmbedding || direction == WTF::Unicode::LeftToRightOverride
+                || direction == WTF::Unicode::PopDirectionalFormat)
+                return false;
+        }
+        // Glyphs from fallback fonts can make the line taller than the strut.
+        if (!font.primaryFontHasGlyphForCharacter(character))
+            return false;
+    }
+    return true;
+}
+
+bool canUseFor(const RenderBlock* flow)
+{
+    if (!flow->childrenInline() || !flow->isBlockFlow())
+        return false;
+    RenderObject* child = flow->firstChild();
+    if (!child || child != flow->lastChild() || !child->isText())
+        return false;
+    const RenderText* textRenderer = toRenderText(child);
+    if (textRenderer->isBR() || textRenderer->isCounter() || textRenderer->isQuote() || textRenderer->isCombineText()
+        || textRenderer->isTextFragment() || textRenderer->isWordBreak() || textRenderer->isSVGInlineText())
+        return false;
+    if (!textRenderer->textLength() || textRenderer->isAllCollapsibleWhitespace())
+        return false;
+    if (textRenderer->selectionState() != RenderObject::SelectionNone)
+        return false;
+    // Document markers (spelling, grammar, text matches) are painted by InlineTextBox.
+    if (textRenderer->node() && flow->document()->markers()->hasMarkers(textRenderer->node()))
+        return false;
+
+    if (flow->isRubyBase() || flow->isRubyText() || flow->isListItem())
+        return false;
+    if (flow->hasColumns() || flow->containsFloats() || flow->flowThreadContainingBlock())
+        return false;
+    if (flow->hasOverflowClip())
+        return false;
+    // -webkit-line-clamp counts line boxes.
+    if (flow->parent() && flow->parent()->isDeprecatedFlexibleBox())
+        return false;
+#if ENABLE(CSS_SHAPES)
+    if (flow->shapeInsideInfo())
+        return false;
+#endif
+    LayoutState* layoutState = flow->view()->layoutState();
+    if (layoutState && (layoutState->isPaginated() || layoutState->lineGrid()))
+        return false;
+
+    Document* document = flow->document();
+    if (document->printing())
+        return false;
+    if (document->styleSheetCollection()->usesFirstLineRules() || document->styleSheetCollection()->usesFirstLetterRules())
+        return false;
+    if (AXObjectCache::accessibilityEnabled())
+        return false;
+
+    RenderStyle* style = flow->style();
+    if (!style->isHorizontalWritingMode() || !style->isLeftToRightDirection() || style->unicodeBidi() != UBNormal || style->rtlOrdering() != LogicalOrder)
+        return false;
+    if (style->whiteSpace() != NORMAL || style->wordBreak() != NormalWordBreak || style->overflowWrap() != NormalOverflowWrap
+        || style->lineBreak() != LineBreakAuto || style->nbspMode() != NBNORMAL || style->hyphens() == HyphensAuto)
+        return false;
+    if (style->textAlign() == JUSTIFY)
+        return false;
+    if (!style->textIndent().isZero() || style->letterSpacing() || style->wordSpacing())
+        return false;
+    if (style->textDecorationsInEffect() != TDNONE || style->textShadow() || style->textStrokeWidth() > 0
+        || style->textEmphasisMark() != TextEmphasisMarkNone || style->textSecurity() != TSNONE || style->hasTextCombine())
+        return false;
+    if (style->textOverflow() || (flow->isAnonymousBlock() && flow->parent() && flow->parent()->style()->textOverflow()))
+        return false;
+    if (style->userModify() != READ_ONLY || style->lineBoxContain() != RenderStyle::initialLineBoxContain() || !style->lineGrid().isNull())
+        return false;
+    if (style->hasOutline())
+        return false;
+
+    const Font& font = style->font();
+    if (font.typesettingFeatures() || font.primaryFont()->isSVGFont())
+        return false;
+
+    return canUseForText(textRenderer, font);
+}
+
+static unsigned skipWhitespace(const RenderText* textRenderer, unsigned position, unsigned length)
+{
+    for (; position < length; ++position) {
+        if (!isWhitespace(textRenderer->characterAt(position)))
+            break;
+    }
+    return position;
+}
+
+// Returns the end of the word starting at the given position, which is the next whitespace
+// character or the next line break opportunity inside a run of non-whitespace characters.
+static unsigned findWordEnd(const RenderText* textRenderer, LazyLineBreakIterator& lineBreakIterator, int& nextBreakable, unsigned position, unsigned length)
+{
+    for (++position; position < length; ++position) {
+        if (isWhitespace(textRenderer->characterAt(position)) || isBreakable(lineBreakIterator, position, nextBreakable, false))
+            break;
+    }
+    return position;
+}
+
+static float computeLineLeftOffset(ETextAlign textAlign, float availableWidth, float lineWidth)
+{
+    // Wide lines spill out of the right side of the block, as they do in the full line layout.
+    float remainingWidth = availableWidth - lineWidth;
+    switch (textAlign) {
+    case RIGHT:
+    case WEBKIT_RIGHT:
+    case TAEND:
+        return std::max<float>(remainingWidth, 0);
+    case CENTER:
+    case WEBKIT_CENTER:
+        return std::max<float>(remainingWidth / 2, 0);
+    case LEFT:
+    case WEBKIT_LEFT:
+    case TASTART:
+    case JUSTIFY:
+        break;
+    }
+    return 0;
+}
+
+Layout::Layout(LayoutUnit top, LayoutUnit lineHeight, int baseline)
+    : m_lineCount(0)
+    , m_top(top)
+    , m_lineHeight(lineHeight)
+    , m_baseline(baseline)
+{
+}
+
+PassOwnPtr<Layout> Layout::create(const RenderBlock* flow)
+{
+    ASSERT(canUseFor(flow));
+
+    RenderText* textRenderer = toRenderText(flow->firstChild());
+    RenderStyle* style = flow->style();
+    const Font& font = style->font();
+
+    LayoutUnit top = flow->borderAndPaddingBefore();
+    LayoutUnit lineHeight = flow->lineHeight(false, HorizontalLine, PositionOfInteriorLineBoxes);
+    int baseline = flow->baselinePosition(AlphabeticBaseline, false, HorizontalLine, PositionOfInteriorLineBoxes);
+    OwnPtr<Layout> layout = adoptPtr(new Layout(top, lineHeight, baseline));
+
+    // Without floats, shapes or text-indent every line has the same horizontal extent. Breaking
+    // uses the unsnapped width while placement uses the snapped edges, like the full line layout.
+    float availableWidth = flow->availableLogicalWidthForLine(top, false);
+    float lineLeft = flow->pixelSnappedLogicalLeftOffsetForLine(top, false);
+    float lineRight = flow->pixelSnappedLogicalRightOffsetForLine(top, false);
+    ETextAlign textAlign = style->textAlign();
+
+    unsigned length = textRenderer->textLength();
+    LazyLineBreakIterator lineBreakIterator(textRenderer->text(), style->locale());
+    int nextBreakable = -1;
+
+    unsigned lineIndex = 0;
+    unsigned wordStart = skipWhitespace(textRenderer, 0, length);
+    while (wordStart < length) {
+        size_t firstRunInLine = layout->m_runs.size();
+        unsigned wordEnd = findWordEnd(textRenderer, lineBreakIterator, nextBreakable, wordStart, length);
+        // The first word always goes on the line, even when it overflows.
+        float lineWidth = textRenderer->width(wordStart, wordEnd - wordStart, font, 0);
+        unsigned runStart = wordStart;
+        float runLeft = 0;
+
+        while (wordEnd < length) {
+            unsigned nextWordStart = skipWhitespace(textRenderer, wordEnd, length);
+            if (nextWordStart == length)
+                break;
+            unsigned nextWordEnd = findWordEnd(textRenderer, lineBreakIterator, nextBreakable, nextWordStart, length);
+            unsigned whitespaceLength = nextWordStart - wordEnd;
+
+            // A single whitespace character is measured together with the word that follows it.
+            // Longer runs collapse to their first character, which is measured on its own.
+            float spaceWidth = 0;
+            float nextWidth;
+            if (whitespaceLength <= 1)
+                nextWidth = textRenderer->width(wordEnd, nextWordEnd - wordEnd, font, lineWidth);
+            else {
+                spaceWidth = textRenderer->width(wordEnd, 1, font, lineWidth);
+                nextWidth = spaceWidth + textRenderer->width(nextWordStart, nextWordEnd - nextWordStart, font, lineWidth + spaceWidth);
+            }
+            if (lineWidth + nextWidth > availableWidth)
+                break;
+
+            if (whitespaceLength > 1) {
+                layout->m_runs.append(Run(runStart, wordEnd + 1, runLeft, lineWidth + spaceWidth, lineIndex));
+                runStart = nextWordStart;
+                runLeft = lineWidth + spaceWidth;
+            }
+            lineWidth += nextWidth;
+            wordEnd = nextWordEnd;
+        }
+        layout->m_runs.append(Run(runStart, wordEnd, runLeft, lineWidth, lineIndex));
+
+        float offset = lineLeft + computeLineLeftOffset(textAlign, lineRight - lineLeft, lineWidth);
+        for (size_t i = firstRunInLine; i < layout->m_runs.size(); ++i) {
+            layout->m_runs[i].left += offset;
+            layout->m_runs[i].right += offset;
+        }
+
+        ++lineIndex;
+        wordStart = skipWhitespace(textRenderer, wordEnd, length);
+    }
+    layout->m_lineCount = lineIndex;
+    layout->m_runs.shrinkToFit();
+
+    return layout.release();
+}
+
+static FloatRect computeRunTextRect(const Layout& layout, const Run& run, const FontMetrics& fontMetrics)
+{
+    LayoutUnit lineTop = layout.lineTop(run.lineIndex);
+    return FloatRect(run.left, lineTop + layout.baseline() - fontMetrics.ascent(), run.right - run.left, fontMetrics.height());
+}
+
+int computeFlowFirstLineBaseline(const RenderBlock*, const Layout& layout)
+{
+    ASSERT(layout.lineCount());
+    return layout.lineTop(0) + layout.baseline();
+}
+
+int computeFlowLastLineBaseline(const RenderBlock*, const Layout& layout)
+{
+    ASSERT(layout.lineCount());
+    return layout.lineTop(layout.lineCount() - 1) + layout.baseline();
+}
+
+void collectFlowOverflow(RenderBlock* flow, const Layout& layout)
+{
+    const FontMetrics& fontMetrics = flow->style()->fontMetrics();
+    const Vector<Run>& runs = layout.runs();
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Run& run = runs[i];
+        FloatRect lineRect(run.left, layout.lineTop(run.lineIndex), run.right - run.left, layout.lineHeight());
+        flow->addLayoutOverflow(enclosingLayoutRect(lineRect));
+        lineRect.unite(computeRunTextRect(layout, run, fontMetrics));
+        flow->addVisualOverflow(enclosingLayoutRect(lineRect));
+    }
+}
+
+void paintFlow(const RenderBlock* flow, const Layout& layout, PaintInfo& paintInfo, const LayoutPoint& paintOffset)
+{
+    if (paintInfo.phase != PaintPhaseForeground && paintInfo.phase != PaintPhaseTextClip)
+        return;
+
+    RenderText* textRenderer = toRenderText(flow->firstChild());
+    RenderStyle* style = flow->style();
+    if (style->visibility() != VISIBLE || !paintInfo.shouldPaintWithinRoot(textRenderer))
+        return;
+
+    // The layout is only valid for the text it was built from.
+    ASSERT(layout.runs().isEmpty() || layout.runs().last().end <= textRenderer->textLength());
+    if (!layout.runs().isEmpty() && layout.runs().last().end > textRenderer->textLength())
+        return;
+
+    GraphicsContext* context = paintInfo.context;
+    const Font& font = style->font();
+    const FontMetrics& fontMetrics = font.fontMetrics();
+
+    Color textFillColor = paintInfo.forceBlackText() ? Color::black : style->visitedDependentColor(CSSPropertyWebkitTextFillColor);
+    updateGraphicsContext(context, textFillColor, textFillColor, 0, style->colorSpace());
+
+    Page* page = paintInfo.phase == PaintPhaseForeground && flow->frame() ? flow->frame()->page() : 0;
+    LayoutPoint adjustedPaintOffset = roundedIntPoint(paintOffset);
+    LayoutRect paintRect = paintInfo.rect;
+
+    const Vector<Run>& runs = layout.runs();
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Run& run = runs[i];
+        FloatRect boxRect = computeRunTextRect(layout, run, fontMetrics);
+        boxRect.moveBy(adjustedPaintOffset);
+        if (!paintRect.intersects(enclosingLayoutRect(boxRect)))
+            continue;
+
+        TextRun textRun = RenderBlock::constructTextRun(textRenderer, font, textRenderer, run.start, run.end - run.start, style);
+        textRun.setCharactersLength(textRenderer->textLength() - run.start);
+        context->drawText(font, textRun, FloatPoint(boxRect.x(), boxRect.y() + fontMetrics.ascent()));
+
+        if (page)
+            page->addRelevantRepaintedObject(textRenderer, enclosingIntRect(boxRect));
+    }
+}
+
+bool hitTestFlow(RenderBlock* flow, const Layout& layout, const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset)
+{
+    RenderText* textRenderer = toRenderText(flow->firstChild());
+    RenderStyle* style = flow->style();
+    if (style->visibility() != VISIBLE || style->pointerEvents() == PE_NONE)
+        return false;
+
+    const FontMetrics& fontMetrics = style->fontMetrics();
+    const Vector<Run>& runs = layout.runs();
+    for (size_t i = runs.size(); i; --i) {
+        FloatRect rect = computeRunTextRect(layout, runs[i - 1], fontMetrics);
+        rect.moveBy(accumulatedOffset);
+        if (!locationInContainer.intersects(rect))
+            continue;
+
+        textRenderer->updateHitTestResult(result, locationInContainer.point() - toLayoutSize(accumulatedOffset));
+        if (!result.addNodeToRectBasedTestResult(textRenderer->node(), request, locationInContainer, rect)) {
+            flow->updateHitTestResult(result, locationInContainer.point() - toLayoutSize(accumulatedOffset));
+            return true;
+        }
+    }
+    return false;
+}
+
+Vector<LayoutRect> collectFlowLineRects(const Layout& layout)
+{
+    Vector<LayoutRect> lineRects;
+    const Vector<Run>& runs = layout.runs();
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Run& run = runs[i];
+        LayoutRect runRect = enclosingLayoutRect(FloatRect(run.left, layout.lineTop(run.lineIndex), run.right - run.left, layout.lineHeight()));
+        if (run.lineIndex < lineRects.size())
+            lineRects[run.lineIndex].unite(runRect);
+        else
+            lineRects.append(runRect);
+    }
+    return lineRects;
+}
+
+Vector<FloatRect> collectTextRunRects(const RenderBlock* flow, const Layout& layout)
+{
+    const FontMetrics& fontMetrics = flow->style()->fontMetrics();
+    const Vector<Run>& runs = layout.runs();
+    Vector<FloatRect> rects;
+    rects.reserveInitialCapacity(runs.size());
+    for (size_t i = 0; i < runs.size(); ++i)
+        rects.uncheckedAppend(computeRunTextRect(layout, runs[i], fontMetrics));
+    return rects;
+}
+
+IntRect computeTextBoundingBox(const RenderBlock* flow, const Layout& layout)
+{
+    const Vector<Run>& runs = layout.runs();
+    if (runs.isEmpty())
+        return IntRect();
+
+    const FontMetrics& fontMetrics = flow->style()->fontMetrics();
+    float left = runs[0].left;
+    float right = runs[0].right;
+    for (size_t i = 1; i < runs.size(); ++i) {
+        left = std::min(left, runs[i].left);
+        right = std::max(right, runs[i].right);
+    }
+    float top = computeRunTextRect(layout, runs.first(), fontMetrics).y();
+    float bottom = computeRunTextRect(layout, runs.last(), fontMetrics).maxY();
+    return enclosingIntRect(FloatRect(left, top, right - left, bottom - top));
+}
+
+unsigned findCaretMinimumOffset(const Layout& layout)
+{
+    return layout.runs().isEmpty() ? 0 : layout.runs().first().start;
+}
+
+unsigned findCaretMaximumOffset(const Layout& layout)
+{
+    return layout.runs().isEmpty() ? 0 : layout.runs().last().end;
+}
+
+unsigned computeTextRenderedLength(const Layout& layout)
+{
+    unsigned length = 0;
+    const Vector<Run>& runs = layout.runs();
+    for (size_t i = 0; i < runs.size(); ++i)
+        length += runs[i].end - runs[i].start;
+    return length;
+}
+
+} // namespace SimpleLineLayout
+} // namespace WebCore
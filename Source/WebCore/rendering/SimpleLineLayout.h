@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SimpleLineLayout_h
+#define SimpleLineLayout_h
+
+#include "FloatRect.h"
+#include "IntRect.h"
+#include "LayoutRect.h"
+#include "LayoutUnit.h"
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class HitTestLocation;
+class HitTestRequest;
+class HitTestResult;
+class LayoutPoint;
+class RenderBlock;
+struct PaintInfo;
+
+// Line layout for the common case of a block containing a single run of plain left-to-right
+// text in one font. Instead of building a RootInlineBox/InlineTextBox tree, lines are stored
+// as a flat vector of text runs. RenderBlock::ensureLineBoxes() lays the block out with the
+// full inline box tree whenever some code needs it.
+namespace SimpleLineLayout {
+
+bool canUseFor(const RenderBlock*);
+
+struct Run {
+    Run(unsigned start, unsigned end, float left, float right, unsigned lineIndex)
+        : start(start)
+        , end(end)
+        , left(left)
+        , right(right)
+        , lineIndex(lineIndex)
+    {
+    }
+
+    unsigned start;
+    unsigned end;
+    float left;
+    float right;
+    unsigned lineIndex;
+};
+
+class Layout {
+    WTF_MAKE_NONCOPYABLE(Layout); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<Layout> create(const RenderBlock*);
+
+    const Vector<Run>& runs() const { return m_runs; }
+    unsigned lineCount() const { return m_lineCount; }
+    LayoutUnit lineHeight() const { return m_lineHeight; }
+    int baseline() const { return m_baseline; }
+
+    LayoutUnit lineTop(unsigned lineIndex) const { return m_top + m_lineHeight * lineIndex; }
+    LayoutUnit height() const { return m_lineHeight * m_lineCount; }
+
+private:
+    Layout(LayoutUnit top, LayoutUnit lineHeight, int baseline);
+
+    Vector<Run> m_runs;
+    unsigned m_lineCount;
+    LayoutUnit m_top;
+    LayoutUnit m_lineHeight;
+    int m_baseline;
+};
+
+int computeFlowFirstLineBaseline(const RenderBlock*, const Layout&);
+int computeFlowLastLineBaseline(const RenderBlock*, const Layout&);
+void collectFlowOverflow(RenderBlock*, const Layout&);
+void paintFlow(const RenderBlock*, const Layout&, PaintInfo&, const LayoutPoint& paintOffset);
+bool hitTestFlow(RenderBlock*, const Layout&, const HitTestRequest&, HitTestResult&, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset);
+Vector<LayoutRect> collectFlowLineRects(const Layout&);
+
+// Geometry of the text child, matching what its InlineTextBoxes would report.
+Vector<FloatRect> collectTextRunRects(const RenderBlock*, const Layout&);
+IntRect computeTextBoundingBox(const RenderBlock*, const Layout&);
+unsigned findCaretMinimumOffset(const Layout&);
+unsigned findCaretMaximumOffset(const Layout&);
+unsigned computeTextRenderedLength(const Layout&);
+
+} // namespace SimpleLineLayout
+
+} // namespace WebCore
+
+#endif // SimpleLineLayout_h
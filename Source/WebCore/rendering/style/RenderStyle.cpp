@@ -395,7 +395,8 @@ bool RenderStyle::changeRequiresLayout(const RenderStyle* other, unsigned& chang
             || rareNonInheritedData->marginBeforeCollapse != other->rareNonInheritedData->marginBeforeCollapse
             || rareNonInheritedData->marginAfterCollapse != other->rareNonInheritedData->marginAfterCollapse
             || rareNonInheritedData->lineClamp != other->rareNonInheritedData->lineClamp
-            || rareNonInheritedData->textOverflow != other->rareNonInheritedData->textOverflow)
+            || rareNonInheritedData->textOverflow != other->rareNonInheritedData->textOverflow
+            || rareNonInheritedData->m_contain != other->rareNonInheritedData->m_contain)
             return true;
 
         if (rareNonInheritedData->m_regionFragment != other->rareNonInheritedData->m_regionFragment)
@@ -495,6 +495,10 @@ enum ColumnAxis { HorizontalColumnAxis, VerticalColumnAxis, AutoColumnAxis };
 
 enum ColumnProgression { NormalColumnProgression, ReverseColumnProgression };
 
+// Strict containment makes a box a layout and size boundary: its contents can neither affect
+// its size nor the layout of anything outside it.
+enum EContain { ContainNone, ContainStrict };
+
 enum LineSnap { LineSnapNone, LineSnapBaseline, LineSnapContain };
 
 enum LineAlign { LineAlignNone, LineAlignEdges };
@@ -73,6 +73,7 @@ StyleRareNonInheritedData::StyleRareNonInheritedData()
     , m_appearance(RenderStyle::initialAppearance())
     , m_borderFit(RenderStyle::initialBorderFit())
     , m_textCombine(RenderStyle::initialTextCombine())
+    , m_contain(RenderStyle::initialContain())
 #if ENABLE(CSS3_TEXT)
     , m_textDecorationStyle(RenderStyle::initialTextDecorationStyle())
 #endif // CSS3_TEXT
@@ -156,6 +157,7 @@ StyleRareNonInheritedData::StyleRareNonInheritedData(const StyleRareNonInherited
     , m_appearance(o.m_appearance)
     , m_borderFit(o.m_borderFit)
     , m_textCombine(o.m_textCombine)
+    , m_contain(o.m_contain)
 #if ENABLE(CSS3_TEXT)
     , m_textDecorationStyle(o.m_textDecorationStyle)
 #endif // CSS3_TEXT
@@ -245,6 +247,7 @@ bool StyleRareNonInheritedData::operator==(const StyleRareNonInheritedData& o) c
         && m_appearance == o.m_appearance
         && m_borderFit == o.m_borderFit
         && m_textCombine == o.m_textCombine
+        && m_contain == o.m_contain
 #if ENABLE(CSS3_TEXT)
         && m_textDecorationStyle == o.m_textDecorationStyle
 #endif // CSS3_TEXT
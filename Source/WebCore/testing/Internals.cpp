@@ -29,6 +29,7 @@
 
 #include "AnimationController.h"
 #include "BackForwardController.h"
+#include "CSSStyleSheet.h"
 #include "CachedResourceLoader.h"
 #include "Chrome.h"
 #include "ChromeClient.h"
@@ -51,6 +52,7 @@
 #include "Frame.h"
 #include "FrameLoader.h"
 #include "FrameView.h"
+#include "GraphicsLayer.h"
 #include "HTMLContentElement.h"
 #include "HTMLInputElement.h"
 #include "HTMLNames.h"
@@ -78,6 +80,7 @@
 #include "PrintContext.h"
 #include "PseudoElement.h"
 #include "Range.h"
+#include "RenderBlock.h"
 #include "RenderEmbeddedObject.h"
 #include "RenderMenuList.h"
 #include "RenderObject.h"
@@ -90,13 +93,17 @@
 #include "SerializedScriptValue.h"
 #include "Settings.h"
 #include "ShadowRoot.h"
+#include "SharedBuffer.h"
 #include "SpellChecker.h"
 #include "StaticNodeList.h"
+#include "StyleResolver.h"
 #include "StyleSheetContents.h"
 #include "TextIterator.h"
+#include "TiledBackingStore.h"
 #include "TreeScope.h"
 #include "TypeConversions.h"
 #include "ViewportArguments.h"
+#include "WordShapingCache.h"
 #include "WorkerThread.h"
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuffer.h>
@@ -298,6 +305,8 @@ void Internals::resetToConsistentState(Page* page)
 Internals::Internals(Document* document)
     : ContextDestructionObserver(document)
 {
+    RenderObject::setCountsRenderersLaidOut(true);
+
 #if ENABLE(VIDEO_TRACK) && !PLATFORM(WIN)
     if (document && document->page())
         document->page()->group().captionPreferences()->setTestingMode(true);
@@ -358,6 +367,39 @@ bool Internals::isLoadingFromMemoryCache(const String& url)
     return resource && resource->status() == CachedResource::Cached;
 }
 
+unsigned Internals::wordShapingCacheHitCount() const
+{
+    return WordShapingCache::hitCount();
+}
+
+unsigned Internals::wordShapingCacheMissCount() const
+{
+    return WordShapingCache::missCount();
+}
+
+void Internals::clearWordShapingCaches()
+{
+    WordShapingCache::clearAll();
+}
+
+unsigned Internals::displayListsSizeInBytes() const
+{
+#if USE(DISPLAY_LIST_RECORDING)
+    return GraphicsLayer::displayListsSizeInBytes();
+#else
+    return 0;
+#endif
+}
+
+unsigned Internals::displayListPatchCount() const
+{
+#if USE(DISPLAY_LIST_RECORDING)
+    return GraphicsLayer::displayListPatchCount();
+#else
+    return 0;
+#endif
+}
+
 PassRefPtr<Element> Internals::createContentElement(ExceptionCode& ec)
 {
     Document* document = contextDocument();
@@ -415,6 +457,13 @@ unsigned Internals::numberOfActiveAnimations() const
     return 0;
 }
 
+unsigned Internals::numberOfAnimatedElementsInLastUpdate() const
+{
+    if (AnimationController* controller = frame()->animation())
+        return controller->numberOfAnimatedElementsInLastUpdate();
+    return 0;
+}
+
 bool Internals::animationsAreSuspended(Document* document, ExceptionCode& ec) const
 {
     if (!document || !document->frame()) {
@@ -1614,6 +1663,155 @@ unsigned Internals::numberOfScrollableAreas(Document* document, ExceptionCode&)
 
     return count;
 }
+
+unsigned Internals::numberOfRenderersLaidOutInLastLayout(Document* document, ExceptionCode& ec)
+{
+    if (!document || !document->view()) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->view()->renderersLaidOutInLastLayout();
+}
+
+unsigned Internals::numberOfLayoutRootsInLastLayout(Document* document, ExceptionCode& ec)
+{
+    if (!document || !document->view()) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->view()->layoutRootsInLastLayout();
+}
+
+unsigned Internals::numberOfDeferredTableRows(Document* document, ExceptionCode& ec)
+{
+    if (!document || !document->renderView()) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->renderView()->deferredTableRowCount();
+}
+
+#if USE(TILED_BACKING_STORE)
+static TiledBackingStore* tiledBackingStore(Document* document)
+{
+    if (!document || !document->frame())
+        return 0;
+    return document->frame()->tiledBackingStore();
+}
+#endif
+
+unsigned Internals::numberOfTilesPaintedInLastTileUpdate(Document* document, ExceptionCode& ec)
+{
+#if USE(TILED_BACKING_STORE)
+    if (TiledBackingStore* backingStore = tiledBackingStore(document))
+        return backingStore->lastUpdateStatistics().paintedTileCount;
+#else
+    UNUSED_PARAM(document);
+#endif
+    ec = INVALID_ACCESS_ERR;
+    return 0;
+}
+
+unsigned Internals::numberOfTilesRasterizedOnWorkerThreadsInLastTileUpdate(Document* document, ExceptionCode& ec)
+{
+#if USE(TILED_BACKING_STORE)
+    if (TiledBackingStore* backingStore = tiledBackingStore(document))
+        return backingStore->lastUpdateStatistics().workerThreadTileCount;
+#else
+    UNUSED_PARAM(document);
+#endif
+    ec = INVALID_ACCESS_ERR;
+    return 0;
+}
+
+double Internals::lastTileUpdateDuration(Document* document, ExceptionCode& ec)
+{
+#if USE(TILED_BACKING_STORE)
+    if (TiledBackingStore* backingStore = tiledBackingStore(document))
+        return backingStore->lastUpdateStatistics().updateDuration;
+#else
+    UNUSED_PARAM(document);
+#endif
+    ec = INVALID_ACCESS_ERR;
+    return 0;
+}
+
+double Internals::lastTileUpdateMainThreadDuration(Document* document, ExceptionCode& ec)
+{
+#if USE(TILED_BACKING_STORE)
+    if (TiledBackingStore* backingStore = tiledBackingStore(document))
+        return backingStore->lastUpdateStatistics().mainThreadDuration;
+#else
+    UNUSED_PARAM(document);
+#endif
+    ec = INVALID_ACCESS_ERR;
+    return 0;
+}
+
+unsigned Internals::numberOfTilesInBackingStore(Document* document, ExceptionCode& ec)
+{
+#if USE(TILED_BACKING_STORE)
+    if (TiledBackingStore* backingStore = tiledBackingStore(document))
+        return backingStore->tileCount();
+#else
+    UNUSED_PARAM(document);
+#endif
+    ec = INVALID_ACCESS_ERR;
+    return 0;
+}
+
+PassRefPtr<ClientRect> Internals::tiledBackingStoreCoverRect(Document* document, ExceptionCode& ec)
+{
+#if USE(TILED_BACKING_STORE)
+    if (TiledBackingStore* backingStore = tiledBackingStore(document))
+        return ClientRect::create(backingStore->mapToContents(backingStore->coverRect()));
+#else
+    UNUSED_PARAM(document);
+#endif
+    ec = INVALID_ACCESS_ERR;
+    return ClientRect::create();
+}
+
+bool Internals::usesSimpleLineLayout(Element* element, ExceptionCode& ec)
+{
+    if (!element) {
+        ec = INVALID_ACCESS_ERR;
+        return false;
+    }
+
+    element->document()->updateLayout();
+    RenderObject* renderer = element->renderer();
+    return renderer && renderer->isRenderBlock() && toRenderBlock(renderer)->simpleLineLayout();
+}
+
+bool Internals::styleSheetContentsAreShared(CSSStyleSheet* sheet1, CSSStyleSheet* sheet2, ExceptionCode& ec)
+{
+    if (!sheet1 || !sheet2) {
+        ec = INVALID_ACCESS_ERR;
+        return false;
+    }
+
+    return sheet1->contents() == sheet2->contents();
+}
+
+unsigned Internals::numberOfUniversalAuthorStyleRules(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    // These are the author rules that are tested against every element.
+    return document->ensureStyleResolver()->ruleSets().authorStyle()->universalRules()->size();
+}
+
+unsigned long long Internals::linearizedSharedBufferByteCount() const
+{
+    return SharedBuffer::linearizedByteCount();
+}
     
 bool Internals::isPageBoxVisible(Document* document, int pageNumber, ExceptionCode& ec)
 {
@@ -39,6 +39,7 @@
 
 namespace WebCore {
 
+class CSSStyleSheet;
 class ClientRect;
 class ClientRectList;
 class DOMStringList;
@@ -78,6 +79,13 @@ public:
     bool isPreloaded(const String& url);
     bool isLoadingFromMemoryCache(const String& url);
 
+    unsigned wordShapingCacheHitCount() const;
+    unsigned wordShapingCacheMissCount() const;
+    void clearWordShapingCaches();
+
+    unsigned displayListsSizeInBytes() const;
+    unsigned displayListPatchCount() const;
+
     size_t numberOfScopedHTMLStyleChildren(const Node*, ExceptionCode&) const;
     PassRefPtr<CSSComputedStyleDeclaration> computedStyleIncludingVisitedInfo(Node*, ExceptionCode&) const;
 
@@ -96,6 +104,7 @@ public:
 
     // CSS Animation testing.
     unsigned numberOfActiveAnimations() const;
+    unsigned numberOfAnimatedElementsInLastUpdate() const;
     bool animationsAreSuspended(Document*, ExceptionCode&) const;
     void suspendAnimations(Document*, ExceptionCode&) const;
     void resumeAnimations(Document*, ExceptionCode&) const;
@@ -204,6 +213,22 @@ public:
 
     unsigned numberOfScrollableAreas(Document*, ExceptionCode&);
 
+    unsigned numberOfRenderersLaidOutInLastLayout(Document*, ExceptionCode&);
+    unsigned numberOfLayoutRootsInLastLayout(Document*, ExceptionCode&);
+    unsigned numberOfDeferredTableRows(Document*, ExceptionCode&);
+    unsigned numberOfTilesPaintedInLastTileUpdate(Document*, ExceptionCode&);
+    unsigned numberOfTilesRasterizedOnWorkerThreadsInLastTileUpdate(Document*, ExceptionCode&);
+    double lastTileUpdateDuration(Document*, ExceptionCode&);
+    double lastTileUpdateMainThreadDuration(Document*, ExceptionCode&);
+    unsigned numberOfTilesInBackingStore(Document*, ExceptionCode&);
+    PassRefPtr<ClientRect> tiledBackingStoreCoverRect(Document*, ExceptionCode&);
+    bool usesSimpleLineLayout(Element*, ExceptionCode&);
+
+    bool styleSheetContentsAreShared(CSSStyleSheet*, CSSStyleSheet*, ExceptionCode&);
+    unsigned numberOfUniversalAuthorStyleRules(Document*, ExceptionCode&);
+
+    unsigned long long linearizedSharedBufferByteCount() const;
+
     bool isPageBoxVisible(Document*, int pageNumber, ExceptionCode&);
 
     static const char* internalsId;
@@ -28,6 +28,7 @@
 #include "FileSystem.h"
 #include "FontCache.h"
 #include "GCController.h"
+#include "GraphicsLayer.h"
 #include "GroupSettings.h"
 #include "IconDatabase.h"
 #include "Image.h"
@@ -45,6 +46,7 @@
 #include "RuntimeEnabledFeatures.h"
 #include "Settings.h"
 #include "StorageThread.h"
+#include "StyleElement.h"
 #include "WorkerThread.h"
 #include <QDir>
 #include <QFileInfo>
@@ -70,6 +72,7 @@ class QWebSettingsPrivate {
 public:
     QWebSettingsPrivate(WebCore::Settings* wcSettings = 0, WebCore::GroupSettings* wcGroupSettings = 0)
         : offlineStorageDefaultQuota(0)
+        , tiledBackingStoreMemoryBudget(0)
         , settings(wcSettings)
         , groupSettings(wcGroupSettings)
     {
@@ -85,6 +88,7 @@ public:
     QString offlineDatabasePath;
     QString mediaType;
     qint64 offlineStorageDefaultQuota;
+    qint64 tiledBackingStoreMemoryBudget;
     QWebSettings::ThirdPartyCookiePolicy thirdPartyCookiePolicy;
     void apply();
     WebCore::Settings* settings;
@@ -165,6 +169,10 @@ void QWebSettingsPrivate::apply()
         bool showDebugVisuals = qgetenv("WEBKIT_SHOW_COMPOSITING_DEBUG_VISUALS") == "1";
         settings->setShowDebugBorders(showDebugVisuals);
         settings->setShowRepaintCounter(showDebugVisuals);
+
+        value = attributes.value(QWebSettings::DisplayListRecordingEnabled,
+                                 global->attributes.value(QWebSettings::DisplayListRecordingEnabled));
+        settings->setDisplayListRecordingEnabled(value);
 #endif
 #if ENABLE(WEBGL)
         value = attributes.value(QWebSettings::WebGLEnabled,
@@ -289,6 +297,12 @@ void QWebSettingsPrivate::apply()
         value = attributes.value(QWebSettings::TiledBackingStoreEnabled,
                                       global->attributes.value(QWebSettings::TiledBackingStoreEnabled));
         settings->setTiledBackingStoreEnabled(value);
+        qint64 budget = tiledBackingStoreMemoryBudget ? tiledBackingStoreMemoryBudget : global->tiledBackingStoreMemoryBudget;
+        settings->setTiledBackingStoreMemoryBudget(static_cast<size_t>(qMax<qint64>(budget, 0)));
+#endif
+
+#if ENABLE(THREADED_HTML_PARSER)
+        settings->setThreadedHTMLParser(qgetenv("WEBKIT_THREADED_HTML_PARSER") != "0");
 #endif
 
 #if ENABLE(SMOOTH_SCROLLING)
@@ -535,6 +549,9 @@ QWebSettings* QWebSettings::globalSettings()
         It is enabled by default.
     \value HyperlinkAuditingEnabled This setting enables support for hyperlink auditing (<a ping>).
         It is disabled by default.
+    \value DisplayListRecordingEnabled Specifies whether the painting of composited layers is recorded
+        and replayed, so that parts of a layer that did not change are not painted again. This uses more
+        memory and is disabled by default.
 */
 
 /*!
@@ -592,6 +609,7 @@ QWebSettings::QWebSettings()
     d->attributes.insert(QWebSettings::NotificationsEnabled, true);
     d->attributes.insert(QWebSettings::Accelerated2dCanvasEnabled, false);
     d->attributes.insert(QWebSettings::WebSecurityEnabled, true);
+    d->attributes.insert(QWebSettings::DisplayListRecordingEnabled, false);
     d->offlineStorageDefaultQuota = 5 * 1024 * 1024;
     d->defaultTextEncoding = QLatin1String("iso-8859-1");
     d->thirdPartyCookiePolicy = AlwaysAllowThirdPartyCookies;
@@ -879,6 +897,14 @@ void QWebSettings::clearMemoryCaches()
     // Empty the Cross-Origin Preflight cache
     WebCore::CrossOriginPreflightResultCache::shared().empty();
 
+    // Drop the parsed inline style sheets kept for reuse across documents.
+    WebCore::StyleElement::clearInlineStyleSheetContentsCache();
+
+#if USE(DISPLAY_LIST_RECORDING)
+    // Drop the recorded painting of composited layers; it is recorded again when next painted.
+    WebCore::GraphicsLayer::releaseAllDisplayLists();
+#endif
+
     // Drop JIT compiled code from ExecutableAllocator.
     WebCore::gcController().discardAllCompiledCode();
     // Garbage Collect to release the references of CachedResource from dead objects.
@@ -985,6 +1011,32 @@ QString QWebSettings::cssMediaType() const
     return d->mediaType;
 }
 
+/*!
+    Sets the memory the tiled backing store may use for its tiles to \a maximumSize bytes.
+
+    Once the tiles reach this size, the tiles furthest from the viewport, and behind the
+    direction of scrolling, are dropped to make room for new ones. The tiles covering the
+    viewport are always kept, even over the budget. A value of 0 means the page uses the
+    global setting, and a global value of 0 means there is no limit, which is the default.
+
+    \sa TiledBackingStoreEnabled
+*/
+void QWebSettings::setTiledBackingStoreMemoryBudget(qint64 maximumSize)
+{
+    d->tiledBackingStoreMemoryBudget = maximumSize;
+    d->apply();
+}
+
+/*!
+    Returns the memory budget of the tiled backing store, in bytes.
+
+    \sa setTiledBackingStoreMemoryBudget()
+*/
+qint64 QWebSettings::tiledBackingStoreMemoryBudget() const
+{
+    return d->tiledBackingStoreMemoryBudget;
+}
+
 /*!
     Sets the actual font family to \a family for the specified generic family,
     \a which.
@@ -88,7 +88,8 @@ public:
         NotificationsEnabled,
         WebAudioEnabled,
         Accelerated2dCanvasEnabled,
-        WebSecurityEnabled
+        WebSecurityEnabled,
+        DisplayListRecordingEnabled
     };
     enum WebGraphic {
         MissingImageGraphic,
@@ -169,6 +170,9 @@ public:
     void setCSSMediaType(const QString&);
     QString cssMediaType() const;
 
+    void setTiledBackingStoreMemoryBudget(qint64 maximumSize);
+    qint64 tiledBackingStoreMemoryBudget() const;
+
     inline QWebSettingsPrivate* handle() const { return d; }
 
 private:
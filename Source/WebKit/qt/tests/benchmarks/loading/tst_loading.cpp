@@ -23,12 +23,65 @@
 
 #include <QtTest/QtTest>
 
+#include <qwebelement.h>
 #include <qwebframe.h>
 #include <qwebview.h>
 #include <qpainter.h>
 
 #include "util.h"
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+// Measures how long the event loop went without running a zero-interval timer. The longest gap is
+// how long the main thread was kept busy at once, and the sum of the gaps longer than a millisecond
+// is roughly how long it was busy in total.
+class MainThreadStallMeter : public QObject {
+    Q_OBJECT
+
+public:
+    MainThreadStallMeter()
+        : m_longestStall(0)
+        , m_busyTime(0)
+    {
+        connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+    }
+
+    void start()
+    {
+        m_longestStall = 0;
+        m_busyTime = 0;
+        m_elapsed.start();
+        m_timer.start(0);
+    }
+    void stop()
+    {
+        tick();
+        m_timer.stop();
+    }
+    qint64 longestStall() const { return m_longestStall; }
+    qint64 busyTime() const { return m_busyTime; }
+
+private Q_SLOTS:
+    void tick()
+    {
+        qint64 stall = m_elapsed.restart();
+        m_longestStall = qMax(m_longestStall, stall);
+        if (stall > 1)
+            m_busyTime += stall;
+    }
+
+private:
+    QTimer m_timer;
+    QElapsedTimer m_elapsed;
+    qint64 m_longestStall;
+    qint64 m_busyTime;
+};
+
 class tst_Loading : public QObject
 {
     Q_OBJECT
@@ -42,6 +95,24 @@ public Q_SLOTS:
 private Q_SLOTS:
     void load_data();
     void load();
+    void styleSheets_data();
+    void styleSheets();
+    void textParagraphs_data();
+    void textParagraphs();
+    void multilingualText_data();
+    void multilingualText();
+    void containedWidgets_data();
+    void containedWidgets();
+    void nestedFlexboxes_data();
+    void nestedFlexboxes();
+    void largeDocument_data();
+    void largeDocument();
+    void tokenizer_data();
+    void tokenizer();
+    void latin1Document_data();
+    void latin1Document();
+    void domConstruction_data();
+    void domConstruction();
 
 private:
 #ifndef QT_NO_BEARERMANAGEMENT
@@ -91,5 +162,388 @@ void tst_Loading::load()
     }
 }
 
+// Roughly the shape of a CSS framework: many small rules made of simple declarations.
+static QString frameworkStyleSheet(int ruleCount)
+{
+    QString sheet;
+    for (int i = 0; i < ruleCount; ++i) {
+        sheet += QString(".col-%1 > .btn-%1:hover, #panel-%1 a.nav-%1 { ").arg(i);
+        sheet += QString("margin-left: %1px; padding: 4px 8px; color: #%2; display: inline-block; ").arg(i % 40).arg(i % 0x1000, 3, 16, QLatin1Char('0'));
+        sheet += QLatin1String("background: url(data:,) no-repeat; font: 12px/1.5 sans-serif; }\n");
+    }
+    return sheet;
+}
+
+void tst_Loading::styleSheets_data()
+{
+    QTest::addColumn<int>("ruleCount");
+    QTest::addColumn<int>("sheetCount");
+    QTest::addColumn<int>("styledElementCount");
+    // Keep the generated markup below the 2 MB setHtml() limit.
+    QTest::newRow("one large sheet") << 5000 << 1 << 0;
+    QTest::newRow("repeated sheets") << 500 << 8 << 0;
+    QTest::newRow("style attributes") << 0 << 0 << 10000;
+}
+
+void tst_Loading::styleSheets()
+{
+    QFETCH(int, ruleCount);
+    QFETCH(int, sheetCount);
+    QFETCH(int, styledElementCount);
+
+    QString sheet = frameworkStyleSheet(ruleCount);
+    QString html = QLatin1String("<html><head>");
+    for (int i = 0; i < sheetCount; ++i)
+        html += QLatin1String("<style>") + sheet + QLatin1String("</style>");
+    html += QLatin1String("</head><body>");
+    for (int i = 0; i < styledElementCount; ++i)
+        html += QString("<div style='width: %1px; color: red; display: block; float: left'></div>").arg(i % 100);
+    html += QLatin1String("</body></html>");
+
+    QBENCHMARK {
+        m_view->setHtml(html);
+        ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+    }
+}
+
+void tst_Loading::textParagraphs_data()
+{
+    QTest::addColumn<QString>("paragraphMarkup");
+    QTest::newRow("plain text") << QString::fromLatin1("<p>%1</p>");
+    QTest::newRow("text with inline element") << QString::fromLatin1("<p><b>Lorem</b> %1</p>");
+}
+
+void tst_Loading::textParagraphs()
+{
+    QFETCH(QString, paragraphMarkup);
+
+    QString text;
+    for (int i = 0; i < 20; ++i)
+        text += QLatin1String("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor. ");
+    QString html = QLatin1String("<html><body>");
+    for (int i = 0; i < 1000; ++i)
+        html += paragraphMarkup.arg(text);
+    html += QLatin1String("</body></html>");
+
+    m_view->setHtml(html);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    // Alternate the viewport width so that every paragraph has to be broken into lines again.
+    int width = 1024;
+    QBENCHMARK {
+        width = width == 1024 ? 800 : 1024;
+        m_page->setViewportSize(QSize(width, 768));
+        m_page->mainFrame()->evaluateJavaScript(QLatin1String("document.body.offsetHeight"));
+    }
+}
+
+// Builds space separated pseudo words out of a run of letters of one script, optionally
+// following every letter with a combining mark so that the text needs shaping.
+static QString scriptText(ushort firstLetter, int letterCount, ushort combiningMark, int wordCount)
+{
+    QString text;
+    for (int word = 0; word < wordCount; ++word) {
+        int wordLength = 3 + word % 5;
+        for (int i = 0; i < wordLength; ++i) {
+            text += QChar(firstLetter + (word * 7 + i) % letterCount);
+            if (combiningMark && i % 2)
+                text += QChar(combiningMark);
+        }
+        text += QLatin1Char(' ');
+    }
+    return text;
+}
+
+void tst_Loading::multilingualText_data()
+{
+    QTest::addColumn<QString>("paragraphMarkup");
+    QTest::newRow("one script per paragraph") << QString::fromLatin1("<p>%1</p>");
+    QTest::newRow("scripts in spans") << QString::fromLatin1("<p><span>%1</span></p>");
+}
+
+void tst_Loading::multilingualText()
+{
+    QFETCH(QString, paragraphMarkup);
+
+    QStringList paragraphs;
+    paragraphs << scriptText(0x0627, 26, 0x064E, 120) // Arabic with fatha
+        << scriptText(0x05D0, 27, 0, 120) // Hebrew
+        << scriptText(0x0915, 37, 0x093F, 120) // Devanagari with vowel sign i
+        << scriptText(0x0E01, 46, 0x0E34, 120) // Thai with sara i
+        << scriptText(0x0430, 32, 0x0301, 120); // Cyrillic with combining acute
+    QString html = QLatin1String("<html><body>");
+    for (int i = 0; i < 1000; ++i)
+        html += paragraphMarkup.arg(paragraphs.at(i % paragraphs.size()) + QString::number(i));
+    html += QLatin1String("</body></html>");
+
+    m_view->setHtml(html);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    // Alternate the viewport width so that every paragraph has to be broken into lines again.
+    int width = 1024;
+    QBENCHMARK {
+        width = width == 1024 ? 800 : 1024;
+        m_page->setViewportSize(QSize(width, 768));
+        m_page->mainFrame()->evaluateJavaScript(QLatin1String("document.body.offsetHeight"));
+    }
+}
+
+void tst_Loading::containedWidgets_data()
+{
+    QTest::addColumn<QString>("containment");
+    QTest::newRow("no containment") << QString::fromLatin1("none");
+    QTest::newRow("strict containment") << QString::fromLatin1("strict");
+}
+
+void tst_Loading::containedWidgets()
+{
+    QFETCH(QString, containment);
+
+    // A dashboard of auto sized widgets, a few of which get new content at a time.
+    QString html = QLatin1String("<html><body>");
+    for (int i = 0; i < 500; ++i) {
+        html += QString("<div style='float: left; width: 180px; height: 120px; margin: 4px; -webkit-contain: %1'><p>Widget %2</p><p id='w%2'>0</p></div>")
+            .arg(containment).arg(i);
+    }
+    html += QLatin1String("</body></html>");
+
+    m_view->setHtml(html);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = m_page->mainFrame();
+    int update = 0;
+    QBENCHMARK {
+        ++update;
+        for (int i = 0; i < 10; ++i) {
+            QWebElement element = mainFrame->findFirstElement(QString("#w%1").arg((update * 37 + i * 50) % 500));
+            element.setPlainText(QString::number(update));
+        }
+        mainFrame->evaluateJavaScript(QLatin1String("document.body.offsetHeight"));
+    }
+}
+
+void tst_Loading::nestedFlexboxes_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::newRow("depth 5") << 5;
+    QTest::newRow("depth 10") << 10;
+    QTest::newRow("depth 20") << 20;
+}
+
+void tst_Loading::nestedFlexboxes()
+{
+    QFETCH(int, depth);
+
+    // Column flexboxes measure the height of each item before flexing it, so nesting them used to
+    // lay out the innermost items a number of times exponential in the depth. The status line is a
+    // sibling of the nested stack: updating it relayouts the outer flexbox, which measures the clean
+    // stack again and should find its height in the cache.
+    QString html = QLatin1String("<html><body><div style='display: -webkit-flex; -webkit-flex-direction: column'>");
+    for (int i = 0; i < depth; ++i)
+        html += QLatin1String("<div style='display: -webkit-flex; -webkit-flex-direction: column; padding: 1px'>");
+    html += QLatin1String("<p>leaf</p>");
+    for (int i = 0; i < depth; ++i)
+        html += QLatin1String("</div>");
+    html += QLatin1String("<p id='status'>0</p></div></body></html>");
+
+    m_view->setHtml(html);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = m_page->mainFrame();
+    QWebElement statusElement = mainFrame->findFirstElement(QLatin1String("#status"));
+    int update = 0;
+    QBENCHMARK {
+        statusElement.setPlainText(QString::number(++update));
+        mainFrame->evaluateJavaScript(QLatin1String("document.body.offsetHeight"));
+    }
+}
+
+void tst_Loading::largeDocument_data()
+{
+    QTest::addColumn<bool>("threadedParser");
+    QTest::newRow("main thread parser") << false;
+    QTest::newRow("threaded parser") << true;
+}
+
+void tst_Loading::largeDocument()
+{
+    QFETCH(bool, threadedParser);
+
+    // The setting is read when the page is created.
+    qputenv("WEBKIT_THREADED_HTML_PARSER", threadedParser ? "1" : "0");
+    QWebView view;
+    view.page()->setViewportSize(QSize(1024, 768));
+
+    // About 4MB of markup. The threaded parser decodes and tokenizes it on the parser thread,
+    // so the main thread is only busy building the tree and laying it out.
+    QString html = QLatin1String("<html><head><meta charset='utf-8'><title>Large document</title></head><body><table>");
+    for (int i = 0; i < 20000; ++i) {
+        html += QString("<tr class='row-%1'><td><a href='#item-%2'>Item %2</a></td><td title='Details of item %2'>"
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit &amp; sed do eiusmod tempor.</td>"
+            "<td><span style='color: #%3'>%4</span></td></tr>\n").arg(i % 2).arg(i).arg(i % 0x1000, 3, 16, QLatin1Char('0')).arg(i * 7);
+    }
+    html += QLatin1String("</table></body></html>");
+
+    MainThreadStallMeter meter;
+    qint64 longestStall = 0;
+    qint64 busyTime = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        meter.start();
+        // Not about:blank, which is always parsed on the main thread.
+        view.setHtml(html, QUrl(QLatin1String("http://localhost/large.html")));
+        ::waitForSignal(&view, SIGNAL(loadFinished(bool)), 0);
+        meter.stop();
+        longestStall = qMax(longestStall, meter.longestStall());
+        busyTime += meter.busyTime();
+        ++iterations;
+    }
+    // Compare these between the two rows to see how much main thread time the parser thread saves.
+    qDebug("Main thread busy while loading: %lldms on average, longest stall %lldms", busyTime / qMax(iterations, 1), longestStall);
+
+    qputenv("WEBKIT_THREADED_HTML_PARSER", QByteArray());
+}
+
+void tst_Loading::tokenizer_data()
+{
+    QTest::addColumn<QString>("fragment");
+    QString latin1Text = QString::fromLatin1("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.");
+    QString utf16Text = scriptText(0x0430, 32, 0, 100);
+    QTest::newRow("ascii text") << QString::fromLatin1("<p>%1</p>\n").arg(latin1Text.repeated(20));
+    QTest::newRow("cyrillic text") << QString::fromLatin1("<p>%1</p>\n").arg(utf16Text.repeated(20));
+    QTest::newRow("attribute values") << QString::fromLatin1("<a href=\"http://www.example.com/%1\" title='%1' data-info=\"%1\"></a>\n").arg(latin1Text);
+    QTest::newRow("inline script") << QString::fromLatin1("<script>var text = '%1';</script>\n").arg(latin1Text.repeated(20));
+}
+
+void tst_Loading::tokenizer()
+{
+    QFETCH(QString, fragment);
+
+    // Parsing into an element that is not rendered keeps style and layout out of the
+    // measurement, and the markup is made of long runs of ordinary characters, so most of
+    // the time goes into the tokenizer.
+    m_view->setHtml(QLatin1String("<html><body><div id='sink' style='display: none'></div></body></html>"));
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+    QWebElement sink = m_page->mainFrame()->findFirstElement(QLatin1String("#sink"));
+
+    QString markup = fragment.repeated(1000);
+    QBENCHMARK {
+        sink.setInnerXml(markup);
+    }
+    qDebug("Tokenized %d characters per iteration", markup.length());
+}
+
+// Bytes currently allocated from the C heap. WebKit's own allocations only show up here when
+// it is built with USE_SYSTEM_MALLOC; otherwise they come from FastMalloc and this returns
+// the allocations made by Qt only.
+static qint64 heapBytesInUse()
+{
+#if defined(__GLIBC__)
+    return mallinfo().uordblks;
+#else
+    return -1;
+#endif
+}
+
+// Resident memory of the process, which also covers memory that is mapped directly instead of
+// coming from the heap, like the large blocks malloc maps on its own.
+static qint64 residentBytes()
+{
+#if defined(Q_OS_LINUX)
+    QFile statm(QLatin1String("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+void tst_Loading::latin1Document_data()
+{
+    QTest::addColumn<QString>("charset");
+    QTest::newRow("iso-8859-1") << QString::fromLatin1("iso-8859-1");
+    QTest::newRow("utf-8") << QString::fromLatin1("utf-8");
+}
+
+void tst_Loading::latin1Document()
+{
+    QFETCH(QString, charset);
+
+    // Accented Latin-1 text, which both charsets decode to 8-bit strings. The parser should keep
+    // it 8-bit all the way into the text nodes and attribute values.
+    QString paragraph = QString::fromLatin1("<p class='caf\xe9'>D\xe9j\xe0 vu, na\xefve fa\xe7" "ade, se\xf1or, cr\xe8me br\xfbl\xe9" "e.</p>\n").repeated(4);
+    QString html = QString::fromLatin1("<html><head><meta charset='%1'></head><body>").arg(charset);
+    for (int i = 0; i < 5000; ++i)
+        html += paragraph;
+    html += QLatin1String("</body></html>");
+    QByteArray data = charset == QLatin1String("utf-8") ? html.toUtf8() : html.toLatin1();
+    QString mimeType = QString::fromLatin1("text/html; charset=%1").arg(charset);
+
+    qint64 heapGrowth = 0;
+    QBENCHMARK {
+        m_view->setHtml(QString());
+        ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+        qint64 heapBefore = heapBytesInUse();
+        m_page->mainFrame()->setContent(data, mimeType, QUrl(QLatin1String("http://localhost/latin1.html")));
+        ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+        heapGrowth = heapBytesInUse() - heapBefore;
+    }
+    if (heapBytesInUse() >= 0)
+        qDebug("Heap growth per parsed MB: %lld bytes", heapGrowth * 1024 * 1024 / data.size());
+}
+
+void tst_Loading::domConstruction_data()
+{
+    QTest::addColumn<bool>("fragment");
+    QTest::newRow("document") << false;
+    QTest::newRow("innerHTML") << true;
+}
+
+void tst_Loading::domConstruction()
+{
+    QFETCH(bool, fragment);
+
+    // Many small text nodes, and elements that repeat the same few sets of attributes.
+    QString markup;
+    for (int i = 0; i < 10000; ++i) {
+        markup += QString::fromLatin1("<li class='item item-%1'><a href='#' class='link'>Item</a> <span class='count'>%2</span></li>\n")
+            .arg(i % 3).arg(i % 10);
+    }
+    const int nodesPerItem = 7;
+
+    qint64 heapGrowth = 0;
+    qint64 residentGrowth = 0;
+    QBENCHMARK {
+        if (fragment) {
+            m_view->setHtml(QLatin1String("<html><body><ul id='list'></ul></body></html>"));
+            ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+            QWebElement list = m_page->mainFrame()->findFirstElement(QLatin1String("#list"));
+            qint64 heapBefore = heapBytesInUse();
+            qint64 residentBefore = residentBytes();
+            list.setInnerXml(markup);
+            heapGrowth = heapBytesInUse() - heapBefore;
+            residentGrowth = residentBytes() - residentBefore;
+        } else {
+            m_view->setHtml(QString());
+            ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+            qint64 heapBefore = heapBytesInUse();
+            qint64 residentBefore = residentBytes();
+            m_view->setHtml(QLatin1String("<html><body><ul>") + markup + QLatin1String("</ul></body></html>"), QUrl(QLatin1String("http://localhost/list.html")));
+            ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+            heapGrowth = heapBytesInUse() - heapBefore;
+            residentGrowth = residentBytes() - residentBefore;
+        }
+    }
+    const int nodeCount = 10000 * nodesPerItem;
+    if (heapBytesInUse() >= 0)
+        qDebug("Heap growth per parsed node: %lld bytes", heapGrowth / nodeCount);
+    if (residentBytes() >= 0)
+        qDebug("Resident memory growth per parsed node: %lld bytes", residentGrowth / nodeCount);
+}
+
 QTEST_MAIN(tst_Loading)
 #include "tst_loading.moc"
@@ -23,10 +23,13 @@
 
 #include <QtTest/QtTest>
 
+#include <qgraphicswebview.h>
 #include <qwebelement.h>
 #include <qwebframe.h>
 #include <qwebview.h>
 #include <qpainter.h>
+#include <QGraphicsScene>
+#include <QStyleOptionGraphicsItem>
 
 #include "util.h"
 
@@ -44,6 +47,12 @@ private Q_SLOTS:
     void paint_data();
     void paint();
     void textAreas();
+    void compositedLayers_data();
+    void compositedLayers();
+    void largeTableScrolling_data();
+    void largeTableScrolling();
+    void tiledScrolling_data();
+    void tiledScrolling();
 
 private:
 #ifndef QT_NO_BEARERMANAGEMENT
@@ -123,5 +132,164 @@ void tst_Painting::textAreas()
     }
 }
 
+void tst_Painting::compositedLayers_data()
+{
+    QTest::addColumn<int>("layerCount");
+    QTest::newRow("100 layers") << 100;
+    QTest::newRow("500 layers") << 500;
+    QTest::newRow("2000 layers") << 2000;
+}
+
+void tst_Painting::compositedLayers()
+{
+    QFETCH(int, layerCount);
+
+    m_page->settings()->setAttribute(QWebSettings::AcceleratedCompositingEnabled, true);
+
+    // A dashboard-like grid of small composited tiles, each of which is tested against
+    // the ones before it for overlap whenever compositing requirements are recomputed.
+    QString html = QLatin1String("<html><body style='margin: 0'>");
+    for (int i = 0; i < layerCount; ++i) {
+        html += QString("<div style='position: absolute; left: %1px; top: %2px; width: 40px; height: 30px; -webkit-transform: translateZ(0)'></div>")
+            .arg((i % 50) * 48).arg((i / 50) * 36);
+    }
+    html += QLatin1String("</body></html>");
+
+    m_view->setHtml(html);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = m_page->mainFrame();
+    QWebElement bodyElement = mainFrame->findFirstElement("body");
+
+    // Moving the body forces a layout, which recomputes the compositing requirements of every layer.
+    int offset = 0;
+    QBENCHMARK {
+        offset = offset ? 0 : 1;
+        bodyElement.setStyleProperty(QLatin1String("margin-left"), QString("%1px").arg(offset));
+        mainFrame->evaluateJavaScript(QLatin1String("document.body.offsetHeight"));
+    }
+}
+
+void tst_Painting::largeTableScrolling_data()
+{
+    QTest::addColumn<int>("rowCount");
+    QTest::newRow("1000 rows") << 1000;
+    QTest::newRow("10000 rows") << 10000;
+}
+
+void tst_Painting::largeTableScrolling()
+{
+    QFETCH(int, rowCount);
+
+    // A data grid whose rows have fixed heights, so rows far from the viewport are only laid out
+    // once scrolling brings them close.
+    QString html = QLatin1String("<html><body style='margin: 0'><table style='table-layout: fixed; width: 100%'>");
+    for (int i = 0; i < rowCount; ++i) {
+        html += QString("<tr><td style='-webkit-contain: strict; height: 20px'>%1</td>"
+            "<td style='-webkit-contain: strict; height: 20px'>Row %1</td></tr>").arg(i);
+    }
+    html += QLatin1String("</table></body></html>");
+
+    m_view->setHtml(html);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = m_page->mainFrame();
+
+    // Only the rows near the top are laid out by this first paint; the rest are laid out while scrolling.
+    QPixmap pixmap(m_page->viewportSize());
+    QPainter initialPainter(&pixmap);
+    mainFrame->render(&initialPainter, QRect(QPoint(0, 0), m_page->viewportSize()));
+    initialPainter.end();
+
+    int position = 0;
+    QBENCHMARK {
+        position = (position + m_page->viewportSize().height()) % mainFrame->contentsSize().height();
+        mainFrame->setScrollPosition(QPoint(0, position));
+        QPainter painter(&pixmap);
+        mainFrame->render(&painter, QRect(QPoint(0, 0), m_page->viewportSize()));
+        painter.end();
+    }
+}
+
+// Pixels of the checker pattern painted where tiles are not ready yet.
+static int checkerboardedPixelCount(const QImage& image)
+{
+    int count = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            if (line[x] == 0xff555555 || line[x] == 0xffaaaaaa)
+                ++count;
+        }
+    }
+    return count;
+}
+
+void tst_Painting::tiledScrolling_data()
+{
+    QTest::addColumn<int>("scrollStep");
+    QTest::addColumn<bool>("recordDisplayLists");
+    QTest::addColumn<int>("memoryBudgetInTiles");
+    QTest::newRow("slow") << 20 << false << 0;
+    QTest::newRow("fast") << 150 << false << 0;
+    QTest::newRow("slow, rasterized on worker threads") << 20 << true << 0;
+    QTest::newRow("fast, rasterized on worker threads") << 150 << true << 0;
+    QTest::newRow("fast, memory for 6 tiles") << 150 << false << 6;
+}
+
+void tst_Painting::tiledScrolling()
+{
+    QFETCH(int, scrollStep);
+    QFETCH(bool, recordDisplayLists);
+    QFETCH(int, memoryBudgetInTiles);
+
+    QGraphicsScene scene;
+    QGraphicsWebView* webView = new QGraphicsWebView;
+    scene.addItem(webView);
+    webView->setGeometry(QRectF(QPointF(0, 0), m_page->viewportSize()));
+    webView->settings()->setAttribute(QWebSettings::TiledBackingStoreEnabled, true);
+    // Tiles are recorded into display lists and rasterized on worker threads when recording is on.
+    webView->settings()->setAttribute(QWebSettings::DisplayListRecordingEnabled, recordDisplayLists);
+    // Tiles are 512x512 and 4 bytes per pixel. The tiles furthest behind the scrolling go first.
+    webView->settings()->setTiledBackingStoreMemoryBudget(qint64(memoryBudgetInTiles) * 512 * 512 * 4);
+
+    // Text-heavy content so that every newly exposed tile takes a while to paint.
+    QString html = QLatin1String("<html><body>");
+    for (int i = 0; i < 2000; ++i)
+        html += QString("<p style='font-size: %1px'>Paragraph %2 of the tiled scrolling benchmark.</p>").arg(10 + i % 20).arg(i);
+    html += QLatin1String("</body></html>");
+
+    webView->setHtml(html);
+    ::waitForSignal(webView, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = webView->page()->mainFrame();
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = webView->geometry();
+    QImage image(option.exposedRect.toAlignedRect().size(), QImage::Format_ARGB32_Premultiplied);
+
+    // Scroll down by scrollStep pixels per 60Hz frame, and see how much of each frame could
+    // not be painted from tiles.
+    const int frameCount = 120;
+    qint64 totalCheckerboardedPixels = 0;
+    int maximumCheckerboardedPixels = 0;
+    QBENCHMARK_ONCE {
+        for (int frame = 0; frame < frameCount; ++frame) {
+            mainFrame->setScrollPosition(QPoint(0, frame * scrollStep));
+            QPainter painter(&image);
+            webView->paint(&painter, &option);
+            painter.end();
+
+            int checkerboardedPixels = checkerboardedPixelCount(image);
+            totalCheckerboardedPixels += checkerboardedPixels;
+            maximumCheckerboardedPixels = qMax(maximumCheckerboardedPixels, checkerboardedPixels);
+            QTest::qWait(16);
+        }
+    }
+
+    qreal viewportArea = image.width() * image.height();
+    qDebug("Checkerboarded area per frame: %.1f%% on average, %.1f%% at most",
+        100 * totalCheckerboardedPixels / (frameCount * viewportArea), 100 * maximumCheckerboardedPixels / viewportArea);
+}
+
 QTEST_MAIN(tst_Painting)
 #include "tst_painting.moc"
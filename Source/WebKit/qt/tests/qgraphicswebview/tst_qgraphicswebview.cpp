@@ -18,7 +18,9 @@
 */
 
 #include "../util.h"
+#include "../WebCoreSupport/DumpRenderTreeSupportQt.h"
 #include <QtTest/QtTest>
+#include <QFontDatabase>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 #include <QStyleOptionGraphicsItem>
@@ -43,6 +45,10 @@ private Q_SLOTS:
     void widgetsRenderingThroughCache();
     void windowResizeEvent();
     void horizontalScrollbarTest();
+    void displayListRecording();
+    void tileRasterizationOnWorkerThreads();
+    void tiledBackingStoreCoverRectFollowsScrolling();
+    void tiledBackingStoreMemoryBudget();
 
 #if !(defined(WTF_USE_QT_MOBILE_THEME) && WTF_USE_QT_MOBILE_THEME)
     void setPalette_data();
@@ -535,7 +541,6 @@ public:
     QGraphicsWebView* m_webView;
 };
 
-#if defined(ENABLE_WEBGL) && ENABLE_WEBGL
 bool compareImagesFuzzyPixelCount(const QImage& image1, const QImage& image2, qreal tolerance = 0.05)
 {
     if (image1.size() != image2.size())
@@ -554,6 +559,7 @@ bool compareImagesFuzzyPixelCount(const QImage& image1, const QImage& image2, qr
     return true;
 }
 
+#if defined(ENABLE_WEBGL) && ENABLE_WEBGL
 GraphicsView::GraphicsView()
 {
     QGraphicsScene* const scene = new QGraphicsScene(this);
@@ -722,6 +728,208 @@ void tst_QGraphicsWebView::horizontalScrollbarTest()
     delete view;
 }
 
+struct DisplayListStatistics {
+    DisplayListStatistics() : sizeInBytes(0), patchCount(0) { }
+    int sizeInBytes;
+    int patchCount;
+};
+
+static QImage renderCompositedPage(const QString& html, const QString& script, bool recordDisplayLists, DisplayListStatistics& statistics)
+{
+    QGraphicsView view;
+    QGraphicsScene* scene = new QGraphicsScene(&view);
+    view.setScene(scene);
+    QGraphicsWebView* webView = new QGraphicsWebView;
+    webView->page()->settings()->setAttribute(QWebSettings::AcceleratedCompositingEnabled, true);
+    webView->page()->settings()->setAttribute(QWebSettings::DisplayListRecordingEnabled, recordDisplayLists);
+    webView->setGeometry(QRectF(0, 0, 400, 300));
+    scene->addItem(webView);
+    view.resize(400, 300);
+    view.show();
+    QTest::qWaitForWindowExposed(&view);
+
+    webView->setHtml(html);
+    waitForSignal(webView, SIGNAL(loadFinished(bool)));
+
+    QImage image(400, 300, QImage::Format_ARGB32);
+    { // Force a render, to create the accelerated compositing tree.
+        QPainter painter(&image);
+        scene->render(&painter);
+    }
+
+    QWebFrame* frame = webView->page()->mainFrame();
+    frame->evaluateJavaScript(script);
+    QTest::qWait(100);
+
+    image.fill(Qt::white);
+    {
+        QPainter painter(&image);
+        scene->render(&painter);
+    }
+
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+    statistics.sizeInBytes = frame->evaluateJavaScript(QLatin1String("window.internals.displayListsSizeInBytes()")).toInt();
+    statistics.patchCount = frame->evaluateJavaScript(QLatin1String("window.internals.displayListPatchCount()")).toInt();
+    return image;
+}
+
+void tst_QGraphicsWebView::displayListRecording()
+{
+    // A composited layer larger than a display list cell, of which only a small part changes
+    // between the recording and the replay, so that the change is recorded as a patch.
+    QString html = QLatin1String("<html><body style='margin: 0'>"
+        "<div style='-webkit-transform: translateZ(0); width: 700px; height: 600px; background: -webkit-linear-gradient(top, yellow, blue)'>"
+        "<p style='font-size: 24px'>Recorded text</p><div id='changed' style='width: 50px; height: 50px; background-color: red'></div>"
+        "<p style='position: absolute; left: 300px; top: 200px; color: green'>Across a cell boundary</p>"
+        "</div></body></html>");
+    QString script = QLatin1String("document.getElementById('changed').style.backgroundColor = 'lime'");
+
+    DisplayListStatistics notRecorded;
+    QImage reference = renderCompositedPage(html, script, false, notRecorded);
+    QCOMPARE(notRecorded.sizeInBytes, 0);
+    QCOMPARE(notRecorded.patchCount, 0);
+
+    DisplayListStatistics recorded;
+    QImage replayed = renderCompositedPage(html, script, true, recorded);
+    QVERIFY(recorded.sizeInBytes > 0);
+    QVERIFY(recorded.patchCount > 0);
+
+    QVERIFY(compareImagesFuzzyPixelCount(replayed, reference, 0.01));
+}
+
+void tst_QGraphicsWebView::tileRasterizationOnWorkerThreads()
+{
+    QGraphicsView view;
+    QGraphicsScene* scene = new QGraphicsScene(&view);
+    view.setScene(scene);
+    QGraphicsWebView* webView = new QGraphicsWebView;
+    webView->settings()->setAttribute(QWebSettings::TiledBackingStoreEnabled, true);
+    webView->settings()->setAttribute(QWebSettings::DisplayListRecordingEnabled, true);
+    webView->setGeometry(QRectF(0, 0, 400, 300));
+    scene->addItem(webView);
+    view.resize(400, 300);
+    view.show();
+    QTest::qWaitForWindowExposed(&view);
+
+    // Text only, so whether the tiles can be rasterized on worker threads depends on the fonts alone.
+    QString html = QLatin1String("<html><body>");
+    for (int i = 0; i < 200; ++i)
+        html += QString("<p id='p%1'>Paragraph %1 rasterized from a recording.</p>").arg(i);
+    html += QLatin1String("</body></html>");
+    webView->setHtml(html);
+    QVERIFY(waitForSignal(webView, SIGNAL(loadFinished(bool))));
+
+    QWebFrame* frame = webView->page()->mainFrame();
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+    QTRY_VERIFY(frame->evaluateJavaScript(QLatin1String("internals.numberOfTilesPaintedInLastTileUpdate(document)")).toInt() > 0);
+
+    // Once the tiles around the visible rect are created, a change at the top updates a single tile.
+    QTest::qWait(500);
+    frame->evaluateJavaScript(QLatin1String("document.getElementById('p0').textContent = 'Changed paragraph'"));
+    QTRY_COMPARE(frame->evaluateJavaScript(QLatin1String("internals.numberOfTilesPaintedInLastTileUpdate(document)")).toInt(), 1);
+
+    int workerThreadTileCount = frame->evaluateJavaScript(QLatin1String("internals.numberOfTilesRasterizedOnWorkerThreadsInLastTileUpdate(document)")).toInt();
+    QCOMPARE(workerThreadTileCount, QFontDatabase::supportsThreadedFontRendering() ? 1 : 0);
+
+    double updateDuration = frame->evaluateJavaScript(QLatin1String("internals.lastTileUpdateDuration(document)")).toDouble();
+    double mainThreadDuration = frame->evaluateJavaScript(QLatin1String("internals.lastTileUpdateMainThreadDuration(document)")).toDouble();
+    QVERIFY(mainThreadDuration >= 0);
+    QVERIFY(mainThreadDuration <= updateDuration);
+}
+
+static QString tallTextPage()
+{
+    // Wider than the view too, so that the cover rect spans more than one column of tiles.
+    QString html = QLatin1String("<html><body style='width: 1200px'>");
+    for (int i = 0; i < 400; ++i)
+        html += QString("<p>Paragraph %1 of a page much taller than the view.</p>").arg(i);
+    html += QLatin1String("</body></html>");
+    return html;
+}
+
+static void paintWebView(QGraphicsWebView* webView)
+{
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = webView->geometry();
+    QImage image(option.exposedRect.toAlignedRect().size(), QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    webView->paint(&painter, &option);
+}
+
+void tst_QGraphicsWebView::tiledBackingStoreCoverRectFollowsScrolling()
+{
+    QGraphicsScene scene;
+    QGraphicsWebView* webView = new QGraphicsWebView;
+    scene.addItem(webView);
+    webView->setGeometry(QRectF(0, 0, 400, 300));
+    webView->settings()->setAttribute(QWebSettings::TiledBackingStoreEnabled, true);
+    webView->setHtml(tallTextPage());
+    QVERIFY(waitForSignal(webView, SIGNAL(loadFinished(bool))));
+
+    QWebFrame* frame = webView->page()->mainFrame();
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+    QString coverTop = QLatin1String("internals.tiledBackingStoreCoverRect(document).top");
+    QString coverBottom = QLatin1String("internals.tiledBackingStoreCoverRect(document).bottom");
+
+    // At rest the cover rect reaches as far above the view as below it.
+    frame->setScrollPosition(QPoint(0, 2000));
+    paintWebView(webView);
+    QTest::qWait(500);
+    paintWebView(webView);
+    QVERIFY(frame->evaluateJavaScript(coverTop).toInt() < 2000);
+    QVERIFY(frame->evaluateJavaScript(coverBottom).toInt() > 2300);
+
+    // Scrolling down moves all of it below the top of the view, at least twice as far ahead as at rest.
+    int scrollY = 2000;
+    for (int step = 0; step < 10; ++step) {
+        scrollY += 40;
+        frame->setScrollPosition(QPoint(0, scrollY));
+        paintWebView(webView);
+        QTest::qWait(16);
+    }
+    QVERIFY(frame->evaluateJavaScript(coverTop).toInt() >= scrollY);
+    QVERIFY(frame->evaluateJavaScript(coverBottom).toInt() >= scrollY + 300 + 300);
+
+    // Once scrolling stops, the cover rect goes back to covering all directions.
+    QTRY_VERIFY(frame->evaluateJavaScript(coverTop).toInt() < scrollY);
+}
+
+void tst_QGraphicsWebView::tiledBackingStoreMemoryBudget()
+{
+    QGraphicsScene scene;
+    QGraphicsWebView* webView = new QGraphicsWebView;
+    scene.addItem(webView);
+    webView->setGeometry(QRectF(0, 0, 400, 300));
+    webView->settings()->setAttribute(QWebSettings::TiledBackingStoreEnabled, true);
+    webView->setHtml(tallTextPage());
+    QVERIFY(waitForSignal(webView, SIGNAL(loadFinished(bool))));
+
+    QWebFrame* frame = webView->page()->mainFrame();
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+    QString tileCount = QLatin1String("internals.numberOfTilesInBackingStore(document)");
+
+    // Without a budget, the tiles around the view are all created.
+    frame->setScrollPosition(QPoint(0, 2000));
+    paintWebView(webView);
+    QTRY_VERIFY(frame->evaluateJavaScript(tileCount).toInt() > 2);
+
+    // With room for two 512x512 tiles, the view, which spans at most two of them, stays covered
+    // and nothing else is kept, wherever it scrolls to.
+    const qint64 bytesPerTile = 512 * 512 * 4;
+    webView->settings()->setTiledBackingStoreMemoryBudget(2 * bytesPerTile);
+    QCOMPARE(webView->settings()->tiledBackingStoreMemoryBudget(), 2 * bytesPerTile);
+    for (int scrollY = 0; scrollY < 6000; scrollY += 250) {
+        frame->setScrollPosition(QPoint(0, scrollY));
+        paintWebView(webView);
+        QTest::qWait(20);
+        int count = frame->evaluateJavaScript(tileCount).toInt();
+        QVERIFY(count >= 1);
+        QVERIFY(count <= 2);
+    }
+
+    webView->settings()->setTiledBackingStoreMemoryBudget(0);
+}
+
 QTEST_MAIN(tst_QGraphicsWebView)
 
 #include "tst_qgraphicswebview.moc"
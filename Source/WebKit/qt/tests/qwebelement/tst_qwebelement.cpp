@@ -25,6 +25,7 @@
 #include <qwebframe.h>
 #include <qwebelement.h>
 #include <util.h>
+#include "../WebCoreSupport/DumpRenderTreeSupportQt.h"
 //TESTED_CLASS=
 //TESTED_FILES=
 
@@ -42,6 +43,11 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void textHtml();
+    void characterReferences_data();
+    void characterReferences();
+    void mixedWidthCharacters_data();
+    void mixedWidthCharacters();
+    void parsedTextNodes();
     void simpleCollection();
     void attributes();
     void attributesNS();
@@ -59,6 +65,14 @@ private Q_SLOTS:
     void frame();
     void style();
     void computedStyle();
+    void strictContainment();
+    void measuredFlexItemHeight();
+    void styleAttributeDeclarations();
+    void sharedInlineStyleSheets();
+    void attributeSelectorRules();
+    void querySelectorAllWithAncestorId();
+    void querySelectorAllAfterMutation();
+    void simpleLineLayoutMatchesLineBoxes();
     void appendAndPrepend();
     void insertBeforeAndAfter();
     void remove();
@@ -112,6 +126,122 @@ void tst_QWebElement::textHtml()
     QCOMPARE(body.toInnerXml(), html);
 }
 
+void tst_QWebElement::characterReferences_data()
+{
+    QTest::addColumn<QString>("html");
+    QTest::addColumn<QString>("property");
+    QTest::addColumn<QString>("expected");
+
+    // The text after each reference is long enough for the tokenizer to scan it in bulk. Failed
+    // references push characters back into the input, which must be read before that text.
+    const QString run = QLatin1String(" and some ordinary text after it");
+
+    QTest::newRow("data") << "<p id='t'>a &amp; b" + run << "textContent" << "a & b" + run;
+    QTest::newRow("data, bare ampersand") << "<p id='t'>a & b" + run << "textContent" << "a & b" + run;
+    QTest::newRow("data, unknown name") << "<p id='t'>a &unknown; b" + run << "textContent" << "a &unknown; b" + run;
+    QTest::newRow("data, failed numeric") << "<p id='t'>a &#; &#x; b" + run << "textContent" << "a &#; &#x; b" + run;
+    QTest::newRow("data, prefix match") << "<p id='t'>a &notit; &ampx b" + run << "textContent" << QString::fromUtf8("a ¬it; &x b") + run;
+    QTest::newRow("RCDATA") << "<textarea id='t'>a &amp; b" + run + "</textarea>" << "value" << "a & b" + run;
+    QTest::newRow("RCDATA, failed references") << "<textarea id='t'>a &unknown; &#; &notit; b" + run + "</textarea>" << "value"
+        << QString::fromUtf8("a &unknown; &#; ¬it; b") + run;
+    QTest::newRow("double quoted attribute") << "<p id='t' title=\"a &amp; b" + run + "\">" << "title" << "a & b" + run;
+    QTest::newRow("double quoted attribute, failed references") << "<p id='t' title=\"a &unknown; &#; &notit; &ampx b" + run + "\">" << "title"
+        << "a &unknown; &#; &notit; &ampx b" + run;
+    QTest::newRow("single quoted attribute") << "<p id='t' title='a &amp; b" + run + "'>" << "title" << "a & b" + run;
+    QTest::newRow("single quoted attribute, failed references") << "<p id='t' title='a &unknown; &#; &notit; &ampx b" + run + "'>" << "title"
+        << "a &unknown; &#; &notit; &ampx b" + run;
+}
+
+void tst_QWebElement::characterReferences()
+{
+    QFETCH(QString, html);
+    QFETCH(QString, property);
+    QFETCH(QString, expected);
+
+    m_mainFrame->setHtml(html);
+    QWebElement element = m_mainFrame->findFirstElement("#t");
+    QVERIFY(!element.isNull());
+    QCOMPARE(element.evaluateJavaScript("this." + property).toString(), expected);
+}
+
+void tst_QWebElement::mixedWidthCharacters_data()
+{
+    QTest::addColumn<QString>("html");
+    QTest::addColumn<QString>("property");
+    QTest::addColumn<QString>("expected");
+
+    // Character tokens are buffered 8-bit until the first character outside Latin-1, which moves
+    // what was buffered so far into a 16-bit buffer. Each row puts that character somewhere else.
+    const QString latin1 = QString::fromUtf8("café crème and some ordinary text");
+    const QString wide = QString::fromUtf8("☺");
+
+    QTest::newRow("Latin-1 only") << "<p id='t'>" + latin1 + "</p>" << "textContent" << latin1;
+    QTest::newRow("wide first") << "<p id='t'>" + wide + latin1 + "</p>" << "textContent" << wide + latin1;
+    QTest::newRow("wide in the middle") << "<p id='t'>" + latin1 + wide + latin1 + "</p>" << "textContent" << latin1 + wide + latin1;
+    QTest::newRow("wide last") << "<p id='t'>" + latin1 + wide + "</p>" << "textContent" << latin1 + wide;
+    QTest::newRow("wide from a reference") << "<p id='t'>" + latin1 + "&#x263a;" + latin1 + "</p>" << "textContent" << latin1 + wide + latin1;
+    QTest::newRow("Latin-1 after a wide token") << "<p id='t'><b>" + wide + "</b>" + latin1 + "</p>" << "textContent" << wide + latin1;
+    QTest::newRow("RCDATA") << "<textarea id='t'>" + latin1 + wide + latin1 + "</textarea>" << "value" << latin1 + wide + latin1;
+    QTest::newRow("script data") << "<script id='t'>// " + latin1 + wide + latin1 + "</script>" << "text" << "// " + latin1 + wide + latin1;
+    QTest::newRow("comment") << "<p id='t'><!--" + latin1 + wide + latin1 + "--></p>" << "firstChild.data" << latin1 + wide + latin1;
+    QTest::newRow("attribute") << "<p id='t' title='" + latin1 + wide + latin1 + "'></p>" << "title" << latin1 + wide + latin1;
+}
+
+void tst_QWebElement::mixedWidthCharacters()
+{
+    QFETCH(QString, html);
+    QFETCH(QString, property);
+    QFETCH(QString, expected);
+
+    // about:blank is parsed on the main thread, other URLs may be parsed on the parser thread.
+    m_mainFrame->setHtml(html);
+    QCOMPARE(m_mainFrame->findFirstElement("#t").evaluateJavaScript("this." + property).toString(), expected);
+    m_mainFrame->setHtml(html, QUrl("http://localhost/"));
+    QCOMPARE(m_mainFrame->findFirstElement("#t").evaluateJavaScript("this." + property).toString(), expected);
+
+    // Fragments go through their own tokenizer.
+    QWebElement body = m_mainFrame->findFirstElement("body");
+    body.setInnerXml(QString());
+    body.appendInside(html);
+    QCOMPARE(m_mainFrame->findFirstElement("#t").evaluateJavaScript("this." + property).toString(), expected);
+}
+
+void tst_QWebElement::parsedTextNodes()
+{
+    m_mainFrame->setHtml("<body><p id='t'></p></body>");
+
+    // Text written in several pieces goes into the tree as one node.
+    m_mainFrame->evaluateJavaScript(
+        "var other = document.implementation.createHTMLDocument('');"
+        "other.open();"
+        "other.write('<p id=a>one ');"
+        "other.write('two ');"
+        "other.write('three</p><p id=b>four</p>');"
+        "other.close();");
+    QCOMPARE(m_mainFrame->evaluateJavaScript("other.getElementById('a').childNodes.length").toInt(), 1);
+    QCOMPARE(m_mainFrame->evaluateJavaScript("other.getElementById('a').firstChild.data").toString(), QLatin1String("one two three"));
+
+    // Parsed text nodes keep working after they are adopted into another document and the
+    // document that parsed them goes away.
+    m_mainFrame->evaluateJavaScript(
+        "var t = document.getElementById('t');"
+        "t.appendChild(document.adoptNode(other.getElementById('a').firstChild));"
+        "var kept = other.getElementById('b').firstChild;"
+        "other = null;");
+    DumpRenderTreeSupportQt::garbageCollectorCollect();
+    QVERIFY(m_mainFrame->evaluateJavaScript("t.firstChild.ownerDocument === document").toBool());
+    QCOMPARE(m_mainFrame->evaluateJavaScript("t.textContent").toString(), QLatin1String("one two three"));
+    QCOMPARE(m_mainFrame->evaluateJavaScript("kept.data").toString(), QLatin1String("four"));
+    m_mainFrame->evaluateJavaScript("t.appendChild(kept); t.firstChild.appendData(' and');");
+    QCOMPARE(m_mainFrame->findFirstElement("#t").toPlainText(), QLatin1String("one two three andfour"));
+
+    // So do text nodes created by innerHTML once the document has finished parsing.
+    m_mainFrame->evaluateJavaScript("t.innerHTML = 'five <b>six</b> seven'; var five = t.firstChild; t.innerHTML = '';");
+    DumpRenderTreeSupportQt::garbageCollectorCollect();
+    QCOMPARE(m_mainFrame->evaluateJavaScript("five.data").toString(), QLatin1String("five "));
+    QVERIFY(m_mainFrame->evaluateJavaScript("five.parentNode === null").toBool());
+}
+
 void tst_QWebElement::simpleCollection()
 {
     QString html = "<body><p>first para</p><p>second para</p></body>";
@@ -606,6 +736,291 @@ void tst_QWebElement::computedStyle()
     QCOMPARE(p.styleProperty("color", QWebElement::InlineStyle), QLatin1String("red"));
 }
 
+void tst_QWebElement::strictContainment()
+{
+    QString html = "<head><style>"
+        ".widget { width: 200px; height: 100px }"
+        ".strict { -webkit-contain: strict }"
+    "</style></head>"
+    "<body>"
+        "<div id='a' class='widget strict'><p id='ta'>a</p><p>a</p></div>"
+        "<div id='b' class='widget strict'><p id='tb'>b</p></div>"
+        "<div id='c' class='widget'><p id='tc'>c</p></div>"
+        "<div id='sized' class='strict' style='width: 100px'><p>content</p></div>"
+        "<p id='after'>after</p>"
+    "</body>";
+    m_mainFrame->setHtml(html);
+    DumpRenderTreeSupportQt::injectInternalsObject(m_mainFrame->handle());
+
+    // The property is not inherited and defaults to none.
+    QWebElement a = m_mainFrame->findFirstElement("#a");
+    QWebElement c = m_mainFrame->findFirstElement("#c");
+    QCOMPARE(a.styleProperty("-webkit-contain", QWebElement::ComputedStyle), QLatin1String("strict"));
+    QCOMPARE(m_mainFrame->findFirstElement("#ta").styleProperty("-webkit-contain", QWebElement::ComputedStyle), QLatin1String("none"));
+    QCOMPARE(c.styleProperty("-webkit-contain", QWebElement::ComputedStyle), QLatin1String("none"));
+
+    // Only none and strict parse.
+    c.setStyleProperty("-webkit-contain", "strict");
+    QCOMPARE(c.styleProperty("-webkit-contain", QWebElement::InlineStyle), QLatin1String("strict"));
+    c.setStyleProperty("-webkit-contain", "layout");
+    QCOMPARE(c.styleProperty("-webkit-contain", QWebElement::InlineStyle), QLatin1String("strict"));
+    c.setStyleProperty("-webkit-contain", "none");
+    QCOMPARE(c.styleProperty("-webkit-contain", QWebElement::InlineStyle), QLatin1String("none"));
+    QCOMPARE(c.styleProperty("-webkit-contain", QWebElement::ComputedStyle), QLatin1String("none"));
+
+    // A contained box sizes as if it were empty.
+    QCOMPARE(m_mainFrame->evaluateJavaScript("document.getElementById('sized').offsetHeight").toInt(), 0);
+
+    // Changes inside a contained box only lay out its subtree, and do not move what follows it.
+    int afterTop = m_mainFrame->evaluateJavaScript("document.getElementById('after').offsetTop").toInt();
+    m_mainFrame->evaluateJavaScript("document.getElementById('ta').textContent = new Array(200).join('grow '); document.body.offsetTop");
+    QCOMPARE(m_mainFrame->evaluateJavaScript("internals.numberOfLayoutRootsInLastLayout(document)").toInt(), 1);
+    int containedCount = m_mainFrame->evaluateJavaScript("internals.numberOfRenderersLaidOutInLastLayout(document)").toInt();
+    QVERIFY(containedCount > 0);
+    QCOMPARE(m_mainFrame->evaluateJavaScript("document.getElementById('after').offsetTop").toInt(), afterTop);
+
+    m_mainFrame->evaluateJavaScript("document.getElementById('tc').textContent = 'changed'; document.body.offsetTop");
+    QVERIFY(m_mainFrame->evaluateJavaScript("internals.numberOfRenderersLaidOutInLastLayout(document)").toInt() > containedCount);
+
+    // Unrelated contained boxes are laid out in the same pass as separate roots.
+    m_mainFrame->evaluateJavaScript("document.getElementById('ta').textContent = 'a'; document.getElementById('tb').textContent = 'b2'; document.body.offsetTop");
+    QCOMPARE(m_mainFrame->evaluateJavaScript("internals.numberOfLayoutRootsInLastLayout(document)").toInt(), 2);
+    QCOMPARE(m_mainFrame->evaluateJavaScript("document.getElementById('after').offsetTop").toInt(), afterTop);
+}
+
+void tst_QWebElement::measuredFlexItemHeight()
+{
+    // Column flexboxes remember how tall their items measured. The remembered height must follow
+    // changes inside the item and changes of the width it is measured at.
+    QString html = "<body>"
+        "<div id='outer' style='display: -webkit-flex; -webkit-flex-direction: column; width: 200px; font: 16px sans-serif'>"
+            "<div id='inner' style='display: -webkit-flex; -webkit-flex-direction: column'><p id='leaf' style='margin: 0'>one</p></div>"
+            "<p id='status' style='margin: 0'>status</p>"
+        "</div>"
+    "</body>";
+    m_mainFrame->setHtml(html);
+
+    const QString innerHeight = "document.getElementById('inner').offsetHeight";
+    const QString outerHeight = "document.getElementById('outer').offsetHeight";
+    const QString statusHeight = "document.getElementById('status').offsetHeight";
+    int oneLine = m_mainFrame->evaluateJavaScript(innerHeight).toInt();
+    QVERIFY(oneLine > 0);
+
+    // A change next to the item lays out the flexbox again without changing the item.
+    m_mainFrame->evaluateJavaScript("document.getElementById('status').textContent = 'changed'");
+    QCOMPARE(m_mainFrame->evaluateJavaScript(innerHeight).toInt(), oneLine);
+
+    m_mainFrame->evaluateJavaScript("document.getElementById('leaf').textContent = new Array(20).join('word ')");
+    int wrapped = m_mainFrame->evaluateJavaScript(innerHeight).toInt();
+    QVERIFY(wrapped > oneLine);
+    QCOMPARE(m_mainFrame->evaluateJavaScript(outerHeight).toInt(), wrapped + m_mainFrame->evaluateJavaScript(statusHeight).toInt());
+
+    m_mainFrame->evaluateJavaScript("document.getElementById('outer').style.width = '100px'");
+    QVERIFY(m_mainFrame->evaluateJavaScript(innerHeight).toInt() > wrapped);
+
+    m_mainFrame->evaluateJavaScript("document.getElementById('leaf').textContent = 'one'");
+    QCOMPARE(m_mainFrame->evaluateJavaScript(innerHeight).toInt(), oneLine);
+    QCOMPARE(m_mainFrame->evaluateJavaScript(outerHeight).toInt(), oneLine + m_mainFrame->evaluateJavaScript(statusHeight).toInt());
+}
+
+void tst_QWebElement::styleAttributeDeclarations()
+{
+    // Plain lists of lengths, colors and keywords skip the CSS grammar, everything else goes through
+    // it. Both must give the same declarations.
+    QString html = "<body>"
+        "<p id='simple' style='width: 10px; color: red; display: block'></p>"
+        "<p id='repeated' style='width: 10px; height: 5px; width: 20px'></p>"
+        "<p id='important' style='width: 10px; color: red !important'></p>"
+        "<p id='invalid' style='width: 10px; color: nonsense; height: 5px'></p>"
+        "<p id='function' style='color: rgb(0, 128, 0); width: 10px'></p>"
+    "</body>";
+    m_mainFrame->setHtml(html);
+
+    QWebElement body = m_mainFrame->documentElement().findFirst("body");
+    QCOMPARE(body.findFirst("#simple").evaluateJavaScript("this.style.cssText").toString(), QLatin1String("width: 10px; color: red; display: block;"));
+    QCOMPARE(body.findFirst("#repeated").evaluateJavaScript("this.style.cssText").toString(), QLatin1String("height: 5px; width: 20px;"));
+    QCOMPARE(body.findFirst("#important").evaluateJavaScript("this.style.cssText").toString(), QLatin1String("width: 10px; color: red !important;"));
+    QCOMPARE(body.findFirst("#invalid").evaluateJavaScript("this.style.cssText").toString(), QLatin1String("width: 10px; height: 5px;"));
+    QCOMPARE(body.findFirst("#function").evaluateJavaScript("this.style.cssText").toString(), QLatin1String("color: rgb(0, 128, 0); width: 10px;"));
+
+    QCOMPARE(body.findFirst("#simple").styleProperty("width", QWebElement::ComputedStyle), QLatin1String("10px"));
+    QCOMPARE(body.findFirst("#simple").styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(255, 0, 0)"));
+}
+
+void tst_QWebElement::sharedInlineStyleSheets()
+{
+    // Identical <style> blocks starting on the same line share their parsed contents.
+    QString style = "<style>#p { color: rgb(0, 128, 0) }</style>";
+    m_mainFrame->setHtml("<head>" + style + style + "</head><body><p id='p'>some text</p></body>");
+    DumpRenderTreeSupportQt::injectInternalsObject(m_mainFrame->handle());
+    QVERIFY(m_mainFrame->evaluateJavaScript("internals.styleSheetContentsAreShared(document.styleSheets[0], document.styleSheets[1])").toBool());
+
+    // Changing one of them from script must leave the other alone.
+    m_mainFrame->evaluateJavaScript("document.styleSheets[0].cssRules[0].style.color = 'red'");
+    QVERIFY(!m_mainFrame->evaluateJavaScript("internals.styleSheetContentsAreShared(document.styleSheets[0], document.styleSheets[1])").toBool());
+    QCOMPARE(m_mainFrame->evaluateJavaScript("document.styleSheets[1].cssRules[0].style.color").toString(), QLatin1String("rgb(0, 128, 0)"));
+
+    // New text is parsed again.
+    QWebElement p = m_mainFrame->findFirstElement("#p");
+    QCOMPARE(p.styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(0, 128, 0)"));
+    m_mainFrame->evaluateJavaScript("document.getElementsByTagName('style')[1].textContent = '#p { color: rgb(0, 0, 255) }'");
+    QCOMPARE(p.styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(0, 0, 255)"));
+
+    // Relative URLs resolve against the base URL of each document, even when the text is the same.
+    QString html = "<head><style>#p { background-image: url(background.png) }</style></head><body><p id='p'></p></body>";
+    m_mainFrame->setHtml(html, QUrl("http://a.example/"));
+    QCOMPARE(m_mainFrame->findFirstElement("#p").styleProperty("background-image", QWebElement::ComputedStyle), QLatin1String("url(http://a.example/background.png)"));
+    m_mainFrame->setHtml(html, QUrl("http://b.example/"));
+    QCOMPARE(m_mainFrame->findFirstElement("#p").styleProperty("background-image", QWebElement::ComputedStyle), QLatin1String("url(http://b.example/background.png)"));
+}
+
+void tst_QWebElement::attributeSelectorRules()
+{
+    // Attribute names match case-insensitively on HTML elements and exactly on SVG elements.
+    QString html = "<head><style>"
+        "[data-state=open] { color: rgb(0, 128, 0) }"
+        "[DATA-LEVEL] { width: 10px }"
+        "[viewBox] { opacity: 0.5 }"
+        "[viewbox] { opacity: 0.25 }"
+    "</style></head>"
+    "<body>"
+        "<p id='open' data-state='open'>open</p>"
+        "<p id='closed' data-state='closed'>closed</p>"
+        "<p id='level' data-level='1'>level</p>"
+        "<svg id='svg' viewBox='0 0 10 10' width='10' height='10'></svg>"
+    "</body>";
+    m_mainFrame->setHtml(html);
+    DumpRenderTreeSupportQt::injectInternalsObject(m_mainFrame->handle());
+
+    // None of the rules is tested against every element.
+    QCOMPARE(m_mainFrame->evaluateJavaScript("internals.numberOfUniversalAuthorStyleRules(document)").toInt(), 0);
+
+    QWebElement closed = m_mainFrame->findFirstElement("#closed");
+    QCOMPARE(m_mainFrame->findFirstElement("#open").styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(0, 128, 0)"));
+    QCOMPARE(closed.styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(0, 0, 0)"));
+    QCOMPARE(m_mainFrame->findFirstElement("#level").styleProperty("width", QWebElement::ComputedStyle), QLatin1String("10px"));
+    QCOMPARE(m_mainFrame->findFirstElement("#svg").styleProperty("opacity", QWebElement::ComputedStyle), QLatin1String("0.5"));
+
+    closed.setAttribute("data-state", "open");
+    QCOMPARE(closed.styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(0, 128, 0)"));
+}
+
+static QString matchedIds(QWebFrame* frame, const QString& query)
+{
+    return frame->evaluateJavaScript(QString("Array.prototype.map.call(%1, function(e) { return e.id; }).join(' ')").arg(query)).toString();
+}
+
+void tst_QWebElement::querySelectorAllWithAncestorId()
+{
+    // Traversal starts at the element with the id, or at its parent for sibling combinators.
+    QString html = "<!DOCTYPE html><body>"
+        "<div id='outer'><span id='s1'></span>"
+            "<div id='inner'><span id='s2'></span></div>"
+            "<p id='first'></p><span id='s3'></span>"
+        "</div>"
+        "<span id='s4'></span>"
+        "<div id='dup'><span id='s5'></span></div><div id='dup'><span id='s6'></span></div>"
+    "</body>";
+    m_mainFrame->setHtml(html);
+
+    QCOMPARE(matchedIds(m_mainFrame, "document.querySelectorAll('#outer span')"), QString("s1 s2 s3"));
+    QCOMPARE(matchedIds(m_mainFrame, "document.querySelectorAll('#inner > span')"), QString("s2"));
+    QCOMPARE(matchedIds(m_mainFrame, "document.querySelectorAll('#first + span')"), QString("s3"));
+    QCOMPARE(matchedIds(m_mainFrame, "document.querySelectorAll('#first ~ span, #outer > #inner span')"), QString("s2 s3"));
+    QCOMPARE(matchedIds(m_mainFrame, "document.querySelectorAll('#missing span')"), QString(""));
+
+    // Ids that are not unique do not narrow the search.
+    QCOMPARE(matchedIds(m_mainFrame, "document.querySelectorAll('#dup span')"), QString("s5 s6"));
+
+    // Matches stay inside the root, whether the element with the id is inside it or an ancestor of it.
+    QCOMPARE(matchedIds(m_mainFrame, "document.getElementById('inner').querySelectorAll('#outer span')"), QString("s2"));
+    QCOMPARE(matchedIds(m_mainFrame, "document.getElementById('outer').querySelectorAll('#inner span')"), QString("s2"));
+    QCOMPARE(matchedIds(m_mainFrame, "document.getElementById('inner').querySelectorAll('#s4 span')"), QString(""));
+}
+
+void tst_QWebElement::querySelectorAllAfterMutation()
+{
+    // Results of selectors made of tags, ids and classes are reused until the DOM changes.
+    m_mainFrame->setHtml("<body><div id='list'><p id='a' class='item'></p><p id='b' class='item'></p></div></body>");
+
+    const QString query = "document.querySelectorAll('#list .item')";
+    QCOMPARE(matchedIds(m_mainFrame, query), QString("a b"));
+    QVERIFY(!m_mainFrame->evaluateJavaScript(QString("%1 === %1").arg(query)).toBool());
+
+    m_mainFrame->evaluateJavaScript("var c = document.createElement('p'); c.id = 'c'; c.className = 'item'; document.getElementById('list').appendChild(c)");
+    QCOMPARE(matchedIds(m_mainFrame, query), QString("a b c"));
+
+    m_mainFrame->evaluateJavaScript("document.getElementById('a').className = 'other'");
+    QCOMPARE(matchedIds(m_mainFrame, query), QString("b c"));
+
+    // A removed element must not come back, even while script keeps it alive.
+    m_mainFrame->evaluateJavaScript("var removed = document.getElementById('b'); removed.parentNode.removeChild(removed)");
+    QCOMPARE(matchedIds(m_mainFrame, query), QString("c"));
+
+    m_mainFrame->evaluateJavaScript("document.getElementById('list').innerHTML = ''");
+    QCOMPARE(matchedIds(m_mainFrame, query), QString(""));
+    QCOMPARE(m_mainFrame->evaluateJavaScript("removed.className").toString(), QString("item"));
+}
+
+void tst_QWebElement::simpleLineLayoutMatchesLineBoxes()
+{
+    // The shadow keeps the second paragraph off the simple line layout without changing its geometry.
+    const QString text = "Lorem ipsum dolor sit amet,  consectetur adipiscing elit, sed do eiusmod tempor "
+        "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation.";
+    QString html = QString("<body style='margin: 0'><div id='container' style='width: 200px; font: 16px sans-serif'>"
+        "<p id='simple'>%1</p>"
+        "<p id='full' style='text-shadow: 0 0 0 transparent'>%1</p>"
+    "</div>"
+    "<script>"
+        "function origin(p) { return p.getBoundingClientRect(); }"
+        "function textGeometry(id) {"
+            "var p = document.getElementById(id), o = origin(p), range = document.createRange(), out = [];"
+            "range.setStart(p.firstChild, 6); range.setEnd(p.firstChild, 140);"
+            "var rects = range.getClientRects();"
+            "for (var i = 0; i < rects.length; ++i)"
+                "out.push([rects[i].left - o.left, rects[i].top - o.top, rects[i].width, rects[i].height].join(','));"
+            "return out.join(' ');"
+        "}"
+        "function selection(id) {"
+            "var p = document.getElementById(id), o = origin(p), s = window.getSelection();"
+            "s.setBaseAndExtent(p.firstChild, 12, p.firstChild, 100);"
+            "var box = s.getRangeAt(0).getBoundingClientRect(), result = s.toString() + '|' + [box.left - o.left, box.top - o.top, box.width, box.height].join(',');"
+            "s.removeAllRanges();"
+            "return result;"
+        "}"
+        "function caretOffset(id) {"
+            "var o = origin(document.getElementById(id));"
+            "return document.caretRangeFromPoint(o.left + 60, o.top + 30).startOffset;"
+        "}"
+    "</script></body>").arg(text);
+    m_mainFrame->setHtml(html);
+    DumpRenderTreeSupportQt::injectInternalsObject(m_mainFrame->handle());
+
+    QVERIFY(m_mainFrame->evaluateJavaScript("internals.usesSimpleLineLayout(document.getElementById('simple'))").toBool());
+    QVERIFY(!m_mainFrame->evaluateJavaScript("internals.usesSimpleLineLayout(document.getElementById('full'))").toBool());
+
+    const char* widths[] = { "200px", "310px" };
+    for (size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i) {
+        m_mainFrame->evaluateJavaScript(QString("document.getElementById('container').style.width = '%1'").arg(widths[i]));
+        // Laying the block out again returns it to the simple line layout, even after queries that needed line boxes.
+        QVERIFY(m_mainFrame->evaluateJavaScript("internals.usesSimpleLineLayout(document.getElementById('simple'))").toBool());
+
+        QVariant simpleHeight = m_mainFrame->evaluateJavaScript("document.getElementById('simple').offsetHeight");
+        QCOMPARE(simpleHeight, m_mainFrame->evaluateJavaScript("document.getElementById('full').offsetHeight"));
+        QVERIFY(simpleHeight.toInt() > 40);
+
+        QString geometry = m_mainFrame->evaluateJavaScript("textGeometry('simple')").toString();
+        QVERIFY(!geometry.isEmpty());
+        QCOMPARE(geometry, m_mainFrame->evaluateJavaScript("textGeometry('full')").toString());
+        QCOMPARE(m_mainFrame->evaluateJavaScript("selection('simple')"), m_mainFrame->evaluateJavaScript("selection('full')"));
+        QCOMPARE(m_mainFrame->evaluateJavaScript("caretOffset('simple')"), m_mainFrame->evaluateJavaScript("caretOffset('full')"));
+        QCOMPARE(m_mainFrame->evaluateJavaScript("document.getElementById('simple').innerText"), m_mainFrame->evaluateJavaScript("document.getElementById('full').innerText"));
+
+        // Building line boxes for the queries kept the block's size.
+        QCOMPARE(m_mainFrame->evaluateJavaScript("document.getElementById('simple').offsetHeight"), simpleHeight);
+    }
+}
+
 void tst_QWebElement::appendAndPrepend()
 {
     QString html = "<body>"
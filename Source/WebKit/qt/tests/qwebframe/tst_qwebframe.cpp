@@ -27,6 +27,7 @@
 #include <qwebhistory.h>
 #include <QAbstractItemView>
 #include <QApplication>
+#include <QBuffer>
 #include <QComboBox>
 #include <QPaintEngine>
 #include <QPicture>
@@ -38,6 +39,7 @@
 #include <qsslerror.h>
 #endif
 #include "../util.h"
+#include "../WebCoreSupport/DumpRenderTreeSupportQt.h"
 
 class tst_QWebFrame : public QObject
 {
@@ -62,6 +64,8 @@ private Q_SLOTS:
     void javaScriptWindowObjectClearedOnEvaluate();
     void setHtml();
     void setHtmlWithImageResource();
+    void navigateAwayFromLoadingImage();
+    void resourceLoadScheduling();
     void setHtmlWithStylesheetResource();
     void setHtmlWithBaseURL();
     void setHtmlWithJSAlert();
@@ -72,6 +76,8 @@ private Q_SLOTS:
 #endif
     void inputFieldFocus();
     void hitTestContent();
+    void deferredTableRowsGeometry();
+    void deferredTableRowsAfterResize();
     void baseUrl_data();
     void baseUrl();
     void hasSetFocus();
@@ -83,6 +89,12 @@ private Q_SLOTS:
     void evaluateWillCauseRepaint();
     void setContent_data();
     void setContent();
+    void setContentDetectsEncoding_data();
+    void setContentDetectsEncoding();
+    void xssAuditorUsesDetectedEncoding();
+    void preloadStyleSheetSubresources();
+    void incrementallyDecodedStyleSheet();
+    void subresourcesLoadWithoutLinearizing();
     void setCacheLoadControlAttribute();
     void setUrlWithPendingLoads();
     void setUrlWithFragment_data();
@@ -425,6 +437,137 @@ void tst_QWebFrame::setHtmlWithImageResource()
     QCOMPARE(frame->evaluateJavaScript("document.images[0].height").toInt(), 0);
 }
 
+// A reply that sends nothing and never finishes, so that the resource stays loading.
+class PendingReply : public QNetworkReply {
+public:
+    PendingReply(const QNetworkRequest& request, QObject* parent)
+        : QNetworkReply(parent)
+    {
+        setOperation(QNetworkAccessManager::GetOperation);
+        setRequest(request);
+        setUrl(request.url());
+        open(QIODevice::ReadOnly);
+    }
+
+    virtual void abort() { }
+
+protected:
+    qint64 readData(char*, qint64)
+    {
+        return 0;
+    }
+};
+
+class PendingImageNetworkManager : public QNetworkAccessManager {
+public:
+    PendingImageNetworkManager()
+        : m_imageRequested(false)
+    {
+    }
+
+    bool imageRequested() const { return m_imageRequested; }
+
+protected:
+    virtual QNetworkReply* createRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+    {
+        if (request.url().path() == QLatin1String("/pending.png")) {
+            m_imageRequested = true;
+            return new PendingReply(request, this);
+        }
+        return QNetworkAccessManager::createRequest(op, request, outgoingData);
+    }
+
+private:
+    bool m_imageRequested;
+};
+
+void tst_QWebFrame::navigateAwayFromLoadingImage()
+{
+    PendingImageNetworkManager manager;
+    QWebPage* page = new QWebPage;
+    page->setNetworkAccessManager(&manager);
+    QWebFrame* frame = page->mainFrame();
+
+    frame->setHtml("<html><body><img width=100 height=100 src='pending.png'></body></html>", QUrl("http://www.example.com/"));
+    QTRY_VERIFY(manager.imageRequested());
+    // Lay the image out while it is still loading, so that the view keeps track of it.
+    QCOMPARE(frame->evaluateJavaScript("document.images[0].offsetWidth").toInt(), 100);
+    QVERIFY(!frame->evaluateJavaScript("document.images[0].complete").toBool());
+
+    // Tearing down the document destroys the image after the document has let go of its view.
+    frame->setHtml("<html><body><p>Next page</p></body></html>");
+    QVERIFY(::waitForSignal(frame, SIGNAL(loadFinished(bool))));
+    QCOMPARE(frame->toPlainText(), QString("Next page"));
+
+    frame->setHtml("<html><body><img width=100 height=100 src='pending.png'></body></html>", QUrl("http://www.example.com/"));
+    QCOMPARE(frame->evaluateJavaScript("document.images[0].offsetWidth").toInt(), 100);
+    delete page;
+}
+
+// Keeps every request pending and counts them per host.
+class PendingNetworkManager : public QNetworkAccessManager {
+public:
+    int requestCount() const { return m_requestedURLs.size(); }
+    int requestCount(const QString& host) const { return m_requestCountPerHost.value(host); }
+    bool requested(const QString& url) const { return m_requestedURLs.contains(url); }
+
+protected:
+    virtual QNetworkReply* createRequest(Operation, const QNetworkRequest& request, QIODevice*)
+    {
+        m_requestedURLs.insert(request.url().toString());
+        ++m_requestCountPerHost[request.url().host()];
+        return new PendingReply(request, this);
+    }
+
+private:
+    QSet<QString> m_requestedURLs;
+    QHash<QString, int> m_requestCountPerHost;
+};
+
+void tst_QWebFrame::resourceLoadScheduling()
+{
+    PendingNetworkManager manager;
+    QWebPage page;
+    page.setNetworkAccessManager(&manager);
+    page.setViewportSize(QSize(800, 600));
+    QWebFrame* frame = page.mainFrame();
+
+    // Far more images than the connection budget of all hosts together. They are not rendered, so
+    // none of them is raised to a higher priority for being in view.
+    const int hostCount = 5;
+    const int imagesPerHost = 60;
+    QString html = "<html><head></head><body>";
+    for (int i = 0; i < imagesPerHost; ++i) {
+        for (int host = 0; host < hostCount; ++host)
+            html += QString("<img id='i%1-%2' style='display: none' src='http://host%1.example.com/%2.png'>").arg(host).arg(i);
+    }
+    html += "</body></html>";
+    frame->setHtml(html, QUrl("http://www.example.com/"));
+
+    // Qt allows 36 requests per host and the budget is four hosts' worth, minus half a host's worth
+    // kept free for loads that block rendering.
+    const int maximumPerHost = 36;
+    const int imageBudget = 4 * maximumPerHost - maximumPerHost / 2;
+    QTRY_COMPARE(manager.requestCount(), imageBudget);
+    QTest::qWait(100);
+    QCOMPARE(manager.requestCount(), imageBudget);
+    for (int host = 0; host < hostCount; ++host) {
+        QVERIFY(manager.requestCount(QString("host%1.example.com").arg(host)) > 0);
+        QVERIFY(manager.requestCount(QString("host%1.example.com").arg(host)) <= maximumPerHost);
+    }
+
+    // A style sheet does not wait for the images.
+    frame->evaluateJavaScript("var link = document.createElement('link'); link.rel = 'stylesheet'; link.href = 'http://host0.example.com/late.css'; document.head.appendChild(link);");
+    QTRY_VERIFY(manager.requested("http://host0.example.com/late.css"));
+
+    // Neither does an image that comes into view.
+    const QString lastImage = QString("http://host%1.example.com/%2.png").arg(hostCount - 1).arg(imagesPerHost - 1);
+    QVERIFY(!manager.requested(lastImage));
+    frame->evaluateJavaScript(QString("document.getElementById('i%1-%2').style.cssText = 'width: 10px; height: 10px'; document.body.offsetTop").arg(hostCount - 1).arg(imagesPerHost - 1));
+    QTRY_VERIFY(manager.requested(lastImage));
+    QCOMPARE(manager.requestCount(), imageBudget + 2);
+}
+
 void tst_QWebFrame::setHtmlWithStylesheetResource()
 {
     // By default, only security origins of local files can load local resources.
@@ -667,6 +810,66 @@ void tst_QWebFrame::hitTestContent()
     QCOMPARE(result.element().tagName(), QString("A"));
 }
 
+// A table that RenderTableSection only lays out near the viewport. Row i is 20px tall and starts at 20 * i,
+// and its first cell holds a 20px high div with the id "c<i>".
+static QString largeTableWithDeferredRows(int rowCount)
+{
+    QString html = QLatin1String("<html><body style='margin: 0'>"
+        "<table style='table-layout: fixed; width: 100%; border-spacing: 0'>");
+    for (int i = 0; i < rowCount; ++i)
+        html += QString("<tr><td style='-webkit-contain: strict; padding: 0; height: 20px'><div id='c%1' style='height: 20px'></div></td></tr>").arg(i);
+    html += QLatin1String("</table></body></html>");
+    return html;
+}
+
+void tst_QWebFrame::deferredTableRowsGeometry()
+{
+    QWebPage page;
+    page.setViewportSize(QSize(400, 100));
+    QWebFrame* frame = page.mainFrame();
+    frame->setHtml(largeTableWithDeferredRows(1000));
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+
+    // Painting only lays out the rows near the viewport.
+    QImage image(page.viewportSize(), QImage::Format_ARGB32);
+    QPainter painter(&image);
+    frame->render(&painter);
+    painter.end();
+
+    const QString deferredRowCount = QLatin1String("internals.numberOfDeferredTableRows(document)");
+    int deferredRows = frame->evaluateJavaScript(deferredRowCount).toInt();
+    QVERIFY(deferredRows > 900);
+
+    // Geometry read from script has to come from laid out rows, wherever they are, but reading it
+    // only lays out the row holding the element asked about.
+    QCOMPARE(frame->evaluateJavaScript("document.getElementById('c500').offsetHeight").toInt(), 20);
+    QCOMPARE(frame->evaluateJavaScript(deferredRowCount).toInt(), deferredRows - 1);
+    QCOMPARE(frame->evaluateJavaScript("document.getElementById('c500').getBoundingClientRect().top").toInt(), 10000);
+    QCOMPARE(frame->evaluateJavaScript("document.getElementById('c999').offsetTop").toInt(), 19980);
+    QCOMPARE(frame->evaluateJavaScript(deferredRowCount).toInt(), deferredRows - 2);
+
+    // Asking about the table itself lays out every row in it.
+    QCOMPARE(frame->evaluateJavaScript("document.querySelector('table').offsetHeight").toInt(), 20000);
+    QCOMPARE(frame->evaluateJavaScript(deferredRowCount).toInt(), 0);
+}
+
+void tst_QWebFrame::deferredTableRowsAfterResize()
+{
+    QWebPage page;
+    page.setViewportSize(QSize(400, 100));
+    QWebFrame* frame = page.mainFrame();
+    frame->setHtml(largeTableWithDeferredRows(1000));
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+
+    QCOMPARE(frame->hitTestContent(QPoint(10, 50)).element().attribute("id"), QString("c2"));
+    QVERIFY(frame->evaluateJavaScript("internals.numberOfDeferredTableRows(document)").toInt() > 900);
+
+    // Making the viewport taller, without scrolling, must lay out the rows it now shows.
+    page.setViewportSize(QSize(400, 2000));
+    QCOMPARE(frame->hitTestContent(QPoint(10, 1010)).element().attribute("id"), QString("c50"));
+    QCOMPARE(frame->hitTestContent(QPoint(10, 1990)).element().attribute("id"), QString("c99"));
+}
+
 void tst_QWebFrame::baseUrl_data()
 {
     QTest::addColumn<QString>("html");
@@ -1069,6 +1272,304 @@ void tst_QWebFrame::setContent()
     QCOMPARE(expected , mainFrame->toPlainText());
 }
 
+void tst_QWebFrame::setContentDetectsEncoding_data()
+{
+    QTest::addColumn<QString>("mimeType");
+    QTest::addColumn<QByteArray>("testContents");
+    QTest::addColumn<QString>("expected");
+    QTest::addColumn<QString>("expectedCharset");
+
+    // The encodings are detected by the decoder on the HTML parser thread, when it is enabled.
+    QTest::newRow("UTF-8 byte order mark") << "text/html; charset=iso-8859-1"
+        << QByteArray("\xEF\xBB\xBF<p>caf\xC3\xA9</p>") << QString::fromUtf8("café") << "UTF-8";
+    QTest::newRow("meta charset") << "text/html"
+        << QByteArray("<meta charset='windows-1251'><p>\xEF\xF0\xE8\xE2\xE5\xF2</p>") << QString::fromUtf8("привет") << "windows-1251";
+    QTest::newRow("meta http-equiv") << "text/html"
+        << QByteArray("<meta http-equiv='Content-Type' content='text/html; charset=koi8-r'><p>\xD0\xD2\xC9\xD7\xC5\xD4</p>") << QString::fromUtf8("привет") << "KOI8-R";
+    QByteArray lateMetaCharset(2048, ' ');
+    lateMetaCharset.prepend("<!--");
+    lateMetaCharset.append("--><meta charset='windows-1251'><p>\xEF\xF0\xE8\xE2\xE5\xF2</p>");
+    QTest::newRow("meta charset after a long comment") << "text/html" << lateMetaCharset << QString::fromUtf8("привет") << "windows-1251";
+}
+
+void tst_QWebFrame::setContentDetectsEncoding()
+{
+    QFETCH(QString, mimeType);
+    QFETCH(QByteArray, testContents);
+    QFETCH(QString, expected);
+    QFETCH(QString, expectedCharset);
+
+    QWebPage page;
+    QWebFrame* frame = page.mainFrame();
+    frame->setContent(testContents, mimeType);
+    ::waitForSignal(frame, SIGNAL(loadFinished(bool)));
+    QCOMPARE(frame->toPlainText(), expected);
+    QCOMPARE(frame->evaluateJavaScript("document.characterSet").toString(), expectedCharset);
+}
+
+void tst_QWebFrame::xssAuditorUsesDetectedEncoding()
+{
+    QWebPage page;
+    page.settings()->setAttribute(QWebSettings::XSSAuditingEnabled, true);
+    QWebFrame* frame = page.mainFrame();
+
+    // The script is reflected from the URL. It only matches the URL once %E9 is decoded with the
+    // encoding from the <meta charset>, which the auditor must learn about after it was created.
+    QByteArray html("<meta charset='windows-1251'><script>reflected='\xE9'</script>");
+    frame->setContent(html, "text/html", QUrl::fromEncoded("http://www.example.com/?q=%3Cscript%3Ereflected='%E9'%3C/script%3E"));
+    ::waitForSignal(frame, SIGNAL(loadFinished(bool)));
+    QCOMPARE(frame->evaluateJavaScript("document.characterSet").toString(), QString("windows-1251"));
+    QCOMPARE(frame->evaluateJavaScript("typeof reflected").toString(), QString("undefined"));
+
+    // The same script is not blocked when it isn't in the URL.
+    frame->setContent(html, "text/html", QUrl("http://www.example.com/"));
+    ::waitForSignal(frame, SIGNAL(loadFinished(bool)));
+    QCOMPARE(frame->evaluateJavaScript("reflected").toString(), QString::fromUtf8("й"));
+}
+
+// Sends its data in two chunks, split at the given offset, with a short pause in between.
+class SplitReply : public QNetworkReply {
+    Q_OBJECT
+
+public:
+    SplitReply(const QNetworkRequest& request, const QByteArray& contentType, const QByteArray& data, int splitAt, QObject* parent)
+        : QNetworkReply(parent)
+    {
+        setOperation(QNetworkAccessManager::GetOperation);
+        setRequest(request);
+        setUrl(request.url());
+        setHeader(QNetworkRequest::ContentTypeHeader, contentType);
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 200);
+        m_chunks << data.left(splitAt) << data.mid(splitAt);
+        open(QIODevice::ReadOnly);
+        QTimer::singleShot(0, this, SLOT(sendMetaData()));
+    }
+
+    virtual qint64 bytesAvailable() const { return m_available.size() + QNetworkReply::bytesAvailable(); }
+    virtual void abort() { }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize)
+    {
+        qint64 size = qMin<qint64>(maxSize, m_available.size());
+        memcpy(data, m_available.constData(), size);
+        m_available.remove(0, size);
+        return size;
+    }
+
+private Q_SLOTS:
+    void sendMetaData()
+    {
+        emit metaDataChanged();
+        sendNextChunk();
+    }
+
+    void sendNextChunk()
+    {
+        if (m_chunks.isEmpty()) {
+            emit readChannelFinished();
+            emit finished();
+            return;
+        }
+        m_available += m_chunks.takeFirst();
+        if (!m_available.isEmpty())
+            emit readyRead();
+        QTimer::singleShot(5, this, SLOT(sendNextChunk()));
+    }
+
+private:
+    QList<QByteArray> m_chunks;
+    QByteArray m_available;
+};
+
+// Serves /sheet.css in two chunks and records the priority of the first request for each path.
+class PreloadRecordingNetworkManager : public QNetworkAccessManager {
+public:
+    PreloadRecordingNetworkManager(const QByteArray& sheet, int splitAt)
+        : m_sheet(sheet)
+        , m_splitAt(splitAt)
+    {
+    }
+
+    QStringList requests() const
+    {
+        QStringList result;
+        QMap<QString, QNetworkRequest::Priority>::const_iterator end = m_priorities.constEnd();
+        for (QMap<QString, QNetworkRequest::Priority>::const_iterator it = m_priorities.constBegin(); it != end; ++it)
+            result << QString("%1 %2").arg(it.key()).arg(it.value() == QNetworkRequest::HighPriority ? "high" : it.value() == QNetworkRequest::LowPriority ? "low" : "normal");
+        return result;
+    }
+
+protected:
+    virtual QNetworkReply* createRequest(Operation, const QNetworkRequest& request, QIODevice*)
+    {
+        QString path = request.url().path();
+        if (!m_priorities.contains(path))
+            m_priorities.insert(path, request.priority());
+        if (path == QLatin1String("/sheet.css"))
+            return new SplitReply(request, "text/css", m_sheet, m_splitAt, this);
+        return new SplitReply(request, path.endsWith(".css") ? "text/css" : "application/octet-stream", QByteArray(), 0, this);
+    }
+
+private:
+    QByteArray m_sheet;
+    int m_splitAt;
+    QMap<QString, QNetworkRequest::Priority> m_priorities;
+};
+
+void tst_QWebFrame::preloadStyleSheetSubresources()
+{
+    // Only the imports and the backgrounds of html and body are preloaded. The inline styles keep
+    // those backgrounds from being used, so they are only requested if the sheet's preload scanner
+    // found them. Nothing else is requested at all.
+    const QByteArray sheet =
+        "/* url(comment.png) @import \"comment.css\"; */\n"
+        "@import \"imported.css\";\n"
+        "@import url('imported-screen.css') screen;\n"
+        "body::after { content: \"url(string.png) } @import 'string.css';\" }\n"
+        "body { color: red; background: url( \"background.png\" ) no-repeat }\n"
+        ".unused { background-image: url(unused.png) }\n"
+        "@media print { body { background-image: url(print.png) } }\n"
+        "@media screen { html > body { background-image: url('screen.png') } }\n"
+        "body:hover { background: url(hover.png) }\n"
+        "@font-face { font-family: unused; src: url(font.ttf) format('truetype'); }\n";
+
+    QStringList expected;
+    expected << "/background.png low" << "/imported-screen.css high" << "/imported.css high"
+        << "/screen.png low" << "/sheet.css high";
+
+    // The body is laid out before the style sheet is inserted, so that preloads aren't deferred
+    // until there is something to draw. The last script keeps the document parsing until the
+    // sheet has loaded.
+    const QString html = "<html style='background: none'><body style='background: none'><p>Text</p><script>document.body.offsetTop</script>"
+        "<link rel='stylesheet' href='sheet.css'><script>var parsed = true</script>";
+
+    // The sheet arrives in two pieces. Split it in a comment, in a string, in a url(), in the
+    // middle of a rule and inside a group rule.
+    QList<int> splits;
+    splits << 0 << sheet.indexOf("url(comment") + 2 << sheet.indexOf("string.png") << sheet.indexOf("background.png") - 3
+        << sheet.indexOf("no-repeat") << sheet.indexOf("html > body") + 5 << sheet.size();
+
+    foreach (int splitAt, splits) {
+        QWebPage page;
+        PreloadRecordingNetworkManager manager(sheet, splitAt);
+        page.setNetworkAccessManager(&manager);
+        page.mainFrame()->setHtml(html, QUrl("http://www.example.com/"));
+        ::waitForSignal(&page, SIGNAL(loadFinished(bool)));
+
+        QStringList requests = manager.requests();
+        QVERIFY2(requests == expected, qPrintable(QString("Split at %1: %2").arg(splitAt).arg(requests.join(", "))));
+        page.setNetworkAccessManager(0);
+    }
+}
+
+void tst_QWebFrame::incrementallyDecodedStyleSheet()
+{
+    // The selector is "#é€" in UTF-8, so some of the splits fall inside a character.
+    const QByteArray rule = "#\xc3\xa9\xe2\x82\xac { color: rgb(0, 128, 0) }\n";
+    // Sheets this large drop the text they decode while loading and decode it again at the end.
+    QByteArray padding;
+    while (padding.size() < 300 * 1024)
+        padding += ".unused { color: red }\n";
+
+    QList<QByteArray> sheets;
+    sheets << "@charset \"utf-8\";\n" + rule << "@charset \"utf-8\";\n" + padding + rule;
+    const QString html = QString::fromUtf8("<link rel='stylesheet' href='sheet.css'><p id='\xc3\xa9\xe2\x82\xac'>Text</p>");
+
+    foreach (const QByteArray& sheet, sheets) {
+        int ruleStart = sheet.size() - rule.size();
+        for (int splitAt = ruleStart; splitAt <= ruleStart + 6; ++splitAt) {
+            QWebPage page;
+            PreloadRecordingNetworkManager manager(sheet, splitAt);
+            page.setNetworkAccessManager(&manager);
+            page.mainFrame()->setHtml(html, QUrl("http://www.example.com/"));
+            ::waitForSignal(&page, SIGNAL(loadFinished(bool)));
+
+            QWebElement p = page.mainFrame()->findFirstElement("p");
+            QVERIFY2(p.styleProperty("color", QWebElement::ComputedStyle) == QLatin1String("rgb(0, 128, 0)"),
+                qPrintable(QString("%1 bytes split at %2").arg(sheet.size()).arg(splitAt)));
+            page.setNetworkAccessManager(0);
+        }
+    }
+}
+
+// Serves each registered path in two chunks.
+class SplitResourceNetworkManager : public QNetworkAccessManager {
+public:
+    void addResource(const QString& path, const QByteArray& contentType, const QByteArray& data)
+    {
+        m_resources.insert(path, qMakePair(contentType, data));
+    }
+
+protected:
+    virtual QNetworkReply* createRequest(Operation, const QNetworkRequest& request, QIODevice*)
+    {
+        QPair<QByteArray, QByteArray> resource = m_resources.value(request.url().path());
+        return new SplitReply(request, resource.first, resource.second, resource.second.size() / 2, this);
+    }
+
+private:
+    QHash<QString, QPair<QByteArray, QByteArray> > m_resources;
+};
+
+void tst_QWebFrame::subresourcesLoadWithoutLinearizing()
+{
+    // Every resource is much larger than a SharedBuffer segment, so none of them is held in one block.
+    QByteArray script;
+    while (script.size() < 64 * 1024)
+        script += "var filler = 'filler';\n";
+    script += "var scriptRan = true;\n";
+
+    QByteArray sheet;
+    while (sheet.size() < 64 * 1024)
+        sheet += ".unused { color: red }\n";
+    sheet += "p { color: rgb(0, 128, 0) }\n";
+
+    // WebCore has no decoder of its own for PPM, so Qt decodes it.
+    QImage image(96, 96, QImage::Format_RGB32);
+    image.fill(Qt::green);
+    QByteArray ppm;
+    QBuffer ppmBuffer(&ppm);
+    ppmBuffer.open(QIODevice::WriteOnly);
+    QVERIFY(image.save(&ppmBuffer, "PPM"));
+    QVERIFY(ppm.size() > 16 * 1024);
+
+    SplitResourceNetworkManager manager;
+    manager.addResource("/script.js", "text/javascript", script);
+    manager.addResource("/sheet.css", "text/css", sheet);
+    manager.addResource("/image.ppm", "image/x-portable-pixmap", ppm);
+
+    QWebPage page;
+    page.setNetworkAccessManager(&manager);
+    page.setViewportSize(QSize(200, 200));
+    QWebFrame* frame = page.mainFrame();
+
+    frame->setHtml("<p>Start</p>", QUrl("http://www.example.com/"));
+    ::waitForSignal(frame, SIGNAL(loadFinished(bool)));
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+    double linearizedBytes = frame->evaluateJavaScript("internals.linearizedSharedBufferByteCount()").toDouble();
+
+    frame->setHtml("<body style='margin: 0'><img src='image.ppm'><p>Text</p><script src='script.js'></script>"
+        "<link rel='stylesheet' href='sheet.css'></body>", QUrl("http://www.example.com/"));
+    ::waitForSignal(frame, SIGNAL(loadFinished(bool)));
+
+    QVERIFY(frame->evaluateJavaScript("window.scriptRan === true").toBool());
+    QCOMPARE(frame->findFirstElement("p").styleProperty("color", QWebElement::ComputedStyle), QLatin1String("rgb(0, 128, 0)"));
+    QCOMPARE(frame->evaluateJavaScript("document.images[0].naturalWidth").toInt(), 96);
+
+    // Painting decodes the image.
+    QImage rendering(page.viewportSize(), QImage::Format_RGB32);
+    rendering.fill(Qt::white);
+    QPainter painter(&rendering);
+    frame->render(&painter);
+    painter.end();
+    QCOMPARE(rendering.pixel(48, 48), QColor(Qt::green).rgb());
+
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+    QCOMPARE(frame->evaluateJavaScript("internals.linearizedSharedBufferByteCount()").toDouble(), linearizedBytes);
+    page.setNetworkAccessManager(0);
+}
+
 class CacheNetworkAccessManager : public QNetworkAccessManager {
 public:
     CacheNetworkAccessManager(QObject* parent = 0)
@@ -195,6 +195,8 @@ private Q_SLOTS:
     void openWindowDefaultSize();
     void cssMediaTypeGlobalSetting();
     void cssMediaTypePageSetting();
+    void animatedElementsUpdateTogether();
+    void wordShapingCacheAcrossRelayouts();
 
 #ifdef Q_OS_MAC
     void macCopyUnicodeToClipboard();
@@ -3520,5 +3522,49 @@ void tst_QWebPage::cssMediaTypePageSetting()
     QVERIFY(m_view->page()->settings()->cssMediaType() == "screen"); 
 }
 
+void tst_QWebPage::animatedElementsUpdateTogether()
+{
+    // Every element whose animation is due is marked before a single style recalc picks them all up.
+    QWebPage page;
+    QWebFrame* frame = page.mainFrame();
+    frame->setHtml("<style>"
+        "@-webkit-keyframes slide { from { margin-left: 0px } to { margin-left: 100px } }"
+        ".animated { -webkit-animation: slide 1s linear infinite }"
+        "</style>"
+        "<div class='animated'></div><div class='animated'></div><div class='animated'></div><div></div>");
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+
+    QTRY_COMPARE(frame->evaluateJavaScript("internals.numberOfActiveAnimations()").toInt(), 3);
+    QTRY_COMPARE(frame->evaluateJavaScript("internals.numberOfAnimatedElementsInLastUpdate()").toInt(), 3);
+
+    frame->evaluateJavaScript("document.getElementsByTagName('div')[0].className = ''");
+    QTRY_COMPARE(frame->evaluateJavaScript("internals.numberOfAnimatedElementsInLastUpdate()").toInt(), 2);
+}
+
+void tst_QWebPage::wordShapingCacheAcrossRelayouts()
+{
+    // Kerning and ligatures make words expensive enough to shape for them to be cached.
+    QWebPage page;
+    QWebFrame* frame = page.mainFrame();
+    frame->setHtml(QString("<p id='p' style='text-rendering: optimizeLegibility; width: 300px'>%1</p>").arg(QString("shaping ").repeated(200)));
+    DumpRenderTreeSupportQt::injectInternalsObject(frame->handle());
+
+    frame->evaluateJavaScript("internals.clearWordShapingCaches()");
+    int hits = frame->evaluateJavaScript("internals.wordShapingCacheHitCount()").toInt();
+    int misses = frame->evaluateJavaScript("internals.wordShapingCacheMissCount()").toInt();
+
+    // The first relayout after clearing has to shape the words again, then finds them in the cache.
+    frame->evaluateJavaScript("var p = document.getElementById('p'); p.style.width = '250px'; p.offsetHeight");
+    QVERIFY(frame->evaluateJavaScript("internals.wordShapingCacheMissCount()").toInt() > misses);
+    QVERIFY(frame->evaluateJavaScript("internals.wordShapingCacheHitCount()").toInt() > hits);
+
+    // Later relayouts only hit.
+    hits = frame->evaluateJavaScript("internals.wordShapingCacheHitCount()").toInt();
+    misses = frame->evaluateJavaScript("internals.wordShapingCacheMissCount()").toInt();
+    frame->evaluateJavaScript("p.style.width = '200px'; p.offsetHeight");
+    QVERIFY(frame->evaluateJavaScript("internals.wordShapingCacheHitCount()").toInt() > hits);
+    QCOMPARE(frame->evaluateJavaScript("internals.wordShapingCacheMissCount()").toInt(), misses);
+}
+
 QTEST_MAIN(tst_QWebPage)
 #include "tst_qwebpage.moc"
@@ -52,9 +52,18 @@ using namespace WebCore;
 
 namespace WebKit {
 
+// Chunks at least this large are written into shared memory, which the web process maps and appends
+// to the resource's buffer as it is, instead of being copied into a message and out of it again.
+static const unsigned sharedMemoryDataMinimumSize = 16 * 1024;
+
+// Consecutive chunks are written one after another into a region of this size, so that the web process
+// maps a region every few hundred kilobytes of a response rather than one for every chunk.
+static const unsigned sharedMemoryDataRegionSize = 256 * 1024;
+
 NetworkResourceLoader::NetworkResourceLoader(const NetworkResourceLoadParameters& loadParameters, NetworkConnectionToWebProcess* connection)
     : SchedulableLoader(loadParameters, connection)
     , m_bytesReceived(0)
+    , m_sharedDataMemoryUsed(0)
     , m_handleConvertedToDownload(false)
 {
     ASSERT(isMainThread());
@@ -173,10 +182,53 @@ void NetworkResourceLoader::didReceiveBuffer(ResourceHandle* handle, PassRefPtr<
     }
 #endif // __MAC_OS_X_VERSION_MIN_REQUIRED >= 1090
 
+    if (buffer->size() >= sharedMemoryDataMinimumSize && sendDataInSharedMemory(buffer.get(), encodedDataLength))
+        return;
+
     CoreIPC::DataReference dataReference(reinterpret_cast<const uint8_t*>(buffer->data()), buffer->size());
     sendAbortingOnFailure(Messages::WebResourceLoader::DidReceiveData(dataReference, encodedDataLength));
 }
 
+bool NetworkResourceLoader::sendDataInSharedMemory(SharedBuffer* buffer, int64_t encodedDataLength)
+{
+    unsigned size = buffer->size();
+    bool startsRegion = !m_sharedDataMemory || m_sharedDataMemory->size() - m_sharedDataMemoryUsed < size;
+    if (startsRegion) {
+        RefPtr<SharedMemory> sharedMemory = SharedMemory::create(std::max(size, sharedMemoryDataRegionSize));
+        if (!sharedMemory)
+            return false;
+        m_sharedDataMemory = sharedMemory.release();
+        m_sharedDataMemoryUsed = 0;
+    }
+
+    // Bytes already sent are never written again, so the web process can keep reading them while later
+    // chunks are written after them.
+    unsigned offset = m_sharedDataMemoryUsed;
+    char* destination = static_cast<char*>(m_sharedDataMemory->data()) + offset;
+    const char* segment;
+    unsigned position = 0;
+    while (unsigned length = buffer->getSomeData(segment, position)) {
+        memcpy(destination + position, segment, length);
+        position += length;
+    }
+    m_sharedDataMemoryUsed += size;
+
+    if (!startsRegion) {
+        // The web process still has the region mapped from the chunk that started it.
+        sendAbortingOnFailure(Messages::WebResourceLoader::DidReceiveDataInSharedMemoryRegion(offset, size, encodedDataLength));
+        return true;
+    }
+
+    ShareableResource::Handle handle;
+    RefPtr<ShareableResource> resource = ShareableResource::create(m_sharedDataMemory, offset, size);
+    if (!resource->createHandle(handle)) {
+        m_sharedDataMemory = 0;
+        return false;
+    }
+    sendAbortingOnFailure(Messages::WebResourceLoader::DidReceiveSharedData(handle, encodedDataLength));
+    return true;
+}
+
 void NetworkResourceLoader::didFinishLoading(ResourceHandle* handle, double finishTime)
 {
     ASSERT_UNUSED(handle, handle == m_handle);
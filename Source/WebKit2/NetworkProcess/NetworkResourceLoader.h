@@ -119,6 +119,9 @@ private:
 
     template<typename U> bool sendAbortingOnFailure(const U& message, unsigned messageSendFlags = 0);
 
+    // Returns false if the data could not be put in shared memory and has to be sent inline instead.
+    bool sendDataInSharedMemory(WebCore::SharedBuffer*, int64_t encodedDataLength);
+
     RefPtr<RemoteNetworkingContext> m_networkingContext;
     RefPtr<WebCore::ResourceHandle> m_handle;
 
@@ -127,6 +130,10 @@ private:
 
     uint64_t m_bytesReceived;
 
+    // The region the last chunks sent in shared memory were written into, and how much of it is used.
+    RefPtr<SharedMemory> m_sharedDataMemory;
+    unsigned m_sharedDataMemoryUsed;
+
     bool m_handleConvertedToDownload;
 
 #if __MAC_OS_X_VERSION_MIN_REQUIRED >= 1090
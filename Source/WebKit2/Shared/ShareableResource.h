@@ -28,17 +28,15 @@
 
 #include "SharedMemory.h"
 
+#include <WebCore/SharedBuffer.h>
 #include <wtf/PassRefPtr.h>
-#include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
 
-namespace WebCore {
-class SharedBuffer;
-}
-
 namespace WebKit {
     
-class ShareableResource : public RefCounted<ShareableResource> {
+// A ShareableResource can be appended to a SharedBuffer as a segment, so data the network process
+// wrote into shared memory reaches the resource's buffer in the web process without being copied.
+class ShareableResource : public WebCore::SharedBuffer::DataSegment {
 public:
 
     class Handle {
@@ -71,10 +69,12 @@ public:
     // Create a handle.
     bool createHandle(Handle&);
 
-    ~ShareableResource();
+    virtual ~ShareableResource();
+
+    virtual const char* data() const OVERRIDE;
+    virtual unsigned size() const OVERRIDE;
 
-    const char* data() const;
-    unsigned size() const;
+    SharedMemory* sharedMemory() const { return m_sharedMemory.get(); }
     
 private:
     ShareableResource(PassRefPtr<SharedMemory>, unsigned offset, unsigned size);
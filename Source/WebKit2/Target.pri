@@ -385,6 +385,7 @@ HEADERS += \
     WebProcess/WebProcess.h \
     WebProcess/qt/QtBuiltinBundle.h \
     WebProcess/qt/QtBuiltinBundlePage.h \
+    WebProcess/qt/QtDiskCache.h \
     WebProcess/qt/QtNetworkAccessManager.h \
     WebProcess/qt/QtNetworkReply.h
 
@@ -774,6 +775,7 @@ SOURCES += \
     WebProcess/WebProcess.cpp \
     WebProcess/qt/QtBuiltinBundle.cpp \
     WebProcess/qt/QtBuiltinBundlePage.cpp \
+    WebProcess/qt/QtDiskCache.cpp \
     WebProcess/qt/QtNetworkAccessManager.cpp \
     WebProcess/qt/QtNetworkReply.cpp \
     WebProcess/qt/WebProcessMainQt.cpp \
@@ -45,6 +45,9 @@ using namespace WebCore;
 
 namespace WebKit {
 
+uint64_t WebResourceLoader::s_bytesReceivedInMessages = 0;
+uint64_t WebResourceLoader::s_bytesReceivedInSharedMemory = 0;
+
 PassRefPtr<WebResourceLoader> WebResourceLoader::create(PassRefPtr<ResourceLoader> coreLoader)
 {
     return adoptRef(new WebResourceLoader(coreLoader));
@@ -120,9 +123,48 @@ void WebResourceLoader::didReceiveResponseWithCertificateInfo(const ResourceResp
 void WebResourceLoader::didReceiveData(const CoreIPC::DataReference& data, int64_t encodedDataLength)
 {
     LOG(Network, "(WebProcess) WebResourceLoader::didReceiveData of size %i for '%s'", (int)data.size(), m_coreLoader->url().string().utf8().data());
+    s_bytesReceivedInMessages += data.size();
     m_coreLoader->didReceiveData(reinterpret_cast<const char*>(data.data()), data.size(), encodedDataLength, DataPayloadBytes);
 }
 
+void WebResourceLoader::didReceiveSharedData(const ShareableResource::Handle& handle, int64_t encodedDataLength)
+{
+    LOG(Network, "(WebProcess) WebResourceLoader::didReceiveSharedData of size %u for '%s'", handle.size(), m_coreLoader->url().string().utf8().data());
+
+    RefPtr<ShareableResource> resource = ShareableResource::create(handle);
+    if (!resource) {
+        LOG_ERROR("Unable to map shared memory sent from the network process.");
+        m_coreLoader->didFail(internalError(m_coreLoader->request().url()));
+        return;
+    }
+
+    m_sharedDataMemory = resource->sharedMemory();
+    didReceiveShareableResource(resource.release(), encodedDataLength);
+}
+
+void WebResourceLoader::didReceiveDataInSharedMemoryRegion(uint32_t offset, uint32_t size, int64_t encodedDataLength)
+{
+    LOG(Network, "(WebProcess) WebResourceLoader::didReceiveDataInSharedMemoryRegion of size %u for '%s'", size, m_coreLoader->url().string().utf8().data());
+
+    if (!m_sharedDataMemory || offset > m_sharedDataMemory->size() || size > m_sharedDataMemory->size() - offset) {
+        LOG_ERROR("Shared memory data sent from the network process is outside of the mapped region.");
+        m_coreLoader->didFail(internalError(m_coreLoader->request().url()));
+        return;
+    }
+
+    didReceiveShareableResource(ShareableResource::create(m_sharedDataMemory, offset, size), encodedDataLength);
+}
+
+void WebResourceLoader::didReceiveShareableResource(PassRefPtr<ShareableResource> resource, int64_t encodedDataLength)
+{
+    s_bytesReceivedInSharedMemory += resource->size();
+
+    // The mapped memory becomes a segment of the resource's buffer as it is.
+    RefPtr<SharedBuffer> buffer = SharedBuffer::create();
+    buffer->append(resource);
+    m_coreLoader->didReceiveBuffer(buffer.release(), encodedDataLength, DataPayloadBytes);
+}
+
 void WebResourceLoader::didFinishResourceLoad(double finishTime)
 {
     LOG(Network, "(WebProcess) WebResourceLoader::didFinishResourceLoad for '%s'", m_coreLoader->url().string().utf8().data());
@@ -65,6 +65,10 @@ public:
 
     void detachFromCoreLoader();
 
+    // Response bytes received from the network process, copied through messages and mapped from shared memory.
+    static uint64_t bytesReceivedInMessages() { return s_bytesReceivedInMessages; }
+    static uint64_t bytesReceivedInSharedMemory() { return s_bytesReceivedInSharedMemory; }
+
 private:
     WebResourceLoader(PassRefPtr<WebCore::ResourceLoader>);
 
@@ -78,6 +82,9 @@ private:
     void didSendData(uint64_t bytesSent, uint64_t totalBytesToBeSent);
     void didReceiveResponseWithCertificateInfo(const WebCore::ResourceResponse&, const PlatformCertificateInfo&, bool needsContinueDidReceiveResponseMessage);
     void didReceiveData(const CoreIPC::DataReference&, int64_t encodedDataLength);
+    void didReceiveSharedData(const ShareableResource::Handle&, int64_t encodedDataLength);
+    void didReceiveDataInSharedMemoryRegion(uint32_t offset, uint32_t size, int64_t encodedDataLength);
+    void didReceiveShareableResource(PassRefPtr<ShareableResource>, int64_t encodedDataLength);
     void didFinishResourceLoad(double finishTime);
     void didFailResourceLoad(const WebCore::ResourceError&);
     void didReceiveResource(const ShareableResource::Handle&, double finishTime);
@@ -85,6 +92,13 @@ private:
     void canAuthenticateAgainstProtectionSpace(const WebCore::ProtectionSpace&);
 
     RefPtr<WebCore::ResourceLoader> m_coreLoader;
+
+    // The shared memory region the last DidReceiveSharedData message mapped. Later chunks the network
+    // process writes into the same region refer to it instead of sending another handle.
+    RefPtr<SharedMemory> m_sharedDataMemory;
+
+    static uint64_t s_bytesReceivedInMessages;
+    static uint64_t s_bytesReceivedInSharedMemory;
 };
 
 } // namespace WebKit
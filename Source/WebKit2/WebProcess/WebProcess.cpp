@@ -65,6 +65,7 @@
 #include <WebCore/FrameLoader.h>
 #include <WebCore/GCController.h>
 #include <WebCore/GlyphPageTreeNode.h>
+#include <WebCore/GraphicsLayer.h>
 #include <WebCore/IconDatabase.h>
 #include <WebCore/JSDOMWindow.h>
 #include <WebCore/Language.h>
@@ -78,7 +79,9 @@
 #include <WebCore/SchemeRegistry.h>
 #include <WebCore/SecurityOrigin.h>
 #include <WebCore/Settings.h>
+#include <WebCore/SharedBuffer.h>
 #include <WebCore/StorageTracker.h>
+#include <WebCore/StyleElement.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/HashCountedSet.h>
 #include <wtf/PassRefPtr.h>
@@ -92,6 +95,7 @@
 #if ENABLE(NETWORK_PROCESS)
 #include "CookieStorageShim.h"
 #include "NetworkProcessConnection.h"
+#include "WebResourceLoader.h"
 #endif
 
 #if !OS(WINDOWS)
@@ -746,6 +750,12 @@ void WebProcess::clearResourceCaches(ResourceCachesToClear resourceCachesToClear
 
     // Empty the cross-origin preflight cache.
     CrossOriginPreflightResultCache::shared().empty();
+
+    StyleElement::clearInlineStyleSheetContentsCache();
+
+#if USE(DISPLAY_LIST_RECORDING)
+    GraphicsLayer::releaseAllDisplayLists();
+#endif
 }
 
 void WebProcess::clearApplicationCache()
@@ -1007,6 +1017,14 @@ void WebProcess::getWebCoreStatistics(uint64_t callbackID)
     // Gather glyph page statistics.
     data.statisticsNumbers.set(ASCIILiteral("GlyphPageCount"), GlyphPageTreeNode::treeGlyphPageCount());
     
+    data.statisticsNumbers.set(ASCIILiteral("SharedBufferLinearizedBytes"), SharedBuffer::linearizedByteCount());
+
+#if ENABLE(NETWORK_PROCESS)
+    // Gather statistics about how resource data arrived from the network process.
+    data.statisticsNumbers.set(ASCIILiteral("NetworkProcessBytesReceivedInMessages"), WebResourceLoader::bytesReceivedInMessages());
+    data.statisticsNumbers.set(ASCIILiteral("NetworkProcessBytesReceivedInSharedMemory"), WebResourceLoader::bytesReceivedInSharedMemory());
+#endif
+
     // Get WebCore memory cache statistics
     getWebCoreMemoryCacheStatistics(data.webCoreCacheStatistics);
     
@@ -0,0 +1,617 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "QtDiskCache.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QTemporaryFile>
+#include <WebCore/HTTPParsers.h>
+#include <algorithm>
+#include <limits>
+#include <wtf/MathExtras.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebKit {
+
+static const quint32 indexMagic = 0x574b4443; // 'WKDC'
+static const quint32 indexVersion = 1;
+static const quint32 metaDataVersion = 1;
+static const int indexWriteDelay = 2000;
+static const qint64 defaultMaximumCacheSize = 50 * 1024 * 1024;
+static const int maximumCacheDirectoryCount = 8;
+// A subdirectory no process has written to for this long is deleted rather than kept for reuse.
+static const int staleCacheDirectoryAgeInDays = 30;
+
+// An entry gets this much extra lifetime in the eviction order for every time it was read, up to
+// maximumAccessCountBonus reads, so that resources shared by many pages outlive one-off downloads.
+static const qint64 accessCountBonus = 60 * 60 * 1000;
+static const quint32 maximumAccessCountBonus = 8;
+
+struct IndexHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 recordCount;
+    quint32 reserved;
+};
+
+struct IndexRecord {
+    char urlHash[20];
+    char bodyHash[20];
+    qint64 bodySize;
+    qint64 expirationTime;
+    qint64 lastAccessTime;
+    quint32 accessCount;
+    quint32 flags;
+};
+
+// Serves a cached body straight out of a memory mapping of its file.
+class MappedBodyBuffer : public QBuffer {
+public:
+    static MappedBodyBuffer* create(const QString& path)
+    {
+        MappedBodyBuffer* buffer = new MappedBodyBuffer(path);
+        if (!buffer->m_file.open(QIODevice::ReadOnly) || buffer->m_file.size() > std::numeric_limits<int>::max()) {
+            delete buffer;
+            return 0;
+        }
+
+        if (qint64 size = buffer->m_file.size()) {
+            if (uchar* bytes = buffer->m_file.map(0, size))
+                buffer->setData(QByteArray::fromRawData(reinterpret_cast<const char*>(bytes), size));
+            else
+                buffer->setData(buffer->m_file.readAll());
+        }
+        buffer->open(QIODevice::ReadOnly);
+        return buffer;
+    }
+
+    virtual ~MappedBodyBuffer()
+    {
+        // Drop the reference to the mapped bytes before m_file unmaps them.
+        close();
+        setData(QByteArray());
+    }
+
+private:
+    explicit MappedBodyBuffer(const QString& path)
+        : m_file(path)
+    {
+    }
+
+    QFile m_file;
+};
+
+static inline qint64 currentTime()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+static QString cacheDirectoryPath(const QString& baseDirectory, int index)
+{
+    return baseDirectory + QLatin1Char('/') + QString::number(index);
+}
+
+static PassOwnPtr<QLockFile> lockCacheDirectory(const QString& cacheDirectory)
+{
+    OwnPtr<QLockFile> lockFile = adoptPtr(new QLockFile(cacheDirectory + QLatin1String(".lock")));
+    // The lock is held for as long as the process runs, so it must never go stale by age.
+    // A lock left behind by a process that crashed is still taken over, because QLockFile
+    // checks whether the owning process is alive.
+    lockFile->setStaleLockTime(0);
+    if (!lockFile->tryLock(0))
+        return nullptr;
+    return lockFile.release();
+}
+
+// Deletes a subdirectory no process is using. When lastUseLimit is valid, only a subdirectory whose
+// index was last written before it is deleted.
+static void removeUnusedCacheDirectory(const QString& cacheDirectory, const QDateTime& lastUseLimit)
+{
+    if (!QFileInfo(cacheDirectory).exists())
+        return;
+    OwnPtr<QLockFile> lockFile = lockCacheDirectory(cacheDirectory);
+    if (!lockFile)
+        return;
+    QFileInfo index(cacheDirectory + QLatin1String("/index"));
+    if (lastUseLimit.isValid() && index.exists() && index.lastModified() >= lastUseLimit)
+        return;
+    QDir(cacheDirectory).removeRecursively();
+}
+
+QtDiskCache* QtDiskCache::create(const QString& baseDirectory, QObject* parent)
+{
+    if (!QDir().mkpath(baseDirectory))
+        return 0;
+
+    for (int i = 0; i < maximumCacheDirectoryCount; ++i) {
+        QString cacheDirectory = cacheDirectoryPath(baseDirectory, i);
+        OwnPtr<QLockFile> lockFile = lockCacheDirectory(cacheDirectory);
+        if (!lockFile)
+            continue;
+
+        // Sessions that ran several web processes at once leave as many subdirectories behind, and
+        // later sessions may never get around to reusing them. Their pages should not be kept forever.
+        QDateTime lastUseLimit = QDateTime::currentDateTime().addDays(-staleCacheDirectoryAgeInDays);
+        for (int j = 0; j < maximumCacheDirectoryCount; ++j) {
+            if (j != i)
+                removeUnusedCacheDirectory(cacheDirectoryPath(baseDirectory, j), lastUseLimit);
+        }
+        return new QtDiskCache(cacheDirectory, lockFile.release(), parent);
+    }
+    return 0;
+}
+
+QtDiskCache::QtDiskCache(const QString& cacheDirectory, PassOwnPtr<QLockFile> lockFile, QObject* parent)
+    : QAbstractNetworkCache(parent)
+    , m_cacheDirectory(cacheDirectory)
+    , m_lockFile(lockFile)
+    , m_maximumCacheSize(defaultMaximumCacheSize)
+    , m_cacheSize(0)
+{
+    QDir directory(m_cacheDirectory);
+    directory.mkpath(QLatin1String("entries"));
+    directory.mkpath(QLatin1String("bodies"));
+    directory.mkpath(QLatin1String("pending"));
+
+    readIndex();
+    removeUnreferencedFiles();
+
+    m_indexWriteTimer.setSingleShot(true);
+    m_indexWriteTimer.setInterval(indexWriteDelay);
+    connect(&m_indexWriteTimer, SIGNAL(timeout()), this, SLOT(writeIndex()));
+}
+
+QtDiskCache::~QtDiskCache()
+{
+    qDeleteAll(m_pendingInsertions.keys());
+    if (m_indexWriteTimer.isActive())
+        writeIndex();
+}
+
+void QtDiskCache::setMaximumCacheSize(qint64 size)
+{
+    m_maximumCacheSize = size;
+    evictIfNeeded();
+}
+
+QByteArray QtDiskCache::urlKey(const QUrl& url)
+{
+    return QCryptographicHash::hash(url.toEncoded(QUrl::RemoveFragment), QCryptographicHash::Sha1);
+}
+
+QString QtDiskCache::entryPath(const QByteArray& key) const
+{
+    return m_cacheDirectory + QLatin1String("/entries/") + QLatin1String(key.toHex());
+}
+
+QString QtDiskCache::bodyPath(const QByteArray& bodyHash) const
+{
+    return m_cacheDirectory + QLatin1String("/bodies/") + QLatin1String(bodyHash.toHex());
+}
+
+// Fills in the dates QNetworkAccessManager could not parse and works out what the index records
+// about the response.
+void QtDiskCache::prepareMetaData(QNetworkCacheMetaData& metaData, quint32& flags, qint64& expirationTime)
+{
+    flags = 0;
+
+    QNetworkCacheMetaData::RawHeaderList headers = metaData.rawHeaders();
+    for (QNetworkCacheMetaData::RawHeaderList::const_iterator it = headers.constBegin(); it != headers.constEnd(); ++it) {
+        QByteArray name = it->first.toLower();
+        if (name == "etag")
+            flags |= HasValidators;
+        else if (name == "last-modified") {
+            flags |= HasValidators;
+            if (!metaData.lastModified().isValid()) {
+                double lastModified = WebCore::parseDate(String(it->second.constData(), it->second.size()));
+                if (std::isfinite(lastModified))
+                    metaData.setLastModified(QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(lastModified)));
+            }
+        } else if (name == "expires" && !metaData.expirationDate().isValid()) {
+            double expires = WebCore::parseDate(String(it->second.constData(), it->second.size()));
+            if (std::isfinite(expires))
+                metaData.setExpirationDate(QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(expires)));
+        }
+    }
+
+    expirationTime = metaData.expirationDate().isValid() ? metaData.expirationDate().toMSecsSinceEpoch() : 0;
+}
+
+void QtDiskCache::readIndex()
+{
+    QFile file(m_cacheDirectory + QLatin1String("/index"));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    qint64 fileSize = file.size();
+    if (fileSize < static_cast<qint64>(sizeof(IndexHeader)))
+        return;
+
+    uchar* bytes = file.map(0, fileSize);
+    if (!bytes)
+        return;
+
+    const IndexHeader* header = reinterpret_cast<const IndexHeader*>(bytes);
+    if (header->magic == indexMagic && header->version == indexVersion
+        && header->recordCount <= (fileSize - sizeof(IndexHeader)) / sizeof(IndexRecord)) {
+        const IndexRecord* records = reinterpret_cast<const IndexRecord*>(bytes + sizeof(IndexHeader));
+        for (quint32 i = 0; i < header->recordCount; ++i) {
+            const IndexRecord& record = records[i];
+            Entry entry;
+            entry.bodyHash = QByteArray(record.bodyHash, sizeof(record.bodyHash));
+            entry.bodySize = record.bodySize;
+            entry.expirationTime = record.expirationTime;
+            entry.lastAccessTime = record.lastAccessTime;
+            entry.accessCount = record.accessCount;
+            entry.flags = record.flags;
+            addEntry(QByteArray(record.urlHash, sizeof(record.urlHash)), entry);
+        }
+    }
+
+    file.unmap(bytes);
+}
+
+// The index is only written every so often, so files added since the last write are not known
+// after a crash. They are removed here, together with insertions that never completed.
+void QtDiskCache::removeUnreferencedFiles()
+{
+    QDir entries(m_cacheDirectory + QLatin1String("/entries"));
+    QStringList names = entries.entryList(QDir::Files);
+    for (int i = 0; i < names.size(); ++i) {
+        if (!m_entries.contains(QByteArray::fromHex(names[i].toLatin1())))
+            entries.remove(names[i]);
+    }
+
+    QDir bodies(m_cacheDirectory + QLatin1String("/bodies"));
+    names = bodies.entryList(QDir::Files);
+    for (int i = 0; i < names.size(); ++i) {
+        if (!m_bodyReferenceCounts.contains(QByteArray::fromHex(names[i].toLatin1())))
+            bodies.remove(names[i]);
+    }
+
+    QDir pending(m_cacheDirectory + QLatin1String("/pending"));
+    names = pending.entryList(QDir::Files);
+    for (int i = 0; i < names.size(); ++i)
+        pending.remove(names[i]);
+}
+
+void QtDiskCache::scheduleIndexWrite()
+{
+    if (!m_indexWriteTimer.isActive())
+        m_indexWriteTimer.start();
+}
+
+void QtDiskCache::writeIndex()
+{
+    m_indexWriteTimer.stop();
+
+    QByteArray bytes(sizeof(IndexHeader) + m_entries.size() * sizeof(IndexRecord), 0);
+
+    IndexHeader* header = reinterpret_cast<IndexHeader*>(bytes.data());
+    header->magic = indexMagic;
+    header->version = indexVersion;
+    header->recordCount = m_entries.size();
+
+    IndexRecord* record = reinterpret_cast<IndexRecord*>(bytes.data() + sizeof(IndexHeader));
+    for (QHash<QByteArray, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it, ++record) {
+        memcpy(record->urlHash, it.key().constData(), sizeof(record->urlHash));
+        memcpy(record->bodyHash, it.value().bodyHash.constData(), sizeof(record->bodyHash));
+        record->bodySize = it.value().bodySize;
+        record->expirationTime = it.value().expirationTime;
+        record->lastAccessTime = it.value().lastAccessTime;
+        record->accessCount = it.value().accessCount;
+        record->flags = it.value().flags;
+    }
+
+    // Write a new file and move it over the old one, so that a crash never leaves a torn index.
+    QString path = m_cacheDirectory + QLatin1String("/index");
+    QString temporaryPath = path + QLatin1String(".new");
+    QFile file(temporaryPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+    bool written = file.write(bytes) == bytes.size();
+    file.close();
+    if (!written) {
+        QFile::remove(temporaryPath);
+        return;
+    }
+    QFile::remove(path);
+    QFile::rename(temporaryPath, path);
+}
+
+bool QtDiskCache::writeMetaData(const QByteArray& key, const QNetworkCacheMetaData& metaData)
+{
+    QFile file(entryPath(key));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << metaDataVersion << metaData;
+    return stream.status() == QDataStream::Ok;
+}
+
+void QtDiskCache::addEntry(const QByteArray& key, const Entry& entry)
+{
+    m_entries.insert(key, entry);
+    if (!m_bodyReferenceCounts[entry.bodyHash]++)
+        m_cacheSize += entry.bodySize;
+}
+
+void QtDiskCache::removeEntry(const QByteArray& key)
+{
+    QHash<QByteArray, Entry>::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    Entry entry = it.value();
+    m_entries.erase(it);
+    QFile::remove(entryPath(key));
+    releaseBody(entry.bodyHash, entry.bodySize);
+    scheduleIndexWrite();
+}
+
+void QtDiskCache::releaseBody(const QByteArray& bodyHash, qint64 bodySize)
+{
+    QHash<QByteArray, unsigned>::iterator it = m_bodyReferenceCounts.find(bodyHash);
+    if (it == m_bodyReferenceCounts.end() || --it.value())
+        return;
+
+    m_bodyReferenceCounts.erase(it);
+    QFile::remove(bodyPath(bodyHash));
+    m_cacheSize -= bodySize;
+}
+
+void QtDiskCache::evictIfNeeded()
+{
+    if (m_cacheSize <= m_maximumCacheSize)
+        return;
+
+    // Expired responses that cannot be revalidated are useless and go first. The others go in
+    // order of last use, with frequently read entries treated as if they were used more recently.
+    qint64 now = currentTime();
+    QVector<QPair<qint64, QByteArray> > candidates;
+    candidates.reserve(m_entries.size());
+    for (QHash<QByteArray, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        const Entry& entry = it.value();
+        qint64 score;
+        if (entry.expirationTime && entry.expirationTime < now && !(entry.flags & HasValidators))
+            score = -1;
+        else
+            score = entry.lastAccessTime + qMin(entry.accessCount, maximumAccessCountBonus) * accessCountBonus;
+        candidates.append(qMakePair(score, it.key()));
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    // Evict a little more than necessary so that the next few insertions do not each trigger another pass.
+    qint64 targetSize = m_maximumCacheSize / 10 * 9;
+    for (int i = 0; i < candidates.size() && m_cacheSize > targetSize; ++i)
+        removeEntry(candidates[i].second);
+}
+
+QNetworkCacheMetaData QtDiskCache::metaData(const QUrl& url)
+{
+    QByteArray key = urlKey(url);
+    if (!m_entries.contains(key))
+        return QNetworkCacheMetaData();
+
+    QFile file(entryPath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        removeEntry(key);
+        return QNetworkCacheMetaData();
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 version = 0;
+    QNetworkCacheMetaData metaData;
+    stream >> version;
+    if (version == metaDataVersion)
+        stream >> metaData;
+    if (stream.status() != QDataStream::Ok || version != metaDataVersion || urlKey(metaData.url()) != key) {
+        file.close();
+        removeEntry(key);
+        return QNetworkCacheMetaData();
+    }
+    return metaData;
+}
+
+void QtDiskCache::updateMetaData(const QNetworkCacheMetaData& newMetaData)
+{
+    QByteArray key = urlKey(newMetaData.url());
+    QHash<QByteArray, Entry>::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    QNetworkCacheMetaData metaData = newMetaData;
+    prepareMetaData(metaData, it->flags, it->expirationTime);
+    if (!writeMetaData(key, metaData)) {
+        removeEntry(key);
+        return;
+    }
+    scheduleIndexWrite();
+}
+
+QIODevice* QtDiskCache::data(const QUrl& url)
+{
+    QByteArray key = urlKey(url);
+    QHash<QByteArray, Entry>::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return 0;
+
+    MappedBodyBuffer* body = MappedBodyBuffer::create(bodyPath(it->bodyHash));
+    if (!body) {
+        removeEntry(key);
+        return 0;
+    }
+
+    it->lastAccessTime = currentTime();
+    ++it->accessCount;
+    scheduleIndexWrite();
+    return body;
+}
+
+bool QtDiskCache::remove(const QUrl& url)
+{
+    // QNetworkAccessManager removes the URL of a reply that failed while it was being written.
+    for (QHash<QIODevice*, QNetworkCacheMetaData>::iterator it = m_pendingInsertions.begin(); it != m_pendingInsertions.end(); ++it) {
+        if (it.value().url() == url) {
+            delete it.key();
+            m_pendingInsertions.erase(it);
+            break;
+        }
+    }
+
+    QByteArray key = urlKey(url);
+    if (!m_entries.contains(key))
+        return false;
+    removeEntry(key);
+    return true;
+}
+
+qint64 QtDiskCache::cacheSize() const
+{
+    return m_cacheSize;
+}
+
+QIODevice* QtDiskCache::prepare(const QNetworkCacheMetaData& metaData)
+{
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk())
+        return 0;
+
+    QNetworkCacheMetaData::RawHeaderList headers = metaData.rawHeaders();
+    for (QNetworkCacheMetaData::RawHeaderList::const_iterator it = headers.constBegin(); it != headers.constEnd(); ++it) {
+        QByteArray name = it->first.toLower();
+        if (name == "cache-control" && it->second.toLower().contains("no-store"))
+            return 0;
+        if (name == "vary" && it->second.trimmed() == "*")
+            return 0;
+        if (name == "content-length" && it->second.toLongLong() > m_maximumCacheSize / 4 * 3)
+            return 0;
+    }
+
+    QTemporaryFile* file = new QTemporaryFile(m_cacheDirectory + QLatin1String("/pending/XXXXXX"));
+    if (!file->open()) {
+        delete file;
+        return 0;
+    }
+
+    m_pendingInsertions.insert(file, metaData);
+    return file;
+}
+
+void QtDiskCache::insert(QIODevice* device)
+{
+    QHash<QIODevice*, QNetworkCacheMetaData>::iterator pending = m_pendingInsertions.find(device);
+    if (pending == m_pendingInsertions.end())
+        return;
+
+    QNetworkCacheMetaData metaData = pending.value();
+    m_pendingInsertions.erase(pending);
+
+    QTemporaryFile* file = static_cast<QTemporaryFile*>(device);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!file->seek(0) || !hash.addData(file)) {
+        delete file;
+        return;
+    }
+
+    Entry entry;
+    entry.bodyHash = hash.result();
+    entry.bodySize = file->size();
+    entry.lastAccessTime = currentTime();
+    entry.accessCount = 0;
+    prepareMetaData(metaData, entry.flags, entry.expirationTime);
+
+    // A body that is already stored under the same hash is shared rather than written again.
+    bool isNewBody = !m_bodyReferenceCounts.contains(entry.bodyHash);
+    if (isNewBody) {
+        QString temporaryPath = file->fileName();
+        file->setAutoRemove(false);
+        file->close();
+        if (!QFile::rename(temporaryPath, bodyPath(entry.bodyHash))) {
+            QFile::remove(temporaryPath);
+            delete file;
+            return;
+        }
+    }
+    delete file;
+
+    QByteArray key = urlKey(metaData.url());
+    if (!writeMetaData(key, metaData)) {
+        if (isNewBody)
+            QFile::remove(bodyPath(entry.bodyHash));
+        remove(metaData.url());
+        return;
+    }
+
+    // Reference the new body before letting go of the old one, which may be the same file.
+    QHash<QByteArray, Entry>::const_iterator previous = m_entries.constFind(key);
+    bool hadPreviousEntry = previous != m_entries.constEnd();
+    Entry previousEntry = hadPreviousEntry ? previous.value() : Entry();
+    addEntry(key, entry);
+    if (hadPreviousEntry)
+        releaseBody(previousEntry.bodyHash, previousEntry.bodySize);
+
+    scheduleIndexWrite();
+    evictIfNeeded();
+}
+
+void QtDiskCache::clear()
+{
+    m_entries.clear();
+    m_bodyReferenceCounts.clear();
+    m_cacheSize = 0;
+
+    QFile::remove(m_cacheDirectory + QLatin1String("/index"));
+    QDir(m_cacheDirectory + QLatin1String("/entries")).removeRecursively();
+    QDir(m_cacheDirectory + QLatin1String("/bodies")).removeRecursively();
+
+    QDir directory(m_cacheDirectory);
+    directory.mkpath(QLatin1String("entries"));
+    directory.mkpath(QLatin1String("bodies"));
+    m_indexWriteTimer.stop();
+
+    // Earlier sessions may have left pages behind in the other subdirectories, and clearing the cache
+    // must get rid of those too. Subdirectories other processes hold are cleared by those processes.
+    QString baseDirectory = QFileInfo(m_cacheDirectory).path();
+    for (int i = 0; i < maximumCacheDirectoryCount; ++i) {
+        QString cacheDirectory = cacheDirectoryPath(baseDirectory, i);
+        if (cacheDirectory != m_cacheDirectory)
+            removeUnusedCacheDirectory(cacheDirectory, QDateTime());
+    }
+}
+
+} // namespace WebKit
+
+#include "moc_QtDiskCache.cpp"
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QtDiskCache_h
+#define QtDiskCache_h
+
+#include <QAbstractNetworkCache>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QTimer>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+
+QT_BEGIN_NAMESPACE
+class QLockFile;
+QT_END_NAMESPACE
+
+namespace WebKit {
+
+// HTTP disk cache for the web process, used instead of QNetworkDiskCache.
+//
+// Response bodies are content-addressed: each distinct body is stored once under the SHA-1 of
+// its bytes, so the same resource served from several URLs shares one file. The headers of each
+// URL live in a small file of their own. A single index of fixed-size records, memory mapped when
+// the cache opens, holds what eviction needs (body size, expiration, last access, access count),
+// so opening the cache does not have to read every entry. Bodies are handed to the network stack
+// as memory-mapped files rather than being copied into memory.
+//
+// Every web process of a context is handed the same base directory, but the index is kept in
+// memory and files the index does not know about are deleted when the cache opens. Each cache
+// therefore lives in a numbered subdirectory of the base directory that it holds a lock file for,
+// so no two processes ever read or clean up the same files. A later process reuses the first
+// subdirectory that is free, which is usually the one the previous session left behind. Free
+// subdirectories that have not been used for a while are deleted when a cache opens, and clear()
+// deletes all of them along with its own entries.
+class QtDiskCache : public QAbstractNetworkCache {
+    Q_OBJECT
+public:
+    // Returns 0 if every subdirectory is locked by another process.
+    static QtDiskCache* create(const QString& baseDirectory, QObject* parent = 0);
+    virtual ~QtDiskCache();
+
+    QString cacheDirectory() const { return m_cacheDirectory; }
+    qint64 maximumCacheSize() const { return m_maximumCacheSize; }
+    void setMaximumCacheSize(qint64);
+
+    virtual QNetworkCacheMetaData metaData(const QUrl&) OVERRIDE;
+    virtual void updateMetaData(const QNetworkCacheMetaData&) OVERRIDE;
+    virtual QIODevice* data(const QUrl&) OVERRIDE;
+    virtual bool remove(const QUrl&) OVERRIDE;
+    virtual qint64 cacheSize() const OVERRIDE;
+    virtual QIODevice* prepare(const QNetworkCacheMetaData&) OVERRIDE;
+    virtual void insert(QIODevice*) OVERRIDE;
+
+public Q_SLOTS:
+    virtual void clear();
+
+private Q_SLOTS:
+    void writeIndex();
+
+private:
+    QtDiskCache(const QString& cacheDirectory, PassOwnPtr<QLockFile>, QObject* parent);
+
+    enum EntryFlag {
+        HasValidators = 1 << 0
+    };
+
+    struct Entry {
+        QByteArray bodyHash;
+        qint64 bodySize;
+        qint64 expirationTime;
+        qint64 lastAccessTime;
+        quint32 accessCount;
+        quint32 flags;
+    };
+
+    static QByteArray urlKey(const QUrl&);
+    static void prepareMetaData(QNetworkCacheMetaData&, quint32& flags, qint64& expirationTime);
+
+    QString entryPath(const QByteArray& key) const;
+    QString bodyPath(const QByteArray& bodyHash) const;
+
+    void readIndex();
+    void removeUnreferencedFiles();
+    void scheduleIndexWrite();
+
+    bool writeMetaData(const QByteArray& key, const QNetworkCacheMetaData&);
+    void addEntry(const QByteArray& key, const Entry&);
+    void removeEntry(const QByteArray& key);
+    void releaseBody(const QByteArray& bodyHash, qint64 bodySize);
+    void evictIfNeeded();
+
+    QString m_cacheDirectory;
+    OwnPtr<QLockFile> m_lockFile;
+    qint64 m_maximumCacheSize;
+    qint64 m_cacheSize;
+
+    QHash<QByteArray, Entry> m_entries;
+    QHash<QByteArray, unsigned> m_bodyReferenceCounts;
+    QHash<QIODevice*, QNetworkCacheMetaData> m_pendingInsertions;
+
+    QTimer m_indexWriteTimer;
+};
+
+} // namespace WebKit
+
+#endif // QtDiskCache_h
@@ -28,6 +28,7 @@
 
 #include "InjectedBundle.h"
 #include "QtBuiltinBundle.h"
+#include "QtDiskCache.h"
 #include "QtNetworkAccessManager.h"
 #include "SeccompFiltersWebProcessQt.h"
 #include "WKBundleAPICast.h"
@@ -36,7 +37,6 @@
 #include <QCoreApplication>
 #include <QNetworkAccessManager>
 #include <QNetworkCookieJar>
-#include <QNetworkDiskCache>
 #include <WebCore/CookieJarQt.h>
 #include <WebCore/FileSystem.h>
 #include <WebCore/MemoryCache.h>
@@ -64,7 +64,7 @@ void WebProcess::platformSetCacheModel(CacheModel cacheModel)
     // The Mac port of WebKit2 uses a fudge factor of 1000 here to account for misalignment, however,
     // that tends to overestimate the memory quite a bit (1 byte misalignment ~ 48 MiB misestimation).
     // We use 1024 * 1023 for now to keep the estimation error down to +/- ~1 MiB.
-    QNetworkDiskCache* diskCache = qobject_cast<QNetworkDiskCache*>(m_networkAccessManager->cache());
+    QtDiskCache* diskCache = qobject_cast<QtDiskCache*>(m_networkAccessManager->cache());
     uint64_t freeVolumeSpace = !diskCache ? 0 : WebCore::getVolumeFreeSizeForPath(diskCache->cacheDirectory().toLocal8Bit().constData()) / 1024 / 1023;
 
     // The following variables are initialised to 0 because WebProcess::calculateCacheSizes might not
@@ -92,8 +92,13 @@ void WebProcess::platformSetCacheModel(CacheModel cacheModel)
     // FIXME: Implement hybrid in-memory- and disk-caching as e.g. the Mac port does.
 }
 
-void WebProcess::platformClearResourceCaches(ResourceCachesToClear)
+void WebProcess::platformClearResourceCaches(ResourceCachesToClear cachesToClear)
 {
+    if (cachesToClear == InMemoryResourceCachesOnly)
+        return;
+
+    if (QAbstractNetworkCache* diskCache = m_networkAccessManager->cache())
+        diskCache->clear();
 }
 
 #if defined(Q_OS_MACX)
@@ -122,10 +127,11 @@ void WebProcess::platformInitializeWebProcess(const WebProcessCreationParameters
     }
 
     if (!parameters.diskCacheDirectory.isEmpty()) {
-        QNetworkDiskCache* diskCache = new QNetworkDiskCache();
-        diskCache->setCacheDirectory(parameters.diskCacheDirectory);
-        // The m_networkAccessManager takes ownership of the diskCache object upon the following call.
-        m_networkAccessManager->setCache(diskCache);
+        // Without a free cache directory the process runs without a disk cache rather than sharing one.
+        if (QtDiskCache* diskCache = QtDiskCache::create(parameters.diskCacheDirectory)) {
+            // The m_networkAccessManager takes ownership of the diskCache object upon the following call.
+            m_networkAccessManager->setCache(diskCache);
+        }
     }
 
 #if defined(Q_OS_MACX)
@@ -50,6 +50,9 @@ set(webkit2_api_harness_SOURCES
 set(test_webcore_BINARIES
     LayoutUnit
     KURL
+    LinkRelAttribute
+    PreconnectQueue
+    SharedBuffer
 )
 
 # In here we list the bundles that are used by our specific WK2 API Tests
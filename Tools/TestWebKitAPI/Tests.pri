@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS += Tests/WTF Tests/JavaScriptCore Tests/WebKit2
+SUBDIRS += Tests/WTF Tests/JavaScriptCore Tests/WebCore Tests/WebKit2
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <WebCore/LinkRelAttribute.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+TEST(LinkRelAttribute, Preconnect)
+{
+    LinkRelAttribute relAttribute("preconnect");
+    EXPECT_TRUE(relAttribute.m_isPreconnect);
+    EXPECT_FALSE(relAttribute.m_isDNSPrefetch);
+    EXPECT_FALSE(relAttribute.m_isStyleSheet);
+
+    EXPECT_TRUE(LinkRelAttribute("PreConnect").m_isPreconnect);
+    EXPECT_FALSE(LinkRelAttribute("preconnected").m_isPreconnect);
+    EXPECT_FALSE(LinkRelAttribute("pre-connect").m_isPreconnect);
+}
+
+TEST(LinkRelAttribute, DNSPrefetch)
+{
+    LinkRelAttribute relAttribute("dns-prefetch");
+    EXPECT_TRUE(relAttribute.m_isDNSPrefetch);
+    EXPECT_FALSE(relAttribute.m_isPreconnect);
+
+    EXPECT_TRUE(LinkRelAttribute("DNS-Prefetch").m_isDNSPrefetch);
+    EXPECT_FALSE(LinkRelAttribute("dns-prefetching").m_isDNSPrefetch);
+}
+
+TEST(LinkRelAttribute, HintsInTokenLists)
+{
+    LinkRelAttribute styleSheetAndPreconnect("stylesheet preconnect");
+    EXPECT_TRUE(styleSheetAndPreconnect.m_isStyleSheet);
+    EXPECT_TRUE(styleSheetAndPreconnect.m_isPreconnect);
+    EXPECT_FALSE(styleSheetAndPreconnect.m_isDNSPrefetch);
+
+    LinkRelAttribute bothHints("dns-prefetch preconnect");
+    EXPECT_TRUE(bothHints.m_isDNSPrefetch);
+    EXPECT_TRUE(bothHints.m_isPreconnect);
+    EXPECT_FALSE(bothHints.m_isStyleSheet);
+
+    LinkRelAttribute separatedByNewline("preconnect\ndns-prefetch");
+    EXPECT_TRUE(separatedByNewline.m_isPreconnect);
+    EXPECT_TRUE(separatedByNewline.m_isDNSPrefetch);
+
+    LinkRelAttribute extraSpaces("  icon   PRECONNECT ");
+    EXPECT_TRUE(extraSpaces.m_isPreconnect);
+    EXPECT_EQ(Favicon, extraSpaces.m_iconType);
+
+    EXPECT_FALSE(LinkRelAttribute("stylesheet preconnected").m_isPreconnect);
+    EXPECT_FALSE(LinkRelAttribute("stylesheet-preconnect").m_isPreconnect);
+}
+
+} // namespace TestWebKitAPI
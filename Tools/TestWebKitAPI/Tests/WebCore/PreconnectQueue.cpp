@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "WTFStringUtilities.h"
+#include <WebCore/KURL.h>
+#include <WebCore/PreconnectQueue.h>
+#include <wtf/MainThread.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+// Opens no sockets. Records the hosts it would have connected to and runs on a clock the test moves.
+class TestPreconnectQueue : public PreconnectQueue {
+public:
+    TestPreconnectQueue()
+        : m_now(1000)
+    {
+    }
+
+    using PreconnectQueue::fired;
+
+    void add(const char* url, ConnectionKind kind = SpeculativeConnection)
+    {
+        PreconnectQueue::add(KURL(ParsedURLString, url), 0, kind);
+    }
+
+    void advanceTime(double seconds) { m_now += seconds; }
+
+    // Returns the hosts connected to since the last call, in the order the connections were opened.
+    String takeConnectedHosts()
+    {
+        String hosts = m_connectedHosts.toString();
+        m_connectedHosts.clear();
+        return hosts;
+    }
+
+private:
+    virtual bool openConnection(const KURL& url, NetworkingContext*) OVERRIDE
+    {
+        if (!m_connectedHosts.isEmpty())
+            m_connectedHosts.append(' ');
+        m_connectedHosts.append(url.host());
+        return true;
+    }
+
+    virtual void prefetchHostName(const String&) OVERRIDE
+    {
+        ADD_FAILURE();
+    }
+
+    virtual double monotonicTime() const OVERRIDE { return m_now; }
+
+    double m_now;
+    StringBuilder m_connectedHosts;
+};
+
+class PreconnectQueueTest : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        WTF::initializeMainThread();
+    }
+
+    // Uses up the budget of the current window with six origins that are not used again.
+    void useUpConnectionBudget(TestPreconnectQueue& queue)
+    {
+        queue.add("http://1.example/");
+        queue.add("http://2.example/");
+        queue.add("http://3.example/");
+        queue.add("http://4.example/");
+        queue.add("http://5.example/");
+        queue.add("http://6.example/");
+        EXPECT_EQ(String("1.example 2.example 3.example 4.example 5.example 6.example"), queue.takeConnectedHosts());
+    }
+};
+
+TEST_F(PreconnectQueueTest, ConnectsRightAwayWithinBudget)
+{
+    TestPreconnectQueue queue;
+    queue.add("http://a.example/", PreconnectQueue::HintedConnection);
+    queue.add("https://b.example/path?query");
+    EXPECT_EQ(String("a.example b.example"), queue.takeConnectedHosts());
+}
+
+TEST_F(PreconnectQueueTest, IgnoresOtherSchemes)
+{
+    TestPreconnectQueue queue;
+    queue.add("ftp://a.example/");
+    queue.add("data:text/plain,a");
+    queue.add("file:///tmp/a.html");
+    EXPECT_TRUE(queue.takeConnectedHosts().isEmpty());
+}
+
+TEST_F(PreconnectQueueTest, Budget)
+{
+    TestPreconnectQueue queue;
+    useUpConnectionBudget(queue);
+
+    queue.add("http://a.example/");
+    queue.add("http://b.example/");
+    EXPECT_TRUE(queue.takeConnectedHosts().isEmpty());
+
+    queue.advanceTime(9);
+    queue.fired();
+    EXPECT_TRUE(queue.takeConnectedHosts().isEmpty());
+
+    queue.advanceTime(1);
+    queue.fired();
+    EXPECT_EQ(String("a.example b.example"), queue.takeConnectedHosts());
+
+    // Only the two connections of this window count now.
+    queue.add("http://c.example/");
+    queue.add("http://d.example/");
+    queue.add("http://e.example/");
+    queue.add("http://f.example/");
+    queue.add("http://g.example/");
+    EXPECT_EQ(String("c.example d.example e.example f.example"), queue.takeConnectedHosts());
+
+    queue.advanceTime(10);
+    queue.fired();
+    EXPECT_EQ(String("g.example"), queue.takeConnectedHosts());
+}
+
+TEST_F(PreconnectQueueTest, ConnectsToAnOriginOnce)
+{
+    TestPreconnectQueue queue;
+    queue.add("http://a.example/one");
+    queue.add("http://A.example/two", PreconnectQueue::HintedConnection);
+    queue.add("http://a.example:80/three");
+    EXPECT_EQ(String("a.example"), queue.takeConnectedHosts());
+
+    // Another scheme or port is another origin.
+    queue.add("https://a.example/");
+    queue.add("https://a.example:443/");
+    queue.add("http://a.example:8080/");
+    EXPECT_EQ(String("a.example a.example"), queue.takeConnectedHosts());
+
+    queue.advanceTime(29);
+    queue.add("http://a.example/");
+    EXPECT_TRUE(queue.takeConnectedHosts().isEmpty());
+
+    queue.advanceTime(1);
+    queue.add("http://a.example/");
+    EXPECT_EQ(String("a.example"), queue.takeConnectedHosts());
+}
+
+TEST_F(PreconnectQueueTest, ConnectsToAPendingOriginOnce)
+{
+    TestPreconnectQueue queue;
+    useUpConnectionBudget(queue);
+
+    queue.add("http://a.example/one");
+    queue.add("http://a.example/two");
+    queue.add("http://a.example/three", PreconnectQueue::HintedConnection);
+    queue.add("http://a.example/four", PreconnectQueue::HintedConnection);
+
+    queue.advanceTime(10);
+    queue.fired();
+    EXPECT_EQ(String("a.example"), queue.takeConnectedHosts());
+}
+
+TEST_F(PreconnectQueueTest, HintsGoFirst)
+{
+    TestPreconnectQueue queue;
+    useUpConnectionBudget(queue);
+
+    queue.add("http://a.example/");
+    queue.add("http://b.example/", PreconnectQueue::HintedConnection);
+    queue.add("http://c.example/");
+    queue.add("http://d.example/", PreconnectQueue::HintedConnection);
+    // The page asks for an origin that was only guessed at so far.
+    queue.add("http://c.example/", PreconnectQueue::HintedConnection);
+
+    queue.advanceTime(10);
+    queue.fired();
+    EXPECT_EQ(String("b.example d.example c.example a.example"), queue.takeConnectedHosts());
+}
+
+TEST_F(PreconnectQueueTest, GuessWaitsBehindPendingHints)
+{
+    TestPreconnectQueue queue;
+    useUpConnectionBudget(queue);
+
+    queue.add("http://a.example/", PreconnectQueue::HintedConnection);
+    queue.advanceTime(10);
+    // The budget is back, but the hint has not been served yet.
+    queue.add("http://b.example/");
+    EXPECT_TRUE(queue.takeConnectedHosts().isEmpty());
+
+    queue.fired();
+    EXPECT_EQ(String("a.example b.example"), queue.takeConnectedHosts());
+}
+
+TEST_F(PreconnectQueueTest, FullQueue)
+{
+    TestPreconnectQueue queue;
+    useUpConnectionBudget(queue);
+
+    // Sixteen origins fill the queue, so the seventeenth guess is dropped.
+    const char* guesses[] = {
+        "http://g1.example/", "http://g2.example/", "http://g3.example/", "http://g4.example/",
+        "http://g5.example/", "http://g6.example/", "http://g7.example/", "http://g8.example/",
+        "http://g9.example/", "http://g10.example/", "http://g11.example/", "http://g12.example/",
+        "http://g13.example/", "http://g14.example/", "http://g15.example/", "http://g16.example/",
+        "http://g17.example/"
+    };
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(guesses); ++i)
+        queue.add(guesses[i]);
+
+    // A hint takes the place of the last guess.
+    queue.add("http://hint.example/", PreconnectQueue::HintedConnection);
+
+    queue.advanceTime(10);
+    queue.fired();
+    EXPECT_EQ(String("hint.example g1.example g2.example g3.example g4.example g5.example"), queue.takeConnectedHosts());
+    queue.advanceTime(10);
+    queue.fired();
+    EXPECT_EQ(String("g6.example g7.example g8.example g9.example g10.example g11.example"), queue.takeConnectedHosts());
+    queue.advanceTime(10);
+    queue.fired();
+    EXPECT_EQ(String("g12.example g13.example g14.example g15.example"), queue.takeConnectedHosts());
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <WebCore/SharedBuffer.h>
+#include <string.h>
+#include <wtf/MainThread.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+// Stands in for memory owned outside the buffer, such as a shared memory region.
+class TestDataSegment : public SharedBuffer::DataSegment {
+public:
+    static PassRefPtr<TestDataSegment> create(char fill, unsigned length) { return adoptRef(new TestDataSegment(fill, length)); }
+
+    virtual const char* data() const OVERRIDE { return m_data.data(); }
+    virtual unsigned size() const OVERRIDE { return m_data.size(); }
+
+private:
+    TestDataSegment(char fill, unsigned length)
+        : m_data(length)
+    {
+        m_data.fill(fill);
+    }
+
+    Vector<char> m_data;
+};
+
+class SharedBufferTest : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        WTF::initializeMainThread();
+    }
+};
+
+static void appendFilled(Vector<char>& expected, char fill, unsigned length)
+{
+    for (unsigned i = 0; i < length; ++i)
+        expected.append(fill);
+}
+
+static void appendFilled(SharedBuffer* buffer, char fill, unsigned length)
+{
+    Vector<char> bytes(length);
+    bytes.fill(fill);
+    buffer->append(bytes);
+}
+
+static Vector<char> contentsFromGetSomeData(SharedBuffer* buffer)
+{
+    Vector<char> contents;
+    const char* segment;
+    unsigned position = 0;
+    while (unsigned length = buffer->getSomeData(segment, position)) {
+        contents.append(segment, length);
+        position += length;
+    }
+    return contents;
+}
+
+// Copied bytes spanning several internal segments, then data segments with small and large
+// appends in between, so every kind of segment is present in one buffer.
+static PassRefPtr<SharedBuffer> createMixedBuffer(Vector<char>& expected)
+{
+    RefPtr<SharedBuffer> buffer = SharedBuffer::create();
+    appendFilled(buffer.get(), 'a', 10000);
+    appendFilled(expected, 'a', 10000);
+    buffer->append(TestDataSegment::create('b', 20000));
+    appendFilled(expected, 'b', 20000);
+    for (unsigned i = 0; i < 100; ++i) {
+        appendFilled(buffer.get(), 'c' + i % 3, 7);
+        appendFilled(expected, 'c' + i % 3, 7);
+    }
+    buffer->append(TestDataSegment::create('f', 3000));
+    appendFilled(expected, 'f', 3000);
+    appendFilled(buffer.get(), 'g', 9000);
+    appendFilled(expected, 'g', 9000);
+    return buffer.release();
+}
+
+TEST_F(SharedBufferTest, GetSomeDataKeepsOrderAcrossMixedSegments)
+{
+    Vector<char> expected;
+    RefPtr<SharedBuffer> buffer = createMixedBuffer(expected);
+
+    EXPECT_EQ(expected.size(), buffer->size());
+    Vector<char> contents = contentsFromGetSomeData(buffer.get());
+    ASSERT_EQ(expected.size(), contents.size());
+    EXPECT_EQ(0, memcmp(expected.data(), contents.data(), expected.size()));
+
+    // Reading from arbitrary positions must land in the right segment.
+    for (unsigned position = 0; position < expected.size(); position += 997) {
+        const char* segment;
+        unsigned length = buffer->getSomeData(segment, position);
+        ASSERT_TRUE(length);
+        EXPECT_LE(position + length, expected.size());
+        EXPECT_EQ(0, memcmp(expected.data() + position, segment, length));
+    }
+}
+
+TEST_F(SharedBufferTest, SmallAppendsAfterDataSegmentShareOneSegment)
+{
+    RefPtr<SharedBuffer> buffer = SharedBuffer::create();
+    buffer->append(TestDataSegment::create('a', 100));
+    for (unsigned i = 0; i < 50; ++i)
+        appendFilled(buffer.get(), 'b', 10);
+
+    const char* segment;
+    EXPECT_EQ(100u, buffer->getSomeData(segment, 0));
+    EXPECT_EQ(500u, buffer->getSomeData(segment, 100));
+    EXPECT_EQ(600u, buffer->size());
+}
+
+TEST_F(SharedBufferTest, Copy)
+{
+    Vector<char> expected;
+    RefPtr<SharedBuffer> buffer = createMixedBuffer(expected);
+    RefPtr<SharedBuffer> clone = buffer->copy();
+
+    // Bytes appended to either buffer after copying must not show up in the other.
+    appendFilled(buffer.get(), 'x', 5);
+    appendFilled(clone.get(), 'y', 5);
+    appendFilled(expected, 'y', 5);
+
+    ASSERT_EQ(expected.size(), clone->size());
+    Vector<char> contents = contentsFromGetSomeData(clone.get());
+    ASSERT_EQ(expected.size(), contents.size());
+    EXPECT_EQ(0, memcmp(expected.data(), contents.data(), expected.size()));
+    EXPECT_EQ(0, memcmp(expected.data(), clone->data(), expected.size()));
+    EXPECT_EQ('x', buffer->data()[buffer->size() - 1]);
+}
+
+TEST_F(SharedBufferTest, DataFlattensMixedSegments)
+{
+    Vector<char> expected;
+    RefPtr<SharedBuffer> buffer = createMixedBuffer(expected);
+
+    const char* data = buffer->data();
+    ASSERT_EQ(expected.size(), buffer->size());
+    EXPECT_EQ(0, memcmp(expected.data(), data, expected.size()));
+
+    // Once flattened, the whole buffer is one block and further appends still go behind it.
+    const char* segment;
+    EXPECT_EQ(expected.size(), buffer->getSomeData(segment, 0));
+    appendFilled(buffer.get(), 'z', 5000);
+    appendFilled(expected, 'z', 5000);
+    Vector<char> contents = contentsFromGetSomeData(buffer.get());
+    ASSERT_EQ(expected.size(), contents.size());
+    EXPECT_EQ(0, memcmp(expected.data(), contents.data(), expected.size()));
+}
+
+TEST_F(SharedBufferTest, AppendSharedBufferSharesDataSegments)
+{
+    RefPtr<TestDataSegment> dataSegment = TestDataSegment::create('a', 20000);
+    RefPtr<SharedBuffer> source = SharedBuffer::create();
+    source->append(dataSegment);
+
+    RefPtr<SharedBuffer> destination = SharedBuffer::create();
+    destination->append(source.get());
+
+    EXPECT_EQ(20000u, destination->size());
+    EXPECT_EQ(dataSegment->data(), destination->data());
+
+    // Bytes appended to the source afterwards must not grow the segment the two buffers now share.
+    appendFilled(source.get(), 'b', 10);
+    RefPtr<SharedBuffer> sharing = SharedBuffer::create();
+    sharing->append(source.get());
+    appendFilled(source.get(), 'c', 10);
+    EXPECT_EQ(20020u, source->size());
+    EXPECT_EQ(20010u, sharing->size());
+    Vector<char> contents = contentsFromGetSomeData(sharing.get());
+    ASSERT_EQ(20010u, contents.size());
+    EXPECT_EQ('b', contents[20009]);
+
+    // A buffer that also holds copied bytes is copied rather than shared.
+    RefPtr<SharedBuffer> mixed = SharedBuffer::create();
+    appendFilled(mixed.get(), 'b', 10);
+    mixed->append(dataSegment);
+    RefPtr<SharedBuffer> copied = SharedBuffer::create();
+    copied->append(mixed.get());
+    EXPECT_EQ(20010u, copied->size());
+    EXPECT_NE(dataSegment->data(), copied->data() + 10);
+    EXPECT_EQ('b', copied->data()[9]);
+    EXPECT_EQ('a', copied->data()[10]);
+}
+
+} // namespace TestWebKitAPI
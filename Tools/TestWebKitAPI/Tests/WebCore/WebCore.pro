@@ -0,0 +1,13 @@
+TEMPLATE = app
+TARGET = tst_webcore
+
+SOURCES += \
+    LinkRelAttribute.cpp \
+    PreconnectQueue.cpp \
+    SharedBuffer.cpp
+
+include(../../TestWebKitAPI.pri)
+
+WEBKIT += webcore
+
+DEFINES += APITEST_SOURCE_DIR=\\\"$$PWD\\\"
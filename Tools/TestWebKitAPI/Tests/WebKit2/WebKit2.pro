@@ -36,7 +36,8 @@ SOURCES += \
     WKConnection.cpp \
     WKString.cpp \
     WKStringJSString.cpp \
-    WKURL.cpp
+    WKURL.cpp \
+    qt/QtDiskCache.cpp
 
 FAILING_SOURCES = \
     CanHandleRequest.cpp \
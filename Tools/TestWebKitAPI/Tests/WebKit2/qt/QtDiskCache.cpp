@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2015 The Qt Company Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "QtDiskCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QNetworkCacheMetaData>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QUrl>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+
+using WebKit::QtDiskCache;
+
+namespace TestWebKitAPI {
+
+static QUrl testURL(const char* path)
+{
+    return QUrl(QLatin1String("http://example.com/") + QLatin1String(path));
+}
+
+static QByteArray testBody(char fill, int size = 1000)
+{
+    return QByteArray(size, fill);
+}
+
+static bool insertResponse(QtDiskCache* cache, const QUrl& url, const QByteArray& body, const QDateTime& expirationDate = QDateTime())
+{
+    QNetworkCacheMetaData metaData;
+    metaData.setUrl(url);
+    metaData.setSaveToDisk(true);
+    metaData.setExpirationDate(expirationDate);
+    QNetworkCacheMetaData::RawHeaderList headers;
+    headers.append(qMakePair(QByteArray("Content-Type"), QByteArray("text/plain")));
+    metaData.setRawHeaders(headers);
+
+    QIODevice* device = cache->prepare(metaData);
+    if (!device)
+        return false;
+    if (device->write(body) != body.size()) {
+        cache->remove(url);
+        return false;
+    }
+    cache->insert(device);
+    return true;
+}
+
+static QByteArray readBody(QtDiskCache* cache, const QUrl& url)
+{
+    OwnPtr<QIODevice> device = adoptPtr(cache->data(url));
+    if (!device)
+        return QByteArray();
+    return device->readAll();
+}
+
+static int fileCount(const QString& path)
+{
+    return QDir(path).entryList(QDir::Files).size();
+}
+
+// Entries are ordered by the millisecond they were last used, so steps that must not tie wait a little.
+static void waitForClockTick()
+{
+    QThread::msleep(5);
+}
+
+TEST(WebKit2, QtDiskCacheIndexRoundTrip)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> cache = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(cache);
+    QString cacheDirectory = cache->cacheDirectory();
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("a"), testBody('a')));
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("b"), testBody('b', 500)));
+    EXPECT_EQ(1500, cache->cacheSize());
+
+    // Destroying the cache writes the index it has not written yet.
+    cache.clear();
+    EXPECT_TRUE(QFile::exists(cacheDirectory + QLatin1String("/index")));
+
+    cache = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(cache);
+    EXPECT_TRUE(cache->cacheDirectory() == cacheDirectory);
+    EXPECT_EQ(1500, cache->cacheSize());
+    EXPECT_TRUE(cache->metaData(testURL("a")).url() == testURL("a"));
+    EXPECT_TRUE(readBody(cache.get(), testURL("a")) == testBody('a'));
+    EXPECT_TRUE(readBody(cache.get(), testURL("b")) == testBody('b', 500));
+    EXPECT_FALSE(cache->metaData(testURL("c")).isValid());
+}
+
+TEST(WebKit2, QtDiskCacheSharedBodies)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> cache = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(cache);
+    QString bodies = cache->cacheDirectory() + QLatin1String("/bodies");
+
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("first"), testBody('x')));
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("second"), testBody('x')));
+    EXPECT_EQ(1000, cache->cacheSize());
+    EXPECT_EQ(1, fileCount(bodies));
+
+    // Replacing the body of a URL with the one it already has must not lose the file.
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("first"), testBody('x')));
+    EXPECT_EQ(1, fileCount(bodies));
+    EXPECT_TRUE(readBody(cache.get(), testURL("first")) == testBody('x'));
+
+    EXPECT_TRUE(cache->remove(testURL("first")));
+    EXPECT_EQ(1000, cache->cacheSize());
+    EXPECT_EQ(1, fileCount(bodies));
+    EXPECT_TRUE(readBody(cache.get(), testURL("second")) == testBody('x'));
+
+    EXPECT_TRUE(cache->remove(testURL("second")));
+    EXPECT_EQ(0, cache->cacheSize());
+    EXPECT_EQ(0, fileCount(bodies));
+}
+
+TEST(WebKit2, QtDiskCacheEvictionOrder)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> cache = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(cache);
+    cache->setMaximumCacheSize(3500);
+
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("a"), testBody('a')));
+    waitForClockTick();
+    // Expired and without validators, so it cannot be used again whenever it was last read.
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("b"), testBody('b'), QDateTime::currentDateTime().addDays(-1)));
+    waitForClockTick();
+    EXPECT_FALSE(readBody(cache.get(), testURL("a")).isEmpty());
+    waitForClockTick();
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("c"), testBody('c')));
+    waitForClockTick();
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("d"), testBody('d')));
+
+    EXPECT_EQ(3000, cache->cacheSize());
+    EXPECT_FALSE(cache->metaData(testURL("b")).isValid());
+    EXPECT_TRUE(cache->metaData(testURL("a")).isValid());
+    EXPECT_TRUE(cache->metaData(testURL("c")).isValid());
+
+    // c was used after a, but a has been read once, which counts for more.
+    waitForClockTick();
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("e"), testBody('e')));
+    EXPECT_EQ(3000, cache->cacheSize());
+    EXPECT_FALSE(cache->metaData(testURL("c")).isValid());
+    EXPECT_TRUE(cache->metaData(testURL("a")).isValid());
+    EXPECT_TRUE(cache->metaData(testURL("d")).isValid());
+    EXPECT_TRUE(cache->metaData(testURL("e")).isValid());
+}
+
+static void expectEmptyAfterReopening(const QString& baseDirectory, const QString& cacheDirectory)
+{
+    OwnPtr<QtDiskCache> cache = adoptPtr(QtDiskCache::create(baseDirectory));
+    ASSERT_TRUE(cache);
+    EXPECT_TRUE(cache->cacheDirectory() == cacheDirectory);
+    EXPECT_EQ(0, cache->cacheSize());
+    EXPECT_FALSE(cache->metaData(testURL("a")).isValid());
+    EXPECT_FALSE(cache->data(testURL("a")));
+    // Files the index does not know about are removed rather than left behind for good.
+    EXPECT_EQ(0, fileCount(cacheDirectory + QLatin1String("/entries")));
+    EXPECT_EQ(0, fileCount(cacheDirectory + QLatin1String("/bodies")));
+
+    // The cache is usable again.
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("a"), testBody('a')));
+    EXPECT_TRUE(readBody(cache.get(), testURL("a")) == testBody('a'));
+}
+
+TEST(WebKit2, QtDiskCacheCorruptIndex)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> cache = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(cache);
+    QString cacheDirectory = cache->cacheDirectory();
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("a"), testBody('a')));
+    cache.clear();
+
+    QFile index(cacheDirectory + QLatin1String("/index"));
+    ASSERT_TRUE(index.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    index.write(QByteArray(100, '\xff'));
+    index.close();
+
+    expectEmptyAfterReopening(baseDirectory.path(), cacheDirectory);
+}
+
+TEST(WebKit2, QtDiskCacheMissingIndex)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> cache = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(cache);
+    QString cacheDirectory = cache->cacheDirectory();
+    EXPECT_TRUE(insertResponse(cache.get(), testURL("a"), testBody('a')));
+    cache.clear();
+
+    ASSERT_TRUE(QFile::remove(cacheDirectory + QLatin1String("/index")));
+
+    expectEmptyAfterReopening(baseDirectory.path(), cacheDirectory);
+}
+
+TEST(WebKit2, QtDiskCacheClearRemovesUnusedSubdirectories)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> first = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    OwnPtr<QtDiskCache> second = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    OwnPtr<QtDiskCache> third = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(first && second && third);
+    EXPECT_TRUE(insertResponse(first.get(), testURL("a"), testBody('a')));
+    EXPECT_TRUE(insertResponse(second.get(), testURL("b"), testBody('b')));
+    EXPECT_TRUE(insertResponse(third.get(), testURL("c"), testBody('c')));
+
+    // The second cache's session ends and leaves its pages behind.
+    QString secondDirectory = second->cacheDirectory();
+    second.clear();
+    EXPECT_TRUE(QFile::exists(secondDirectory + QLatin1String("/index")));
+
+    first->clear();
+    EXPECT_EQ(0, first->cacheSize());
+    EXPECT_FALSE(first->metaData(testURL("a")).isValid());
+    EXPECT_FALSE(QDir(secondDirectory).exists());
+    // A cache that is still in use is left to its own process.
+    EXPECT_TRUE(readBody(third.get(), testURL("c")) == testBody('c'));
+}
+
+TEST(WebKit2, QtDiskCacheRemovesStaleSubdirectories)
+{
+    QTemporaryDir baseDirectory;
+    ASSERT_TRUE(baseDirectory.isValid());
+
+    OwnPtr<QtDiskCache> first = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    OwnPtr<QtDiskCache> second = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(first && second);
+    EXPECT_TRUE(insertResponse(second.get(), testURL("b"), testBody('b')));
+    QString secondDirectory = second->cacheDirectory();
+    second.clear();
+
+    // A subdirectory written to recently is kept for a later session to reuse.
+    first.clear();
+    first = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(first);
+    EXPECT_TRUE(QDir(secondDirectory).exists());
+
+    // One without an index, left by a process that ended before ever writing it, is not.
+    first.clear();
+    ASSERT_TRUE(QFile::remove(secondDirectory + QLatin1String("/index")));
+    first = adoptPtr(QtDiskCache::create(baseDirectory.path()));
+    ASSERT_TRUE(first);
+    EXPECT_FALSE(QDir(secondDirectory).exists());
+}
+
+} // namespace TestWebKitAPI